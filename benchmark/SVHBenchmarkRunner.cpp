@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains a small timing harness for the micro benchmarks of
+ * the library.
+ */
+//----------------------------------------------------------------------
+#include "SVHBenchmarkRunner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace driver_svh {
+namespace benchmark {
+
+bool BenchmarkOptions::parse(int argc, char* argv[], const std::string& extra_usage)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool has_value  = (i + 1 < argc);
+
+    if (arg == "--min-time" && has_value)
+    {
+      min_time = std::chrono::nanoseconds(static_cast<int64_t>(std::atof(argv[++i]) * 1e9));
+    }
+    else if (arg == "--repetitions" && has_value)
+    {
+      repetitions = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+    }
+    else if (arg == "--filter" && has_value)
+    {
+      filter = argv[++i];
+    }
+    else if (arg == "--output" && has_value)
+    {
+      output = argv[++i];
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [options]" << std::endl
+                << "  --min-time SECONDS   minimal duration of one repetition (default 0.2)"
+                << std::endl
+                << "  --repetitions N      measured repetitions per benchmark (default 5)"
+                << std::endl
+                << "  --filter STRING      only run benchmarks whose name contains STRING"
+                << std::endl
+                << "  --output FILE        write results as JSON to FILE, '-' for stdout"
+                << std::endl
+                << extra_usage;
+      return false;
+    }
+  }
+  return true;
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options)
+  : m_options(options)
+{
+}
+
+bool BenchmarkRunner::isSelected(const std::string& name) const
+{
+  return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+}
+
+double BenchmarkRunner::measure(const BenchmarkFunction& function, uint64_t iterations) const
+{
+  auto start = std::chrono::steady_clock::now();
+  function(iterations);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void BenchmarkRunner::run(const std::string& name,
+                          double bytes_per_op,
+                          const BenchmarkFunction& function)
+{
+  if (!isSelected(name))
+  {
+    return;
+  }
+
+  BenchmarkResult result;
+  result.name             = name;
+  result.iterations       = 0;
+  result.ns_per_op_median = 0.0;
+  result.ns_per_op_min    = 0.0;
+  result.ns_per_op_max    = 0.0;
+  result.bytes_per_op     = bytes_per_op;
+
+  try
+  {
+    // Grow the iteration count until a run takes a noticeable fraction of the minimal time and
+    // extrapolate from there
+    const double min_time = static_cast<double>(m_options.min_time.count());
+    uint64_t iterations   = 1;
+    double elapsed        = measure(function, iterations);
+    while (elapsed < min_time / 10.0 && iterations < (uint64_t(1) << 40))
+    {
+      iterations *= 10;
+      elapsed = measure(function, iterations);
+    }
+    if (elapsed < min_time)
+    {
+      iterations = std::max<uint64_t>(
+        1, static_cast<uint64_t>(static_cast<double>(iterations) * min_time / elapsed));
+    }
+
+    std::vector<double> ns_per_op;
+    for (unsigned int i = 0; i < m_options.repetitions; ++i)
+    {
+      ns_per_op.push_back(measure(function, iterations) / static_cast<double>(iterations));
+    }
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+
+    result.iterations       = iterations;
+    result.ns_per_op_median = ns_per_op[ns_per_op.size() / 2];
+    result.ns_per_op_min    = ns_per_op.front();
+    result.ns_per_op_max    = ns_per_op.back();
+
+    std::cerr << std::left << std::setw(48) << name << std::right << std::setw(14) << std::fixed
+              << std::setprecision(1) << result.ns_per_op_median << " ns/op";
+    if (bytes_per_op > 0)
+    {
+      std::cerr << std::setw(12) << std::setprecision(2)
+                << bytes_per_op / result.ns_per_op_median * 1e3 << " MB/s";
+    }
+    std::cerr << std::endl;
+  }
+  catch (const std::exception& e)
+  {
+    result.error = e.what();
+    std::cerr << std::left << std::setw(48) << name << " FAILED: " << e.what() << std::endl;
+  }
+
+  m_results.push_back(result);
+}
+
+bool BenchmarkRunner::hasErrors() const
+{
+  return std::any_of(m_results.begin(), m_results.end(), [](const BenchmarkResult& result) {
+    return !result.error.empty();
+  });
+}
+
+bool BenchmarkRunner::writeJson(const std::string& suite) const
+{
+  if (m_options.output.empty())
+  {
+    return true;
+  }
+  if (m_options.output == "-")
+  {
+    writeJson(std::cout, suite);
+    return true;
+  }
+
+  std::ofstream file(m_options.output);
+  if (!file)
+  {
+    std::cerr << "Could not open output file " << m_options.output << std::endl;
+    return false;
+  }
+  writeJson(file, suite);
+  return static_cast<bool>(file);
+}
+
+void BenchmarkRunner::writeJson(std::ostream& o, const std::string& suite) const
+{
+  char timestamp[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+  o << std::setprecision(6) << std::defaultfloat;
+  o << "{" << std::endl;
+  o << "  \"suite\": \"" << jsonEscape(suite) << "\"," << std::endl;
+  o << "  \"library_version\": \"" << SVH_BENCHMARK_LIBRARY_VERSION << "\"," << std::endl;
+  o << "  \"timestamp\": \"" << timestamp << "\"," << std::endl;
+  o << "  \"min_time_s\": " << static_cast<double>(m_options.min_time.count()) * 1e-9 << ","
+    << std::endl;
+  o << "  \"repetitions\": " << m_options.repetitions << "," << std::endl;
+  o << "  \"benchmarks\": [";
+  for (size_t i = 0; i < m_results.size(); ++i)
+  {
+    const BenchmarkResult& result = m_results[i];
+    o << (i == 0 ? "" : ",") << std::endl;
+    o << "    {\"name\": \"" << jsonEscape(result.name) << "\"";
+    if (!result.error.empty())
+    {
+      o << ", \"error\": \"" << jsonEscape(result.error) << "\"}";
+      continue;
+    }
+    double ops_per_second = (result.ns_per_op_median > 0) ? 1e9 / result.ns_per_op_median : 0.0;
+    o << ", \"iterations\": " << result.iterations
+      << ", \"ns_per_op\": {\"median\": " << result.ns_per_op_median
+      << ", \"min\": " << result.ns_per_op_min << ", \"max\": " << result.ns_per_op_max << "}"
+      << ", \"ops_per_second\": " << ops_per_second;
+    if (result.bytes_per_op > 0)
+    {
+      o << ", \"bytes_per_second\": " << ops_per_second * result.bytes_per_op;
+    }
+    o << "}";
+  }
+  o << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+std::string jsonEscape(const std::string& value)
+{
+  std::ostringstream escaped;
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        escaped << "\\\"";
+        break;
+      case '\\':
+        escaped << "\\\\";
+        break;
+      case '\n':
+        escaped << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                  << std::dec << std::setfill(' ');
+        }
+        else
+        {
+          escaped << c;
+        }
+    }
+  }
+  return escaped.str();
+}
+
+} // namespace benchmark
+} // namespace driver_svh
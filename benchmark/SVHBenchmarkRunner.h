@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains a small timing harness for the micro benchmarks of
+ * the library. Each benchmark is calibrated to run for a minimal time,
+ * repeated a couple of times and the results can be written as JSON so
+ * that they can be compared between library versions.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_BENCHMARK_RUNNER_H_INCLUDED
+#define DRIVER_SVH_SVH_BENCHMARK_RUNNER_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+namespace benchmark {
+
+//! Keeps the compiler from optimizing away the computation of \a value
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+//! Benchmark body, has to execute the measured operation \a iterations times
+using BenchmarkFunction = std::function<void(uint64_t iterations)>;
+
+/*!
+ * \brief Options of a benchmark run, usually given on the command line
+ */
+struct BenchmarkOptions
+{
+  //! Minimal time one repetition of a benchmark should take
+  std::chrono::nanoseconds min_time = std::chrono::milliseconds(200);
+  //! Number of measured repetitions per benchmark
+  unsigned int repetitions = 5;
+  //! Only benchmarks whose name contains this string are run
+  std::string filter;
+  //! File to write the JSON results to, "-" for stdout and empty for no JSON output
+  std::string output;
+
+  /*!
+   * \brief parse reads the options from the command line
+   * \param argc number of arguments
+   * \param argv arguments as given to main
+   * \param extra_usage additional lines printed with the usage message
+   * \return false if the program should exit, e.g. on invalid arguments or --help
+   */
+  bool parse(int argc, char* argv[], const std::string& extra_usage = "");
+};
+
+/*!
+ * \brief Result of a single benchmark, all times are given per operation
+ */
+struct BenchmarkResult
+{
+  std::string name;
+  uint64_t iterations;
+  double ns_per_op_median;
+  double ns_per_op_min;
+  double ns_per_op_max;
+  //! Number of bytes processed per operation, 0 if not applicable
+  double bytes_per_op;
+  //! Error message if the benchmark could not be run
+  std::string error;
+};
+
+/*!
+ * \brief Runs benchmarks and collects their results
+ */
+class BenchmarkRunner
+{
+public:
+  explicit BenchmarkRunner(const BenchmarkOptions& options);
+
+  /*!
+   * \brief run calibrates and measures a benchmark, the result is printed to stderr
+   * \param name unique name of the benchmark, e.g. "encode/SVHControlCommand"
+   * \param bytes_per_op bytes processed per operation, used to report a throughput
+   * \param function benchmark body
+   * \note Exceptions thrown by the body are recorded as error of the benchmark
+   */
+  void run(const std::string& name, double bytes_per_op, const BenchmarkFunction& function);
+
+  //! Whether a benchmark of the given name would be run with the current filter
+  bool isSelected(const std::string& name) const;
+
+  //! Results of all benchmarks run so far
+  const std::vector<BenchmarkResult>& results() const { return m_results; }
+
+  //! Whether at least one benchmark failed
+  bool hasErrors() const;
+
+  /*!
+   * \brief writeJson writes all results to the output given in the options
+   * \param suite name of the benchmark suite that is stored with the results
+   * \return false if the output file could not be written
+   */
+  bool writeJson(const std::string& suite) const;
+
+  //! Writes all results as JSON document to the stream
+  void writeJson(std::ostream& o, const std::string& suite) const;
+
+private:
+  //! Measures the duration of \a iterations executions in nanoseconds
+  double measure(const BenchmarkFunction& function, uint64_t iterations) const;
+
+  BenchmarkOptions m_options;
+
+  std::vector<BenchmarkResult> m_results;
+};
+
+//! Escapes a string to be used as JSON string value
+std::string jsonEscape(const std::string& value);
+
+} // namespace benchmark
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,518 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * Stress test of the receiving side under a degraded link. Known frames
+ * are sent through an in-process pipe and an SVHFaultInjectionTransport
+ * into an unmodified SVHReceiveThread, once for every noise level. For
+ * each level the benchmark reports how many intact frames were recovered,
+ * how long the decoder needed to find the next frame after a damaged one
+ * and how many damaged frames were accepted as valid.
+ */
+//----------------------------------------------------------------------
+#include "SVHBenchmarkRunner.h"
+#include "SVHFaultInjectionTransport.h"
+
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHReceiveThread.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct StressOptions
+{
+  //! frames sent per noise level
+  uint64_t frames = 200000;
+  //! byte error rates to test, see faultSettings
+  std::vector<double> levels = {0.0, 1e-5, 1e-4, 1e-3, 1e-2};
+  //! largest partial read, 0 disables partial reads
+  size_t max_read = 16;
+  //! time a burst holds back frames
+  std::chrono::microseconds burst_delay{2000};
+  uint32_t seed = 1;
+  //! JSON output file, "-" for stdout
+  std::string output;
+
+  // Thresholds checked at every level, negative disables the check
+  double min_recovered_percent = -1.0;
+  double max_false_accept_rate = -1.0;
+};
+
+//! Results of a single noise level
+struct LevelResult
+{
+  double level;
+  SVHFaultStatistics faults;
+  SVHReceiveStatistics receive;
+  uint64_t intact        = 0;
+  uint64_t recovered     = 0;
+  uint64_t duplicates    = 0;
+  uint64_t false_payload = 0;
+  uint64_t false_header  = 0;
+  double duration_s      = 0.0;
+  //! intact frames lost in front of the next accepted frame after a damaged one
+  double lost_per_damage = 0.0;
+  std::vector<double> resync_us;
+
+  double recoveredPercent() const
+  {
+    return intact > 0 ? 100.0 * static_cast<double>(recovered) / static_cast<double>(intact)
+                      : 100.0;
+  }
+
+  double falseAcceptRate() const
+  {
+    return faults.damaged_frames > 0 ? static_cast<double>(false_payload + false_header) /
+                                         static_cast<double>(faults.damaged_frames)
+                                     : 0.0;
+  }
+
+  double resyncPercentile(double p) const
+  {
+    if (resync_us.empty())
+    {
+      return 0.0;
+    }
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(resync_us.size() - 1));
+    return resync_us[index];
+  }
+};
+
+//! Fault mix of a noise level: bit errors at the given rate, fewer lost bytes and more frame
+//! level faults, as seen on long cables where disturbances hit several bytes at once
+SVHFaultSettings faultSettings(const StressOptions& options, double level)
+{
+  SVHFaultSettings settings;
+  settings.corrupt_probability   = level;
+  settings.drop_probability      = level / 4;
+  settings.duplicate_probability = std::min(1.0, level * 10);
+  settings.burst_probability     = std::min(1.0, level * 10);
+  settings.burst_delay           = options.burst_delay;
+  settings.max_read_size         = options.max_read;
+  settings.seed                  = options.seed;
+  return settings;
+}
+
+//! Payload byte \a i of frame \a sequence, the first four bytes hold the sequence number
+uint8_t payloadByte(uint32_t sequence, size_t i)
+{
+  if (i < 4)
+  {
+    return static_cast<uint8_t>(sequence >> (8 * i));
+  }
+  return static_cast<uint8_t>((sequence * 2654435761u + static_cast<uint32_t>(i) * 40503u) >> 24);
+}
+
+uint8_t frameAddress(uint32_t sequence)
+{
+  return static_cast<uint8_t>(((sequence % SVH_DIMENSION) << 4) | SVH_GET_CONTROL_FEEDBACK);
+}
+
+//! Serializes frame \a sequence like the hand does
+void buildFrame(uint32_t sequence, std::vector<uint8_t>& frame)
+{
+  frame.assign(C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE, 0);
+  frame[0]         = PACKET_HEADER1;
+  frame[1]         = PACKET_HEADER2;
+  frame[2]         = static_cast<uint8_t>(sequence % 255);
+  frame[3]         = frameAddress(sequence);
+  frame[4]         = static_cast<uint8_t>(C_MAXIMUM_PACKET_SIZE);
+  frame[5]         = 0;
+  uint8_t checksum = 0;
+  uint8_t parity   = 0;
+  for (size_t i = 0; i < C_MAXIMUM_PACKET_SIZE; ++i)
+  {
+    frame[6 + i] = payloadByte(sequence, i);
+    checksum += frame[6 + i];
+    parity ^= frame[6 + i];
+  }
+  frame[6 + C_MAXIMUM_PACKET_SIZE] = checksum;
+  frame[7 + C_MAXIMUM_PACKET_SIZE] = parity;
+}
+
+bool runLevel(const StressOptions& options, double level, LevelResult& result)
+{
+  std::shared_ptr<SVHPipeTransport> sender;
+  std::shared_ptr<SVHPipeTransport> receiver_end;
+  if (!SVHPipeTransport::createPair(sender, receiver_end, 1 << 20))
+  {
+    std::cerr << "Could not create the pipe" << std::endl;
+    return false;
+  }
+  auto faulty =
+    std::make_shared<SVHFaultInjectionTransport>(receiver_end, faultSettings(options, level));
+
+  const size_t frames = static_cast<size_t>(options.frames);
+  std::vector<uint32_t> faults(frames, 0);
+  std::vector<Clock::time_point> delivered(frames);
+  std::vector<Clock::time_point> received(frames);
+  std::vector<bool> accepted(frames, false);
+
+  faulty->setObserver([&](uint64_t frame, uint32_t frame_faults) {
+    if (frame < frames)
+    {
+      faults[frame]    = frame_faults;
+      delivered[frame] = Clock::now();
+    }
+  });
+
+  // Every accepted packet is checked against what was sent
+  auto check = [&](const SVHSerialPacket& packet, unsigned int) {
+    if (packet.data.size() != C_MAXIMUM_PACKET_SIZE)
+    {
+      result.false_header++;
+      return;
+    }
+    uint32_t sequence = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+      sequence |= static_cast<uint32_t>(packet.data[i]) << (8 * i);
+    }
+    bool payload_ok = sequence < frames;
+    for (size_t i = 4; payload_ok && i < packet.data.size(); ++i)
+    {
+      payload_ok = packet.data[i] == payloadByte(sequence, i);
+    }
+    if (!payload_ok)
+    {
+      result.false_payload++;
+    }
+    else if (packet.index != sequence % 255 || packet.address != frameAddress(sequence))
+    {
+      // Index and address are not covered by the checksum
+      result.false_header++;
+    }
+    else if (accepted[sequence])
+    {
+      result.duplicates++;
+    }
+    else
+    {
+      accepted[sequence] = true;
+      received[sequence] = Clock::now();
+    }
+  };
+
+  SVHReceiveThread receiver(std::chrono::microseconds(1000), faulty, check, 256, RS_BLOCKING);
+  std::thread receive_thread([&] { receiver.run(); });
+
+  const Clock::time_point start = Clock::now();
+  std::vector<uint8_t> frame;
+  for (size_t sequence = 0; sequence < frames; ++sequence)
+  {
+    buildFrame(static_cast<uint32_t>(sequence), frame);
+    size_t written = 0;
+    while (written < frame.size())
+    {
+      struct iovec buffer = {frame.data() + written, frame.size() - written};
+      ssize_t bytes       = sender->writev(&buffer, 1);
+      if (bytes < 0)
+      {
+        sender->waitWritable(10000);
+        continue;
+      }
+      written += static_cast<size_t>(bytes);
+    }
+  }
+
+  // Done when all frames were read and nothing arrived for longer than a burst
+  uint64_t last_bytes        = 0;
+  Clock::time_point progress = Clock::now();
+  while (Clock::now() - progress < options.burst_delay + std::chrono::milliseconds(100))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    uint64_t bytes = receiver.statistics().bytes;
+    if (bytes != last_bytes || faulty->statistics().frames < options.frames)
+    {
+      last_bytes = bytes;
+      progress   = Clock::now();
+    }
+  }
+  receiver.stop();
+  receive_thread.join();
+
+  result.level   = level;
+  result.faults  = faulty->statistics();
+  result.receive = receiver.statistics();
+
+  Clock::time_point last = start;
+  for (size_t i = 0; i < frames; ++i)
+  {
+    if (!(faults[i] & (FF_CORRUPTED | FF_DROPPED)))
+    {
+      result.intact++;
+      result.recovered += accepted[i] ? 1 : 0;
+    }
+    if (accepted[i])
+    {
+      last = std::max(last, received[i]);
+    }
+  }
+  result.duration_s = std::chrono::duration<double>(last - start).count();
+
+  // Walk backwards to know the next accepted frame behind every damaged one
+  size_t next_accepted = frames;
+  uint64_t lost_intact = 0;
+  uint64_t lost_total  = 0;
+  uint64_t damaged     = 0;
+  for (size_t i = frames; i-- > 0;)
+  {
+    if (faults[i] & (FF_CORRUPTED | FF_DROPPED))
+    {
+      damaged++;
+      lost_total += lost_intact;
+      if (next_accepted < frames)
+      {
+        auto resync = received[next_accepted] - delivered[i];
+        result.resync_us.push_back(
+          std::max(0.0, std::chrono::duration<double, std::micro>(resync).count()));
+      }
+    }
+    if (accepted[i])
+    {
+      next_accepted = i;
+      lost_intact   = 0;
+    }
+    else if (!(faults[i] & (FF_CORRUPTED | FF_DROPPED)))
+    {
+      lost_intact++;
+    }
+  }
+  result.lost_per_damage =
+    damaged > 0 ? static_cast<double>(lost_total) / static_cast<double>(damaged) : 0.0;
+  std::sort(result.resync_us.begin(), result.resync_us.end());
+  return true;
+}
+
+bool parseLevels(const std::string& spec, std::vector<double>& levels)
+{
+  std::vector<double> parsed;
+  std::istringstream stream(spec);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    char* end    = nullptr;
+    double value = std::strtod(item.c_str(), &end);
+    if (item.empty() || *end != '\0' || value < 0 || value > 1)
+    {
+      return false;
+    }
+    parsed.push_back(value);
+  }
+  if (parsed.empty())
+  {
+    return false;
+  }
+  levels = parsed;
+  return true;
+}
+
+bool parseOptions(int argc, char* argv[], StressOptions& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool has_value  = i + 1 < argc;
+
+    if (arg == "--frames" && has_value && std::atoll(argv[i + 1]) > 0)
+    {
+      options.frames = static_cast<uint64_t>(std::atoll(argv[++i]));
+    }
+    else if (arg == "--levels" && has_value && parseLevels(argv[++i], options.levels))
+    {
+    }
+    else if (arg == "--max-read" && has_value)
+    {
+      options.max_read = static_cast<size_t>(std::atoll(argv[++i]));
+    }
+    else if (arg == "--burst-delay-us" && has_value)
+    {
+      options.burst_delay = std::chrono::microseconds(std::atol(argv[++i]));
+    }
+    else if (arg == "--seed" && has_value)
+    {
+      options.seed = static_cast<uint32_t>(std::atol(argv[++i]));
+    }
+    else if (arg == "--output" && has_value)
+    {
+      options.output = argv[++i];
+    }
+    else if (arg == "--min-recovered-percent" && has_value)
+    {
+      options.min_recovered_percent = std::atof(argv[++i]);
+    }
+    else if (arg == "--max-false-accept-rate" && has_value)
+    {
+      options.max_false_accept_rate = std::atof(argv[++i]);
+    }
+    else
+    {
+      std::cerr
+        << "Usage: " << argv[0] << " [options]" << std::endl
+        << "  --frames N                     frames sent per noise level (default 200000)"
+        << std::endl
+        << "  --levels LIST                  byte error rates, e.g. 0,1e-4,1e-2 (default "
+        << "0,1e-5,1e-4,1e-3,1e-2)" << std::endl
+        << "                                 a quarter of it drops bytes, ten times of it "
+        << "duplicates frames and starts bursts" << std::endl
+        << "  --max-read N                   largest partial read, 0 disables (default 16)"
+        << std::endl
+        << "  --burst-delay-us US            time a burst holds frames back (default 2000)"
+        << std::endl
+        << "  --seed N                       seed of the injected faults (default 1)"
+        << std::endl
+        << "  --output FILE                  write results as JSON to FILE, '-' for stdout"
+        << std::endl
+        << "  --min-recovered-percent P      intact frames that have to be received" << std::endl
+        << "  --max-false-accept-rate R      damaged frames that may be accepted" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  StressOptions options;
+  if (!parseOptions(argc, argv, options))
+  {
+    return 1;
+  }
+
+  std::vector<LevelResult> results;
+  bool passed = true;
+  std::cerr << std::setw(8) << "level" << std::setw(10) << "damaged" << std::setw(12)
+            << "recovered" << std::setw(12) << "frames/s" << std::setw(10) << "lost/dmg"
+            << std::setw(14) << "resync p50" << std::setw(14) << "resync p99" << std::setw(16)
+            << "false acc p/h" << std::endl;
+  for (double level : options.levels)
+  {
+    LevelResult result;
+    if (!runLevel(options, level, result))
+    {
+      return 1;
+    }
+
+    bool level_passed = true;
+    if (options.min_recovered_percent >= 0 &&
+        result.recoveredPercent() < options.min_recovered_percent)
+    {
+      level_passed = false;
+    }
+    if (options.max_false_accept_rate >= 0 &&
+        result.falseAcceptRate() > options.max_false_accept_rate)
+    {
+      level_passed = false;
+    }
+    passed = passed && level_passed;
+
+    std::cerr << std::setw(8) << std::setprecision(0) << std::scientific << level << std::fixed
+              << std::setw(10) << result.faults.damaged_frames << std::setw(11)
+              << std::setprecision(3) << result.recoveredPercent() << "%" << std::setw(12)
+              << std::setprecision(0)
+              << (result.duration_s > 0 ? result.recovered / result.duration_s : 0.0)
+              << std::setw(10) << std::setprecision(3) << result.lost_per_damage << std::setw(11)
+              << std::setprecision(1) << result.resyncPercentile(50) << " us" << std::setw(11)
+              << result.resyncPercentile(99) << " us" << std::setw(9) << result.false_payload
+              << " /" << std::setw(5) << result.false_header << (level_passed ? "" : "  FAILED")
+              << std::endl;
+    results.push_back(result);
+  }
+
+  if (!options.output.empty())
+  {
+    std::ofstream file;
+    if (options.output != "-")
+    {
+      file.open(options.output);
+      if (!file)
+      {
+        std::cerr << "Could not open output file " << options.output << std::endl;
+        return 1;
+      }
+    }
+    std::ostream& o = (options.output == "-") ? std::cout : file;
+
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    o << std::setprecision(6) << std::defaultfloat;
+    o << "{" << std::endl;
+    o << "  \"suite\": \"fault_stress\"," << std::endl;
+    o << "  \"library_version\": \"" << SVH_BENCHMARK_LIBRARY_VERSION << "\"," << std::endl;
+    o << "  \"timestamp\": \"" << timestamp << "\"," << std::endl;
+    o << "  \"settings\": {\"frames\": " << options.frames << ", \"max_read\": "
+      << options.max_read << ", \"burst_delay_us\": " << options.burst_delay.count()
+      << ", \"seed\": " << options.seed << "}," << std::endl;
+    o << "  \"levels\": [" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      const LevelResult& r = results[i];
+      o << "    {\"level\": " << r.level << ", \"frames\": " << r.faults.frames
+        << ", \"damaged\": " << r.faults.damaged_frames
+        << ", \"corrupted_bytes\": " << r.faults.corrupted_bytes
+        << ", \"dropped_bytes\": " << r.faults.dropped_bytes
+        << ", \"duplicated\": " << r.faults.duplicated_frames
+        << ", \"bursts\": " << r.faults.bursts << ", \"partial_reads\": " << r.faults.partial_reads
+        << ", \"intact\": " << r.intact << ", \"recovered\": " << r.recovered
+        << ", \"recovered_percent\": " << r.recoveredPercent()
+        << ", \"recovered_rate_hz\": " << (r.duration_s > 0 ? r.recovered / r.duration_s : 0.0)
+        << ", \"lost_intact_per_damage\": " << r.lost_per_damage
+        << ", \"resync_us\": {\"count\": " << r.resync_us.size()
+        << ", \"p50\": " << r.resyncPercentile(50) << ", \"p99\": " << r.resyncPercentile(99)
+        << ", \"max\": " << r.resyncPercentile(100) << "}"
+        << ", \"duplicates_delivered\": " << r.duplicates
+        << ", \"false_accepts_payload\": " << r.false_payload
+        << ", \"false_accepts_header\": " << r.false_header
+        << ", \"false_accept_rate\": " << r.falseAcceptRate()
+        << ", \"checksum_errors\": " << r.receive.checksum_errors
+        << ", \"skipped_bytes\": " << r.receive.skipped_bytes << "}"
+        << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    o << "  ]," << std::endl;
+    o << "  \"passed\": " << (passed ? "true" : "false") << std::endl;
+    o << "}" << std::endl;
+  }
+
+  return passed ? 0 : 1;
+}
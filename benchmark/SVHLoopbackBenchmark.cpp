@@ -0,0 +1,773 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * End-to-end benchmark of the complete library stack. The unmodified
+ * SVHFingerManager, SVHController, SVHSerialInterface and Serial talk to
+ * the SVHSimulator through a pseudo terminal, so everything that is
+ * measured here is overhead of the library (plus the kernel's terminal
+ * layer) and not of the hand. The terminal can be replaced by an
+ * in-process pipe or a socket pair to measure the library alone.
+ *
+ * Measured are the latency from an API call until its answer is visible
+ * to the application, the age of the feedback available to the
+ * application, the achievable command rate and the CPU usage of every
+ * thread. Thresholds can be given to turn the benchmark into a
+ * regression check.
+ */
+//----------------------------------------------------------------------
+#include "SVHBenchmarkRunner.h"
+#include "SVHSimulator.h"
+
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHTrace.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHSocketTransport.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <pthread.h>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace driver_svh;
+using driver_svh::benchmark::jsonEscape;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+//! Kinds of commands the benchmark issues through the finger manager
+enum CommandKind
+{
+  CK_TARGET,     //!< setTargetPosition of a single channel
+  CK_TARGET_ALL, //!< setAllTargetPositions
+  CK_FEEDBACK,   //!< requestControllerFeedback of a single channel
+  CK_DIMENSION
+};
+
+const char* const C_COMMAND_NAMES[CK_DIMENSION] = {"target", "all", "feedback"};
+
+struct LoopbackOptions
+{
+  //! duration of each measurement phase in seconds
+  double duration = 2.0;
+  //! command rate of the throughput phase in Hz, 0 sends as fast as possible
+  double rate = 0.0;
+  //! relative weights of the command kinds
+  std::array<unsigned int, CK_DIMENSION> mix = {{1, 1, 1}};
+  //! speed scale of the simulated hand, makes homing faster
+  double speed_scale = 50.0;
+  //! JSON output file, "-" for stdout
+  std::string output;
+  //! connection to the simulated hand: "pty", "pipe" or "socket"
+  std::string transport = "pty";
+  //! gap between two frames in us, negative keeps the default of the transport options
+  long gap_us = -1;
+  //! frames waiting for their reply at a time, 0 paces by the gap
+  unsigned int window = 0;
+  //! Chrome trace file of connect, homing and the measurement, empty disables tracing
+  std::string trace;
+
+  // Thresholds, 0 disables the check
+  double max_latency_p99_us      = 0.0;
+  double max_feedback_age_p99_ms = 0.0;
+  double min_command_rate        = 0.0;
+  double max_thread_cpu          = 0.0;
+};
+
+//! Collects samples and reports percentiles
+class Distribution
+{
+public:
+  void add(double value) { m_samples.push_back(value); }
+
+  size_t count() const { return m_samples.size(); }
+
+  double percentile(double p)
+  {
+    if (m_samples.empty())
+    {
+      return 0.0;
+    }
+    std::sort(m_samples.begin(), m_samples.end());
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(m_samples.size() - 1));
+    return m_samples[index];
+  }
+
+  void writeJson(std::ostream& o)
+  {
+    o << "{\"count\": " << count() << ", \"p50\": " << percentile(50)
+      << ", \"p90\": " << percentile(90) << ", \"p99\": " << percentile(99)
+      << ", \"max\": " << percentile(100) << "}";
+  }
+
+private:
+  std::vector<double> m_samples;
+};
+
+//! Records when answers to the issued commands arrive, fed by packet observers
+struct EchoTracker
+{
+  std::array<std::atomic<uint64_t>, CK_DIMENSION> count;
+  std::array<std::atomic<int64_t>, CK_DIMENSION> last_ns;
+  //! reception time of the last packet carrying feedback of all channels
+  std::atomic<int64_t> feedback_ns;
+
+  EchoTracker()
+    : feedback_ns(0)
+  {
+    for (size_t i = 0; i < CK_DIMENSION; ++i)
+    {
+      count[i]   = 0;
+      last_ns[i] = 0;
+    }
+  }
+
+  static int64_t now() { return Clock::now().time_since_epoch().count(); }
+
+  void echo(CommandKind kind)
+  {
+    last_ns[kind] = now();
+    count[kind]++;
+  }
+};
+
+//! CPU time of a thread as read from /proc
+struct ThreadTimes
+{
+  std::string name;
+  uint64_t ticks;
+};
+
+std::map<std::string, ThreadTimes> readThreadTimes()
+{
+  std::map<std::string, ThreadTimes> times;
+  DIR* tasks = opendir("/proc/self/task");
+  if (tasks == nullptr)
+  {
+    return times;
+  }
+  while (dirent* entry = readdir(tasks))
+  {
+    if (entry->d_name[0] == '.')
+    {
+      continue;
+    }
+    std::ifstream file(std::string("/proc/self/task/") + entry->d_name + "/stat");
+    std::string stat((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t open  = stat.find('(');
+    size_t close = stat.rfind(')');
+    if (open == std::string::npos || close == std::string::npos)
+    {
+      continue;
+    }
+
+    // After the name: state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt cmajflt
+    // utime stime
+    std::istringstream fields(stat.substr(close + 2));
+    std::string field;
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    for (int i = 0; i < 13 && fields >> field; ++i)
+    {
+      if (i == 11)
+      {
+        utime = std::strtoull(field.c_str(), nullptr, 10);
+      }
+      if (i == 12)
+      {
+        stime = std::strtoull(field.c_str(), nullptr, 10);
+      }
+    }
+    times[entry->d_name] = ThreadTimes{stat.substr(open + 1, close - open - 1), utime + stime};
+  }
+  closedir(tasks);
+  return times;
+}
+
+//! CPU usage per thread name in percent of one core between two snapshots
+std::map<std::string, double> cpuUsage(const std::map<std::string, ThreadTimes>& before,
+                                       const std::map<std::string, ThreadTimes>& after,
+                                       double seconds)
+{
+  const double ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+  std::map<std::string, double> usage;
+  for (const auto& thread : after)
+  {
+    auto previous  = before.find(thread.first);
+    uint64_t ticks = thread.second.ticks - (previous != before.end() ? previous->second.ticks : 0);
+    double percent = static_cast<double>(ticks) / ticks_per_second / seconds * 100.0;
+    usage[thread.second.name] += percent;
+  }
+  return usage;
+}
+
+bool parseMix(const std::string& spec, std::array<unsigned int, CK_DIMENSION>& mix)
+{
+  std::array<unsigned int, CK_DIMENSION> parsed = {{0, 0, 0}};
+  std::istringstream entries(spec);
+  std::string entry;
+  while (std::getline(entries, entry, ','))
+  {
+    size_t colon     = entry.find(':');
+    std::string name = entry.substr(0, colon);
+    int weight       = (colon == std::string::npos) ? 1 : std::atoi(entry.c_str() + colon + 1);
+    auto kind        = std::find(std::begin(C_COMMAND_NAMES), std::end(C_COMMAND_NAMES), name);
+    if (kind == std::end(C_COMMAND_NAMES) || weight < 0)
+    {
+      return false;
+    }
+    parsed[kind - std::begin(C_COMMAND_NAMES)] = static_cast<unsigned int>(weight);
+  }
+  if (parsed[CK_TARGET] + parsed[CK_TARGET_ALL] + parsed[CK_FEEDBACK] == 0)
+  {
+    return false;
+  }
+  mix = parsed;
+  return true;
+}
+
+bool parseOptions(int argc, char* argv[], LoopbackOptions& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool has_value  = (i + 1 < argc);
+
+    if (arg == "--duration" && has_value)
+    {
+      options.duration = std::atof(argv[++i]);
+    }
+    else if (arg == "--rate" && has_value)
+    {
+      options.rate = std::atof(argv[++i]);
+    }
+    else if (arg == "--mix" && has_value && parseMix(argv[++i], options.mix))
+    {
+    }
+    else if (arg == "--speed-scale" && has_value)
+    {
+      options.speed_scale = std::atof(argv[++i]);
+    }
+    else if (arg == "--transport" && has_value &&
+             (std::string(argv[i + 1]) == "pty" || std::string(argv[i + 1]) == "pipe" ||
+              std::string(argv[i + 1]) == "socket"))
+    {
+      options.transport = argv[++i];
+    }
+    else if (arg == "--gap" && has_value)
+    {
+      options.gap_us = std::atol(argv[++i]);
+    }
+    else if (arg == "--window" && has_value)
+    {
+      options.window = static_cast<unsigned int>(std::atol(argv[++i]));
+    }
+    else if (arg == "--output" && has_value)
+    {
+      options.output = argv[++i];
+    }
+    else if (arg == "--trace" && has_value)
+    {
+      options.trace = argv[++i];
+    }
+    else if (arg == "--max-latency-p99-us" && has_value)
+    {
+      options.max_latency_p99_us = std::atof(argv[++i]);
+    }
+    else if (arg == "--max-feedback-age-p99-ms" && has_value)
+    {
+      options.max_feedback_age_p99_ms = std::atof(argv[++i]);
+    }
+    else if (arg == "--min-command-rate" && has_value)
+    {
+      options.min_command_rate = std::atof(argv[++i]);
+    }
+    else if (arg == "--max-thread-cpu" && has_value)
+    {
+      options.max_thread_cpu = std::atof(argv[++i]);
+    }
+    else
+    {
+      std::cerr
+        << "Usage: " << argv[0] << " [options]" << std::endl
+        << "  --duration SECONDS            duration of each measurement phase (default 2)"
+        << std::endl
+        << "  --rate HZ                     command rate of the throughput phase, 0 = maximum"
+        << std::endl
+        << "  --mix SPEC                    command mix, e.g. target:2,all:1,feedback:1"
+        << std::endl
+        << "  --speed-scale FACTOR          speed of the simulated hand (default 50)" << std::endl
+        << "  --transport pty|pipe|socket   connection to the simulated hand (default pty)"
+        << std::endl
+        << "  --gap US                      gap between two frames, pipe and socket accept 0"
+        << std::endl
+        << "  --window FRAMES               pace by replies with FRAMES in flight, use a short gap"
+        << std::endl
+        << "  --output FILE                 write results as JSON to FILE, '-' for stdout"
+        << std::endl
+        << "  --trace FILE                  write a Chrome trace of the run to FILE" << std::endl
+        << "Thresholds, the program exits with 1 if one is violated:" << std::endl
+        << "  --max-latency-p99-us US       99th percentile of the command to echo latency"
+        << std::endl
+        << "  --max-feedback-age-p99-ms MS  99th percentile of the feedback age" << std::endl
+        << "  --min-command-rate HZ         achieved command rate of the throughput phase"
+        << std::endl
+        << "  --max-thread-cpu PERCENT      CPU usage of each library thread" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief Issues commands through the finger manager according to the configured mix
+ */
+class CommandIssuer
+{
+public:
+  CommandIssuer(SVHFingerManager& finger_manager, const std::array<unsigned int, CK_DIMENSION>& mix)
+    : m_finger_manager(finger_manager)
+    , m_mix(mix)
+    , m_step(0)
+  {
+    m_mix_total = mix[CK_TARGET] + mix[CK_TARGET_ALL] + mix[CK_FEEDBACK];
+  }
+
+  //! Kind of the next command
+  CommandKind next() const
+  {
+    unsigned int slot = static_cast<unsigned int>(m_step % m_mix_total);
+    if (slot < m_mix[CK_TARGET])
+    {
+      return CK_TARGET;
+    }
+    if (slot < m_mix[CK_TARGET] + m_mix[CK_TARGET_ALL])
+    {
+      return CK_TARGET_ALL;
+    }
+    return CK_FEEDBACK;
+  }
+
+  //! Sends the next command, alternating between channels and two target positions
+  bool issue(CommandKind kind)
+  {
+    SVHChannel channel = static_cast<SVHChannel>(m_step % SVH_DIMENSION);
+    double position    = ((m_step / SVH_DIMENSION) % 2) ? 0.1 : 0.3;
+    m_step++;
+
+    switch (kind)
+    {
+      case CK_TARGET:
+        return m_finger_manager.setTargetPosition(channel, position, 0.0);
+      case CK_TARGET_ALL:
+        return m_finger_manager.setAllTargetPositions(std::vector<double>(SVH_DIMENSION, position));
+      default:
+        return m_finger_manager.requestControllerFeedback(channel);
+    }
+  }
+
+private:
+  SVHFingerManager& m_finger_manager;
+  std::array<unsigned int, CK_DIMENSION> m_mix;
+  unsigned int m_mix_total;
+  uint64_t m_step;
+};
+
+struct Threshold
+{
+  std::string name;
+  double limit;
+  double value;
+  bool passed;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  LoopbackOptions options;
+  if (!parseOptions(argc, argv, options))
+  {
+    return 1;
+  }
+  pthread_setname_np(pthread_self(), "bench-main");
+
+  // Start the simulated hand and connect the complete stack to it
+  SVHSimulatorSettings simulator_settings;
+  simulator_settings.speed_scale = options.speed_scale;
+  SVHSimulator simulator(simulator_settings);
+  std::shared_ptr<SVHTransport> library_end;
+  std::shared_ptr<SVHTransport> hand_end;
+  if (options.transport == "pipe")
+  {
+    std::shared_ptr<SVHPipeTransport> first;
+    std::shared_ptr<SVHPipeTransport> second;
+    if (!SVHPipeTransport::createPair(first, second))
+    {
+      std::cerr << "Could not create the transport to the simulated hand" << std::endl;
+      return 1;
+    }
+    library_end = first;
+    hand_end    = second;
+  }
+  else if (options.transport == "socket")
+  {
+    std::shared_ptr<SVHSocketTransport> first;
+    std::shared_ptr<SVHSocketTransport> second;
+    if (!SVHSocketTransport::createPair(first, second))
+    {
+      std::cerr << "Could not create the transport to the simulated hand" << std::endl;
+      return 1;
+    }
+    library_end = first;
+    hand_end    = second;
+  }
+  if (library_end ? !simulator.start(hand_end) : !simulator.start())
+  {
+    return 1;
+  }
+
+  // Only the newest 256k events are kept, older ones are overwritten
+  if (!options.trace.empty())
+  {
+    SVHTrace::start(1 << 18);
+  }
+
+  SVHFingerManager finger_manager;
+  if (options.gap_us >= 0 || options.window > 0)
+  {
+    SVHTransportOptions transport_options;
+    if (options.gap_us >= 0)
+    {
+      transport_options.transmission_gap = std::chrono::microseconds(options.gap_us);
+    }
+    transport_options.transmit_window = options.window;
+    finger_manager.setTransportOptions(transport_options);
+  }
+  if (library_end ? !finger_manager.connect(library_end)
+                  : !finger_manager.connect(simulator.deviceName()))
+  {
+    std::cerr << "Could not connect to the simulated hand" << std::endl;
+    return 1;
+  }
+
+  auto homing_start = Clock::now();
+  if (!finger_manager.resetChannel(SVH_ALL))
+  {
+    std::cerr << "Could not home the simulated hand" << std::endl;
+    return 1;
+  }
+  const double homing_s = std::chrono::duration<double>(Clock::now() - homing_start).count();
+  std::cerr << "Homing took " << homing_s << " s" << std::endl;
+
+  EchoTracker tracker;
+  finger_manager.addPacketObserver(SVH_SET_CONTROL_COMMAND,
+                                   [&](const SVHSerialPacket&) { tracker.echo(CK_TARGET); });
+  finger_manager.addPacketObserver(SVH_SET_CONTROL_COMMAND_ALL, [&](const SVHSerialPacket&) {
+    tracker.feedback_ns = EchoTracker::now();
+    tracker.echo(CK_TARGET_ALL);
+  });
+  finger_manager.addPacketObserver(SVH_GET_CONTROL_FEEDBACK,
+                                   [&](const SVHSerialPacket&) { tracker.echo(CK_FEEDBACK); });
+  finger_manager.addPacketObserver(SVH_GET_CONTROL_FEEDBACK_ALL, [&](const SVHSerialPacket&) {
+    tracker.feedback_ns = EchoTracker::now();
+  });
+
+  // Sample the age of the feedback the application sees during both measurement phases
+  Distribution feedback_age_ms;
+  std::atomic<bool> sampling(true);
+  std::thread sampler([&] {
+    pthread_setname_np(pthread_self(), "bench-sampler");
+    while (sampling)
+    {
+      int64_t last = tracker.feedback_ns;
+      if (last > 0)
+      {
+        feedback_age_ms.add(static_cast<double>(EchoTracker::now() - last) * 1e-6);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  auto cpu_before = readThreadTimes();
+  auto cpu_start  = Clock::now();
+
+  // Latency phase: one command at a time, wait for its answer
+  CommandIssuer issuer(finger_manager, options.mix);
+  std::array<Distribution, CK_DIMENSION> latency_us;
+  std::array<Distribution, CK_DIMENSION> api_call_us;
+  std::array<uint64_t, CK_DIMENSION> lost = {{0, 0, 0}};
+  auto phase_end = Clock::now() + std::chrono::duration<double>(options.duration);
+  while (Clock::now() < phase_end)
+  {
+    CommandKind kind = issuer.next();
+    uint64_t before  = tracker.count[kind];
+    // Measure from an idle link, not the pacing gap left by the previous command
+    std::this_thread::sleep_until(finger_manager.nextTransmissionTime());
+    auto start = Clock::now();
+    issuer.issue(kind);
+    api_call_us[kind].add(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+    auto timeout = Clock::now() + std::chrono::milliseconds(500);
+    while (tracker.count[kind] == before && Clock::now() < timeout)
+    {
+      std::this_thread::yield();
+    }
+    if (tracker.count[kind] == before)
+    {
+      lost[kind]++;
+      continue;
+    }
+    latency_us[kind].add(
+      static_cast<double>(tracker.last_ns[kind] - start.time_since_epoch().count()) * 1e-3);
+  }
+
+  // Throughput phase: send without waiting for answers, paced if a rate was given
+  uint64_t echoes_before = 0;
+  for (size_t i = 0; i < CK_DIMENSION; ++i)
+  {
+    echoes_before += tracker.count[i];
+  }
+  uint64_t sent         = 0;
+  auto throughput_start = Clock::now();
+  phase_end             = throughput_start + std::chrono::duration<double>(options.duration);
+  while (Clock::now() < phase_end)
+  {
+    issuer.issue(issuer.next());
+    sent++;
+    if (options.rate > 0)
+    {
+      auto offset = std::chrono::duration<double>(static_cast<double>(sent) / options.rate);
+      std::this_thread::sleep_until(throughput_start +
+                                    std::chrono::duration_cast<Clock::duration>(offset));
+    }
+  }
+  const double throughput_s =
+    std::chrono::duration<double>(Clock::now() - throughput_start).count();
+
+  // Give outstanding answers some time to arrive
+  uint64_t echoed  = 0;
+  auto drain_until = Clock::now() + std::chrono::milliseconds(500);
+  while (Clock::now() < drain_until)
+  {
+    echoed = 0;
+    for (size_t i = 0; i < CK_DIMENSION; ++i)
+    {
+      echoed += tracker.count[i];
+    }
+    echoed -= echoes_before;
+    if (echoed >= sent)
+    {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto cpu_after         = readThreadTimes();
+  const double cpu_s     = std::chrono::duration<double>(Clock::now() - cpu_start).count();
+  auto cpu_usage         = cpuUsage(cpu_before, cpu_after, cpu_s);
+  const double rate      = static_cast<double>(sent) / throughput_s;
+  const double echo_rate = static_cast<double>(echoed) / throughput_s;
+
+  sampling = false;
+  sampler.join();
+  finger_manager.disconnect();
+  simulator.stop();
+
+  // Evaluate thresholds
+  std::vector<Threshold> thresholds;
+  if (options.max_latency_p99_us > 0)
+  {
+    for (size_t i = 0; i < CK_DIMENSION; ++i)
+    {
+      if (latency_us[i].count() > 0)
+      {
+        double value = latency_us[i].percentile(99);
+        thresholds.push_back({std::string("latency_p99_us/") + C_COMMAND_NAMES[i],
+                              options.max_latency_p99_us,
+                              value,
+                              value <= options.max_latency_p99_us && lost[i] == 0});
+      }
+    }
+  }
+  if (options.max_feedback_age_p99_ms > 0)
+  {
+    double value = feedback_age_ms.percentile(99);
+    thresholds.push_back({"feedback_age_p99_ms",
+                          options.max_feedback_age_p99_ms,
+                          value,
+                          value <= options.max_feedback_age_p99_ms});
+  }
+  if (options.min_command_rate > 0)
+  {
+    thresholds.push_back({"command_rate_hz",
+                          options.min_command_rate,
+                          echo_rate,
+                          echo_rate >= options.min_command_rate && echoed >= sent});
+  }
+  if (options.max_thread_cpu > 0)
+  {
+    for (const auto& thread : cpu_usage)
+    {
+      // Only the threads of the library are checked, not the simulator or the benchmark itself
+      if (thread.first == "svh-receive" || thread.first == "svh-feedback")
+      {
+        thresholds.push_back({"thread_cpu_percent/" + thread.first,
+                              options.max_thread_cpu,
+                              thread.second,
+                              thread.second <= options.max_thread_cpu});
+      }
+    }
+  }
+  bool passed = std::all_of(
+    thresholds.begin(), thresholds.end(), [](const Threshold& t) { return t.passed; });
+
+  // Human readable summary
+  std::cerr << std::fixed << std::setprecision(1);
+  for (size_t i = 0; i < CK_DIMENSION; ++i)
+  {
+    if (latency_us[i].count() == 0 && lost[i] == 0)
+    {
+      continue;
+    }
+    std::cerr << "latency " << std::left << std::setw(10) << C_COMMAND_NAMES[i] << std::right
+              << " p50 " << latency_us[i].percentile(50) << " us, p99 "
+              << latency_us[i].percentile(99) << " us, max " << latency_us[i].percentile(100)
+              << " us, api call p50 " << api_call_us[i].percentile(50) << " us, lost " << lost[i]
+              << std::endl;
+  }
+  std::cerr << "feedback age p50 " << feedback_age_ms.percentile(50) << " ms, p99 "
+            << feedback_age_ms.percentile(99) << " ms, max " << feedback_age_ms.percentile(100)
+            << " ms" << std::endl;
+  std::cerr << "throughput: sent " << sent << " commands at " << rate << " Hz, " << echoed
+            << " answered (" << echo_rate << " Hz)" << std::endl;
+  for (const auto& thread : cpu_usage)
+  {
+    std::cerr << "cpu " << std::left << std::setw(16) << thread.first << std::right
+              << thread.second << " %" << std::endl;
+  }
+  for (const Threshold& threshold : thresholds)
+  {
+    std::cerr << (threshold.passed ? "PASSED " : "FAILED ") << threshold.name << ": "
+              << threshold.value << " (limit " << threshold.limit << ")" << std::endl;
+  }
+
+  if (!options.trace.empty())
+  {
+    SVHTrace::stop();
+    if (!SVHTrace::writeChromeTrace(options.trace))
+    {
+      return 1;
+    }
+  }
+
+  // Machine readable results
+  if (!options.output.empty())
+  {
+    std::ofstream file;
+    if (options.output != "-")
+    {
+      file.open(options.output);
+      if (!file)
+      {
+        std::cerr << "Could not open output file " << options.output << std::endl;
+        return 1;
+      }
+    }
+    std::ostream& o = (options.output == "-") ? std::cout : file;
+
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    o << std::setprecision(6) << std::defaultfloat;
+    o << "{" << std::endl;
+    o << "  \"suite\": \"loopback\"," << std::endl;
+    o << "  \"library_version\": \"" << SVH_BENCHMARK_LIBRARY_VERSION << "\"," << std::endl;
+    o << "  \"timestamp\": \"" << timestamp << "\"," << std::endl;
+    o << "  \"settings\": {\"duration_s\": " << options.duration
+      << ", \"rate_hz\": " << options.rate << ", \"mix\": {\"target\": " << options.mix[CK_TARGET]
+      << ", \"all\": " << options.mix[CK_TARGET_ALL]
+      << ", \"feedback\": " << options.mix[CK_FEEDBACK]
+      << "}, \"speed_scale\": " << options.speed_scale << ", \"transport\": \""
+      << options.transport << "\", \"gap_us\": " << options.gap_us
+      << ", \"window\": " << options.window << "}," << std::endl;
+    o << "  \"homing_s\": " << homing_s << "," << std::endl;
+    o << "  \"latency_us\": {";
+    for (size_t i = 0; i < CK_DIMENSION; ++i)
+    {
+      o << (i == 0 ? "" : ", ") << "\"" << C_COMMAND_NAMES[i] << "\": ";
+      latency_us[i].writeJson(o);
+    }
+    o << "}," << std::endl;
+    o << "  \"api_call_us\": {";
+    for (size_t i = 0; i < CK_DIMENSION; ++i)
+    {
+      o << (i == 0 ? "" : ", ") << "\"" << C_COMMAND_NAMES[i] << "\": ";
+      api_call_us[i].writeJson(o);
+    }
+    o << "}," << std::endl;
+    o << "  \"lost\": {\"target\": " << lost[CK_TARGET] << ", \"all\": " << lost[CK_TARGET_ALL]
+      << ", \"feedback\": " << lost[CK_FEEDBACK] << "}," << std::endl;
+    o << "  \"feedback_age_ms\": ";
+    feedback_age_ms.writeJson(o);
+    o << "," << std::endl;
+    o << "  \"throughput\": {\"sent\": " << sent << ", \"answered\": " << echoed
+      << ", \"rate_hz\": " << rate << ", \"answer_rate_hz\": " << echo_rate << "}," << std::endl;
+    o << "  \"thread_cpu_percent\": {";
+    bool first = true;
+    for (const auto& thread : cpu_usage)
+    {
+      o << (first ? "" : ", ") << "\"" << jsonEscape(thread.first) << "\": " << thread.second;
+      first = false;
+    }
+    o << "}," << std::endl;
+    o << "  \"thresholds\": [";
+    for (size_t i = 0; i < thresholds.size(); ++i)
+    {
+      o << (i == 0 ? "" : ", ") << "{\"name\": \"" << jsonEscape(thresholds[i].name)
+        << "\", \"limit\": " << thresholds[i].limit << ", \"value\": " << thresholds[i].value
+        << ", \"passed\": " << (thresholds[i].passed ? "true" : "false") << "}";
+    }
+    o << "]," << std::endl;
+    o << "  \"passed\": " << (passed ? "true" : "false") << std::endl;
+    o << "}" << std::endl;
+  }
+
+  return passed ? 0 : 1;
+}
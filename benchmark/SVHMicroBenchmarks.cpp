@@ -0,0 +1,541 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * Micro benchmarks of the hot paths of the library: payload encoding and
+ * decoding, frame decoding and packet framing in the receive thread, checksum calculation,
+ * packet dispatch in the controller and the position conversions of the
+ * finger manager. The framing benchmarks feed a pseudo terminal, all
+ * other benchmarks run without any device.
+ */
+//----------------------------------------------------------------------
+#include "SVHBenchmarkRunner.h"
+
+#include <schunk_svh_library/SVHFirmwareInfo.h>
+#include <schunk_svh_library/control/SVHControlCommand.h>
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHControllerFeedback.h>
+#include <schunk_svh_library/control/SVHControllerState.h>
+#include <schunk_svh_library/control/SVHCurrentSettings.h>
+#include <schunk_svh_library/control/SVHEncoderSettings.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/control/SVHPositionSettings.h>
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+#include <schunk_svh_library/serial/SVHReceiveThread.h>
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+#include <schunk_svh_library/serial/Serial.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+using namespace driver_svh;
+using namespace driver_svh::benchmark;
+using driver_svh::serial::SerialFlags;
+
+namespace {
+
+//! Serializes a complete frame including header and checksum as the serial interface does
+std::vector<uint8_t> encodeFrame(SVHSerialPacket packet)
+{
+  packet.data.resize(64, 0);
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, packet);
+
+  ArrayBuilder frame(packet.data.size() + C_PACKET_APPENDIX_SIZE);
+  frame << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+  return frame.array;
+}
+
+//! Creates a feedback packet for a channel as the hardware would send it
+SVHSerialPacket feedbackPacket(uint8_t index, SVHChannel channel)
+{
+  ArrayBuilder payload(64);
+  payload << SVHControllerFeedback(1000 * channel, 10 * channel);
+  SVHSerialPacket packet(0, SVH_SET_CONTROL_COMMAND | static_cast<uint8_t>(channel << 4));
+  packet.index = index;
+  packet.data  = payload.array;
+  return packet;
+}
+
+template <typename T>
+void benchmarkCodec(BenchmarkRunner& runner, const std::string& type_name, T value)
+{
+  ArrayBuilder encoded(0);
+  encoded << value;
+  const double size = static_cast<double>(encoded.write_pos);
+
+  // Encoding uses a fresh builder per payload just like the controller does when sending
+  runner.run("encode/" + type_name, size, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      ArrayBuilder ab(40);
+      ab << value;
+      doNotOptimize(ab.array.data());
+    }
+  });
+
+  runner.run("decode/" + type_name, size, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      T decoded;
+      encoded.read_pos = 0;
+      encoded >> decoded;
+      doNotOptimize(decoded);
+    }
+  });
+}
+
+void benchmarkCodecs(BenchmarkRunner& runner)
+{
+  benchmarkCodec(runner, "SVHControlCommand", SVHControlCommand(23));
+  benchmarkCodec(runner,
+                 "SVHControlCommandAllChannels",
+                 SVHControlCommandAllChannels(0, 1, 2, 3, 4, 5, 6, 7, 8));
+  benchmarkCodec(runner, "SVHControllerFeedback", SVHControllerFeedback(23, 42));
+
+  std::vector<SVHControllerFeedback> feedbacks;
+  for (int32_t channel = 0; channel < SVH_DIMENSION; ++channel)
+  {
+    feedbacks.push_back(SVHControllerFeedback(channel, 9 + channel));
+  }
+  benchmarkCodec(
+    runner, "SVHControllerFeedbackAllChannels", SVHControllerFeedbackAllChannels(feedbacks));
+  benchmarkCodec(runner,
+                 "SVHControllerState",
+                 SVHControllerState(0x001F, 0x001F, 0x0200, 0x02000, 0x0001, 0x0001));
+  benchmarkCodec(runner,
+                 "SVHCurrentSettings",
+                 SVHCurrentSettings(0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.1));
+  benchmarkCodec(runner,
+                 "SVHPositionSettings",
+                 SVHPositionSettings(0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.1));
+  benchmarkCodec(runner, "SVHEncoderSettings", SVHEncoderSettings(23));
+
+  SVHFirmwareInfo firmware_info;
+  firmware_info.svh           = "SVH";
+  firmware_info.version_major = 4;
+  firmware_info.version_minor = 2;
+  firmware_info.text          = "Benchmark firmware";
+  benchmarkCodec(runner, "SVHFirmwareInfo", firmware_info);
+
+  SVHSerialPacket packet = feedbackPacket(1, SVH_PINKY);
+  packet.data.resize(64, 0);
+  benchmarkCodec(runner, "SVHSerialPacket", packet);
+}
+
+void benchmarkChecksum(BenchmarkRunner& runner)
+{
+  SVHSerialPacket packet(64, SVH_SET_CONTROL_COMMAND_ALL);
+  for (size_t i = 0; i < packet.data.size(); ++i)
+  {
+    packet.data[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  runner.run("checksum/64", 64, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      uint8_t check_sum1;
+      uint8_t check_sum2;
+      packet.data[0] = static_cast<uint8_t>(i);
+      calcCheckSum(check_sum1, check_sum2, packet);
+      doNotOptimize(check_sum1);
+      doNotOptimize(check_sum2);
+    }
+  });
+}
+
+/*!
+ * \brief Receive thread reading from the slave side of a pseudo terminal, the benchmark writes
+ * frames to the master side and waits until all of them were delivered
+ */
+class FramingFixture
+{
+public:
+  FramingFixture()
+    : m_master(-1)
+    , m_received(0)
+  {
+    m_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0)
+    {
+      throw std::runtime_error("Could not create a pseudo terminal");
+    }
+
+    m_device = std::make_shared<Serial>(ptsname(m_master),
+                                        SerialFlags(SerialFlags::BR_921600, SerialFlags::DB_8));
+    if (!m_device->open())
+    {
+      throw std::runtime_error("Could not open the pseudo terminal");
+    }
+
+    m_receiver = std::make_unique<SVHReceiveThread>(
+      std::chrono::microseconds(500), m_device, [this](const SVHSerialPacket&, unsigned int) {
+        m_received++;
+      });
+    m_thread = std::thread([this] { m_receiver->run(); });
+  }
+
+  ~FramingFixture()
+  {
+    m_receiver->stop();
+    m_thread.join();
+    m_device->close();
+    ::close(m_master);
+  }
+
+  /*!
+   * \brief transfer writes the byte stream \a count times and waits until all contained frames
+   * were received
+   */
+  void transfer(const std::vector<uint8_t>& stream, uint64_t frames_per_stream, uint64_t count)
+  {
+    const uint64_t expected = m_received + frames_per_stream * count;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      size_t written = 0;
+      while (written < stream.size())
+      {
+        ssize_t bytes = ::write(m_master, stream.data() + written, stream.size() - written);
+        if (bytes < 0 && errno != EINTR && errno != EAGAIN)
+        {
+          throw std::runtime_error("Writing to the pseudo terminal failed");
+        }
+        written += static_cast<size_t>(std::max<ssize_t>(bytes, 0));
+      }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (m_received < expected)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        throw std::runtime_error("Timeout while waiting for frames");
+      }
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  int m_master;
+  std::shared_ptr<Serial> m_device;
+  std::unique_ptr<SVHReceiveThread> m_receiver;
+  std::thread m_thread;
+  std::atomic<uint64_t> m_received;
+};
+
+void benchmarkFraming(BenchmarkRunner& runner)
+{
+  if (!runner.isSelected("framing/"))
+  {
+    return;
+  }
+
+  std::unique_ptr<FramingFixture> fixture;
+  try
+  {
+    fixture = std::make_unique<FramingFixture>();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Skipping framing benchmarks: " << e.what() << std::endl;
+    return;
+  }
+
+  // Clean stream: frames back to back
+  const uint64_t frames = 16;
+  std::vector<uint8_t> clean;
+  for (uint64_t i = 0; i < frames; ++i)
+  {
+    std::vector<uint8_t> frame =
+      encodeFrame(feedbackPacket(static_cast<uint8_t>(i), static_cast<SVHChannel>(i % 9)));
+    clean.insert(clean.end(), frame.begin(), frame.end());
+  }
+
+  // Noisy stream: up to 32 bytes of garbage in front of every frame. The garbage never contains
+  // the first header byte so that every frame is still received.
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> noise_length(0, 32);
+  std::uniform_int_distribution<int> noise_byte(0, 255);
+  std::vector<uint8_t> noisy;
+  for (uint64_t i = 0; i < frames; ++i)
+  {
+    for (int n = noise_length(random); n > 0; --n)
+    {
+      uint8_t byte = static_cast<uint8_t>(noise_byte(random));
+      noisy.push_back(byte == PACKET_HEADER1 ? 0 : byte);
+    }
+    std::vector<uint8_t> frame =
+      encodeFrame(feedbackPacket(static_cast<uint8_t>(i), static_cast<SVHChannel>(i % 9)));
+    noisy.insert(noisy.end(), frame.begin(), frame.end());
+  }
+
+  // One operation is one received frame
+  runner.run("framing/clean", static_cast<double>(clean.size()) / frames, [&](uint64_t iterations) {
+    fixture->transfer(clean, frames, (iterations + frames - 1) / frames);
+  });
+  runner.run("framing/noisy", static_cast<double>(noisy.size()) / frames, [&](uint64_t iterations) {
+    fixture->transfer(noisy, frames, (iterations + frames - 1) / frames);
+  });
+}
+
+void benchmarkDecoder(BenchmarkRunner& runner)
+{
+  const uint64_t frames = 16;
+  std::vector<uint8_t> clean;
+  for (uint64_t i = 0; i < frames; ++i)
+  {
+    std::vector<uint8_t> frame =
+      encodeFrame(feedbackPacket(static_cast<uint8_t>(i), static_cast<SVHChannel>(i % 9)));
+    clean.insert(clean.end(), frame.begin(), frame.end());
+  }
+
+  // Line noise in front of every frame, including header bytes that start false frames
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> noise_length(0, 32);
+  std::uniform_int_distribution<int> noise_byte(0, 255);
+  std::vector<uint8_t> noisy;
+  for (uint64_t i = 0; i < frames; ++i)
+  {
+    for (int n = noise_length(random); n > 0; --n)
+    {
+      noisy.push_back(n % 8 == 0 ? PACKET_HEADER1 : static_cast<uint8_t>(noise_byte(random)));
+    }
+    noisy.insert(noisy.end(), SVHFrameDecoder::C_MAXIMUM_FRAME_SIZE, 0);
+    std::vector<uint8_t> frame =
+      encodeFrame(feedbackPacket(static_cast<uint8_t>(i), static_cast<SVHChannel>(i % 9)));
+    noisy.insert(noisy.end(), frame.begin(), frame.end());
+  }
+
+  // One operation is one decoded frame. Streams are fed in chunks like reads from the device.
+  const size_t chunk_size = 256;
+  SVHFrameDecoder decoder;
+  uint64_t decoded    = 0;
+  auto count_frame    = [&](const SVHFrameView& frame) { decoded += frame.length; };
+  auto feed_in_chunks = [&](const std::vector<uint8_t>& stream, uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i += frames)
+    {
+      for (size_t position = 0; position < stream.size(); position += chunk_size)
+      {
+        decoder.feed(stream.data() + position,
+                     std::min(chunk_size, stream.size() - position),
+                     count_frame);
+      }
+    }
+    doNotOptimize(decoded);
+  };
+
+  runner.run("decoder/clean", static_cast<double>(clean.size()) / frames, [&](uint64_t iterations) {
+    feed_in_chunks(clean, iterations);
+  });
+  runner.run("decoder/noisy", static_cast<double>(noisy.size()) / frames, [&](uint64_t iterations) {
+    feed_in_chunks(noisy, iterations);
+  });
+  runner.run(
+    "decoder/bytewise", static_cast<double>(clean.size()) / frames, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; i += frames)
+      {
+        for (uint8_t byte : clean)
+        {
+          decoder.feed(&byte, 1, count_frame);
+        }
+      }
+      doNotOptimize(decoded);
+    });
+}
+
+void benchmarkRecorder(BenchmarkRunner& runner)
+{
+  if (!runner.isSelected("recorder/"))
+  {
+    return;
+  }
+
+  char path[] = "/tmp/svh_benchmark_capture_XXXXXX";
+  int fd      = mkstemp(path);
+  if (fd < 0)
+  {
+    std::cerr << "Skipping recorder benchmarks: could not create a capture file" << std::endl;
+    return;
+  }
+  close(fd);
+
+  SVHPacketRecorder recorder;
+  if (!recorder.open(path, 4096))
+  {
+    std::cerr << "Skipping recorder benchmarks: could not map the capture file" << std::endl;
+    unlink(path);
+    return;
+  }
+
+  // A sent frame in the pieces SVHSerialInterface writes it in
+  SVHSerialPacket packet(64, SVH_SET_CONTROL_COMMAND_ALL);
+  uint8_t header[6] = {PACKET_HEADER1, PACKET_HEADER2, 0, SVH_SET_CONTROL_COMMAND_ALL, 64, 0};
+  uint8_t trailer[2] = {0, 0};
+  struct iovec buffers[3];
+  buffers[0].iov_base = header;
+  buffers[0].iov_len  = sizeof(header);
+  buffers[1].iov_base = packet.data.data();
+  buffers[1].iov_len  = packet.data.size();
+  buffers[2].iov_base = trailer;
+  buffers[2].iov_len  = sizeof(trailer);
+
+  std::vector<uint8_t> received = encodeFrame(feedbackPacket(0, SVH_PINKY));
+  SVHFrameView frame;
+  frame.index   = received[2];
+  frame.address = received[3];
+  frame.payload = received.data() + SVHFrameDecoder::C_FRAME_HEADER_SIZE;
+  frame.length  = static_cast<uint16_t>(received.size() - C_PACKET_APPENDIX_SIZE);
+
+  runner.run("recorder/transmit", 72, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      recorder.record(CD_TRANSMIT, CS_OK, buffers, 3);
+    }
+  });
+  runner.run("recorder/receive", static_cast<double>(received.size()), [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      recorder.record(CS_OK, frame);
+    }
+  });
+
+  recorder.close();
+  unlink(path);
+}
+
+void benchmarkDispatch(BenchmarkRunner& runner)
+{
+  SVHController controller;
+
+  SVHSerialPacket feedback = feedbackPacket(1, SVH_RING_FINGER);
+  runner.run("dispatch/controller_feedback", 0, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      controller.receivedPacketCallback(feedback, static_cast<unsigned int>(i));
+    }
+  });
+
+  std::vector<SVHControllerFeedback> feedbacks(SVH_DIMENSION, SVHControllerFeedback(23, 42));
+  SVHControllerFeedbackAllChannels feedback_all_channels(feedbacks);
+  ArrayBuilder payload(64);
+  payload << feedback_all_channels;
+  SVHSerialPacket feedback_all(0, SVH_SET_CONTROL_COMMAND_ALL);
+  feedback_all.data = payload.array;
+  runner.run("dispatch/controller_feedback_all", 0, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      controller.receivedPacketCallback(feedback_all, static_cast<unsigned int>(i));
+    }
+  });
+
+  payload.reset(64);
+  payload << SVHControllerState(0x001F, 0x001F, 0x0200, 0x02000, 0x0001, 0x0001);
+  SVHSerialPacket state(0, SVH_SET_CONTROLLER_STATE);
+  state.data = payload.array;
+  runner.run("dispatch/controller_state", 0, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      controller.receivedPacketCallback(state, static_cast<unsigned int>(i));
+    }
+  });
+
+  unsigned int observed = 0;
+  controller.addPacketObserver(SVH_SET_CONTROL_COMMAND,
+                               [&](const SVHSerialPacket&) { observed++; });
+  runner.run("dispatch/controller_feedback_observed", 0, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      controller.receivedPacketCallback(feedback, static_cast<unsigned int>(i));
+    }
+    doNotOptimize(observed);
+  });
+}
+
+void benchmarkConversion(BenchmarkRunner& runner)
+{
+  SVHFingerManager finger_manager;
+
+  // One operation converts all channels
+  runner.run("convert/rad2ticks_all_channels", 0, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      for (size_t channel = 0; channel < SVH_DIMENSION; ++channel)
+      {
+        int32_t ticks = finger_manager.convertRad2Ticks(static_cast<SVHChannel>(channel),
+                                                        0.1 * static_cast<double>(i % 8));
+        doNotOptimize(ticks);
+      }
+    }
+  });
+
+  runner.run("convert/ticks2rad_all_channels", 0, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      for (size_t channel = 0; channel < SVH_DIMENSION; ++channel)
+      {
+        double rad = finger_manager.convertTicks2Rad(static_cast<SVHChannel>(channel),
+                                                     static_cast<int32_t>(i % 40000));
+        doNotOptimize(rad);
+      }
+    }
+  });
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  BenchmarkOptions options;
+  if (!options.parse(argc, argv))
+  {
+    return 1;
+  }
+
+  BenchmarkRunner runner(options);
+  benchmarkCodecs(runner);
+  benchmarkChecksum(runner);
+  benchmarkDecoder(runner);
+  benchmarkFraming(runner);
+  benchmarkRecorder(runner);
+  benchmarkDispatch(runner);
+  benchmarkConversion(runner);
+
+  if (!runner.writeJson("micro"))
+  {
+    return 1;
+  }
+  return runner.hasErrors() ? 1 : 0;
+}
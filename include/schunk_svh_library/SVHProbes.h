@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the static tracepoints (USDT probes) of the library.
+ * They are compiled in when the library is built with sys/sdt.h available,
+ * see the ENABLE_USDT_PROBES option, and can be attached to with SystemTap,
+ * bpftrace or perf in a running process. An unattached probe is a single
+ * nop instruction. Without sys/sdt.h the macros expand to nothing and their
+ * arguments are not evaluated. All probes belong to the provider schunk_svh.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_PROBES_H_INCLUDED
+#define DRIVER_SVH_SVH_PROBES_H_INCLUDED
+
+#ifdef SVH_USDT_PROBES
+#  include <sys/sdt.h>
+
+#  define SVH_PROBE(NAME) DTRACE_PROBE(schunk_svh, NAME)
+#  define SVH_PROBE1(NAME, A) DTRACE_PROBE1(schunk_svh, NAME, A)
+#  define SVH_PROBE2(NAME, A, B) DTRACE_PROBE2(schunk_svh, NAME, A, B)
+#  define SVH_PROBE3(NAME, A, B, C) DTRACE_PROBE3(schunk_svh, NAME, A, B, C)
+#else
+#  define SVH_PROBE(NAME)                                                                          \
+    do                                                                                             \
+    {                                                                                              \
+    } while (false)
+#  define SVH_PROBE1(NAME, A) SVH_PROBE(NAME)
+#  define SVH_PROBE2(NAME, A, B) SVH_PROBE(NAME)
+#  define SVH_PROBE3(NAME, A, B, C) SVH_PROBE(NAME)
+#endif
+
+#endif // DRIVER_SVH_SVH_PROBES_H_INCLUDED
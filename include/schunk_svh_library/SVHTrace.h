@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains SVHTrace, a process wide recorder of timed spans and
+ * instant events, e.g. around packet transmission, frame decoding, dispatch
+ * and the phases of connect and homing. Events are written into a lock free
+ * ring and can be exported in the Chrome trace event format, which is read
+ * by chrome://tracing and the Perfetto UI. While tracing is disabled, a span
+ * costs one relaxed atomic load.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_TRACE_H_INCLUDED
+#define DRIVER_SVH_SVH_TRACE_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! Traces the enclosing scope as span NAME of CATEGORY, both have to be string literals
+#define SVH_TRACE_SPAN(CATEGORY, NAME)                                                             \
+  driver_svh::SVHTraceSpan SVH_TRACE_UNIQUE_NAME(svh_trace_span_, __LINE__)(CATEGORY, NAME)
+//! Like SVH_TRACE_SPAN with a named integer argument, e.g. a channel
+#define SVH_TRACE_SPAN_ARG(CATEGORY, NAME, ARG_NAME, ARG)                                          \
+  driver_svh::SVHTraceSpan SVH_TRACE_UNIQUE_NAME(svh_trace_span_, __LINE__)(                       \
+    CATEGORY, NAME, ARG_NAME, static_cast<int64_t>(ARG))
+//! Records an instant event NAME of CATEGORY with a named integer argument
+#define SVH_TRACE_INSTANT(CATEGORY, NAME, ARG_NAME, ARG)                                           \
+  do                                                                                               \
+  {                                                                                                \
+    if (driver_svh::SVHTrace::isEnabled())                                                         \
+    {                                                                                              \
+      driver_svh::SVHTrace::instant(CATEGORY, NAME, ARG_NAME, static_cast<int64_t>(ARG));          \
+    }                                                                                              \
+  } while (false)
+
+#define SVH_TRACE_UNIQUE_NAME(PREFIX, LINE) SVH_TRACE_CONCATENATE(PREFIX, LINE)
+#define SVH_TRACE_CONCATENATE(PREFIX, LINE) PREFIX##LINE
+
+namespace driver_svh {
+
+//! One recorded event. Names point to string literals of the library.
+struct SVHTraceEvent
+{
+  const char* category = "";
+  const char* name     = "";
+  //! 'X' for spans and 'i' for instant events, as in the Chrome trace event format
+  char phase = 'X';
+  //! Start in ns of the steady clock
+  uint64_t start_ns = 0;
+  //! Duration in ns, 0 for instant events
+  uint64_t duration_ns = 0;
+  //! Number of the recording thread, see SVHTrace::threadNames
+  uint32_t thread = 0;
+  //! Name of the optional argument, nullptr if there is none
+  const char* arg_name = nullptr;
+  int64_t arg          = 0;
+};
+
+/*!
+ * \brief Process wide trace recorder
+ *
+ * Any thread can record. A recording thread reserves a slot of the ring with one atomic increment
+ * and publishes it with a sequence number, so neither writers nor readers take a lock. Once the
+ * ring is full, the oldest events are overwritten.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHTrace
+{
+public:
+  /*!
+   * \brief start enables the recording and discards previously recorded events
+   * \param capacity number of events kept, rounded up to a power of two
+   * \return false if the capacity is 0
+   */
+  static bool start(size_t capacity = 65536);
+
+  //! Disables the recording, the recorded events are kept
+  static void stop();
+
+  //! Whether events are recorded
+  static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  //! Current time in ns of the steady clock, the time base of the events
+  static uint64_t now();
+
+  //! Records a span that started at \a start_ns and ends now
+  static void complete(const char* category,
+                       const char* name,
+                       uint64_t start_ns,
+                       const char* arg_name = nullptr,
+                       int64_t arg          = 0);
+
+  //! Records an instant event
+  static void instant(const char* category,
+                      const char* name,
+                      const char* arg_name = nullptr,
+                      int64_t arg          = 0);
+
+  //! Recorded events that were not overwritten yet, oldest first
+  static std::vector<SVHTraceEvent> events();
+
+  //! Names of the recording threads by the number used in the events
+  static std::map<uint32_t, std::string> threadNames();
+
+  //! \brief Names the calling thread in the trace and, on Linux, in the operating system, where
+  //! profilers and /proc/<pid>/task show it. Names are cut to 15 characters there.
+  static void setThreadName(const char* name);
+
+  //! Events recorded since start, including overwritten ones
+  static uint64_t recordedCount();
+
+  //! Writes the events as Chrome trace event JSON
+  static void writeChromeTrace(std::ostream& out);
+
+  //! Writes the events as Chrome trace event JSON file, returns false if it cannot be written
+  static bool writeChromeTrace(const std::string& file_name);
+
+private:
+  struct Ring;
+
+  //! Stores one event in the current ring
+  static void record(const char* category,
+                     const char* name,
+                     char phase,
+                     uint64_t start_ns,
+                     uint64_t duration_ns,
+                     const char* arg_name,
+                     int64_t arg);
+
+  //! Number of the calling thread, registers its name on first use
+  static uint32_t threadNumber();
+
+  static std::atomic<bool> s_enabled;
+  static std::atomic<Ring*> s_ring;
+};
+
+/*!
+ * \brief Records the lifetime of a scope as span, see SVH_TRACE_SPAN
+ */
+class SVHTraceSpan
+{
+public:
+  SVHTraceSpan(const char* category,
+               const char* name,
+               const char* arg_name = nullptr,
+               int64_t arg          = 0)
+    : m_category(category)
+    , m_name(name)
+    , m_arg_name(arg_name)
+    , m_arg(arg)
+    , m_start_ns(SVHTrace::isEnabled() ? SVHTrace::now() : 0)
+  {
+  }
+
+  ~SVHTraceSpan()
+  {
+    if (m_start_ns != 0 && SVHTrace::isEnabled())
+    {
+      SVHTrace::complete(m_category, m_name, m_start_ns, m_arg_name, m_arg);
+    }
+  }
+
+  SVHTraceSpan(const SVHTraceSpan&) = delete;
+  SVHTraceSpan& operator=(const SVHTraceSpan&) = delete;
+
+private:
+  const char* m_category;
+  const char* m_name;
+  const char* m_arg_name;
+  int64_t m_arg;
+  uint64_t m_start_ns;
+};
+
+} // namespace driver_svh
+
+#endif // DRIVER_SVH_SVH_TRACE_H_INCLUDED
@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains awaitables for the asynchronous operations of the
+ * SVHFingerManager, so that C++20 coroutines can connect, home and exchange
+ * settings without blocking a thread. The library itself is built as C++14,
+ * the awaitables are only available to code compiled with coroutine support.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_AWAITABLE_H_INCLUDED
+#define DRIVER_SVH_SVH_AWAITABLE_H_INCLUDED
+
+#include <schunk_svh_library/control/SVHFingerManager.h>
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#  include <coroutine>
+#  include <exception>
+#  include <functional>
+#  include <memory>
+#  include <string>
+#  include <utility>
+
+namespace driver_svh {
+
+//! Outcome of an awaited operation, \a value is only meaningful on success
+template <typename T>
+struct SVHAsyncResult
+{
+  bool success = false;
+  T value{};
+};
+
+/*!
+ * \brief Awaits one asynchronous operation of an SVHFingerManager
+ *
+ * The coroutine resumes in the reactor thread, or in the thread that cancelled the operation by
+ * disconnecting. If the operation cannot be started it does not suspend and reports a failure.
+ */
+template <typename T>
+class SVHAsyncAwaiter
+{
+public:
+  //! Starts the operation with the given completion, see SVHFingerManager::connectAsync
+  using Start = std::function<bool(const SVHAsyncResultCallback<T>& done)>;
+
+  explicit SVHAsyncAwaiter(Start start)
+    : m_start(std::move(start))
+  {
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle)
+  {
+    // The operation may complete and destroy the frame before start returns
+    Start start = std::move(m_start);
+    return start([this, handle](bool success, const T& value) {
+      m_result.success = success;
+      m_result.value   = value;
+      handle.resume();
+    });
+  }
+
+  SVHAsyncResult<T> await_resume() const { return m_result; }
+
+private:
+  Start m_start;
+  SVHAsyncResult<T> m_result;
+};
+
+//! Coroutine that starts right away and is not awaited itself, e.g. a startup sequence of a hand
+struct SVHTask
+{
+  struct promise_type
+  {
+    SVHTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+//! Awaitable SVHFingerManager::connectAsync, the value is the success
+inline SVHAsyncAwaiter<bool>
+asyncConnect(SVHFingerManager& manager, std::string dev_name, unsigned int retry_count = 3)
+{
+  return SVHAsyncAwaiter<bool>(
+    [&manager, dev_name, retry_count](const SVHAsyncResultCallback<bool>& done) {
+      return manager.connectAsync(
+        dev_name, [done](bool success) { done(success, success); }, retry_count);
+    });
+}
+
+//! Awaitable SVHFingerManager::connectAsync over an opened transport
+inline SVHAsyncAwaiter<bool> asyncConnect(SVHFingerManager& manager,
+                                          std::shared_ptr<SVHTransport> transport,
+                                          unsigned int retry_count = 3)
+{
+  return SVHAsyncAwaiter<bool>(
+    [&manager, transport, retry_count](const SVHAsyncResultCallback<bool>& done) {
+      return manager.connectAsync(
+        transport, [done](bool success) { done(success, success); }, retry_count);
+    });
+}
+
+//! Awaitable SVHFingerManager::resetChannelAsync, the value is the success
+inline SVHAsyncAwaiter<bool> asyncResetChannel(SVHFingerManager& manager, SVHChannel channel)
+{
+  return SVHAsyncAwaiter<bool>([&manager, channel](const SVHAsyncResultCallback<bool>& done) {
+    return manager.resetChannelAsync(channel, [done](bool success) { done(success, success); });
+  });
+}
+
+//! Awaitable SVHFingerManager::getFirmwareInfoAsync
+inline SVHAsyncAwaiter<SVHFirmwareInfo> asyncFirmwareInfo(SVHFingerManager& manager,
+                                                          unsigned int retry_count = 3)
+{
+  return SVHAsyncAwaiter<SVHFirmwareInfo>(
+    [&manager, retry_count](const SVHAsyncResultCallback<SVHFirmwareInfo>& done) {
+      return manager.getFirmwareInfoAsync(done, retry_count);
+    });
+}
+
+//! Awaitable SVHFingerManager::requestPositionSettingsAsync
+inline SVHAsyncAwaiter<SVHPositionSettings> asyncRequestPositionSettings(SVHFingerManager& manager,
+                                                                         SVHChannel channel)
+{
+  return SVHAsyncAwaiter<SVHPositionSettings>(
+    [&manager, channel](const SVHAsyncResultCallback<SVHPositionSettings>& done) {
+      return manager.requestPositionSettingsAsync(channel, done);
+    });
+}
+
+//! Awaitable SVHFingerManager::requestCurrentSettingsAsync
+inline SVHAsyncAwaiter<SVHCurrentSettings> asyncRequestCurrentSettings(SVHFingerManager& manager,
+                                                                       SVHChannel channel)
+{
+  return SVHAsyncAwaiter<SVHCurrentSettings>(
+    [&manager, channel](const SVHAsyncResultCallback<SVHCurrentSettings>& done) {
+      return manager.requestCurrentSettingsAsync(channel, done);
+    });
+}
+
+//! Awaitable SVHFingerManager::setPositionSettingsAsync, the value is the echo of the hand
+inline SVHAsyncAwaiter<SVHPositionSettings> asyncSetPositionSettings(
+  SVHFingerManager& manager, SVHChannel channel, SVHPositionSettings settings)
+{
+  return SVHAsyncAwaiter<SVHPositionSettings>(
+    [&manager, channel, settings](const SVHAsyncResultCallback<SVHPositionSettings>& done) {
+      return manager.setPositionSettingsAsync(channel, settings, done);
+    });
+}
+
+//! Awaitable SVHFingerManager::setCurrentSettingsAsync, the value is the echo of the hand
+inline SVHAsyncAwaiter<SVHCurrentSettings> asyncSetCurrentSettings(SVHFingerManager& manager,
+                                                                   SVHChannel channel,
+                                                                   SVHCurrentSettings settings)
+{
+  return SVHAsyncAwaiter<SVHCurrentSettings>(
+    [&manager, channel, settings](const SVHAsyncResultCallback<SVHCurrentSettings>& done) {
+      return manager.setCurrentSettingsAsync(channel, settings, done);
+    });
+}
+
+} // namespace driver_svh
+
+#endif
+
+#endif // DRIVER_SVH_SVH_AWAITABLE_H_INCLUDED
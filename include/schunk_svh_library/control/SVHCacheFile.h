@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the cache file shared by the gap and the homing
+ * calibration. It holds lines of values followed by the device they belong
+ * to, several processes may update the entries of their hands concurrently.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_CACHE_FILE_H_INCLUDED
+#define DRIVER_SVH_SVH_CACHE_FILE_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+/*!
+ * \brief Reads and replaces the entries of one device in a cache file
+ *
+ * Every line holds a fixed number of whitespace separated values followed by the device, whose
+ * name may contain spaces. Updates lock the file against other writers and replace it at once,
+ * so that neither a crash nor a second hand sharing the file loses entries.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHCacheFile
+{
+public:
+  /*!
+   * \brief load reads the entries of a device
+   * \param value_count number of values in front of the device
+   * \param entries the values of every entry of the device, separated by single spaces
+   * \return false if the file or an entry for the device does not exist
+   */
+  static bool load(const std::string& cache_file,
+                   const std::string& device,
+                   size_t value_count,
+                   std::vector<std::string>& entries);
+
+  /*!
+   * \brief store replaces the entries of a device, entries of other devices and lines that do not
+   * hold value_count values are kept
+   * \param value_count number of values in front of the device
+   * \param entries the values of every new entry, separated by spaces
+   * \return false if the file could not be written
+   */
+  static bool store(const std::string& cache_file,
+                    const std::string& device,
+                    size_t value_count,
+                    const std::vector<std::string>& entries);
+};
+
+} // namespace driver_svh
+
+#endif
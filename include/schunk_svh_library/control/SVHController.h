@@ -58,6 +58,10 @@
 #include <schunk_svh_library/serial/SVHReceiveThread.h>
 #include <schunk_svh_library/serial/SVHSerialInterface.h>
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 namespace driver_svh {
 
 //! Channel indicates which motor to use in command calls. WARNING: DO NOT CHANGE THE ORDER OF THESE
@@ -77,6 +81,18 @@ enum
   SVH_DIMENSION // 9
 } typedef SVHChannel;
 
+//! Mask of all channels for enableChannels and disableChannels, bit i stands for channel i
+const uint16_t SVH_ALL_CHANNELS_MASK = (1 << SVH_DIMENSION) - 1;
+
+/*!
+ * \brief Function signature of handlers and observers for received packets of one message type
+ * \param packet Received packet, integrity has been checked by the serial interface
+ */
+using SVHPacketHandler = std::function<void(const SVHSerialPacket& packet)>;
+
+//! Number of distinct message types that can be encoded in the lower nibble of the address byte
+const size_t SVH_PACKET_TYPE_DIMENSION = 16;
+
 /*!
  * \brief This class controls the the SCHUNK five finger hand.
  *
@@ -102,9 +118,74 @@ public:
    */
   bool connect(const std::string& dev_name);
 
+  /*!
+   * \brief Communicate over an opened transport, see SVHSerialInterface::connect
+   * \param transport e.g. an SVHPipeTransport to a simulated hand
+   * \return true if connect was successfull
+   */
+  bool connect(const std::shared_ptr<SVHTransport>& transport);
+
   //! disconnect serial device
   void disconnect();
 
+  /*!
+   * \brief Receive through a shared reactor instead of a dedicated thread, see
+   * SVHSerialInterface::setReactor
+   * \param reactor running reactor, or nullptr to use a receive thread
+   */
+  void setReactor(const std::shared_ptr<SVHReactor>& reactor);
+
+  /*!
+   * \brief set the parameters of the serial transport used from the next connect on, see
+   * SVHSerialInterface::setTransportOptions
+   */
+  void setTransportOptions(const SVHTransportOptions& options);
+
+  //! Parameters of the serial transport, see SVHSerialInterface::transportOptions
+  SVHTransportOptions getTransportOptions();
+
+  //! Change the gap between two frames while connected, see
+  //! SVHSerialInterface::setTransmissionGap
+  bool setTransmissionGap(const std::chrono::microseconds& gap);
+
+  /*!
+   * \brief record all frames from the next connect on, see SVHSerialInterface::setPacketRecorder
+   */
+  void setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder);
+
+  /*!
+   * \brief Check whether the serial device failed since it was connected
+   * \return true if the device was hung up or could not be read
+   */
+  bool hasCommunicationFailed();
+
+  /*!
+   * \brief get the counters of the receiving side of the serial interface
+   * \return counters since the last connect
+   */
+  SVHReceiveStatistics getReceiveStatistics();
+
+  /*!
+   * \brief get the counters of the transmitting side of the serial interface
+   * \return counters since the last connect
+   */
+  SVHTransmitStatistics getTransmitStatistics();
+
+  //! Queue the packets of the calling thread, see SVHSerialInterface::holdTransmission
+  void holdTransmission();
+
+  //! Number of queued packets, see SVHSerialInterface::heldPacketCount
+  size_t heldPacketCount();
+
+  //! Earliest time of the next write, see SVHSerialInterface::nextTransmissionTime
+  std::chrono::steady_clock::time_point nextTransmissionTime();
+
+  //! Write the oldest queued packet, see SVHSerialInterface::releaseHeldPacket
+  bool releaseHeldPacket(std::chrono::steady_clock::time_point& written);
+
+  //! Write all queued packets and stop queueing, see SVHSerialInterface::releaseTransmission
+  bool releaseTransmission();
+
   /*!
    * \brief Set new position target for finger index
    * \param channel Motorchanel to set the target for
@@ -132,6 +213,20 @@ public:
    */
   void disableChannel(const SVHChannel& channel);
 
+  /*!
+   *  \brief Enable several motor channels at once. The controllers of all channels in the mask are
+   *  reset and then activated with one controller state each, instead of one sequence per channel.
+   *  \param mask bit i stands for channel i, see SVH_ALL_CHANNELS_MASK
+   */
+  void enableChannels(uint16_t mask);
+
+  /*!
+   *  \brief Disable several motor channels at once with a single controller state, the other
+   *  channels stay enabled
+   *  \param mask bit i stands for channel i, see SVH_ALL_CHANNELS_MASK
+   */
+  void disableChannels(uint16_t mask);
+
   //! Request current controller state (mainly usefull for debug purposes)
   void requestControllerState();
 
@@ -191,6 +286,42 @@ public:
    */
   void receivedPacketCallback(const SVHSerialPacket& packet, unsigned int packet_count);
 
+  /*!
+   * \brief Replace the handler that decodes received packets of one message type.
+   *
+   * Packets are dispatched by the lower nibble of their address byte, i.e. the SVH_GET_* and
+   * SVH_SET_* constants. Setting an empty handler disables decoding of that type entirely.
+   * \note Handlers are called from the receive thread and must not (un)register handlers.
+   * \param type Message type to set the handler for (lower nibble of the address byte)
+   * \param handler Function to call for each received packet of that type
+   * \return true if the type was valid
+   */
+  bool setPacketHandler(const uint8_t& type, const SVHPacketHandler& handler);
+
+  /*!
+   * \brief Restore the built-in decoding handler of one message type
+   * \param type Message type to restore the handler for
+   * \return true if the type was valid
+   */
+  bool resetPacketHandler(const uint8_t& type);
+
+  /*!
+   * \brief Add an observer that is called after the handler of a message type has been executed.
+   *
+   * Observers can use the getter functions to access the freshly decoded data.
+   * \note Observers are called from the receive thread and should return quickly.
+   * \param type Message type to observe
+   * \param observer Function to call for each received packet of that type
+   * \return true if the type was valid
+   */
+  bool addPacketObserver(const uint8_t& type, const SVHPacketHandler& observer);
+
+  /*!
+   * \brief Remove all observers of one message type
+   * \param type Message type to clear the observers for
+   */
+  void clearPacketObservers(const uint8_t& type);
+
   /*!
    * \brief request the latest stored controllerfeedback (current, position) from the controller.
    * \param channel Motor to get the latest feedback to
@@ -251,6 +382,12 @@ public:
    */
   bool isEnabled(const SVHChannel& channel);
 
+  /*!
+   * \brief Channels whose controllers were enabled, can be read from any thread
+   * \return bit i is set if channel i is enabled, see SVH_ALL_CHANNELS_MASK
+   */
+  uint16_t enabledMask() const;
+
   //! Description values to get the corresponding string value to a channel enum
   static const char* m_channel_description[];
 
@@ -261,6 +398,21 @@ public:
   void getControllerFeedbackAllChannels(SVHControllerFeedbackAllChannels& controller_feedback);
 
 private:
+  //! Create a dispatch table filled with the built-in decoding handlers
+  std::array<SVHPacketHandler, SVH_PACKET_TYPE_DIMENSION> defaultPacketHandlers();
+
+  //! Load the payload of a received packet into the reusable receive array builder
+  ArrayBuilder& receivedPayload(const SVHSerialPacket& packet);
+
+  // Built-in decoding handlers, one per pair of get/set message types
+  void handleControllerFeedback(const SVHSerialPacket& packet);
+  void handleControllerFeedbackAllChannels(const SVHSerialPacket& packet);
+  void handlePositionSettings(const SVHSerialPacket& packet);
+  void handleCurrentSettings(const SVHSerialPacket& packet);
+  void handleControllerState(const SVHSerialPacket& packet);
+  void handleEncoderValues(const SVHSerialPacket& packet);
+  void handleFirmwareInfo(const SVHSerialPacket& packet);
+
   // Data Structures for holding configurations and feedback of the Controller
 
   //! vector of current controller parameters for each finger
@@ -286,12 +438,31 @@ private:
   //! Serial interface for transmission and reveibing of data packets
   SVHSerialInterface* m_serial_interface;
 
-  //! Bitmask to tell which fingers are enabled
-  uint16_t m_enable_mask;
+  //! Bitmask to tell which fingers are enabled, updated with atomic bit operations
+  std::atomic<uint16_t> m_enable_mask;
+
+  //! Held while m_enable_mask is changed or read for a controller state until the state is sent,
+  //! so that the hand receives the states in the order of the changes
+  std::mutex m_enable_mutex;
 
   //! store how many packages where actually received. Updated every time the receivepacket callback
   //! is called
   unsigned int m_received_package_count;
+
+  //! Dispatch table of decoding handlers, indexed by the message type
+  std::array<SVHPacketHandler, SVH_PACKET_TYPE_DIMENSION> m_packet_handlers;
+
+  //! Observers called after the handler, indexed by the message type
+  std::array<std::vector<SVHPacketHandler>, SVH_PACKET_TYPE_DIMENSION> m_packet_observers;
+
+  //! Protects the dispatch table against concurrent registration
+  std::mutex m_dispatch_mutex;
+
+  //! Array builder reused for decoding every received payload (only used by the receive thread)
+  ArrayBuilder m_receive_ab;
+
+  //! Intermediate structure for decoding all channel feedback (only used by the receive thread)
+  SVHControllerFeedbackAllChannels m_received_feedback_all;
 };
 
 } // namespace driver_svh
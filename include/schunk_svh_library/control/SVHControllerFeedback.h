@@ -115,7 +115,7 @@ struct SVHControllerFeedbackAllChannels
    */
   SVHControllerFeedbackAllChannels(std::vector<SVHControllerFeedback> feedbacks)
   {
-    feedbacks.insert(feedbacks.begin(), feedbacks.begin(), feedbacks.end());
+    this->feedbacks.insert(this->feedbacks.begin(), feedbacks.begin(), feedbacks.end());
   }
 
   /*!
@@ -37,19 +37,38 @@
 #ifndef DRIVER_SVH_SVH_FINGER_MANAGER_H_INCLUDED
 #define DRIVER_SVH_SVH_FINGER_MANAGER_H_INCLUDED
 
+#include <atomic>
 #include <chrono>
 #include <schunk_svh_library/ImportExport.h>
 #include <schunk_svh_library/control/SVHController.h>
 #include <schunk_svh_library/control/SVHCurrentSettings.h>
+#include <schunk_svh_library/control/SVHGapCalibration.h>
+#include <schunk_svh_library/control/SVHHomingCalibration.h>
+#include <schunk_svh_library/control/SVHHomingProfile.h>
 #include <schunk_svh_library/control/SVHHomeSettings.h>
 #include <schunk_svh_library/control/SVHPositionSettings.h>
+#include <schunk_svh_library/control/SVHSubscription.h>
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 
 namespace driver_svh {
 
+/*!
+ * \brief Function called when an asynchronous operation of the finger manager finished. It is
+ * called in the reactor thread, or in the thread that cancelled the operation by disconnecting.
+ * \param success whether the operation succeeded
+ */
+using SVHAsyncCallback = std::function<void(bool success)>;
+
+//! Function called with the outcome of an asynchronous round trip, see SVHAsyncCallback
+template <typename T>
+using SVHAsyncResultCallback = std::function<void(bool success, const T& result)>;
+
 /*! This class manages controller parameters and the finger reset.
  */
 class DRIVER_SVH_IMPORT_EXPORT SVHFingerManager
@@ -99,17 +118,184 @@ public:
    */
   bool connect(const std::string& dev_name = "/dev/ttyUSB0", const unsigned int& retry_count = 3);
 
+  /*!
+   *  \brief Open connection to SCHUNK five finger hand over an opened transport, e.g. an
+   * SVHPipeTransport to a simulated hand. See connect for the retries.
+   */
+  bool connect(const std::shared_ptr<SVHTransport>& transport, const unsigned int& retry_count = 3);
+
   //!
-  //! \brief disconnect SCHUNK five finger hand
+  //! \brief disconnect SCHUNK five finger hand. Asynchronous operations that are still running are
+  //! cancelled and report a failure.
   //!
   void disconnect();
 
+  //!
+  //! \brief connectAsync is the non-blocking variant of connect. The connection attempts run as a
+  //! task of the reactor given to setReactor, which calls \a done once they are finished. The gap
+  //! calibration is skipped, it waits for replies that only the reactor thread could receive.
+  //! \return false if the device could not be opened or there is no running reactor, \a done is
+  //! not called then
+  //!
+  bool connectAsync(const std::string& dev_name,
+                    const SVHAsyncCallback& done,
+                    const unsigned int& retry_count = 3);
+
+  //! connectAsync over an opened transport, see connect
+  bool connectAsync(const std::shared_ptr<SVHTransport>& transport,
+                    const SVHAsyncCallback& done,
+                    const unsigned int& retry_count = 3);
+
+  //!
+  //! \brief resetChannelAsync is the non-blocking variant of resetChannel, one homing step is
+  //! executed per reactor cycle. Only one homing per hand should run at a time.
+  //! \return false if the operation could not be started, \a done is not called then
+  //!
+  bool resetChannelAsync(const SVHChannel& channel, const SVHAsyncCallback& done);
+
+  //!
+  //! \brief getFirmwareInfoAsync is the non-blocking variant of getFirmwareInfo on a connected hand
+  //! \return false if the operation could not be started, \a done is not called then
+  //!
+  bool getFirmwareInfoAsync(const SVHAsyncResultCallback<SVHFirmwareInfo>& done,
+                            const unsigned int& retry_count = 3);
+
+  //!
+  //! \brief requestPositionSettingsAsync reads the position settings of a channel from the hand
+  //! \return false if the operation could not be started, \a done is not called then
+  //!
+  bool requestPositionSettingsAsync(const SVHChannel& channel,
+                                    const SVHAsyncResultCallback<SVHPositionSettings>& done);
+
+  //! requestCurrentSettingsAsync reads the current settings of a channel from the hand
+  bool requestCurrentSettingsAsync(const SVHChannel& channel,
+                                   const SVHAsyncResultCallback<SVHCurrentSettings>& done);
+
+  //!
+  //! \brief setPositionSettingsAsync sets the position settings like setPositionSettings and
+  //! reports the settings echoed by the hand
+  //! \return false if the operation could not be started, \a done is not called then
+  //!
+  bool setPositionSettingsAsync(const SVHChannel& channel,
+                                const SVHPositionSettings& position_settings,
+                                const SVHAsyncResultCallback<SVHPositionSettings>& done);
+
+  //! setCurrentSettingsAsync sets the current settings and reports the echo, see
+  //! setPositionSettingsAsync
+  bool setCurrentSettingsAsync(const SVHChannel& channel,
+                               const SVHCurrentSettings& current_settings,
+                               const SVHAsyncResultCallback<SVHCurrentSettings>& done);
+
+  //! Number of asynchronous operations that have not finished yet
+  size_t pendingAsyncOperations();
+
   //!
   //! \brief returns connected state of finger manager
   //! \return bool true if the finger manager is connected to the hardware
   //!
   bool isConnected() { return m_connected; }
 
+  //!
+  //! \brief receive through a shared reactor instead of a dedicated thread. The finger manager
+  //! then does not start its feedback polling thread either, the owner of the reactor is expected
+  //! to call requestControllerFeedback(SVH_ALL) periodically as SVHMultiHandManager does.
+  //! Has to be called while disconnected.
+  //! \param reactor running reactor, or nullptr to go back to the own threads
+  //!
+  void setReactor(const std::shared_ptr<SVHReactor>& reactor);
+
+  //!
+  //! \brief set the parameters of the serial transport like the baud rate and the receive
+  //! strategy. Has to be called while disconnected, the options are validated by connect.
+  //! \param options transport parameters used from the next connect on
+  //!
+  void setTransportOptions(const SVHTransportOptions& options);
+
+  //!
+  //! \brief get the parameters of the serial transport, including a calibrated gap
+  //!
+  SVHTransportOptions getTransportOptions();
+
+  //!
+  //! \brief record all frames exchanged with the hand into a capture file. Has to be called while
+  //! disconnected. \param recorder opened recorder, or nullptr to stop recording
+  //!
+  void setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder);
+
+  //!
+  //! \brief calibrate the gap between two frames on connect instead of using the one of the
+  //! transport options, see SVHGapCalibration. Has to be called while disconnected.
+  //! \param settings calibration parameters, disabled by default
+  //!
+  void setGapCalibration(const SVHGapCalibrationSettings& settings);
+
+  //!
+  //! \brief get the outcome of the gap calibration of the last connect
+  //!
+  SVHGapCalibrationReport gapCalibrationReport() { return m_gap_calibration_report; }
+
+  //!
+  //! \brief keep the calibration of homed channels for the next connect, see
+  //! SVHHomingCalibration. Channels whose stored calibration still fits their encoder are not
+  //! driven to the hard stop by resetChannel but only checked with a short move. Has to be called
+  //! while disconnected.
+  //! \param settings calibration parameters, disabled by default
+  //!
+  void setHomingCalibration(const SVHHomingCalibrationSettings& settings);
+
+  //!
+  //! \brief get the outcome of the verification of the stored calibration of the last connect
+  //!
+  SVHHomingCalibrationReport homingCalibrationReport();
+
+  //!
+  //! \brief returns whether the connection to the hardware broke down since connect was called
+  //! \return bool true if the serial device was hung up or could not be read
+  //!
+  bool hasCommunicationFailed();
+
+  //!
+  //! \brief get the counters of the receiving side of the serial interface
+  //! \return counters since the last connect
+  //!
+  SVHReceiveStatistics getReceiveStatistics();
+
+  //!
+  //! \brief get the counters of the transmitting side of the serial interface
+  //! \return counters since the last connect
+  //!
+  SVHTransmitStatistics getTransmitStatistics();
+
+  //!
+  //! \brief queue all packets sent by the calling thread until releaseTransmission is called. This
+  //! and the following functions are the building blocks of SVHHandGroup, which releases the
+  //! commands of several hands at the same time.
+  //!
+  void holdTransmission();
+
+  //!
+  //! \brief returns the number of packets queued since holdTransmission was called
+  //!
+  size_t heldPacketCount();
+
+  //!
+  //! \brief returns the earliest time the next packet can be written to the hardware
+  //!
+  std::chrono::steady_clock::time_point nextTransmissionTime();
+
+  //!
+  //! \brief write the oldest queued packet
+  //! \param written time the packet was handed to the serial device
+  //! \return false if nothing was queued or writing failed
+  //!
+  bool releaseHeldPacket(std::chrono::steady_clock::time_point& written);
+
+  //!
+  //! \brief write all queued packets and stop queueing
+  //! \return false if writing failed
+  //!
+  bool releaseTransmission();
+
   //!
   //! \brief reset function for channel
   //! \param channel Channel to reset
@@ -192,6 +378,23 @@ public:
   //!
   bool isHomed(const SVHChannel& channel);
 
+  /*!
+   * \brief Channels that count as homed. Switched off channels are always included.
+   *
+   * The channel state masks are updated atomically by the homing and can be read from any thread
+   * without locking. Bit i stands for channel i, see SVH_ALL_CHANNELS_MASK.
+   */
+  uint16_t homedMask() const;
+
+  //! Channels that count as enabled, i.e. enabled in the controller or switched off
+  uint16_t enabledMask() const;
+
+  //! Channels that are switched off by the user
+  uint16_t switchedOffMask() const;
+
+  //! Channels whose last homing failed, cleared when the channel is homed again
+  uint16_t faultedMask() const;
+
   //! requests the current controller state to be updated
   //! @note This is a debuging function. Should not be called by users
   void requestControllerState();
@@ -282,6 +485,20 @@ public:
   //!
   void setResetSpeed(const float& speed);
 
+  //!
+  //! \brief setHomingProfile configures the fast approach and the detection of the hard stop
+  //! during homing, see SVHHomingProfile. Has to be called while disconnected.
+  //! \param profile profile used by the next homings
+  //! \return false if a factor is out of range or the manager is connected
+  //!
+  bool setHomingProfile(const SVHHomingProfile& profile);
+
+  //!
+  //! \brief homingTimings returns how long the phases of the last homing of a channel took
+  //! \param channel channel to get the timings for
+  //!
+  SVHHomingTimings homingTimings(const SVHChannel& channel);
+
   //!
   //! \brief setResetTimeout Helper function to set the timout durind rest of fingers
   //! \param resetTimeout timeout in Seconds. Values smaler than 0 will be interpreted as 0
@@ -311,6 +528,47 @@ public:
   //!
   double convertmAtoN(const SVHChannel& channel, const int16_t& current);
 
+  //!
+  //! \brief Converts joint positions of a specific channel from RAD to ticks factoring in the
+  //! offset of the channels \param channel Channel to Convert for (each one has different offset)
+  //! \param position The desired position given in RAD
+  //! \return The tick value corresponing to the RAD input
+  //!
+  int32_t convertRad2Ticks(const SVHChannel& channel, const double& position);
+
+  //!
+  //! \brief Converts joint positions of a specific channel from ticks to RAD factoring in the
+  //! offset of the channels \param channel Channel to Convert for (each one has different offset)
+  //! \param ticks The current position in ticks
+  //! \return the RAD Value corresponding to the tick value of a given channel
+  //!
+  double convertTicks2Rad(const SVHChannel& channel, const int32_t& ticks);
+
+  //!
+  //! \brief addPacketObserver registers a function that is called for every received packet of the
+  //! given type after the controller has processed it, see SVHController::addPacketObserver
+  //! \param type packet type, i.e. the lower nibble of the packet address
+  //! \param observer function to call, it is executed in the receive thread
+  //! \return true if the observer was registered
+  //!
+  bool addPacketObserver(const uint8_t& type, const SVHPacketHandler& observer);
+
+  //!
+  //! \brief subscribe registers for events of the hand, i.e. new feedback samples, controller state
+  //! changes, settings echoes and firmware info, instead of polling the getters
+  //! \param options event types, channels, deadbands and the thread that delivers the events
+  //! \param callback function called with every event, empty for SVH_DELIVER_QUEUE
+  //! \return the subscription, empty if the options were invalid
+  //!
+  std::shared_ptr<SVHSubscription> subscribe(const SVHSubscriptionOptions& options,
+                                             const SVHEventCallback& callback = SVHEventCallback());
+
+  //!
+  //! \brief unsubscribe removes a subscription, see SVHEventHub::unsubscribe
+  //! \return false if it was not registered
+  //!
+  bool unsubscribe(const std::shared_ptr<SVHSubscription>& subscription);
+
   //!
   //! \brief getFirmwareInfo Requests the firmware information from the harware, waits a bit and
   //! returns the last one read. \note  if no connection is open and the param dev_name is given, a
@@ -328,6 +586,11 @@ public:
   // ----------------------------------------------------------------------
 
 private:
+  //! Initializes the hand after \a open connected the controller, shared by the connect variants
+  bool connectController(const std::function<bool()>& open,
+                         const std::string& device_name,
+                         const unsigned int& retry_count);
+
   //! \brief pointer to svh controller
   SVHController* m_controller;
 
@@ -337,8 +600,11 @@ private:
   //! \brief Thread for polling periodic feedback from the hardware
   std::thread m_feedback_thread;
 
+  //! \brief Whether a reactor is used, feedback is not polled by m_feedback_thread then
+  bool m_uses_reactor;
+
   //! \brief holds the connected state
-  bool m_connected;
+  std::atomic<bool> m_connected;
 
   //! Helper variable to check if feedback was printed (will be replaced by a better solution in the
   //! future)
@@ -363,12 +629,181 @@ private:
   //! \brief home position after complete reset of each channel
   std::vector<int32_t> m_position_home;
 
-  //! \brief vector storing reset flags for each channel
-  std::vector<bool> m_is_homed;
+  //! Subscriptions to the events of the hand
+  SVHEventHub m_event_hub;
+
+  //! Last controller state published, to detect changes
+  SVHControllerState m_published_controller_state;
+
+  //! Whether m_published_controller_state holds a received state
+  bool m_controller_state_published;
+
+  //! Reactor given to setReactor, runs the asynchronous operations
+  std::shared_ptr<SVHReactor> m_reactor;
+
+  //! Guards m_async_operations
+  std::mutex m_async_mutex;
+
+  //! A running asynchronous operation
+  struct AsyncOperation
+  {
+    //! Identifies the operation, as task ids are reused once a task was removed
+    std::shared_ptr<int> id;
+    //! Reports the failure of the operation when it is cancelled
+    std::function<void()> cancel;
+  };
+
+  //! Running asynchronous operations by reactor task id
+  std::map<int, AsyncOperation> m_async_operations;
+
+  /*!
+   * \brief startAsync runs an operation as a task of the reactor
+   * \param period time between two steps
+   * \param step executes one step, returns whether the operation wants to be called again
+   * \param cancel reports the failure of the operation when it is cancelled by disconnect
+   * \return false if there is no running reactor
+   */
+  bool startAsync(const std::chrono::microseconds& period,
+                  const std::function<bool()>& step,
+                  const std::function<void()>& cancel);
+
+  //! Removes all running asynchronous operations and calls their cancel functions
+  void cancelAsyncOperations();
+
+  //! Opens the connection and starts the connection attempts of connectAsync
+  bool connectControllerAsync(const std::function<bool()>& open,
+                              const std::string& device_name,
+                              const SVHAsyncCallback& done,
+                              const unsigned int& retry_count);
+
+  //! Common part of the asynchronous settings round trips, sends the request and waits for the
+  //! echo of \a type that \a matches, any echo if it is empty
+  bool awaitSettingsAsync(const SVHChannel& channel,
+                          SVHEventType type,
+                          const std::function<bool()>& request,
+                          const std::function<bool(const SVHEvent&)>& matches,
+                          const std::function<void(bool, const SVHEvent&)>& done);
+
+  //! States of one connection attempt
+  enum ConnectState
+  {
+    CS_PENDING,   //!< Not all packets have been answered yet
+    CS_CONNECTED, //!< All packets have been answered
+    CS_TIMEOUT    //!< The answers did not arrive in time
+  };
+
+  //! Sends the initial settings and feedback requests of a connection attempt
+  void beginConnectAttempt();
+
+  //! Checks whether all packets of the current attempt have been answered
+  ConnectState checkConnectAttempt(const std::chrono::high_resolution_clock::time_point& start_time,
+                                   unsigned int& received_count);
+
+  //! Decides whether a failed attempt is retried, counts down \a num_retries
+  bool retryConnect(unsigned int received_count, unsigned int& num_retries);
+
+  //! Calibrates the gap, requests the firmware and starts polling, or closes a failed connection
+  void finishConnect(const std::string& device_name, bool calibrate_gap);
+
+  //! Phases of the homing of one channel
+  enum HomingPhase
+  {
+    HP_FAST_APPROACH,      //!< Drive quickly to a margin before the expected hard stop
+    HP_FIND_HARDSTOP,      //!< Drive against the hard stop until the current rises
+    HP_VERIFY_CALIBRATION, //!< Short move to check a restored calibration instead
+    HP_GO_TO_IDLE,         //!< Drive back to the idle position
+    HP_DONE                //!< Finished, see HomingProcess::success
+  };
+
+  //! State of the homing of one channel, advanced step by step
+  struct HomingProcess
+  {
+    SVHChannel channel;
+    HomingPhase phase;
+    //! Whether the homing finished without a timeout at the hard stop
+    bool success;
+    SVHHomeSettings home;
+    SVHCurrentSettings cur_set;
+    //! Current target in ticks
+    int32_t position;
+    SVHControllerFeedback control_feedback;
+    SVHControllerFeedback control_feedback_previous;
+    std::chrono::high_resolution_clock::time_point start_time;
+    std::chrono::high_resolution_clock::time_point start_time_log;
+    //! Debug helper to just notify about fresh stales
+    bool stale_notification_sent;
+    size_t hit_count;
+    //! Start of the current phase in the trace, 0 while tracing is disabled
+    uint64_t trace_start_ns;
+    //! Target of the slow search behind the hard stop
+    int32_t search_position;
+    //! Whether the current is at the detection threshold since contact_start
+    bool contact;
+    std::chrono::high_resolution_clock::time_point contact_start;
+    int32_t contact_position;
+    //! Fastest speed seen during the slow search in ticks per second, and the last sample of it
+    double peak_speed;
+    std::chrono::high_resolution_clock::time_point speed_sample_time;
+    int32_t speed_sample_position;
+    std::chrono::high_resolution_clock::time_point homing_start;
+    std::chrono::high_resolution_clock::time_point phase_start;
+    SVHHomingTimings timings;
+  };
+
+  //! Prepares the homing of a valid channel, switched off channels are done immediately
+  void startHoming(HomingProcess& homing, const SVHChannel& channel);
+
+  //! Sends one target and evaluates the feedback, returns false once the homing is done
+  bool stepHoming(HomingProcess& homing);
+
+  //! Starts driving the channel of \a homing to its hard stop, quickly if it is known
+  void startHardstopSearch(HomingProcess& homing);
+
+  //! Starts the search of the hard stop at the reset speed and the reduced current limits
+  void startSlowSearch(HomingProcess& homing);
+
+  //! Restores the current limits lowered by startSlowSearch
+  void restoreSearchCurrent(const HomingProcess& homing);
+
+  //! Adds the time spent in the current phase to the timings and switches to \a phase. The
+  //! timings are published once the homing is done.
+  void enterHomingPhase(HomingProcess& homing, HomingPhase phase);
+
+  //! Starts the plausibility move if the channel has a restored calibration, returns false if not
+  bool startCalibrationCheck(HomingProcess& homing);
+
+  //! Loads the stored calibration of the connected hand and checks it against the encoders
+  void restoreHomingCalibration(const std::string& device_name);
+
+  //! Updates the calibration of a channel from its soft stops and stores it if a file is given
+  void storeHomingCalibration(const SVHChannel& channel, bool valid, int32_t encoder_position);
+
+  //! Stores the last encoder positions of all calibrated channels, called before disconnecting
+  void storeHomingCalibrationPositions();
+
+  //! \brief Stores the encoder positions of calibrated fingers that settled somewhere else, at
+  //! most once per second. Called with every feedback poll so that a crashed process leaves a
+  //! recent position in the cache file.
+  void refreshHomingCalibrationPositions();
+
+  //! Observer of the decoded packets that turns them into events for the subscriptions
+  void publishEvents(const SVHSerialPacket& packet);
 
-  //! vector storing information if a finger is enabled. In Case it is all request for it will be
-  //! granted but not executed on hardware
-  std::vector<bool> m_is_switched_off;
+  //! Publishes the latest feedback of a homed channel, see getPosition and getCurrent
+  void publishFeedback(SVHEvent& event, const SVHChannel& channel);
+
+  //! \brief reset flags, bit i is set when channel i has been homed
+  std::atomic<uint16_t> m_homed_mask;
+
+  //! bit i is set if channel i is switched off by the user. All requests for it will be granted but
+  //! not executed on hardware
+  std::atomic<uint16_t> m_switched_off_mask;
+
+  //! \brief bit i is set when the last homing of channel i failed
+  std::atomic<uint16_t> m_faulted_mask;
+
+  //! Atomically set or clear the bits of \a mask in \a flags
+  static void updateMask(std::atomic<uint16_t>& flags, uint16_t mask, bool set);
 
   //! \brief vectors storing diagnostic information, encoder state
   std::vector<bool> m_diagnostic_encoder_state;
@@ -397,6 +832,45 @@ private:
   //! Time in seconds after which the a reset is aborted if no change in current is observable
   std::chrono::seconds m_reset_timeout;
 
+  //! Parameters of the gap calibration on connect
+  SVHGapCalibrationSettings m_gap_calibration;
+
+  //! Outcome of the gap calibration of the last connect
+  SVHGapCalibrationReport m_gap_calibration_report;
+
+  //! Parameters of the persisted homing calibration
+  SVHHomingCalibrationSettings m_homing_calibration;
+
+  //! protects the calibrations, hints and timings below, homing may run in the reactor thread
+  std::mutex m_homing_calibration_mutex;
+
+  //! Calibration of every channel of the connected hand
+  std::vector<SVHChannelCalibration> m_channel_calibrations;
+
+  //! Outcome of the verification of the last connect and of the plausibility moves since
+  SVHHomingCalibrationReport m_homing_calibration_report;
+
+  //! Bit i is set while channel i has a restored calibration that was not checked yet
+  uint16_t m_unchecked_calibration_mask;
+
+  //! Encoder positions at the last refresh of the stored positions, to tell settled fingers
+  std::vector<int32_t> m_calibration_position_samples;
+
+  //! Time of the last refresh of the stored positions
+  std::chrono::steady_clock::time_point m_calibration_position_time;
+
+  //! Expected position of the hard stop of every channel, from the last homing or calibration
+  std::vector<int32_t> m_hardstop_hints;
+
+  //! Bit i is set if m_hardstop_hints holds a position for channel i
+  uint16_t m_hardstop_hint_mask;
+
+  //! Timings of the last homing of every channel
+  std::vector<SVHHomingTimings> m_homing_timings;
+
+  //! Parameters of the hard stop search
+  SVHHomingProfile m_homing_profile;
+
   //! Vector of current controller parameters for each finger (as given by external config)
   std::vector<SVHCurrentSettings> m_current_settings;
 
@@ -434,22 +908,6 @@ private:
    */
   std::vector<double> m_reset_current_factor;
 
-  //!
-  //! \brief Converts joint positions of a specific channel from RAD to ticks factoring in the
-  //! offset of the channels \param channel Channel to Convert for (each one has different offset)
-  //! \param position The desired position given in RAD
-  //! \return The tick value corresponing to the RAD input
-  //!
-  int32_t convertRad2Ticks(const SVHChannel& channel, const double& position);
-
-  //!
-  //! \brief Converts joint positions of a specific channel from ticks to RAD factoring in the
-  //! offset of the channels \param channel Channel to Convert for (each one has different offset)
-  //! \param ticks The current position in ticks
-  //! \return the RAD Value corresponding to the tick value of a given channel
-  //!
-  double convertTicks2Rad(const SVHChannel& channel, const int32_t& ticks);
-
   //!
   //! \brief Converts joint efforts of a specific channel from force [N] to current [mA] factoring
   //! the effort_constants of the channels \param channel Channel to Convert for (each one has
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the calibration of the gap between two frames. The
+ * hardware drops frames that follow each other too closely, how closely
+ * depends on the hand and the computer it is connected to. The calibration
+ * probes shorter and shorter gaps with feedback requests and keeps the
+ * shortest one that was answered completely, plus a safety margin. Results
+ * are cached per device so that the probing only runs once per hand.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_GAP_CALIBRATION_H_INCLUDED
+#define DRIVER_SVH_SVH_GAP_CALIBRATION_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/control/SVHController.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+//! Parameters of the gap calibration, see SVHFingerManager::setGapCalibration
+struct SVHGapCalibrationSettings
+{
+  //! Whether connect calibrates the gap, the gap of the transport options is used otherwise
+  bool enabled = false;
+  //! Gap the probing starts with, it is also the longest gap that is ever used
+  std::chrono::microseconds longest_gap{782};
+  //! Gap the probing stops at if every probe was answered
+  std::chrono::microseconds shortest_gap{100};
+  //! Amount by which the gap is shortened from one probe to the next
+  std::chrono::microseconds step{50};
+  //! Number of feedback requests sent per probe
+  unsigned int probe_frames = 20;
+  //! Time the replies to a probe may take after its last request was sent
+  std::chrono::microseconds reply_timeout{100000};
+  //! Fraction of the shortest answered gap added on top of it
+  double safety_margin = 0.2;
+  //! File the calibrated gaps are cached in, one line per device. Empty disables the cache. It may
+  //! be the cache file of the homing calibration as well.
+  std::string cache_file;
+  //! Root of the sysfs tree the serial number of USB adapters is read from
+  std::string sysfs_root = "/sys";
+};
+
+//! Result of probing one gap
+struct SVHGapProbe
+{
+  //! Probed gap
+  std::chrono::microseconds gap{0};
+  //! Number of requests sent
+  unsigned int sent = 0;
+  //! Number of replies received
+  unsigned int answered = 0;
+};
+
+//! Outcome of a calibration
+struct SVHGapCalibrationReport
+{
+  //! Whether a gap was determined, either by probing or from the cache
+  bool calibrated = false;
+  //! Whether the gap was read from the cache instead of being probed
+  bool cached = false;
+  //! Device the gap belongs to, the serial number of USB adapters or the device name
+  std::string device;
+  //! Gap used from now on
+  std::chrono::microseconds gap{0};
+  //! Probes in the order they were run, empty if the gap was cached
+  std::vector<SVHGapProbe> probes;
+};
+
+/*!
+ * \brief Determines the shortest gap between two frames the hand still answers completely
+ *
+ * Each probe sends a number of feedback requests, which do not change the state of the hand, with
+ * the probed gap and waits for their replies. The probing starts at the longest gap and stops at
+ * the first probe that was not answered completely, so the hand is flooded at most once.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHGapCalibration
+{
+public:
+  explicit SVHGapCalibration(const SVHGapCalibrationSettings& settings);
+
+  /*!
+   * \brief run determines the gap for a connected controller and sets it. Nothing else may be
+   * sent to the hand meanwhile, so the feedback polling must not be running yet.
+   * \param controller connected controller
+   * \param device_name name of the device the controller is connected to
+   * \return report of the calibration, the gap is left as it was if it did not succeed
+   */
+  SVHGapCalibrationReport run(SVHController& controller, const std::string& device_name);
+
+  /*!
+   * \brief deviceIdentifier identifies the hand behind a device
+   * \param device_name e.g. /dev/ttyUSB0 or a link to it in /dev/serial/by-id
+   * \param sysfs_root root of the sysfs tree
+   * \return serial number of the USB adapter if it has one, the device name otherwise
+   */
+  static std::string deviceIdentifier(const std::string& device_name,
+                                      const std::string& sysfs_root = "/sys");
+
+  /*!
+   * \brief loadGap reads the cached gap of a device
+   * \return false if the file or an entry for the device does not exist
+   */
+  static bool loadGap(const std::string& cache_file,
+                      const std::string& device,
+                      std::chrono::microseconds& gap);
+
+  /*!
+   * \brief storeGap writes the gap of a device into the cache, entries of other devices are kept
+   * \return false if the file could not be written
+   */
+  static bool storeGap(const std::string& cache_file,
+                       const std::string& device,
+                       const std::chrono::microseconds& gap);
+
+private:
+  //! Sends one probe with the given gap
+  SVHGapProbe probe(SVHController& controller, const std::chrono::microseconds& gap);
+
+  SVHGapCalibrationSettings m_settings;
+};
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the hand group that sends commands to several SCHUNK
+ * five finger hands at the same time. The commands of all hands are prepared
+ * first and their frames are then written back to back, so the hands receive
+ * them within a small, measured skew instead of one frame time apart.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_HAND_GROUP_H_INCLUDED
+#define DRIVER_SVH_SVH_HAND_GROUP_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+
+#include <chrono>
+#include <vector>
+
+namespace driver_svh {
+
+//! Outcome of a group command
+struct SVHGroupDispatchReport
+{
+  //! Whether the command was accepted and written for every hand
+  bool success = false;
+  //! Time between the first and the last command frame being handed to the serial devices
+  std::chrono::nanoseconds skew{0};
+  //! Whether the skew stayed within the bound of the group
+  bool within_bound = false;
+  //! Write time of the command frame of every hand relative to the earliest one, 0 for hands that
+  //! did not write one
+  std::vector<std::chrono::nanoseconds> offsets;
+};
+
+/*!
+ * \brief Sends commands to several hands within a bounded skew
+ *
+ * Every hand first queues the packets of its command. Packets that precede the command, e.g. the
+ * enabling of channels, are written with the usual pacing. The last packet of every hand is then
+ * written back to back once all hands may send again. The skew is measured on the write calls,
+ * latencies of the serial adapters are not included.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHHandGroup
+{
+public:
+  /*!
+   * \brief Creates an empty group
+   * \param max_skew skew above which a group command is reported as out of bound
+   */
+  explicit SVHHandGroup(const std::chrono::microseconds& max_skew = std::chrono::microseconds(200));
+
+  /*!
+   * \brief addHand adds a hand to the group, it has to outlive the group
+   * \return index of the hand within the group
+   */
+  size_t addHand(SVHFingerManager& hand);
+
+  //! Number of hands in the group
+  size_t size() const { return m_hands.size(); }
+
+  /*!
+   * \brief setAllTargetPositions sets the target positions of all channels of all hands, see
+   * SVHFingerManager::setAllTargetPositions
+   * \param positions target positions in rad, one vector per hand in the order they were added
+   * \param report optional outcome including the measured skew
+   * \return true if the command was accepted and written for every hand. If a hand rejects its
+   * command, the commands of the other hands are still released.
+   */
+  bool setAllTargetPositions(const std::vector<std::vector<double> >& positions,
+                             SVHGroupDispatchReport* report = nullptr);
+
+private:
+  std::vector<SVHFingerManager*> m_hands;
+
+  std::chrono::microseconds m_max_skew;
+};
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the persisted homing calibration. The soft stops and
+ * the idle position of a channel are derived from its hard stop, so they
+ * are only valid as long as the encoders keep counting. They are stored per
+ * hand together with the encoder position at the time, which lets the next
+ * connect reuse them if the hand was not switched off in between.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_HOMING_CALIBRATION_H_INCLUDED
+#define DRIVER_SVH_SVH_HOMING_CALIBRATION_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+//! Parameters of the persisted homing calibration, see SVHFingerManager::setHomingCalibration
+struct SVHHomingCalibrationSettings
+{
+  //! Whether homed channels keep their calibration for the next connect
+  bool enabled = false;
+  //! File the calibrations are stored in, one line per channel and device. Empty keeps them in
+  //! memory only, for reconnects of the same finger manager. It may be the cache file of the gap
+  //! calibration as well.
+  std::string cache_file;
+  //! Ticks an encoder may differ from its stored position, e.g. because a finger was moved by hand
+  int32_t position_tolerance = 1000;
+  //! Length of the plausibility move that replaces the homing of a restored channel in ticks
+  int32_t plausibility_distance = 5000;
+  //! Root of the sysfs tree the serial number of USB adapters is read from
+  std::string sysfs_root = "/sys";
+};
+
+//! Calibration of one channel in encoder ticks
+struct SVHChannelCalibration
+{
+  //! Whether the channel was homed successfully
+  bool valid = false;
+  int32_t position_min  = 0;
+  int32_t position_max  = 0;
+  int32_t position_home = 0;
+  //! Encoder position when the calibration was last stored
+  int32_t encoder_position = 0;
+};
+
+//! Outcome of the verification on connect and of the plausibility moves
+struct SVHHomingCalibrationReport
+{
+  //! Device the calibration belongs to, the serial number of USB adapters or the device name
+  std::string device;
+  //! Whether a calibration was stored for the device
+  bool loaded = false;
+  //! Bit i is set if the stored calibration of channel i matched its encoder on connect, its
+  //! homing is replaced by a plausibility move
+  uint16_t restored_mask = 0;
+  //! Bit i is set if channel i passed the plausibility move and kept its calibration
+  uint16_t verified_mask = 0;
+};
+
+/*!
+ * \brief Stores and checks the calibrations of homed channels
+ *
+ * A hand that is switched off loses its encoder positions and starts counting at zero again. A
+ * stored calibration is therefore only accepted while the encoder is still close to the position
+ * stored with it. A finger resting near the position the hand was switched on at cannot be told
+ * apart that way, which is what the plausibility move before the calibration is used is for.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHHomingCalibration
+{
+public:
+  /*!
+   * \brief load reads the stored calibrations of a device
+   * \param calibrations resized to one entry per channel, channels without entry are invalid
+   * \return false if the file or an entry for the device does not exist
+   */
+  static bool load(const std::string& cache_file,
+                   const std::string& device,
+                   std::vector<SVHChannelCalibration>& calibrations);
+
+  /*!
+   * \brief store writes the valid calibrations of a device, entries of other devices are kept
+   * \return false if the file could not be written
+   */
+  static bool store(const std::string& cache_file,
+                    const std::string& device,
+                    const std::vector<SVHChannelCalibration>& calibrations);
+
+  /*!
+   * \brief isConsistent checks whether a stored calibration still fits the encoder
+   * \param calibration stored calibration of the channel
+   * \param encoder_position position reported by the channel now
+   * \param tolerance ticks the position may differ from the stored one
+   */
+  static bool isConsistent(const SVHChannelCalibration& calibration,
+                           int32_t encoder_position,
+                           int32_t tolerance);
+};
+
+} // namespace driver_svh
+
+#endif
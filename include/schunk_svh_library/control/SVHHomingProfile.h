@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the profile of the hard stop search during homing and
+ * the timings reported for it. Where the hard stop of a channel is known
+ * from an earlier homing, the channel approaches it quickly up to a margin
+ * and searches the rest of the way at the reset speed. The stop counts as
+ * found once the current stayed at the detection threshold for a while
+ * and the channel stopped moving.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_HOMING_PROFILE_H_INCLUDED
+#define DRIVER_SVH_SVH_HOMING_PROFILE_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+
+namespace driver_svh {
+
+//! Parameters of the hard stop search, see SVHFingerManager::setHomingProfile
+struct SVHHomingProfile
+{
+  //! Whether channels with a known hard stop approach it quickly before searching it slowly
+  bool fast_approach = true;
+  //! Speed of the fast approach as a fraction of the normal speed of the channel, 0 < x <= 1
+  float approach_speed_factor = 1.0f;
+  //! Distance in ticks before the expected hard stop at which the slow search takes over
+  int32_t approach_margin = 10000;
+  //! Scales the current limits during the slow search, 0 < x <= 1. Lower values detect the hard
+  //! stop with less force, but the friction of the channel has to stay below the threshold.
+  float search_current_factor = 1.0f;
+  //! Time the current has to stay at the detection threshold before the hard stop counts as found
+  std::chrono::milliseconds contact_time{50};
+  //! Fraction of the fastest speed seen during the search below which the channel counts as
+  //! standing, 0 <= x <= 1
+  double stall_speed_factor = 0.25;
+  //! Distance in ticks a standing channel may still move during contact_time
+  int32_t stall_ticks = 100;
+};
+
+//! Durations of the phases of the last homing of a channel
+struct SVHHomingTimings
+{
+  //! Fast approach towards the expected hard stop
+  std::chrono::microseconds fast_approach{0};
+  //! Slow search of the hard stop
+  std::chrono::microseconds hardstop_search{0};
+  //! Plausibility move of a restored calibration, see SVHHomingCalibration
+  std::chrono::microseconds calibration_check{0};
+  //! Move to the idle position
+  std::chrono::microseconds go_to_idle{0};
+  //! Complete homing, including the settings sent in between
+  std::chrono::microseconds total{0};
+  //! Whether the channel met its hard stop during the fast approach, before it was expected
+  bool early_contact = false;
+};
+
+} // namespace driver_svh
+
+#endif
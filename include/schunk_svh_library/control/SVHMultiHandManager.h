@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the multi hand manager that drives several SCHUNK five
+ * finger hands from one process. All serial devices are serviced by a single
+ * reactor thread which also polls the feedback of every hand, so the number of
+ * threads does not grow with the number of hands. Each hand keeps its own
+ * finger manager with the complete single hand interface.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_MULTI_HAND_MANAGER_H_INCLUDED
+#define DRIVER_SVH_SVH_MULTI_HAND_MANAGER_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/control/SVHHandGroup.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace driver_svh {
+
+//! Counters and state of a single hand of the multi hand manager
+struct SVHHandStatistics
+{
+  //! Counters of the receiving side of the serial interface
+  SVHReceiveStatistics receive;
+  //! Counters of the transmitting side of the serial interface
+  SVHTransmitStatistics transmit;
+  //! Number of feedback requests sent by the poll timer
+  uint64_t feedback_polls = 0;
+  //! Whether the hand is connected
+  bool connected = false;
+  //! Whether the serial device of the hand failed, the hand is not polled anymore then
+  bool failed = false;
+};
+
+/*!
+ * \brief Manages several SCHUNK five finger hands with one shared I/O thread
+ *
+ * Hands are added with addHand() and addressed by the returned index. A broken connection of
+ * one hand is detected and isolated, the remaining hands keep being serviced.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHMultiHandManager
+{
+public:
+  /*!
+   * \brief Creates the manager and starts the shared reactor thread
+   * \param poll_period time between two feedback requests sent to every connected hand
+   */
+  explicit SVHMultiHandManager(
+    const std::chrono::milliseconds& poll_period = std::chrono::milliseconds(100));
+
+  //! Disconnects all hands and stops the reactor thread
+  ~SVHMultiHandManager();
+
+  /*!
+   * \brief addHand adds a hand, the parameters are passed on to its SVHFingerManager
+   * \return index of the new hand
+   */
+  size_t addHand(const std::vector<bool>& disable_mask = std::vector<bool>(9, false),
+                 const uint32_t& reset_timeout         = 5);
+
+  //! Number of hands that were added
+  size_t size();
+
+  /*!
+   * \brief hand gives access to the complete single hand interface of a hand
+   * \param index index returned by addHand
+   * \return finger manager of the hand, throws std::out_of_range for invalid indices
+   */
+  SVHFingerManager& hand(size_t index);
+
+  /*!
+   * \brief connect opens the connection to a hand, see SVHFingerManager::connect. This blocks the
+   * caller until the hand answered, other hands are serviced in the meantime.
+   * \param index index returned by addHand
+   * \param dev_name file handle of the serial device e.g. "/dev/ttyUSB0"
+   * \param retry_count number of connection attempts
+   * \return true if the connection was established
+   */
+  bool connect(size_t index, const std::string& dev_name, const unsigned int& retry_count = 3);
+
+  //! disconnect a single hand
+  void disconnect(size_t index);
+
+  /*!
+   * \brief setAllTargetPositions commands all hands at the same time, see SVHHandGroup
+   * \param positions target positions in rad, one vector per hand
+   * \param report optional outcome including the measured skew between the hands
+   * \return true if the command was accepted and written for every hand
+   */
+  bool setAllTargetPositions(const std::vector<std::vector<double> >& positions,
+                             SVHGroupDispatchReport* report = nullptr);
+
+  //! disconnect all hands
+  void disconnectAll();
+
+  /*!
+   * \brief statistics returns the counters and state of a hand
+   * \param index index returned by addHand
+   * \return empty statistics for invalid indices
+   */
+  SVHHandStatistics statistics(size_t index);
+
+  //! Counters of the shared reactor, i.e. the wakeups of the I/O thread of all hands
+  SVHReactorStatistics reactorStatistics() const;
+
+private:
+  //! A single hand and its counters
+  struct Hand
+  {
+    std::unique_ptr<SVHFingerManager> manager;
+    std::atomic<uint64_t> feedback_polls{0};
+  };
+
+  //! Sends a feedback request to every connected hand, called by the poll timer. The requests are
+  //! queued without waiting for the hands, see SVHSerialInterface::sendPacket
+  void pollFeedback();
+
+  //! Returns the hand of the given index or nullptr
+  Hand* findHand(size_t index);
+
+  //! Reactor servicing the serial devices and the poll timer of all hands
+  std::shared_ptr<SVHReactor> m_reactor;
+
+  //! Timer of the feedback polling
+  int m_poll_timer;
+
+  //! protects m_hands
+  std::mutex m_hands_mutex;
+
+  //! keeps a hand from being disconnected while it is polled
+  std::mutex m_poll_mutex;
+
+  std::vector<std::unique_ptr<Hand>> m_hands;
+};
+
+} // namespace driver_svh
+
+#endif
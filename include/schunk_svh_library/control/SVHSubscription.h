@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the subscriptions to events of a hand: new feedback
+ * samples, changes of the controller state, echoes of controller settings
+ * and firmware information. Subscribers choose the events and channels
+ * they are interested in, deadbands for the feedback and whether they are
+ * called from the receive thread, from a dispatch thread or fetch the
+ * events from a lock free queue themselves.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_SUBSCRIPTION_H_INCLUDED
+#define DRIVER_SVH_SVH_SUBSCRIPTION_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/SVHFirmwareInfo.h>
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHControllerState.h>
+#include <schunk_svh_library/control/SVHCurrentSettings.h>
+#include <schunk_svh_library/control/SVHPositionSettings.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace driver_svh {
+
+//! Kinds of events a subscription can receive
+enum SVHEventType
+{
+  SVH_EVENT_FEEDBACK,          //!< New position and current of one homed channel
+  SVH_EVENT_CONTROLLER_STATE,  //!< The controller state reported by the hand changed
+  SVH_EVENT_POSITION_SETTINGS, //!< Position controller settings of one channel were echoed
+  SVH_EVENT_CURRENT_SETTINGS,  //!< Current controller settings of one channel were echoed
+  SVH_EVENT_FIRMWARE_INFO,     //!< Firmware information was received
+  SVH_EVENT_TYPE_DIMENSION     //!< Number of event types
+};
+
+//! Mask of all event types for SVHSubscriptionOptions::events, bit i stands for event type i
+const uint32_t SVH_ALL_EVENTS = (1u << SVH_EVENT_TYPE_DIMENSION) - 1;
+
+//! One event, only the members belonging to its type are filled
+struct SVHEvent
+{
+  SVHEventType type = SVH_EVENT_FEEDBACK;
+  //! Channel of feedback and settings, SVH_ALL for controller state and firmware info
+  SVHChannel channel = SVH_ALL;
+  //! Time the packet was handed to the finger manager by the receive thread
+  std::chrono::steady_clock::time_point stamp;
+  //! Position in rad, see SVHFingerManager::getPosition
+  double position = 0.0;
+  //! Current in mA
+  double current = 0.0;
+  SVHControllerState controller_state;
+  SVHPositionSettings position_settings;
+  SVHCurrentSettings current_settings;
+  SVHFirmwareInfo firmware_info;
+};
+
+//! Function called with the events of a subscription
+using SVHEventCallback = std::function<void(const SVHEvent& event)>;
+
+//! Thread that delivers the events of a subscription
+enum SVHEventDelivery
+{
+  //! The callback runs in the receive thread. It must return quickly and must not (un)subscribe.
+  SVH_DELIVER_RECEIVE_THREAD,
+  //! The callback runs in a dispatch thread shared by the subscriptions of one finger manager, so a
+  //! slow subscriber does not hold up the reception
+  SVH_DELIVER_DISPATCH_THREAD,
+  //! There is no callback, the events are fetched with SVHSubscription::poll
+  SVH_DELIVER_QUEUE
+};
+
+//! What a subscription receives and how
+struct SVHSubscriptionOptions
+{
+  //! Event types to receive, bit i stands for SVHEventType i
+  uint32_t events = SVH_ALL_EVENTS;
+  //! Channels to receive feedback and settings of, see SVH_ALL_CHANNELS_MASK. Events that concern
+  //! the whole hand are always received.
+  uint16_t channels = SVH_ALL_CHANNELS_MASK;
+  //! Feedback is only received when position or current moved by more than their deadband since
+  //! the last sample received of that channel, with a deadband of 0 any change counts. With both
+  //! at 0 every sample is received.
+  double position_deadband = 0.0;
+  //! Deadband of the current in mA, see position_deadband
+  double current_deadband = 0.0;
+  SVHEventDelivery delivery = SVH_DELIVER_RECEIVE_THREAD;
+  //! Events buffered for the dispatch thread or for polling, rounded up to a power of two. Events
+  //! that do not fit are dropped and counted.
+  size_t queue_capacity = 1024;
+};
+
+/*!
+ * \brief One subscription, created by SVHFingerManager::subscribe
+ *
+ * Queued events are kept in a lock free ring buffer with a single writer and a single reader. The
+ * writer is the receive thread, the reader is the dispatch thread or the one thread calling poll().
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHSubscription
+{
+public:
+  /*!
+   * \brief poll fetches the oldest queued event of an SVH_DELIVER_QUEUE subscription
+   * \param event receives the event
+   * \return false if no event was queued
+   */
+  bool poll(SVHEvent& event);
+
+  //! Events that passed the filters and were delivered or queued
+  uint64_t deliveredCount() const { return m_delivered; }
+
+  //! Events that passed the filters but were dropped as the queue was full
+  uint64_t droppedCount() const { return m_dropped; }
+
+  //! False once the subscription was removed
+  bool isActive() const { return m_active; }
+
+  const SVHSubscriptionOptions& options() const { return m_options; }
+
+private:
+  friend class SVHEventHub;
+
+  SVHSubscription(const SVHSubscriptionOptions& options, const SVHEventCallback& callback);
+
+  //! Whether the event passes the filters, updates the deadband reference of the channel
+  bool accepts(const SVHEvent& event);
+
+  //! Queues an event, returns true if the queue was empty before
+  bool push(const SVHEvent& event);
+
+  //! Takes the oldest queued event
+  bool pop(SVHEvent& event);
+
+  SVHSubscriptionOptions m_options;
+
+  SVHEventCallback m_callback;
+
+  //! Ring of queued events, its size is a power of two
+  std::vector<SVHEvent> m_ring;
+
+  //! Next slot to write, only advanced by the writer
+  std::atomic<size_t> m_head;
+
+  //! Next slot to read, only advanced by the reader
+  std::atomic<size_t> m_tail;
+
+  //! Last received sample per channel, the reference of the deadbands
+  double m_last_position[SVH_DIMENSION];
+  double m_last_current[SVH_DIMENSION];
+  uint16_t m_sampled_mask;
+
+  std::atomic<uint64_t> m_delivered;
+  std::atomic<uint64_t> m_dropped;
+  std::atomic<bool> m_active;
+};
+
+/*!
+ * \brief Distributes the events of one hand to its subscriptions
+ *
+ * publish() is called from the receive thread. The dispatch thread is started with the first
+ * subscription that needs it.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHEventHub
+{
+public:
+  SVHEventHub();
+
+  //! Stops the dispatch thread
+  ~SVHEventHub();
+
+  /*!
+   * \brief subscribe adds a subscription
+   * \param options what to receive and how
+   * \param callback function to call, has to be empty for SVH_DELIVER_QUEUE only
+   * \return the subscription, empty if the options were invalid
+   */
+  std::shared_ptr<SVHSubscription> subscribe(const SVHSubscriptionOptions& options,
+                                             const SVHEventCallback& callback);
+
+  /*!
+   * \brief unsubscribe removes a subscription. Its callback is not running anymore and will not be
+   * called again once this returns, unless called from that callback.
+   * \return false if the subscription was not registered
+   */
+  bool unsubscribe(const std::shared_ptr<SVHSubscription>& subscription);
+
+  //! Delivers an event to all subscriptions whose filters it passes
+  void publish(const SVHEvent& event);
+
+  //! Union of the event types of all subscriptions, lets the publisher skip unwanted events cheaply
+  uint32_t subscribedEvents() const { return m_subscribed_events; }
+
+private:
+  //! Main loop of the dispatch thread
+  void dispatch();
+
+  //! Guards the list of subscriptions, held while receive thread callbacks run
+  std::mutex m_mutex;
+
+  std::vector<std::shared_ptr<SVHSubscription> > m_subscriptions;
+
+  std::atomic<uint32_t> m_subscribed_events;
+
+  std::thread m_dispatch_thread;
+
+  //! Guards the wake up of the dispatch thread
+  std::mutex m_dispatch_mutex;
+
+  //! Held while the dispatch thread runs callbacks
+  std::mutex m_callback_mutex;
+
+  std::condition_variable m_dispatch_cv;
+
+  bool m_dispatch_pending;
+
+  bool m_dispatch_stop;
+};
+
+} // namespace driver_svh
+
+#endif
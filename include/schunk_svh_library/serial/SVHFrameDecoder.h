@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHFrameDecoder that extracts serial packets from
+ * a byte stream. It accepts the stream in chunks of arbitrary size, searches
+ * for the packet header with memchr, validates the checksum in one pass and
+ * hands complete frames to the caller as views without copying them.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_FRAME_DECODER_H_INCLUDED
+#define DRIVER_SVH_SVH_FRAME_DECODER_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace driver_svh {
+
+/*!
+ * \brief A decoded frame. The payload points into memory owned by the decoder or the caller of
+ * SVHFrameDecoder::feed and is only valid during the frame callback. The two checksum bytes
+ * directly follow the payload.
+ */
+struct SVHFrameView
+{
+  uint8_t index;
+  uint8_t address;
+  const uint8_t* payload;
+  uint16_t length;
+};
+
+//! Function called for every frame with a valid checksum
+using SVHFrameCallback = std::function<void(const SVHFrameView& frame)>;
+
+//! Counters of a frame decoder
+struct SVHFrameDecoderStatistics
+{
+  //! Number of frames with a valid checksum
+  uint64_t frames = 0;
+  //! Number of frames that were dropped due to a checksum error
+  uint64_t checksum_errors = 0;
+  //! Number of headers that were dropped as their length exceeded C_MAXIMUM_PACKET_SIZE
+  uint64_t oversized_frames = 0;
+  //! Number of bytes that did not belong to a valid frame
+  uint64_t skipped_bytes = 0;
+};
+
+/*!
+ * \brief Incremental decoder of the frames of the serial protocol
+ *
+ * A frame consists of the two header bytes, index, address, the payload length as little endian
+ * uint16, the payload and two checksum bytes. After an error the search for the next header starts
+ * right after the header of the broken frame, so no valid frame is lost.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHFrameDecoder
+{
+public:
+  //! Size of the header in front of the payload
+  static const size_t C_FRAME_HEADER_SIZE = 6;
+
+  //! Size of the largest valid frame
+  static const size_t C_MAXIMUM_FRAME_SIZE = C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE;
+
+  SVHFrameDecoder();
+
+  /*!
+   * \brief feed decodes the next chunk of the byte stream
+   * \param data start of the chunk
+   * \param size number of bytes in the chunk
+   * \param callback function called for every complete frame with a valid checksum
+   * \param rejected optional function called for every complete frame with a checksum error
+   * \return number of frames found in this chunk
+   */
+  size_t feed(const uint8_t* data,
+              size_t size,
+              const SVHFrameCallback& callback,
+              const SVHFrameCallback& rejected = SVHFrameCallback());
+
+  //! Drops a partially received frame
+  void reset() { m_fill = 0; }
+
+  //! Number of bytes kept for a frame that is not complete yet
+  size_t pendingBytes() const { return m_fill; }
+
+  //! Counters since construction
+  const SVHFrameDecoderStatistics& statistics() const { return m_statistics; }
+
+private:
+  /*!
+   * \brief parse decodes all complete frames of a contiguous span
+   * \return number of bytes consumed, the rest is the beginning of an incomplete frame
+   */
+  size_t parse(const uint8_t* data,
+               size_t size,
+               const SVHFrameCallback& callback,
+               const SVHFrameCallback& rejected);
+
+  //! Keeps the beginning of a frame that was split between two chunks
+  std::array<uint8_t, C_MAXIMUM_FRAME_SIZE> m_buffer;
+
+  //! Number of valid bytes in m_buffer
+  size_t m_fill;
+
+  SVHFrameDecoderStatistics m_statistics;
+};
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHPacketRecorder that keeps a flight record of
+ * the serial communication. Every sent and received frame is copied into a
+ * fixed-size ring of records in a memory-mapped file. Recording a frame is a
+ * memcpy without any system call, and as the pages belong to the kernel the
+ * records are on disk even if the process crashes.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_PACKET_RECORDER_H_INCLUDED
+#define DRIVER_SVH_SVH_PACKET_RECORDER_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+#include <schunk_svh_library/serial/Serial.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+//! Direction of a recorded frame
+enum SVHCaptureDirection
+{
+  CD_TRANSMIT = 0,
+  CD_RECEIVE  = 1
+};
+
+//! What happened to a recorded frame
+enum SVHCaptureStatus
+{
+  //! Sent completely, or received with a valid checksum
+  CS_OK = 0,
+  //! Received with a checksum error and dropped
+  CS_CHECKSUM_ERROR = 1,
+  //! Could not be written to the device completely
+  CS_WRITE_FAILED = 2
+};
+
+//! Header at the start of a capture file
+struct SVHCaptureFileHeader
+{
+  //! C_CAPTURE_MAGIC
+  char magic[8];
+  //! Format version, C_CAPTURE_VERSION
+  uint32_t version;
+  //! Size of one record in bytes
+  uint32_t record_size;
+  //! Number of records in the ring
+  uint64_t capacity;
+  //! System clock at the time the file was created, in ns since the epoch
+  int64_t realtime_ns;
+  //! Steady clock at the same time, to convert the record timestamps
+  int64_t steady_ns;
+  //! Number of records written so far, the next record goes to slot next % capacity
+  uint64_t next;
+  uint8_t reserved[16];
+};
+
+//! A recorded frame
+struct SVHCaptureRecord
+{
+  //! Position of the record in the recording starting at 1, 0 for empty or incomplete records
+  uint64_t sequence;
+  //! Steady clock in ns when the frame was written or decoded
+  int64_t timestamp_ns;
+  //! SVHCaptureDirection
+  uint8_t direction;
+  //! SVHCaptureStatus
+  uint8_t status;
+  //! Number of valid bytes in frame
+  uint16_t length;
+  uint8_t reserved[4];
+  //! The frame including header and checksum
+  uint8_t frame[SVHFrameDecoder::C_MAXIMUM_FRAME_SIZE];
+};
+
+/*!
+ * \brief Records the frames of a serial interface into a ring file
+ *
+ * The recorder is thread safe, the sending threads and the receive thread record concurrently.
+ * Attach it with SVHSerialInterface::setPacketRecorder. Once the ring is full the oldest records
+ * are overwritten, so the file always holds the most recent frames.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHPacketRecorder
+{
+public:
+  //! Identifies capture files
+  static const char C_CAPTURE_MAGIC[8];
+
+  //! Version of the file format
+  static const uint32_t C_CAPTURE_VERSION = 1;
+
+  SVHPacketRecorder();
+
+  //! Unmaps the file, the records stay on disk
+  ~SVHPacketRecorder();
+
+  /*!
+   * \brief create the capture file, an existing file is overwritten
+   * \param path file to record into
+   * \param capacity number of frames kept, the file has about 100 bytes per frame
+   * \return true if the file could be created and mapped
+   */
+  bool open(const std::string& path, size_t capacity);
+
+  //! Stop recording and unmap the file
+  void close();
+
+  //! Whether frames are recorded
+  bool isOpen() const { return m_header != nullptr; }
+
+  /*!
+   * \brief record a frame given in pieces, as passed to Serial::writev
+   * \param direction whether the frame was sent or received
+   * \param status what happened to the frame
+   * \param buffers pieces of the frame, cut at C_MAXIMUM_FRAME_SIZE bytes
+   * \param count number of pieces
+   */
+  void record(SVHCaptureDirection direction,
+              SVHCaptureStatus status,
+              const struct iovec* buffers,
+              int count);
+
+  /*!
+   * \brief record a decoded frame, the header is restored from the frame view
+   * \param status CS_OK or CS_CHECKSUM_ERROR
+   * \param frame view given by SVHFrameDecoder
+   */
+  void record(SVHCaptureStatus status, const SVHFrameView& frame);
+
+  //! Number of frames recorded since open, including overwritten ones
+  uint64_t recordedFrames() const;
+
+  /*!
+   * \brief write the records to disk synchronously. This is only needed to survive a power loss,
+   * the records of a crashed process are written by the kernel anyway.
+   * \return true on success
+   */
+  bool flush();
+
+  /*!
+   * \brief read the complete records of a capture file, oldest first
+   * \param path capture file
+   * \param header receives the file header
+   * \param records receives the records
+   * \return false if the file cannot be read or is no capture file
+   */
+  static bool readCapture(const std::string& path,
+                          SVHCaptureFileHeader& header,
+                          std::vector<SVHCaptureRecord>& records);
+
+  //! Whether header starts a capture file of this version
+  static bool isCaptureHeader(const SVHCaptureFileHeader& header);
+
+private:
+  // Forbid copying
+  SVHPacketRecorder(const SVHPacketRecorder&);
+  SVHPacketRecorder& operator=(const SVHPacketRecorder&);
+
+  //! Reserves the next slot and marks it as incomplete until commitRecord is called
+  SVHCaptureRecord*
+  beginRecord(SVHCaptureDirection direction, SVHCaptureStatus status, uint64_t& sequence);
+
+  //! Publishes a record filled after beginRecord
+  void commitRecord(SVHCaptureRecord* record, uint64_t sequence);
+
+  //! Mapped file, the records follow the header
+  SVHCaptureFileHeader* m_header;
+
+  //! First record in the mapping
+  SVHCaptureRecord* m_records;
+
+  //! Size of the mapping in bytes
+  size_t m_mapped_size;
+};
+
+} // namespace driver_svh
+
+#endif
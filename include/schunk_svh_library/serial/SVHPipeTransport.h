@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the SVHPipeTransport, a pair of in-process byte
+ * pipes that connects the protocol stack to a simulated hand without
+ * any terminal or kernel buffer in between.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_PIPE_TRANSPORT_H_INCLUDED
+#define DRIVER_SVH_SVH_PIPE_TRANSPORT_H_INCLUDED
+
+#include "schunk_svh_library/ImportExport.h"
+#include "schunk_svh_library/serial/SVHTransport.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace driver_svh {
+
+/*!
+ * \brief One end of an in-process pipe pair
+ *
+ * Each direction is a lock free ring buffer with a single writer and a single reader, which is
+ * what the serial interface and the simulator need. Bytes are copied once into the ring and once
+ * out of it. An eventfd signals the reader only when the ring was empty, so a busy pipe does not
+ * cost any system call on the writing side. fileDescriptor() returns that eventfd, so a pipe can
+ * be serviced by an SVHReactor like a serial device.
+ *
+ * Closing one end makes the other end fail once it has read the remaining data.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHPipeTransport : public SVHTransport
+{
+public:
+  //! Default number of bytes buffered per direction
+  static const size_t C_DEFAULT_CAPACITY = 65536;
+
+  /*!
+   * \brief createPair creates two connected ends, what is written to one can be read from the other
+   * \param first receives the first end
+   * \param second receives the second end
+   * \param capacity bytes buffered per direction, rounded up to a power of two
+   * \return false if the event descriptors could not be created
+   */
+  static bool createPair(std::shared_ptr<SVHPipeTransport>& first,
+                         std::shared_ptr<SVHPipeTransport>& second,
+                         size_t capacity = C_DEFAULT_CAPACITY);
+
+  //! Closes this end
+  ~SVHPipeTransport() override;
+
+  bool isOpen() const override { return m_open; }
+
+  void close() override;
+
+  ssize_t read(void* data,
+               ssize_t size,
+               unsigned long time       = 100,
+               bool return_on_less_data = true) override;
+
+  ssize_t writev(const struct iovec* buffers, int count) override;
+
+  int waitWritable(unsigned long time) override;
+
+  int waitReadable(unsigned long time) override;
+
+  int fileDescriptor() override;
+
+  int status() const override { return m_status; }
+
+  std::string statusText() const override;
+
+  const char* deviceName() const override { return m_name.c_str(); }
+
+private:
+  struct Ring;
+  struct Channel;
+
+  SVHPipeTransport(const std::shared_ptr<Channel>& channel, int side);
+
+  //! Copies at most \a size bytes out of the incoming ring and returns their number
+  size_t consume(uint8_t* data, size_t size);
+
+  //! Rings and state shared with the other end
+  std::shared_ptr<Channel> m_channel;
+
+  //! Ring written by the other end
+  Ring* m_in;
+
+  //! Ring read by the other end
+  Ring* m_out;
+
+  std::atomic<bool> m_open;
+
+  std::atomic<int> m_status;
+
+  std::string m_name;
+};
+
+} // namespace driver_svh
+
+#endif
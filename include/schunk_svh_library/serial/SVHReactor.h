@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHReactor, an event loop that services the file
+ * descriptors of several serial interfaces and timers from a single thread.
+ * It replaces one receive thread per hand when many hands are driven by the
+ * same process. The reactor is based on epoll and only available on Linux.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_REACTOR_H_INCLUDED
+#define DRIVER_SVH_SVH_REACTOR_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace driver_svh {
+
+/*!
+ * \brief Function signature of descriptor handlers
+ * \param events Combination of SVHReactor::EV_READABLE and SVHReactor::EV_HANGUP
+ */
+using SVHReactorHandler = std::function<void(uint32_t events)>;
+
+//! Counters of a reactor, they are never reset
+struct SVHReactorStatistics
+{
+  //! Number of times the reactor thread woke up to handle events
+  uint64_t wakeups = 0;
+  //! Number of descriptor and timer events that were dispatched to handlers
+  uint64_t events = 0;
+  //! Number of handlers that terminated with an exception
+  uint64_t handler_errors = 0;
+};
+
+/*!
+ * \brief Single threaded event loop for serial devices and timers
+ *
+ * Handlers are executed in the reactor thread and should return quickly, as all other
+ * descriptors wait for them. Descriptors are monitored level triggered, so a handler has to
+ * consume the data it is notified about or remove its descriptor.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHReactor
+{
+public:
+  //! Data can be read from the descriptor
+  static const uint32_t EV_READABLE = 0x1;
+  //! The descriptor was hung up or is in an error state, it will not recover
+  static const uint32_t EV_HANGUP = 0x2;
+
+  SVHReactor();
+
+  //! Stops the reactor thread
+  ~SVHReactor();
+
+  /*!
+   * \brief start creates the event loop and starts the reactor thread
+   * \return true if the reactor is running
+   */
+  bool start();
+
+  //! Stops the reactor thread, registered descriptors and timers stay registered
+  void stop();
+
+  //! Whether the reactor thread is running
+  bool isRunning() const { return m_running; }
+
+  //! Whether the caller is executed in the reactor thread, i.e. from within a handler
+  bool isReactorThread() const;
+
+  /*!
+   * \brief addDescriptor monitors a file descriptor for incoming data
+   * \param fd file descriptor to monitor, it must not be registered already
+   * \param handler function that is called in the reactor thread whenever the descriptor is ready
+   * \return true if the descriptor was registered
+   */
+  bool addDescriptor(int fd, const SVHReactorHandler& handler);
+
+  /*!
+   * \brief removeDescriptor stops monitoring a file descriptor. When called from another thread
+   * this waits for a running handler of the descriptor to return, so the descriptor can safely be
+   * closed afterwards. Handlers may remove their own descriptor.
+   * \param fd file descriptor to remove
+   * \return false if the descriptor was not registered
+   */
+  bool removeDescriptor(int fd);
+
+  /*!
+   * \brief addTimer calls a function periodically in the reactor thread
+   * \param period time between two calls
+   * \param handler function to call
+   * \return id of the timer to remove it later, or -1 on error
+   */
+  int addTimer(const std::chrono::microseconds& period, const std::function<void()>& handler);
+
+  /*!
+   * \brief removeTimer stops a timer, see removeDescriptor for the synchronization guarantees.
+   * Removing a timer that was removed already, e.g. a finished task, has no effect.
+   * \param timer id returned by addTimer or addTask
+   */
+  void removeTimer(int timer);
+
+  /*!
+   * \brief addTask runs a resumable operation in the reactor thread. Its step function is called
+   * periodically like a timer until it returns false, the task is removed then.
+   * \param period time between two steps
+   * \param step function to call, returns whether the task wants to be called again
+   * \return id of the task to cancel it with removeTimer, or -1 on error
+   */
+  int addTask(const std::chrono::microseconds& period, const std::function<bool()>& step);
+
+  //! Counters of the reactor
+  SVHReactorStatistics statistics() const;
+
+private:
+  //! Registration of a single descriptor
+  struct Entry
+  {
+    //! Distinguishes registrations that reuse the same descriptor number
+    uint32_t generation;
+    SVHReactorHandler handler;
+    //! Held while the handler runs
+    std::mutex mutex;
+    std::atomic<bool> active{true};
+  };
+
+  //! Creates an armed periodic timerfd, returns -1 on error
+  int createTimer(const std::chrono::microseconds& period);
+
+  //! Event loop of the reactor thread
+  void run();
+
+  //! Calls the handler of a descriptor, if it is still registered
+  void dispatch(uint64_t data, uint32_t events);
+
+  //! epoll instance
+  int m_epoll_fd;
+
+  //! eventfd to wake up the reactor thread on stop()
+  int m_wakeup_fd;
+
+  std::thread m_thread;
+
+  std::atomic<bool> m_running;
+
+  //! protects the registrations
+  std::mutex m_entries_mutex;
+
+  std::map<int, std::shared_ptr<Entry>> m_entries;
+
+  uint32_t m_next_generation;
+
+  std::atomic<uint64_t> m_wakeups;
+  std::atomic<uint64_t> m_events;
+  std::atomic<uint64_t> m_handler_errors;
+};
+
+} // namespace driver_svh
+
+#endif
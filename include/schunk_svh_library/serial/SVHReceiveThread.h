@@ -32,7 +32,7 @@
  * this class in client code and call its run() method in a separate thread.
  *
  * This class will then poll the serial interface periodically for new data. If
- * data is present, a statemachine will evaluate the right packet structure and
+ * data is present, a frame decoder will evaluate the right packet structure and
  * send the data via callback to the caller for further parsing once a complete
  * serial packaged is received.
  */
@@ -41,6 +41,9 @@
 #define DRIVER_SVH_SVH_RECEIVE_THREAD_H_INCLUDED
 
 #include <schunk_svh_library/serial/ByteOrderConversion.h>
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+#include <schunk_svh_library/serial/SVHTransportOptions.h>
 #include <schunk_svh_library/serial/Serial.h>
 
 #include <schunk_svh_library/serial/SVHSerialPacket.h>
@@ -49,6 +52,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <vector>
 
 using driver_svh::serial::Serial;
 
@@ -58,6 +62,23 @@ namespace driver_svh {
 using ReceivedPacketCallback =
   std::function<void(const SVHSerialPacket& packet, unsigned int packet_count)>;
 
+//! Counters of the receiving side of a serial interface
+struct SVHReceiveStatistics
+{
+  //! Number of times the device was read, i.e. thread cycles or reactor notifications
+  uint64_t wakeups = 0;
+  //! Number of bytes read from the device
+  uint64_t bytes = 0;
+  //! Number of packets with a valid checksum
+  uint64_t packets = 0;
+  //! Number of bytes discarded while searching for a packet header
+  uint64_t skipped_bytes = 0;
+  //! Number of packets dropped due to a checksum error
+  uint64_t checksum_errors = 0;
+  //! Number of failed reads
+  uint64_t read_errors = 0;
+};
+
 /*!
  * \brief Class for receiving messages from the serial device.
  *
@@ -70,12 +91,16 @@ public:
   /*!
    * \brief SVHReceiveThread Constructs a new Receivethread
    * \param idle_sleep sleep time during run() if no data is available
-   * \param device handle of the serial device
+   * \param device transport the data is read from
    * \param received_callback function to call uppon finished packet
+   * \param read_buffer_size size of the chunks the device is read in
+   * \param strategy how run() waits for data
    */
   SVHReceiveThread(const std::chrono::microseconds& idle_sleep,
-                   std::shared_ptr<Serial> device,
-                   ReceivedPacketCallback const& received_callback);
+                   std::shared_ptr<SVHTransport> device,
+                   ReceivedPacketCallback const& received_callback,
+                   size_t read_buffer_size     = 256,
+                   SVHReceiveStrategy strategy = RS_POLLING);
 
   //! Default DTOR
   ~SVHReceiveThread() {}
@@ -83,6 +108,23 @@ public:
   //! run method of the thread, executes the main program in an infinite loop
   void run();
 
+  /*!
+   * \brief receiveAvailableData reads everything that is currently available from the serial
+   * device without waiting and processes it. Use this instead of run() when the device is
+   * monitored by an event loop.
+   * \return false if reading from the device failed
+   */
+  bool receiveAvailableData();
+
+  //! Counters of the received data
+  SVHReceiveStatistics statistics() const;
+
+  //! Record all decoded frames, including those with a checksum error. Set before run() is called.
+  void setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder)
+  {
+    m_recorder = recorder;
+  }
+
   //! stop the run() method
   void stop() { m_continue = false; };
 
@@ -102,47 +144,43 @@ private:
   //! sleep time during run() if idle
   std::chrono::microseconds m_idle_sleep;
 
-  //! pointer to serial device object
-  std::shared_ptr<Serial> m_serial_device;
+  //! how run() waits for data
+  SVHReceiveStrategy m_strategy;
 
-  //! enum for receive packet state machine states
-  enum
-  {
-    RS_HEADE_R1,
-    RS_HEADE_R2,
-    RS_INDEX,
-    RS_ADDRESS,
-    RS_LENGT_H1,
-    RS_LENGT_H2,
-    RS_DATA,
-    RS_CHECKSU_M1,
-    RS_CHECKSU_M2
-  } typedef tState;
+  //! chunk the device is read into
+  std::vector<uint8_t> m_read_buffer;
 
-  //! current state of the state machine
-  tState m_received_state;
+  //! pointer to serial device object
+  std::shared_ptr<SVHTransport> m_serial_device;
 
-  //! length of received serial data
-  uint16_t m_length;
+  //! packets counter
+  std::atomic<unsigned int> m_packets_received;
 
-  //! Checksum of packet
-  uint8_t m_checksum1;
-  uint8_t m_checksum2;
+  //! extracts the packets from the received bytes
+  SVHFrameDecoder m_decoder;
 
-  //! length of received serial data
-  std::vector<uint8_t> m_data;
+  //! packet handed to the callback, reused for every received packet
+  SVHSerialPacket m_received_packet;
 
-  //! pointer to array builder object for packet receive
-  driver_svh::ArrayBuilder m_ab;
+  //! read the data that arrives within a short time and process it
+  bool receiveData();
 
-  //! packets counter
-  std::atomic<unsigned int> m_packets_received;
+  //! decode the received bytes and pass complete packets on
+  void processData(const uint8_t* data, size_t size);
 
-  //! counter for skipped bytes in case no packet is detected
-  unsigned int m_skipped_bytes;
+  //! called by the decoder for every frame with a valid checksum
+  void processFrame(const SVHFrameView& frame);
 
-  //! state machine processing received data
-  bool receiveData();
+  //! records the frames if set
+  std::shared_ptr<SVHPacketRecorder> m_recorder;
+
+  //! Counters returned by statistics()
+  std::atomic<uint64_t> m_stat_wakeups;
+  std::atomic<uint64_t> m_stat_bytes;
+  std::atomic<uint64_t> m_stat_packets;
+  std::atomic<uint64_t> m_stat_skipped_bytes;
+  std::atomic<uint64_t> m_stat_checksum_errors;
+  std::atomic<uint64_t> m_stat_read_errors;
 
   //! function callback for received packages
   ReceivedPacketCallback m_received_callback;
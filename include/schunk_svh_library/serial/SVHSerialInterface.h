@@ -41,16 +41,56 @@
 // Windows declarations
 #include <schunk_svh_library/ImportExport.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
 #include <schunk_svh_library/serial/SVHReceiveThread.h>
 #include <schunk_svh_library/serial/SVHSerialPacket.h>
+#include <schunk_svh_library/serial/SVHTransportOptions.h>
 #include <schunk_svh_library/serial/Serial.h>
 #include <thread>
 
 using driver_svh::serial::Serial;
+using driver_svh::serial::SerialLatencyReport;
+using driver_svh::serial::SerialLatencySettings;
 
 namespace driver_svh {
 
+//! Counters of the transmitting side of a serial interface
+struct SVHTransmitStatistics
+{
+  //! Number of frames written completely
+  uint64_t frames = 0;
+  //! Number of bytes written to the device
+  uint64_t bytes = 0;
+  //! Number of writes that took only a part of the remaining frame
+  uint64_t partial_writes = 0;
+  //! Number of times a frame had to wait for room in the output buffer of the device
+  uint64_t blocked_writes = 0;
+  //! Number of frames abandoned because the device did not take them in time
+  uint64_t timeouts = 0;
+  //! Number of frames abandoned due to a write error
+  uint64_t write_errors = 0;
+  //! Number of frames written per SVHTransmitPriority
+  uint64_t priority_frames[TP_DIMENSION] = {};
+  //! Longest time in microseconds a frame of each SVHTransmitPriority took from sendPacket until
+  //! it was written completely
+  uint64_t priority_max_latency_us[TP_DIMENSION] = {};
+  //! Number of replies that freed a slot of the transmit window
+  uint64_t replies = 0;
+  //! Number of frames whose reply did not arrive within the reply timeout
+  uint64_t lost_replies = 0;
+  //! Number of replies whose index was not waiting in the transmit window, e.g. late replies
+  uint64_t unexpected_replies = 0;
+  //! Longest time in microseconds between writing a frame and receiving its reply
+  uint64_t max_round_trip_us = 0;
+};
+
 /*!
  *  \brief Basic communication handler for the SCHUNK five finger hand.
  */
@@ -66,6 +106,46 @@ public:
   //! Default DTOR
   ~SVHSerialInterface();
 
+  //!
+  //! \brief service the serial device from a shared reactor instead of a dedicated receive thread.
+  //! Has to be called while disconnected. \param reactor running reactor, or nullptr to go back to
+  //! a receive thread
+  //!
+  void setReactor(const std::shared_ptr<SVHReactor>& reactor);
+
+  //!
+  //! \brief record all sent and received frames from the next connect on. Has to be called while
+  //! disconnected. \param recorder opened recorder, or nullptr to stop recording
+  //!
+  void setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder);
+
+  //!
+  //! \brief set the parameters of the serial transport used from the next connect on. Has to be
+  //! called while disconnected, the options are validated by connect.
+  //! \param options baud rate, receive strategy, pacing and thread tuning
+  //!
+  void setTransportOptions(const SVHTransportOptions& options);
+
+  //!
+  //! \brief get the parameters of the serial transport
+  //!
+  SVHTransportOptions transportOptions();
+
+  //!
+  //! \brief change the gap between two frames while connected, e.g. to a calibrated value. It is
+  //! used until the transport options are set again.
+  //! \param gap new gap, validated like SVHTransportOptions::transmission_gap
+  //! \return false if the gap is not valid for the connected transport
+  //!
+  bool setTransmissionGap(const std::chrono::microseconds& gap);
+
+  //!
+  //! \brief get the latency settings that took effect on the last connect, see
+  //! SVHTransportOptions::latency
+  //! \return report read back from the device, not applied if no tuning was requested
+  //!
+  SerialLatencyReport latencyReport() { return m_latency_report; }
+
   //!
   //! \brief connecting to serial device and starting receive thread
   //! \param dev_name Filehandle of the device i.e. dev/ttyUSB0
@@ -73,6 +153,14 @@ public:
   //!
   bool connect(const std::string& dev_name);
 
+  //!
+  //! \brief start communicating over an already opened transport, e.g. an SVHPipeTransport to a
+  //! simulated hand. Baud rate and latency settings of the transport options are not used.
+  //! \param transport opened transport, it is closed on close
+  //! \return bool true if connection was succesfull
+  //!
+  bool connect(const std::shared_ptr<SVHTransport>& transport);
+
   //!
   //! \brief canceling receive thread and closing connection to serial port
   //!
@@ -85,12 +173,71 @@ public:
   bool isConnected() { return m_connected; }
 
   //!
-  //! \brief function for sending packets via serial device to the SVH
+  //! \brief returns whether the serial device failed since the last connect, i.e. it was hung up
+  //! or could not be read. The interface stays connected until close is called.
+  //! \return bool true if the device failed
+  //!
+  bool hasFailed() { return m_failed; }
+
+  //!
+  //! \brief function for sending packets via serial device to the SVH, the priority is derived
+  //! from the address of the packet
   //! \param packet the prepared Serial Packet
   //! \return true if successful
   //!
   bool sendPacket(SVHSerialPacket& packet);
 
+  //!
+  //! \brief function for sending packets via serial device to the SVH. Packets of concurrent
+  //! callers are queued and written in the order of their priority, so that a packet waits for at
+  //! most the frame currently written and the transmission gap behind packets of a lower priority.
+  //! Emergency packets are not held back by holdTransmission either. On the thread of the reactor,
+  //! which reads the replies, a copy of the packet is queued instead of waiting for the device,
+  //! the hold or the transmit window, it is written as soon as it is due. These copies are written
+  //! in the order they were sent, only their first one competes with other callers by priority.
+  //! \param packet the prepared Serial Packet
+  //! \param priority class of the packet
+  //! \param spacing minimum time between the previous frame and this one, in addition to the
+  //! transmission gap. Held packets are released without it.
+  //! \return true if successful, or if the packet was queued by the reactor thread
+  //!
+  bool sendPacket(SVHSerialPacket& packet,
+                  SVHTransmitPriority priority,
+                  const std::chrono::microseconds& spacing = std::chrono::microseconds(0));
+
+  //!
+  //! \brief queue the packets sent by the calling thread instead of writing them, until
+  //! releaseTransmission is called. Packets of other threads wait in sendPacket meanwhile. This is
+  //! used to release the commands of several hands at the same time, see SVHHandGroup.
+  //!
+  void holdTransmission();
+
+  //!
+  //! \brief get number of packets queued since holdTransmission was called
+  //!
+  size_t heldPacketCount();
+
+  //!
+  //! \brief get the earliest time the next packet may be written. Packets are paced so that the
+  //! hardware is not flooded, sendPacket waits for this time if necessary. With a transmit window,
+  //! see SVHTransportOptions::transmit_window, a full window also delays it until a slot is freed
+  //! at the latest.
+  //!
+  std::chrono::steady_clock::time_point nextTransmissionTime();
+
+  //!
+  //! \brief write the oldest held packet, waiting for nextTransmissionTime first
+  //! \param written time the packet was handed to the serial device
+  //! \return false if no packet was held or the write failed
+  //!
+  bool releaseHeldPacket(std::chrono::steady_clock::time_point& written);
+
+  //!
+  //! \brief write all packets still held and stop holding
+  //! \return false if a write failed
+  //!
+  bool releaseTransmission();
+
   //!
   //! \brief get number of transmitted packets
   //! \return number of successfully sent packets
@@ -102,6 +249,18 @@ public:
    */
   void resetTransmitPackageCount();
 
+  //!
+  //! \brief get the counters of the receiving side
+  //! \return counters since the last connect
+  //!
+  SVHReceiveStatistics receiveStatistics();
+
+  //!
+  //! \brief get the counters of the transmitting side
+  //! \return counters since the last connect
+  //!
+  SVHTransmitStatistics transmitStatistics();
+
   /*!
    * \brief printPacketOnConsole is a pure helper function to show what raw data is actually sent.
    * This is not meant for any productive use other than understand whats going on. \param packet
@@ -112,16 +271,96 @@ public:
 private:
   void receivedPacketCallback(const SVHSerialPacket& packet, unsigned int packet_count);
 
+  //! Starts receiving from m_serial_device, which has to be open
+  bool startCommunication();
+
+  //! Applies the thread tuning of the transport options to the calling thread
+  void tuneReceiveThread();
+
+  //! Maximum number of buffers passed to writeFrame
+  static const int C_MAXIMUM_FRAME_BUFFERS = 3;
+
+  //! A sendPacket call waiting in m_transmit_queues or m_posted_queue
+  struct TransmitRequest
+  {
+    SVHSerialPacket* packet;
+    std::chrono::steady_clock::time_point queued;
+    std::chrono::microseconds spacing;
+    SVHTransmitPriority priority;
+    //! order in which the requests were queued
+    uint64_t sequence;
+    bool done;
+    bool success;
+    //! copy of a packet queued by the reactor thread, the request is deleted once it is written
+    std::unique_ptr<SVHSerialPacket> posted;
+  };
+
+  //! Writes queued packets in the order of their priority until \a own was written. Expects
+  //! \a lock to hold m_send_mutex and the calling thread to own the transmission.
+  void writeQueuedPackets(std::unique_lock<std::mutex>& lock, const TransmitRequest& own);
+
+  //! Queue whose first packet is written next, nullptr if no packet is queued. Expects
+  //! m_send_mutex to be held.
+  std::deque<TransmitRequest*>* nextQueue();
+
+  //! Writes the first packet of \a queue. Expects \a lock to hold m_send_mutex and the calling
+  //! thread to own the transmission.
+  void writeQueuedPacket(std::unique_lock<std::mutex>& lock, std::deque<TransmitRequest*>& queue);
+
+  //! Queues a copy of \a packet for the reactor thread and writes the packets that are due.
+  //! Expects \a lock to hold m_send_mutex.
+  void postPacket(std::unique_lock<std::mutex>& lock,
+                  const SVHSerialPacket& packet,
+                  SVHTransmitPriority priority,
+                  const std::chrono::microseconds& spacing);
+
+  //! Earliest time the queued \a request may be written, see transmissionTime
+  std::chrono::steady_clock::time_point queuedTransmissionTime(const TransmitRequest& request);
+
+  //! Writes queued packets as long as they are due without waiting, unless another thread owns
+  //! the transmission. Expects \a lock to hold m_send_mutex.
+  void writeDuePackets(std::unique_lock<std::mutex>& lock);
+
+  //! Step of the reactor task that writes the queued copies, returns whether copies are left
+  bool flushPostedPackets();
+
+  //! Writes the buffers of a complete frame after waiting for the pacing and records it. Expects
+  //! \a lock to hold m_send_mutex and the calling thread to own the transmission, the mutex is
+  //! released while waiting and writing. Emergency frames do not wait for the transmit window.
+  bool writeFrame(std::unique_lock<std::mutex>& lock,
+                  uint8_t index,
+                  const struct iovec* buffers,
+                  int count,
+                  bool emergency);
+
+  //! Earliest time the next frame may be written, i.e. the end of the gap and, with a transmit
+  //! window, additionally the time a slot is freed unless the frame is an \a emergency frame.
+  //! Frames whose reply timed out are dropped from the window. Expects m_send_mutex to be held.
+  std::chrono::steady_clock::time_point transmissionTime(bool emergency = false);
+
+  //! Number of distinct packet indices
+  static const size_t C_PACKET_INDICES = 255;
+
+  //! Writes buffers until the write timeout expires. The buffer descriptions are advanced on
+  //! partial writes.
+  bool writeBuffers(struct iovec* buffers, int count);
+
+  //! Called by the reactor whenever the serial device registered as fd is ready
+  void handleDeviceEvents(int fd, uint32_t events);
+
   //! serial device connected state
   bool m_connected;
 
-  uint8_t m_last_index;
+  //! whether the frames go over a serial line, i.e. the transport was opened by connect(dev_name)
+  bool m_serial_line;
 
-  //! pointer to serial interface object
-  std::shared_ptr<Serial> m_serial_device;
+  //! set when the serial device failed while being serviced by the reactor
+  std::atomic<bool> m_failed;
 
-  //! cecksum calculation
-  void calcCheckSum(uint8_t& check_sum1, uint8_t& check_sum2, const SVHSerialPacket& packet);
+  uint8_t m_last_index;
+
+  //! transport to the hand, a Serial for real devices
+  std::shared_ptr<SVHTransport> m_serial_device;
 
   //! thread for receiving serial packets
   std::thread m_receive_thread;
@@ -129,6 +368,81 @@ private:
   //! handle to manage the actual receiving of data
   std::unique_ptr<SVHReceiveThread> m_svh_receiver;
 
+  //! reactor servicing the serial device instead of m_receive_thread, if set
+  std::shared_ptr<SVHReactor> m_reactor;
+
+  //! descriptor registered at m_reactor, -1 if none
+  int m_reactor_fd;
+
+  //! parameters of the serial transport
+  SVHTransportOptions m_options;
+
+  //! records the frames if set
+  std::shared_ptr<SVHPacketRecorder> m_recorder;
+
+  //! latency settings read back on the last connect
+  SerialLatencyReport m_latency_report;
+
+  //! serializes sendPacket calls of application and polling
+  std::mutex m_send_mutex;
+
+  //! signals the end of a hold to waiting senders
+  std::condition_variable m_hold_cv;
+
+  //! signals queued and written packets and the end of a transmission
+  std::condition_variable m_transmit_cv;
+
+  //! set while a thread writes to the device, the others queue their packets meanwhile
+  bool m_transmitting;
+
+  //! packets waiting to be written, one queue per SVHTransmitPriority
+  std::deque<TransmitRequest*> m_transmit_queues[TP_DIMENSION];
+
+  //! copies of packets sent by the reactor thread, they are written in the order they were sent
+  std::deque<TransmitRequest*> m_posted_queue;
+
+  //! sequence of the next queued request
+  uint64_t m_transmit_sequence;
+
+  //! reactor task writing the queued copies, -1 if none
+  int m_flush_task;
+
+  //! whether packets are held, see holdTransmission
+  bool m_hold;
+
+  //! thread whose packets are held
+  std::thread::id m_hold_owner;
+
+  //! encoded frames waiting for release
+  std::deque<std::vector<uint8_t> > m_held_frames;
+
+  //! earliest time the next frame may be written
+  std::chrono::steady_clock::time_point m_next_transmission;
+
+  //! time the last frame was written
+  std::chrono::steady_clock::time_point m_last_transmission;
+
+  //! time the frame of each index in the transmit window was written, zero if it is not waiting
+  //! for a reply
+  std::chrono::steady_clock::time_point m_window_sent[C_PACKET_INDICES];
+
+  //! number of frames waiting for a reply
+  unsigned int m_window_count;
+
+  //! Counters returned by transmitStatistics()
+  std::atomic<uint64_t> m_stat_frames;
+  std::atomic<uint64_t> m_stat_bytes;
+  std::atomic<uint64_t> m_stat_partial_writes;
+  std::atomic<uint64_t> m_stat_blocked_writes;
+  std::atomic<uint64_t> m_stat_timeouts;
+  std::atomic<uint64_t> m_stat_write_errors;
+  uint64_t m_stat_priority_frames[TP_DIMENSION];
+  uint64_t m_stat_priority_max_latency_us[TP_DIMENSION];
+  uint64_t m_stat_replies;
+  uint64_t m_stat_lost_replies;
+  uint64_t m_stat_unexpected_replies;
+  uint64_t m_stat_max_round_trip_us;
+
   //! Callback function for received packets
   ReceivedPacketCallback m_received_packet_callback;
 
@@ -47,6 +47,7 @@ namespace driver_svh {
 // packet sizes
 const size_t C_PACKET_APPENDIX_SIZE = 8;  //!< The packet overhead size in bytes
 const size_t C_DEFAULT_PACKET_SIZE  = 48; //!< Default packet payload size in bytes
+const size_t C_MAXIMUM_PACKET_SIZE  = 64; //!< Maximum packet payload size in bytes
 
 // packet headers
 const uint8_t PACKET_HEADER1 = 0x4C; //!< Header sync byte 1
@@ -73,6 +74,37 @@ const uint8_t SVH_GET_ENCODER_VALUES = 0x0A; //!< Request the current encoder sc
 const uint8_t SVH_SET_ENCODER_VALUES = 0x0B; //!< Set new encoder scalings
 const uint8_t SVH_GET_FIRMWARE_INFO  = 0x0C; //!< Request the firmware info to be transmitted
 
+//! Classes of packets. Queued packets of a lower value are written first, see
+//! SVHSerialInterface::sendPacket.
+enum SVHTransmitPriority
+{
+  TP_EMERGENCY, //!< Controller states, which disable channels, never wait behind other traffic
+  TP_CONTROL,   //!< Setpoints
+  TP_FEEDBACK,  //!< Polling of feedback and controller states
+  TP_SETTINGS,  //!< Controller settings, encoder scalings and firmware queries
+  TP_DIMENSION  //!< Number of classes
+};
+
+//! Default class of a packet, derived from its address. The channel in the upper nibble is ignored.
+inline SVHTransmitPriority transmitPriority(uint8_t address)
+{
+  switch (address & 0x0F)
+  {
+    case SVH_SET_CONTROLLER_STATE:
+      // Enabling shares the lane of disabling, a state never overtakes a newer one
+      return TP_EMERGENCY;
+    case SVH_SET_CONTROL_COMMAND:
+    case SVH_SET_CONTROL_COMMAND_ALL:
+      return TP_CONTROL;
+    case SVH_GET_CONTROL_FEEDBACK:
+    case SVH_GET_CONTROL_FEEDBACK_ALL:
+    case SVH_GET_CONTROLLER_STATE:
+      return TP_FEEDBACK;
+    default:
+      return TP_SETTINGS;
+  }
+}
+
 /*!
  * \brief The SerialPacket holds the (non generated) header and data of one message to the
  * SVH-Hardware
@@ -115,5 +147,13 @@ driver_svh::ArrayBuilder& operator>>(driver_svh::ArrayBuilder& ab, SVHSerialPack
 //! Output Stream operator for easy printing of packet data
 std::ostream& operator<<(std::ostream& o, const SVHSerialPacket& sp);
 
+/*!
+ * \brief calcCheckSum calculates the two checksum bytes transmitted after the payload of a packet
+ * \param check_sum1 sum of all payload bytes
+ * \param check_sum2 xor of all payload bytes
+ * \param packet packet whose payload is used for the calculation
+ */
+void calcCheckSum(uint8_t& check_sum1, uint8_t& check_sum2, const SVHSerialPacket& packet);
+
 } // namespace driver_svh
 #endif // SVHSERIALPACKET_H
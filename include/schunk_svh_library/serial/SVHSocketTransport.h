@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the SVHSocketTransport, which talks to a hand over a
+ * UNIX domain stream socket, e.g. to a simulator running in another
+ * process.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_SOCKET_TRANSPORT_H_INCLUDED
+#define DRIVER_SVH_SVH_SOCKET_TRANSPORT_H_INCLUDED
+
+#include "schunk_svh_library/ImportExport.h"
+#include "schunk_svh_library/serial/SVHTransport.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace driver_svh {
+
+/*!
+ * \brief Transport over a UNIX domain stream socket
+ *
+ * The socket is non blocking and monitored with poll, so it behaves like a serial device without
+ * line discipline. A hung up peer makes reads and writes fail.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHSocketTransport : public SVHTransport
+{
+public:
+  SVHSocketTransport();
+
+  //! Closes the socket
+  ~SVHSocketTransport() override;
+
+  /*!
+   * \brief connect to a socket another process listens on
+   * \param path file system path of the socket
+   * \return true if the connection was established
+   */
+  bool connect(const std::string& path);
+
+  /*!
+   * \brief accept waits for a single peer that connects to \a path. The socket file is created
+   * and removed again once the peer connected or the time expired.
+   * \param path file system path of the socket, an existing socket file is replaced
+   * \param time time to wait for the peer in us
+   * \return true if a peer connected
+   */
+  bool accept(const std::string& path, unsigned long time);
+
+  /*!
+   * \brief createPair creates two connected sockets within this process
+   * \return false if the sockets could not be created
+   */
+  static bool createPair(std::shared_ptr<SVHSocketTransport>& first,
+                         std::shared_ptr<SVHSocketTransport>& second);
+
+  bool isOpen() const override { return m_file_descr >= 0; }
+
+  void close() override;
+
+  ssize_t read(void* data,
+               ssize_t size,
+               unsigned long time       = 100,
+               bool return_on_less_data = true) override;
+
+  ssize_t writev(const struct iovec* buffers, int count) override;
+
+  int waitWritable(unsigned long time) override;
+
+  int waitReadable(unsigned long time) override;
+
+  int fileDescriptor() override { return m_file_descr; }
+
+  int status() const override { return m_status; }
+
+  std::string statusText() const override;
+
+  const char* deviceName() const override { return m_name.c_str(); }
+
+private:
+  //! Takes over a connected socket
+  void attach(int fd, const std::string& name);
+
+  //! Waits for \a events on the socket, see SVHTransport::waitReadable
+  int waitForEvents(int events, unsigned long time);
+
+  std::atomic<int> m_file_descr;
+
+  std::atomic<int> m_status;
+
+  std::string m_name;
+};
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the SVHTransport, the byte stream the serial
+ * interface talks to the hand through. Serial is the transport for real
+ * devices, SVHPipeTransport and SVHSocketTransport connect the protocol
+ * stack to a simulated hand without a terminal in between.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_TRANSPORT_H_INCLUDED
+#define DRIVER_SVH_SVH_TRANSPORT_H_INCLUDED
+
+#include "schunk_svh_library/ImportExport.h"
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+
+#ifdef _SYSTEM_WIN32_
+typedef int ssize_t;
+//! Buffer description for SVHTransport::writev, as known from POSIX
+struct iovec
+{
+  void* iov_base;
+  size_t iov_len;
+};
+#endif
+
+#ifdef _SYSTEM_POSIX_
+#  include <sys/uio.h>
+#endif
+
+namespace driver_svh {
+
+/*!
+ * \brief Bidirectional byte stream to a hand
+ *
+ * All functions return a negative status on error, status() keeps it until the next call.
+ * Reads and writes do not block beyond the given time, writes take what fits right now.
+ */
+class DRIVER_SVH_IMPORT_EXPORT SVHTransport
+{
+public:
+  virtual ~SVHTransport() {}
+
+  //! Whether the transport can be read and written
+  virtual bool isOpen() const = 0;
+
+  //! Close the transport, the other end sees a hangup
+  virtual void close() = 0;
+
+  /*!
+   * \brief read data that arrives within \a time us
+   * \param data receives the bytes
+   * \param size maximal number of bytes
+   * \param time time to wait for data in us
+   * \param return_on_less_data return what arrived instead of waiting for \a size bytes
+   * \return number of bytes read, 0 if nothing arrived
+   */
+  virtual ssize_t
+  read(void* data, ssize_t size, unsigned long time = 100, bool return_on_less_data = true) = 0;
+
+  /*!
+   * \brief write the \a count buffers in the given order without waiting
+   * \return number of bytes taken, which may be less than requested. A full transport returns a
+   * negative value with status() -EAGAIN.
+   */
+  virtual ssize_t writev(const struct iovec* buffers, int count) = 0;
+
+  //! Wait at most \a time us until data can be written. Returns 1, 0 on timeout or a status.
+  virtual int waitWritable(unsigned long time) = 0;
+
+  //! Wait at most \a time us until data can be read. Returns 1, 0 on timeout or a status.
+  virtual int waitReadable(unsigned long time) = 0;
+
+  /*!
+   * \brief descriptor that polls readable whenever data may be available, used by the SVHReactor
+   * \return -1 if the transport cannot be polled
+   */
+  virtual int fileDescriptor() = 0;
+
+  //! Status of the last call, 0 or a negative errno value
+  virtual int status() const = 0;
+
+  //! Description of status()
+  virtual std::string statusText() const = 0;
+
+  //! Name of the transport for log messages, e.g. the device name
+  virtual const char* deviceName() const = 0;
+};
+
+} // namespace driver_svh
+
+#endif
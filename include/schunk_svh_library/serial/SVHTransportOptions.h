@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHTransportOptions that configure the serial
+ * transport to the hand, i.e. the baud rate, how data is received, the
+ * pacing of sent frames and the tuning of the receive thread. The defaults
+ * match the hardware and an FTDI based adapter.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_TRANSPORT_OPTIONS_H_INCLUDED
+#define DRIVER_SVH_SVH_TRANSPORT_OPTIONS_H_INCLUDED
+
+#include <schunk_svh_library/ImportExport.h>
+#include <schunk_svh_library/serial/Serial.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace driver_svh {
+
+//! How the receive thread waits for data from the serial device
+enum SVHReceiveStrategy
+{
+  //! Sleep for the idle period whenever no data is available
+  RS_POLLING,
+  //! Wait in the kernel until data arrives, the idle period only bounds the reaction to stopping
+  RS_BLOCKING
+};
+
+/*!
+ * \brief Parameters of the serial transport, see SVHSerialInterface::setTransportOptions
+ *
+ * The receive settings only apply to the receive thread. If the device is serviced by a shared
+ * reactor, see SVHSerialInterface::setReactor, the reactor thread reads the device instead.
+ */
+struct DRIVER_SVH_IMPORT_EXPORT SVHTransportOptions
+{
+  //! Baud rate in bit/s. Rates without a termios constant are set as custom rate, which has to be
+  //! supported by the adapter.
+  uint32_t baud_rate = 921600;
+
+  //! How the receive thread waits for data
+  SVHReceiveStrategy receive_strategy = RS_POLLING;
+
+  //! Sleep of the receive thread while no data is available
+  std::chrono::microseconds receive_idle_period{500};
+
+  //! Size of the chunks the device is read in
+  size_t read_buffer_size = 256;
+
+  //! Gap between the start of two frames. The hardware drops packets that arrive faster, even
+  //! though the link should handle them. 782us are needed to send 72bytes via a baudrate of 921600.
+  //! Transports without a serial line, e.g. an SVHPipeTransport to a simulator, accept any gap.
+  std::chrono::microseconds transmission_gap{782};
+
+  //! Longest time a frame may wait for room in the output buffer of the device. A healthy device
+  //! takes a frame within a few gaps, so running into this means that the device is stalled.
+  std::chrono::microseconds write_timeout{10000};
+
+  //! Number of frames that may wait for their reply at the same time. With a window the frames are
+  //! paced by the replies of the hand, the transmission gap only keeps them apart on the wire and
+  //! can be lowered to the frame time. 0 disables it. Emergency frames do not wait for a slot.
+  //! Replies are matched by the echoed packet index, so at most 254 frames can be told apart.
+  unsigned int transmit_window = 0;
+
+  //! Time after which the reply to a frame in the transmit window is considered lost
+  std::chrono::microseconds reply_timeout{20000};
+
+  //! SCHED_FIFO priority of the receive thread, 0 keeps the default scheduling
+  int receive_thread_priority = 0;
+
+  //! CPU the receive thread is pinned to, -1 lets the scheduler decide
+  int receive_thread_cpu = -1;
+
+  //! Latency tuning of the serial device, by default the device is left as it is
+  serial::SerialLatencySettings latency;
+
+  /*!
+   * \brief check the options for consistency
+   * \param error description of the first problem found
+   * \param serial_line whether the frames go over a serial line of baud_rate, otherwise gap and
+   * write timeout are not bound to the frame time
+   * \return true if the options can be used
+   */
+  bool validate(std::string& error, bool serial_line = true) const;
+};
+
+} // namespace driver_svh
+
+#endif
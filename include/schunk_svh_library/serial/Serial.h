@@ -41,11 +41,11 @@
 #include <sys/types.h>
 
 #include "schunk_svh_library/ImportExport.h"
+#include "schunk_svh_library/serial/SVHTransport.h"
 #include "schunk_svh_library/serial/SerialFlags.h"
 
 #ifdef _SYSTEM_WIN32_
 typedef unsigned int speed_t;
-typedef int ssize_t;
 #endif
 
 #ifdef _SYSTEM_POSIX_
@@ -60,12 +60,36 @@ typedef int ssize_t;
 namespace driver_svh {
 namespace serial {
 
+//! Settings to reduce the receive latency of a serial device, see Serial::tuneLatency()
+struct SerialLatencySettings
+{
+  //! Set ASYNC_LOW_LATENCY so that the driver hands received data on without delay
+  bool low_latency = false;
+  //! Latency timer of USB serial adapters like the FTDI ones in ms, 0 leaves it untouched
+  int latency_timer = 0;
+  //! Root of the sysfs tree holding the latency timer, only changed for tests
+  std::string sysfs_root = "/sys";
+};
+
+//! The latency settings of a serial device as read back after Serial::tuneLatency()
+struct SerialLatencyReport
+{
+  //! Whether all requested settings took effect
+  bool applied = false;
+  //! Whether ASYNC_LOW_LATENCY is set, false if the device does not support it
+  bool low_latency = false;
+  //! Latency timer of the USB adapter in ms, -1 if the device has none
+  int latency_timer = -1;
+  //! sysfs attribute of the latency timer, empty if the device has none
+  std::string latency_timer_path;
+};
+
 //! Enables acces to serial devices
 /*!
   Open a serial device, change baudrates, read from and write to the device.
   Status-information after calling the functions get be
  */
-class DRIVER_SVH_IMPORT_EXPORT Serial
+class DRIVER_SVH_IMPORT_EXPORT Serial : public SVHTransport
 {
 public:
   /*!
@@ -96,7 +120,7 @@ public:
   /*!
     Restore old serial settings and close device
    */
-  ~Serial();
+  ~Serial() override;
   /*!
     speed is one of the followind values :
     - B50, B75, B110, B134, B150, B200, B300, B600, B1200,
@@ -107,6 +131,15 @@ public:
    */
   int changeBaudrate(SerialFlags::BaudRate speed);
 
+  /*!
+    Set a baud rate that is not part of SerialFlags::BaudRate, given in
+    bit/s. This needs support of the serial driver and the adapter.
+    Returns 0 on success.
+    Returns -status on failure, also if the adapter cannot run the rate
+    accurately.
+   */
+  int setCustomBaudrate(unsigned int baud_rate);
+
   /*!
    * Clears the serial port's receive buffer.
    */
@@ -135,18 +168,42 @@ public:
     Returns \c true if the serial interface is opened.
     \c false otherwhise.
    */
-  bool isOpen() const;
+  bool isOpen() const override;
 
   /*!
     Close the serial interface.
    */
-  void close();
+  void close() override;
 
 
   /*!
     Write data to serial out.
    */
   ssize_t write(const void* data, ssize_t size);
+  /*!
+    Write the \a count buffers to serial out with a single call, in the
+    given order. Like write() this may write less than requested.
+   */
+  ssize_t writev(const struct iovec* buffers, int count) override;
+  /*!
+    Wait until data can be written to the device, at most \param time us.
+    Returns 1 if the device is writable, 0 on timeout and a negative
+    status on error.
+   */
+  int waitWritable(unsigned long time) override;
+  /*!
+    Wait until data can be read from the device, at most \param time us.
+    Returns 1 if data is available, 0 on timeout and a negative status on
+    error or hangup.
+   */
+  int waitReadable(unsigned long time) override;
+  /*!
+    Apply the latency \a settings to the opened device and read back what
+    took effect. Settings that are not supported by the device or that
+    cannot be changed due to missing permissions are reported, but they
+    do not make the device unusable.
+   */
+  SerialLatencyReport tuneLatency(const SerialLatencySettings& settings);
   /*!
     Read data from device. This function waits until \param time us passed or
     the respected number of bytes are received via serial line.
@@ -155,7 +212,10 @@ public:
     If the parameter is false, data is only read from serial line, if at least
     \param size bytes are available.
    */
-  ssize_t read(void* data, ssize_t size, unsigned long time = 100, bool return_on_less_data = true);
+  ssize_t read(void* data,
+               ssize_t size,
+               unsigned long time       = 100,
+               bool return_on_less_data = true) override;
   /*!
     All routines return a negavtiv number on error. Then the global errno is
     stored into a private variable. Use this funtion to ask for this value.
@@ -163,16 +223,16 @@ public:
     succesful opening of the device by calling this function. It returns 0, if
     no error occured.
    */
-  int status() const { return m_status; }
+  int status() const override { return m_status; }
 
-  std::string statusText() const;
+  std::string statusText() const override;
 
-  const char* deviceName() const { return m_dev_name; }
+  const char* deviceName() const override { return m_dev_name; }
 
   /*!
     Return the file descriptor of the serial class
   */
-  int fileDescriptor()
+  int fileDescriptor() override
   {
 #ifdef _SYSTEM_POSIX_
     return m_file_descr;
@@ -188,6 +248,9 @@ private:
 
   void dumpData(void* data, size_t length);
 
+  //! Wait for the poll \a events of the device, see waitReadable()
+  int waitForEvents(int events, unsigned long time);
+
 #ifdef _SYSTEM_WIN32_
   HANDLE m_com;
   unsigned char m_read_buffer[0x4000];
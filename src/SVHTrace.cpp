@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHTrace.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#ifdef _SYSTEM_LINUX_
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+//! Ring of events, slots are addressed by their ticket modulo the capacity
+struct SVHTrace::Ring
+{
+  //! One event, the fields are atomics as a reader may copy a slot while it is overwritten
+  struct Slot
+  {
+    //! 2 * ticket + 1 while the event of a ticket is written, 2 * ticket + 2 once it is complete
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char*> category{""};
+    std::atomic<const char*> name{""};
+    std::atomic<const char*> arg_name{nullptr};
+    std::atomic<char> phase{'X'};
+    std::atomic<uint64_t> start_ns{0};
+    std::atomic<uint64_t> duration_ns{0};
+    std::atomic<uint32_t> thread{0};
+    std::atomic<int64_t> arg{0};
+  };
+
+  explicit Ring(size_t size)
+    : slots(new Slot[size])
+    , capacity(size)
+    , next(0)
+    , first(0)
+    , kept(size)
+  {
+  }
+
+  std::unique_ptr<Slot[]> slots;
+  size_t capacity;
+  //! Next ticket to hand out
+  std::atomic<uint64_t> next;
+  //! First ticket since the last start, earlier events were discarded
+  std::atomic<uint64_t> first;
+  //! Number of events kept as requested by the last start, at most the capacity
+  std::atomic<uint64_t> kept;
+};
+
+std::atomic<bool> SVHTrace::s_enabled(false);
+std::atomic<SVHTrace::Ring*> SVHTrace::s_ring(nullptr);
+
+namespace {
+
+//! Guards the rings and the thread names
+std::mutex g_trace_mutex;
+
+//! Names of the recording threads by number
+std::map<uint32_t, std::string> g_thread_names;
+
+//! Last number given to a thread
+std::atomic<uint32_t> g_thread_count(0);
+
+//! Number of the calling thread, 0 until it recorded its first event
+thread_local uint32_t t_thread_number = 0;
+
+//! Writes a string as JSON string literal
+void writeJsonString(std::ostream& out, const std::string& text)
+{
+  out << '"';
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) >= 0x20)
+    {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+//! Writes a time in ns as µs with three decimals, the unit of the Chrome trace event format
+void writeMicroseconds(std::ostream& out, uint64_t ns)
+{
+  const uint64_t fraction = ns % 1000;
+  out << ns / 1000 << '.' << fraction / 100 << (fraction / 10) % 10 << fraction % 10;
+}
+
+} // namespace
+
+bool SVHTrace::start(size_t capacity)
+{
+  if (capacity == 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHTrace", "The trace needs room for at least one event");
+    return false;
+  }
+  size_t size = 1;
+  while (size < capacity)
+  {
+    size <<= 1;
+  }
+
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  // A writer may still hold a replaced ring, so rings are kept until the process ends. The current
+  // ring is reused unless it is too small, which bounds the kept rings by twice the largest one.
+  static std::vector<std::unique_ptr<Ring> > rings;
+  Ring* ring = s_ring.load(std::memory_order_relaxed);
+  if (ring == nullptr || ring->capacity < size)
+  {
+    rings.emplace_back(new Ring(size));
+    ring = rings.back().get();
+  }
+  ring->kept.store(size, std::memory_order_relaxed);
+  ring->first.store(ring->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  s_ring.store(ring, std::memory_order_release);
+  s_enabled = true;
+  return true;
+}
+
+void SVHTrace::stop()
+{
+  s_enabled = false;
+}
+
+uint64_t SVHTrace::now()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch())
+                                 .count());
+}
+
+void SVHTrace::complete(const char* category,
+                        const char* name,
+                        uint64_t start_ns,
+                        const char* arg_name,
+                        int64_t arg)
+{
+  const uint64_t end_ns = now();
+  record(category, name, 'X', start_ns, end_ns > start_ns ? end_ns - start_ns : 0, arg_name, arg);
+}
+
+void SVHTrace::instant(const char* category, const char* name, const char* arg_name, int64_t arg)
+{
+  record(category, name, 'i', now(), 0, arg_name, arg);
+}
+
+void SVHTrace::record(const char* category,
+                      const char* name,
+                      char phase,
+                      uint64_t start_ns,
+                      uint64_t duration_ns,
+                      const char* arg_name,
+                      int64_t arg)
+{
+  Ring* ring = s_ring.load(std::memory_order_acquire);
+  if (ring == nullptr)
+  {
+    return;
+  }
+
+  const uint32_t thread = threadNumber();
+  const uint64_t ticket = ring->next.fetch_add(1, std::memory_order_relaxed);
+  Ring::Slot& slot      = ring->slots[ticket & (ring->capacity - 1)];
+
+  // Readers skip the slot until the closing sequence number is stored
+  slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.category.store(category, std::memory_order_relaxed);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.arg_name.store(arg_name, std::memory_order_relaxed);
+  slot.phase.store(phase, std::memory_order_relaxed);
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+  slot.thread.store(thread, std::memory_order_relaxed);
+  slot.arg.store(arg, std::memory_order_relaxed);
+  slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+void SVHTrace::setThreadName(const char* name)
+{
+#ifdef _SYSTEM_LINUX_
+  char buffer[16] = {0};
+  std::strncpy(buffer, name, sizeof(buffer) - 1);
+  pthread_setname_np(pthread_self(), buffer);
+#endif
+  if (t_thread_number != 0)
+  {
+    std::lock_guard<std::mutex> lock(g_trace_mutex);
+    g_thread_names[t_thread_number] = name;
+  }
+}
+
+uint32_t SVHTrace::threadNumber()
+{
+  if (t_thread_number == 0)
+  {
+    t_thread_number = ++g_thread_count;
+
+    std::string name = "thread " + std::to_string(t_thread_number);
+#ifdef _SYSTEM_LINUX_
+    char buffer[16] = {0};
+    if (pthread_getname_np(pthread_self(), buffer, sizeof(buffer)) == 0 && buffer[0] != '\0')
+    {
+      name = buffer;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(g_trace_mutex);
+    g_thread_names[t_thread_number] = name;
+  }
+  return t_thread_number;
+}
+
+std::vector<SVHTraceEvent> SVHTrace::events()
+{
+  std::vector<SVHTraceEvent> events;
+  Ring* ring = s_ring.load(std::memory_order_acquire);
+  if (ring == nullptr)
+  {
+    return events;
+  }
+
+  const uint64_t first = ring->first.load(std::memory_order_relaxed);
+  const uint64_t kept  = ring->kept.load(std::memory_order_relaxed);
+  const uint64_t end   = ring->next.load(std::memory_order_acquire);
+  const uint64_t begin = std::max(first, end > kept ? end - kept : 0);
+  events.reserve(static_cast<size_t>(end - begin));
+  for (uint64_t ticket = begin; ticket < end; ++ticket)
+  {
+    const Ring::Slot& slot  = ring->slots[ticket & (ring->capacity - 1)];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * ticket + 2)
+    {
+      // Still written or already overwritten
+      continue;
+    }
+
+    SVHTraceEvent event;
+    event.category    = slot.category.load(std::memory_order_relaxed);
+    event.name        = slot.name.load(std::memory_order_relaxed);
+    event.arg_name    = slot.arg_name.load(std::memory_order_relaxed);
+    event.phase       = slot.phase.load(std::memory_order_relaxed);
+    event.start_ns    = slot.start_ns.load(std::memory_order_relaxed);
+    event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+    event.thread      = slot.thread.load(std::memory_order_relaxed);
+    event.arg         = slot.arg.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+std::map<uint32_t, std::string> SVHTrace::threadNames()
+{
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  return g_thread_names;
+}
+
+uint64_t SVHTrace::recordedCount()
+{
+  Ring* ring = s_ring.load(std::memory_order_acquire);
+  return ring ? ring->next.load() - ring->first.load() : 0;
+}
+
+void SVHTrace::writeChromeTrace(std::ostream& out)
+{
+#ifdef _SYSTEM_LINUX_
+  const int pid = static_cast<int>(getpid());
+#else
+  const int pid = 1;
+#endif
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& thread : threadNames())
+  {
+    out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":" << thread.first << ",\"args\":{\"name\":";
+    writeJsonString(out, thread.second);
+    out << "}}";
+    first = false;
+  }
+
+  for (const SVHTraceEvent& event : events())
+  {
+    out << (first ? "\n" : ",\n") << "{\"name\":";
+    writeJsonString(out, event.name);
+    out << ",\"cat\":";
+    writeJsonString(out, event.category);
+    out << ",\"ph\":\"" << event.phase << "\",\"ts\":";
+    writeMicroseconds(out, event.start_ns);
+    if (event.phase == 'X')
+    {
+      out << ",\"dur\":";
+      writeMicroseconds(out, event.duration_ns);
+    }
+    else
+    {
+      // Instant events are drawn on the track of their thread
+      out << ",\"s\":\"t\"";
+    }
+    out << ",\"pid\":" << pid << ",\"tid\":" << event.thread;
+    if (event.arg_name != nullptr)
+    {
+      out << ",\"args\":{";
+      writeJsonString(out, event.arg_name);
+      out << ':' << event.arg << '}';
+    }
+    out << '}';
+    first = false;
+  }
+  out << "\n]}\n";
+}
+
+bool SVHTrace::writeChromeTrace(const std::string& file_name)
+{
+  std::ofstream out(file_name.c_str());
+  if (!out)
+  {
+    SVH_LOG_ERROR_STREAM("SVHTrace", "Could not open trace file " << file_name);
+    return false;
+  }
+  writeChromeTrace(out);
+  out.flush();
+  if (!out)
+  {
+    SVH_LOG_ERROR_STREAM("SVHTrace", "Could not write trace file " << file_name);
+    return false;
+  }
+  return true;
+}
+
+} // namespace driver_svh
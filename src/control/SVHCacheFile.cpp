@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/control/SVHCacheFile.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _SYSTEM_LINUX_
+#  include <fcntl.h>
+#  include <sys/file.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+namespace {
+
+//! Splits a line into its values, joined by single spaces, and the device
+bool parseLine(const std::string& line,
+               size_t value_count,
+               std::string& values,
+               std::string& device)
+{
+  std::istringstream entry(line);
+  std::string value;
+  values.clear();
+  for (size_t i = 0; i < value_count; ++i)
+  {
+    if (!(entry >> value))
+    {
+      return false;
+    }
+    values += (i == 0) ? value : " " + value;
+  }
+  return std::getline(entry >> std::ws, device) && !device.empty();
+}
+
+#ifdef _SYSTEM_LINUX_
+//! \brief Exclusive lock of the cache file while it exists. The cache file itself is replaced on
+//! every update, so the lock is held on a separate file next to it.
+class UpdateLock
+{
+public:
+  explicit UpdateLock(const std::string& cache_file)
+    : m_fd(::open((cache_file + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644))
+  {
+    while (m_fd >= 0 && ::flock(m_fd, LOCK_EX) != 0)
+    {
+      if (errno != EINTR)
+      {
+        ::close(m_fd);
+        m_fd = -1;
+      }
+    }
+  }
+
+  ~UpdateLock()
+  {
+    if (m_fd >= 0)
+    {
+      ::close(m_fd);
+    }
+  }
+
+  bool isLocked() const { return m_fd >= 0; }
+
+private:
+  int m_fd;
+};
+#endif
+
+//! Writes the content to a new file next to the cache file and renames it over the cache file, so
+//! that a crash does not leave half an entry behind
+bool replaceFile(const std::string& cache_file, const std::string& content)
+{
+#ifdef _SYSTEM_LINUX_
+  // Writers of other hands never share the temporary file
+  std::string name = cache_file + ".XXXXXX";
+  std::vector<char> temporary(name.begin(), name.end());
+  temporary.push_back('\0');
+  const int fd = ::mkstemp(temporary.data());
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  bool written = ::fchmod(fd, 0644) == 0;
+  for (size_t offset = 0; written && offset < content.size();)
+  {
+    const ssize_t count = ::write(fd, content.data() + offset, content.size() - offset);
+    if (count < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    written = count > 0;
+    offset += written ? static_cast<size_t>(count) : 0;
+  }
+  written = ::fsync(fd) == 0 && written;
+  written = ::close(fd) == 0 && written;
+  if (!written || std::rename(temporary.data(), cache_file.c_str()) != 0)
+  {
+    ::unlink(temporary.data());
+    return false;
+  }
+  return true;
+#else
+  const std::string temporary = cache_file + ".tmp";
+  {
+    std::ofstream file(temporary.c_str(), std::ios::trunc);
+    file << content;
+    if (!file)
+    {
+      return false;
+    }
+  }
+  return std::rename(temporary.c_str(), cache_file.c_str()) == 0;
+#endif
+}
+
+} // namespace
+
+bool SVHCacheFile::load(const std::string& cache_file,
+                        const std::string& device,
+                        size_t value_count,
+                        std::vector<std::string>& entries)
+{
+  entries.clear();
+
+  std::ifstream file(cache_file.c_str());
+  std::string line;
+  while (std::getline(file, line))
+  {
+    std::string values;
+    std::string name;
+    if (parseLine(line, value_count, values, name) && name == device)
+    {
+      entries.push_back(values);
+    }
+  }
+  return !entries.empty();
+}
+
+bool SVHCacheFile::store(const std::string& cache_file,
+                         const std::string& device,
+                         size_t value_count,
+                         const std::vector<std::string>& entries)
+{
+#ifdef _SYSTEM_LINUX_
+  // Another hand may update its entries in the meantime
+  UpdateLock lock(cache_file);
+  if (!lock.isLocked())
+  {
+    return false;
+  }
+#endif
+
+  std::ostringstream content;
+  {
+    std::ifstream file(cache_file.c_str());
+    std::string line;
+    while (std::getline(file, line))
+    {
+      // Lines of a different width, e.g. gap entries next to homing entries, are kept as well
+      std::string values;
+      std::string name;
+      if (!line.empty() && !(parseLine(line, value_count, values, name) && name == device))
+      {
+        content << line << "\n";
+      }
+    }
+  }
+
+  for (const std::string& entry : entries)
+  {
+    content << entry << " " << device << "\n";
+  }
+  return replaceFile(cache_file, content.str());
+}
+
+} // namespace driver_svh
@@ -48,13 +48,42 @@
 #include <chrono>
 #include <functional>
 #include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHProbes.h>
+#include <schunk_svh_library/SVHTrace.h>
 #include <schunk_svh_library/serial/ByteOrderConversion.h>
-#include <thread>
 
 using driver_svh::ArrayBuilder;
 
 namespace driver_svh {
 
+namespace {
+
+//! Names of the packet types in traces of the dispatch, by the lower nibble of the address
+const char* const C_PACKET_TYPE_NAMES[SVH_PACKET_TYPE_DIMENSION] = {"GET_CONTROL_FEEDBACK",
+                                                                    "SET_CONTROL_COMMAND",
+                                                                    "GET_CONTROL_FEEDBACK_ALL",
+                                                                    "SET_CONTROL_COMMAND_ALL",
+                                                                    "GET_POSITION_SETTINGS",
+                                                                    "SET_POSITION_SETTINGS",
+                                                                    "GET_CURRENT_SETTINGS",
+                                                                    "SET_CURRENT_SETTINGS",
+                                                                    "GET_CONTROLLER_STATE",
+                                                                    "SET_CONTROLLER_STATE",
+                                                                    "GET_ENCODER_VALUES",
+                                                                    "SET_ENCODER_VALUES",
+                                                                    "GET_FIRMWARE_INFO",
+                                                                    "UNKNOWN_13",
+                                                                    "UNKNOWN_14",
+                                                                    "UNKNOWN_15"};
+
+//! Distance between the controller states that power up the drivers
+const std::chrono::microseconds C_POWER_UP_SPACING(2000);
+
+//! Distance between resetting the enabled channels and activating their controllers
+const std::chrono::microseconds C_ACTIVATION_SPACING(500);
+
+} // namespace
+
 
 //! Description of the channels for enum matching:
 const char* SVHController::m_channel_description[] = {"Thumb_Flexion",
@@ -100,10 +129,13 @@ SVHController::SVHController()
       &SVHController::receivedPacketCallback, this, std::placeholders::_1, std::placeholders::_2)))
   , m_enable_mask(0)
   , m_received_package_count(0)
+  , m_receive_ab(0)
 {
   SVH_LOG_DEBUG_STREAM("SVHController", "SVH Controller started");
   m_firmware_info.version_major = 0;
   m_firmware_info.version_minor = 0;
+
+  m_packet_handlers = defaultPacketHandlers();
 }
 
 SVHController::~SVHController()
@@ -135,6 +167,23 @@ bool SVHController::connect(const std::string& dev_name)
   }
 }
 
+bool SVHController::connect(const std::shared_ptr<SVHTransport>& transport)
+{
+  SVH_LOG_DEBUG_STREAM("SVHController", "Connect was called, starting the serial interface...");
+  if (m_serial_interface != NULL)
+  {
+    bool success = m_serial_interface->connect(transport);
+    SVH_LOG_DEBUG_STREAM("SVHController",
+                         "Connect finished " << ((success) ? "succesfully" : "with an error"));
+    return success;
+  }
+  else
+  {
+    SVH_LOG_DEBUG_STREAM("SVHController", "Connect failed");
+    return false;
+  }
+}
+
 void SVHController::disconnect()
 {
   SVH_LOG_DEBUG_STREAM("SVHController",
@@ -153,6 +202,71 @@ void SVHController::disconnect()
   SVH_LOG_DEBUG_STREAM("SVHController", "Disconnect finished");
 }
 
+void SVHController::setReactor(const std::shared_ptr<SVHReactor>& reactor)
+{
+  m_serial_interface->setReactor(reactor);
+}
+
+void SVHController::setTransportOptions(const SVHTransportOptions& options)
+{
+  m_serial_interface->setTransportOptions(options);
+}
+
+SVHTransportOptions SVHController::getTransportOptions()
+{
+  return m_serial_interface->transportOptions();
+}
+
+bool SVHController::setTransmissionGap(const std::chrono::microseconds& gap)
+{
+  return m_serial_interface->setTransmissionGap(gap);
+}
+
+void SVHController::setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder)
+{
+  m_serial_interface->setPacketRecorder(recorder);
+}
+
+bool SVHController::hasCommunicationFailed()
+{
+  return m_serial_interface->hasFailed();
+}
+
+SVHReceiveStatistics SVHController::getReceiveStatistics()
+{
+  return m_serial_interface->receiveStatistics();
+}
+
+SVHTransmitStatistics SVHController::getTransmitStatistics()
+{
+  return m_serial_interface->transmitStatistics();
+}
+
+void SVHController::holdTransmission()
+{
+  m_serial_interface->holdTransmission();
+}
+
+size_t SVHController::heldPacketCount()
+{
+  return m_serial_interface->heldPacketCount();
+}
+
+std::chrono::steady_clock::time_point SVHController::nextTransmissionTime()
+{
+  return m_serial_interface->nextTransmissionTime();
+}
+
+bool SVHController::releaseHeldPacket(std::chrono::steady_clock::time_point& written)
+{
+  return m_serial_interface->releaseHeldPacket(written);
+}
+
+bool SVHController::releaseTransmission()
+{
+  return m_serial_interface->releaseTransmission();
+}
+
 void SVHController::setControllerTarget(const SVHChannel& channel, const int32_t& position)
 {
   // No Sanity Checks for out of bounds positions at this point as the finger manager has already
@@ -216,15 +330,42 @@ void SVHController::setControllerTargetAllChannels(const std::vector<int32_t>& p
 }
 
 void SVHController::enableChannel(const SVHChannel& channel)
+{
+  SVH_LOG_DEBUG_STREAM("SVHController", "Enable of channel " << channel << " requested.");
+
+  // enable actual channels (again we only accept individual channels for safety)
+  if (channel >= 0 && channel < SVH_DIMENSION)
+  {
+    enableChannels(static_cast<uint16_t>(1 << channel));
+    SVH_LOG_DEBUG_STREAM("SVHController", "Enabled channel: " << channel);
+  }
+  else
+  {
+    SVH_LOG_ERROR_STREAM("SVHController",
+                         "Activation request for ALL or unknown channel: " << channel
+                                                                           << "- ignoring request");
+  }
+}
+
+void SVHController::enableChannels(uint16_t mask)
 {
   SVHSerialPacket serial_packet(0, SVH_SET_CONTROLLER_STATE);
   SVHControllerState controller_state;
   ArrayBuilder ab(40);
 
-  SVH_LOG_DEBUG_STREAM("SVHController", "Enable of channel " << channel << " requested.");
+  mask &= SVH_ALL_CHANNELS_MASK;
+  if (mask == 0)
+  {
+    return;
+  }
+
+  // The delays between the states are kept by the serial interface when it writes them, a caller
+  // in the reactor thread does not sleep through them
+  const SVHTransmitPriority priority = transmitPriority(serial_packet.address);
+  std::chrono::microseconds spacing(0);
 
   // In case no channel was enabled we need to enable the 12V dc drivers first
-  if (m_enable_mask == 0)
+  if (m_enable_mask.load() == 0)
   {
     SVH_LOG_DEBUG_STREAM("SVHController",
                          "Enable was called and no channel was previously activated, commands are "
@@ -241,7 +382,7 @@ void SVHController::enableChannel(const SVHChannel& channel)
 
     // Small delays seem to make communication at this point more reliable although they SHOULD NOT
     // be necessary
-    std::this_thread::sleep_for(std::chrono::microseconds(2000));
+    spacing = C_POWER_UP_SPACING;
 
     SVH_LOG_DEBUG_STREAM("SVHController",
                          "Enabling 12V Driver (pwm_reset and pwm_active = 0x0200)...");
@@ -250,64 +391,57 @@ void SVHController::enableChannel(const SVHChannel& channel)
     controller_state.pwm_active = 0x0200;
     ab << controller_state;
     serial_packet.data = ab.array;
-    m_serial_interface->sendPacket(serial_packet);
+    m_serial_interface->sendPacket(serial_packet, priority, spacing);
     ab.reset(40);
 
-    std::this_thread::sleep_for(std::chrono::microseconds(2000));
-
     SVH_LOG_DEBUG_STREAM("SVHController", "Enabling pos_ctrl and cur_ctrl...");
     // enable controller
     controller_state.pos_ctrl = 0x0001;
     controller_state.cur_ctrl = 0x0001;
     ab << controller_state;
     serial_packet.data = ab.array;
-    m_serial_interface->sendPacket(serial_packet);
+    m_serial_interface->sendPacket(serial_packet, priority, spacing);
     ab.reset(40);
 
-    std::this_thread::sleep_for(std::chrono::microseconds(2000));
-
     SVH_LOG_DEBUG_STREAM("SVHController", "...Done");
   }
 
-  // enable actual channels (again we only accept individual channels for safety)
-  if (channel >= 0 && channel < SVH_DIMENSION)
+  SVH_LOG_DEBUG_STREAM("SVHController", "Enabling channels of mask: " << mask);
+
+  // SENDING EVERYTHING AT ONCE WILL LEAD TO "Jumping" behaviour of the controller on faster
+  // Systems ---> this has to do with the initialization of the hardware controllers. If we split
+  // it in two calls we will reset them first and then activate making sure that all values are
+  // initialized properly effectively preventing any jumping behaviour. Both steps cover all
+  // channels of the mask, so the sequence does not grow with the number of channels.
   {
-    SVH_LOG_DEBUG_STREAM("SVHController", "Enabling motor: " << channel);
+    std::lock_guard<std::mutex> lock(m_enable_mutex);
     // oring all channels to create the activation mask-> high = channel active
-    m_enable_mask |= (1 << channel);
-
-    // SENDING EVERYTHING AT ONCE WILL LEAD TO "Jumping" behaviour of the controller on faster
-    // Systems ---> this has to do with the initialization of the hardware controllers. If we split
-    // it in two calls we will reset them first and then activate making sure that all values are
-    // initialized properly effectively preventing any jumping behaviour
-    ab.reset(40);
+    const uint16_t enabled      = m_enable_mask.fetch_or(mask) | mask;
     controller_state.pwm_fault  = 0x001F;
     controller_state.pwm_otw    = 0x001F;
-    controller_state.pwm_reset  = (0x0200 | (m_enable_mask & 0x01FF));
-    controller_state.pwm_active = (0x0200 | (m_enable_mask & 0x01FF));
-    ab << controller_state;
-    serial_packet.data = ab.array;
-    m_serial_interface->sendPacket(serial_packet);
-    ab.reset(40);
-
-    // WARNING: DO NOT ! REMOVE THESE DELAYS OR THE HARDWARE WILL! FREAK OUT! (see reason above)
-    std::this_thread::sleep_for(std::chrono::microseconds(500));
-
-    controller_state.pos_ctrl = 0x0001;
-    controller_state.cur_ctrl = 0x0001;
+    controller_state.pwm_reset  = (0x0200 | (enabled & 0x01FF));
+    controller_state.pwm_active = (0x0200 | (enabled & 0x01FF));
     ab << controller_state;
     serial_packet.data = ab.array;
-    m_serial_interface->sendPacket(serial_packet);
+    m_serial_interface->sendPacket(serial_packet, priority, spacing);
     ab.reset(40);
-
-    SVH_LOG_DEBUG_STREAM("SVHController", "Enabled channel: " << channel);
   }
-  else
+
+  // Channels disabled in the meantime must not be switched on again by a stale mask
+  std::lock_guard<std::mutex> lock(m_enable_mutex);
+  const uint16_t enabled = m_enable_mask.load();
+  if (enabled == 0)
   {
-    SVH_LOG_ERROR_STREAM("SVHController",
-                         "Activation request for ALL or unknown channel: " << channel
-                                                                           << "- ignoring request");
+    return;
   }
+  controller_state.pwm_reset  = (0x0200 | (enabled & 0x01FF));
+  controller_state.pwm_active = (0x0200 | (enabled & 0x01FF));
+  controller_state.pos_ctrl   = 0x0001;
+  controller_state.cur_ctrl   = 0x0001;
+  ab << controller_state;
+  serial_packet.data = ab.array;
+  // WARNING: DO NOT ! REMOVE THESE DELAYS OR THE HARDWARE WILL! FREAK OUT! (see reason above)
+  m_serial_interface->sendPacket(serial_packet, priority, C_ACTIVATION_SPACING);
 }
 
 void SVHController::disableChannel(const SVHChannel& channel)
@@ -316,44 +450,15 @@ void SVHController::disableChannel(const SVHChannel& channel)
 
   if (m_serial_interface != NULL && m_serial_interface->isConnected())
   {
-    // prepare general packet
-    SVHSerialPacket serial_packet(0, SVH_SET_CONTROLLER_STATE);
-    SVHControllerState controller_state;
-    ArrayBuilder ab(40);
-
     // we just accept it at this point because it makes no difference in the calls
     if (channel == SVH_ALL)
     {
-      m_enable_mask              = 0;
-      controller_state.pwm_fault = 0x001F;
-      controller_state.pwm_otw   = 0x001F;
-
-      // default initialization to zero -> controllers are deactivated
-      ab << controller_state;
-      serial_packet.data = ab.array;
-      m_serial_interface->sendPacket(serial_packet);
-
+      disableChannels(SVH_ALL_CHANNELS_MASK);
       SVH_LOG_DEBUG_STREAM("SVHController", "Disabled all channels");
     }
     else if (channel >= 0 && channel < SVH_DIMENSION)
     {
-      controller_state.pwm_fault = 0x001F;
-      controller_state.pwm_otw   = 0x001F;
-      // Disable the finger in the bitmask
-      m_enable_mask &= ~(1 << channel);
-
-      if (m_enable_mask != 0) // pos and current control stay on then
-      {
-        controller_state.pwm_reset  = (0x0200 | (m_enable_mask & 0x01FF));
-        controller_state.pwm_active = (0x0200 | (m_enable_mask & 0x01FF));
-        controller_state.pos_ctrl   = 0x0001;
-        controller_state.cur_ctrl   = 0x0001;
-      }
-
-      ab << controller_state;
-      serial_packet.data = ab.array;
-      m_serial_interface->sendPacket(serial_packet);
-
+      disableChannels(static_cast<uint16_t>(1 << channel));
       SVH_LOG_DEBUG_STREAM("SVHController", "Disabled channel: " << channel);
     }
     else
@@ -370,6 +475,41 @@ void SVHController::disableChannel(const SVHChannel& channel)
   }
 }
 
+void SVHController::disableChannels(uint16_t mask)
+{
+  if (m_serial_interface == NULL || !m_serial_interface->isConnected())
+  {
+    SVH_LOG_ERROR_STREAM("SVHController",
+                         "Disabling Channel not possible. Serial interface is not connected!");
+    return;
+  }
+
+  // prepare general packet, it overtakes all queued packets as it stops the motors
+  SVHSerialPacket serial_packet(0, SVH_SET_CONTROLLER_STATE);
+  SVHControllerState controller_state;
+  ArrayBuilder ab(40);
+
+  controller_state.pwm_fault = 0x001F;
+  controller_state.pwm_otw   = 0x001F;
+  // Disable the fingers in the bitmask. An enable sends at most one state while holding the
+  // mutex, so the stop waits for no more than that frame.
+  std::lock_guard<std::mutex> lock(m_enable_mutex);
+  const uint16_t enabled = m_enable_mask.fetch_and(static_cast<uint16_t>(~mask)) & ~mask;
+
+  // default initialization to zero -> controllers are deactivated if no channel is left
+  if (enabled != 0) // pos and current control stay on then
+  {
+    controller_state.pwm_reset  = (0x0200 | (enabled & 0x01FF));
+    controller_state.pwm_active = (0x0200 | (enabled & 0x01FF));
+    controller_state.pos_ctrl   = 0x0001;
+    controller_state.cur_ctrl   = 0x0001;
+  }
+
+  ab << controller_state;
+  serial_packet.data = ab.array;
+  m_serial_interface->sendPacket(serial_packet);
+}
+
 void SVHController::requestControllerState()
 {
   SVH_LOG_DEBUG_STREAM("SVHController", "Requesting ControllerStatefrom Hardware");
@@ -545,155 +685,258 @@ void SVHController::requestFirmwareInfo()
 }
 
 void SVHController::receivedPacketCallback(const SVHSerialPacket& packet, unsigned int packet_count)
+{
+  m_received_package_count = packet_count;
+
+  // Packet meaning is encoded in the lower nibble of the adress byte
+  const uint8_t type = packet.address & 0x0F;
+  SVH_TRACE_SPAN_ARG("dispatch", C_PACKET_TYPE_NAMES[type], "channel", packet.address >> 4);
+  SVH_PROBE2(dispatch_start, type, packet.address >> 4);
+
+  std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+  if (m_packet_handlers[type])
+  {
+    m_packet_handlers[type](packet);
+  }
+  else if (m_packet_observers[type].empty())
+  {
+    SVH_LOG_ERROR_STREAM("SVHController",
+                         "Received a Packet with unknown address: " << static_cast<int>(type)
+                                                                    << " - ignoring packet");
+    SVH_PROBE1(dispatch_done, type);
+    return;
+  }
+
+  for (const SVHPacketHandler& observer : m_packet_observers[type])
+  {
+    observer(packet);
+  }
+  SVH_PROBE1(dispatch_done, type);
+}
+
+bool SVHController::setPacketHandler(const uint8_t& type, const SVHPacketHandler& handler)
+{
+  if (type >= SVH_PACKET_TYPE_DIMENSION)
+  {
+    SVH_LOG_WARN_STREAM("SVHController",
+                        "Packet handler was given for unknown type: " << static_cast<int>(type)
+                                                                      << " - ignoring request");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+  m_packet_handlers[type] = handler;
+  return true;
+}
+
+bool SVHController::resetPacketHandler(const uint8_t& type)
+{
+  if (type >= SVH_PACKET_TYPE_DIMENSION)
+  {
+    SVH_LOG_WARN_STREAM("SVHController",
+                        "Packet handler reset was requested for unknown type: "
+                          << static_cast<int>(type) << " - ignoring request");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+  m_packet_handlers[type] = defaultPacketHandlers()[type];
+  return true;
+}
+
+bool SVHController::addPacketObserver(const uint8_t& type, const SVHPacketHandler& observer)
+{
+  if (type >= SVH_PACKET_TYPE_DIMENSION || !observer)
+  {
+    SVH_LOG_WARN_STREAM("SVHController",
+                        "Invalid packet observer was given for type: " << static_cast<int>(type)
+                                                                       << " - ignoring request");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+  m_packet_observers[type].push_back(observer);
+  return true;
+}
+
+void SVHController::clearPacketObservers(const uint8_t& type)
+{
+  if (type < SVH_PACKET_TYPE_DIMENSION)
+  {
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+    m_packet_observers[type].clear();
+  }
+}
+
+std::array<SVHPacketHandler, SVH_PACKET_TYPE_DIMENSION> SVHController::defaultPacketHandlers()
+{
+  using std::placeholders::_1;
+
+  std::array<SVHPacketHandler, SVH_PACKET_TYPE_DIMENSION> handlers;
+
+  // Answers to get and set requests carry the same payload and are decoded the same way
+  handlers[SVH_GET_CONTROL_FEEDBACK] =
+    std::bind(&SVHController::handleControllerFeedback, this, _1);
+  handlers[SVH_SET_CONTROL_COMMAND] = handlers[SVH_GET_CONTROL_FEEDBACK];
+
+  handlers[SVH_GET_CONTROL_FEEDBACK_ALL] =
+    std::bind(&SVHController::handleControllerFeedbackAllChannels, this, _1);
+  handlers[SVH_SET_CONTROL_COMMAND_ALL] = handlers[SVH_GET_CONTROL_FEEDBACK_ALL];
+
+  handlers[SVH_GET_POSITION_SETTINGS] = std::bind(&SVHController::handlePositionSettings, this, _1);
+  handlers[SVH_SET_POSITION_SETTINGS] = handlers[SVH_GET_POSITION_SETTINGS];
+
+  handlers[SVH_GET_CURRENT_SETTINGS] = std::bind(&SVHController::handleCurrentSettings, this, _1);
+  handlers[SVH_SET_CURRENT_SETTINGS] = handlers[SVH_GET_CURRENT_SETTINGS];
+
+  handlers[SVH_GET_CONTROLLER_STATE] = std::bind(&SVHController::handleControllerState, this, _1);
+  handlers[SVH_SET_CONTROLLER_STATE] = handlers[SVH_GET_CONTROLLER_STATE];
+
+  handlers[SVH_GET_ENCODER_VALUES] = std::bind(&SVHController::handleEncoderValues, this, _1);
+  handlers[SVH_SET_ENCODER_VALUES] = handlers[SVH_GET_ENCODER_VALUES];
+
+  handlers[SVH_GET_FIRMWARE_INFO] = std::bind(&SVHController::handleFirmwareInfo, this, _1);
+
+  return handlers;
+}
+
+ArrayBuilder& SVHController::receivedPayload(const SVHSerialPacket& packet)
+{
+  // Copy the payload en bloc into the already allocated builder instead of appending it bytewise
+  m_receive_ab.array.assign(packet.data.begin(), packet.data.end());
+  m_receive_ab.write_pos = packet.data.size();
+  m_receive_ab.read_pos  = 0;
+  return m_receive_ab;
+}
+
+void SVHController::handleControllerFeedback(const SVHSerialPacket& packet)
 {
   // Extract Channel
   uint8_t channel = (packet.address >> 4) & 0x0F;
-  // Prepare Data for conversion
-  ArrayBuilder ab;
-  ab.appendWithoutConversion(packet.data);
 
-  SVHControllerFeedbackAllChannels feedback_all;
+  if (channel < SVH_DIMENSION)
+  {
+    receivedPayload(packet) >> m_controller_feedback[channel];
+    // Disabled as this is spamming the output to much
+    SVH_LOG_DEBUG_STREAM("SVHController",
+                         "Received a Control Feedback/Control Command packet for channel "
+                           << channel
+                           << " Position: " << (int)m_controller_feedback[channel].position
+                           << " Current: " << (int)m_controller_feedback[channel].current);
+  }
+  else
+  {
+    SVH_LOG_ERROR_STREAM("SVHController",
+                         "Received a Control Feedback/Control Command packet for ILLEGAL channel "
+                           << channel << "- packet ignored!");
+  }
+}
+
+void SVHController::handleControllerFeedbackAllChannels(const SVHSerialPacket& packet)
+{
+  // We cannot just read them all into the vector (which would have been nice) because the
+  // feedback of all channels is structured different from the feedback of one channel. So the
+  // SVHControllerFeedbackAllChannels is used as an intermediary ( handles the deserialization)
+  receivedPayload(packet) >> m_received_feedback_all;
+  m_controller_feedback = m_received_feedback_all.feedbacks;
+  // Disabled as this is spannimg the output to much
+  SVH_LOG_DEBUG_STREAM("SVHController",
+                       "Received a Control Feedback/Control Command packet for all channels ");
+}
 
-  m_received_package_count = packet_count;
+void SVHController::handlePositionSettings(const SVHSerialPacket& packet)
+{
+  uint8_t channel = (packet.address >> 4) & 0x0F;
 
-  // Packet meaning is encoded in the lower nibble of the adress byte
-  switch (packet.address & 0x0F)
-  {
-    case SVH_GET_CONTROL_FEEDBACK:
-    case SVH_SET_CONTROL_COMMAND:
-      if (channel >= 0 && channel < SVH_DIMENSION)
-      {
-        // std::cout << "Recieved: Controllerfeedback RAW Data: " << ab;
-        ab >> m_controller_feedback[channel];
-        // Disabled as this is spamming the output to much
-        SVH_LOG_DEBUG_STREAM("SVHController",
-                             "Received a Control Feedback/Control Command packet for channel "
-                               << channel
-                               << " Position: " << (int)m_controller_feedback[channel].position
-                               << " Current: " << (int)m_controller_feedback[channel].current);
-      }
-      else
-      {
-        SVH_LOG_ERROR_STREAM(
-          "SVHController",
-          "Received a Control Feedback/Control Command packet for ILLEGAL channel "
-            << channel << "- packet ignored!");
-      }
-      break;
-    case SVH_GET_CONTROL_FEEDBACK_ALL:
-    case SVH_SET_CONTROL_COMMAND_ALL:
-      // We cannot just read them all into the vector (which would have been nice) because the
-      // feedback of all channels is structured different from the feedback of one channel. So the
-      // SVHControllerFeedbackAllChannels is used as an intermediary ( handles the deserialization)
-      ab >> feedback_all;
-      m_controller_feedback = feedback_all.feedbacks;
-      // Disabled as this is spannimg the output to much
-      SVH_LOG_DEBUG_STREAM(
-        "SVHController",
-        "Received a Control Feedback/Control Command packet for channel all channels ");
-      break;
-    case SVH_GET_POSITION_SETTINGS:
-    case SVH_SET_POSITION_SETTINGS:
-      if (channel >= 0 && channel < SVH_DIMENSION)
-      {
-        // std::cout << "Recieved: Postitionsettings RAW Data: " << ab; // for really intensive
-        // debugging
-        ab >> m_position_settings[channel];
-        SVH_LOG_DEBUG_STREAM("SVHController",
-                             "Received a get/set position setting packet for channel " << channel);
-        SVH_LOG_DEBUG_STREAM("SVHController",
-                             "wmn " << m_position_settings[channel].wmn << " "
-                                    << "wmx " << m_position_settings[channel].wmx << " "
-                                    << "dwmx " << m_position_settings[channel].dwmx << " "
-                                    << "ky " << m_position_settings[channel].ky << " "
-                                    << "dt " << m_position_settings[channel].dt << " "
-                                    << "imn " << m_position_settings[channel].imn << " "
-                                    << "imx " << m_position_settings[channel].imx << " "
-                                    << "kp " << m_position_settings[channel].kp << " "
-                                    << "ki " << m_position_settings[channel].ki << " "
-                                    << "kd " << m_position_settings[channel].kd);
-      }
-      else
-      {
-        SVH_LOG_ERROR_STREAM("SVHController",
-                             "Received a get/set position setting packet for ILLEGAL channel "
-                               << channel << "- packet ignored!");
-      }
-      break;
-    case SVH_GET_CURRENT_SETTINGS:
-    case SVH_SET_CURRENT_SETTINGS:
-      if (channel >= 0 && channel < SVH_DIMENSION)
-      {
-        // std::cout << "Recieved: Current Settings RAW Data: " << ab; // for really intensive
-        // debugging
-        ab >> m_current_settings[channel];
-        SVH_LOG_DEBUG_STREAM("SVHController",
-                             "Received a get/set current setting packet for channel " << channel);
-        SVH_LOG_DEBUG_STREAM("SVHController",
-                             "wmn " << m_current_settings[channel].wmn << " "
-                                    << "wmx " << m_current_settings[channel].wmx << " "
-                                    << "ky " << m_current_settings[channel].ky << " "
-                                    << "dt " << m_current_settings[channel].dt << " "
-                                    << "imn " << m_current_settings[channel].imn << " "
-                                    << "imx " << m_current_settings[channel].imx << " "
-                                    << "kp " << m_current_settings[channel].kp << " "
-                                    << "ki " << m_current_settings[channel].ki << " "
-                                    << "umn " << m_current_settings[channel].umn << " "
-                                    << "umx " << m_current_settings[channel].umx << " ");
-      }
-      else
-      {
-        SVH_LOG_ERROR_STREAM("SVHController",
-                             "Received a get/set current setting packet for ILLEGAL channel "
-                               << channel << "- packet ignored!");
-      }
-      break;
-    case SVH_GET_CONTROLLER_STATE:
-    case SVH_SET_CONTROLLER_STATE:
-      // std::cout << "Recieved: Controller State RAW Data: " << ab; // for really intensive
-      // debugging
-      ab >> m_controller_state;
-      // std::cout << "Received controllerState interpreded data: "<< m_controller_state <<
-      // std::endl; // for really intensive debugging
-      SVH_LOG_DEBUG_STREAM("SVHController", "Received a get/set controler state packet ");
-      SVH_LOG_DEBUG_STREAM("SVHController",
-                           "Controllerstate (NO HEX):"
-                             << "pwm_fault "
-                             << "0x" << static_cast<int>(m_controller_state.pwm_fault) << " "
-                             << "pwm_otw "
-                             << "0x" << static_cast<int>(m_controller_state.pwm_otw) << " "
-                             << "pwm_reset "
-                             << "0x" << static_cast<int>(m_controller_state.pwm_reset) << " "
-                             << "pwm_active "
-                             << "0x" << static_cast<int>(m_controller_state.pwm_active) << " "
-                             << "pos_ctr "
-                             << "0x" << static_cast<int>(m_controller_state.pos_ctrl) << " "
-                             << "cur_ctrl "
-                             << "0x" << static_cast<int>(m_controller_state.cur_ctrl));
-      break;
-    case SVH_GET_ENCODER_VALUES:
-    case SVH_SET_ENCODER_VALUES:
-      SVH_LOG_DEBUG_STREAM("SVHController", "Received a get/set encoder settings packet ");
-      ab >> m_encoder_settings;
-      break;
-    case SVH_GET_FIRMWARE_INFO:
-      // std::cout << "Recieved: Firmware Settings RAW Data: " << ab; // for really intensive
-      // debugging
-      ab >> m_firmware_info;
-      SVH_LOG_INFO_STREAM("SVHController",
-                          "Hardware is using the following Firmware: "
-                            << m_firmware_info.svh << " Version: " << m_firmware_info.version_major
-                            << "." << m_firmware_info.version_minor << " : "
-                            << m_firmware_info.text);
-      break;
-    default:
-      SVH_LOG_ERROR_STREAM("SVHController",
-                           "Received a Packet with unknown address: " << (packet.address & 0x0F)
-                                                                      << " - ignoring packet");
-      break;
+  if (channel < SVH_DIMENSION)
+  {
+    receivedPayload(packet) >> m_position_settings[channel];
+    SVH_LOG_DEBUG_STREAM("SVHController",
+                         "Received a get/set position setting packet for channel " << channel);
+    SVH_LOG_DEBUG_STREAM("SVHController",
+                         "wmn " << m_position_settings[channel].wmn << " "
+                                << "wmx " << m_position_settings[channel].wmx << " "
+                                << "dwmx " << m_position_settings[channel].dwmx << " "
+                                << "ky " << m_position_settings[channel].ky << " "
+                                << "dt " << m_position_settings[channel].dt << " "
+                                << "imn " << m_position_settings[channel].imn << " "
+                                << "imx " << m_position_settings[channel].imx << " "
+                                << "kp " << m_position_settings[channel].kp << " "
+                                << "ki " << m_position_settings[channel].ki << " "
+                                << "kd " << m_position_settings[channel].kd);
+  }
+  else
+  {
+    SVH_LOG_ERROR_STREAM("SVHController",
+                         "Received a get/set position setting packet for ILLEGAL channel "
+                           << channel << "- packet ignored!");
+  }
+}
+
+void SVHController::handleCurrentSettings(const SVHSerialPacket& packet)
+{
+  uint8_t channel = (packet.address >> 4) & 0x0F;
+
+  if (channel < SVH_DIMENSION)
+  {
+    receivedPayload(packet) >> m_current_settings[channel];
+    SVH_LOG_DEBUG_STREAM("SVHController",
+                         "Received a get/set current setting packet for channel " << channel);
+    SVH_LOG_DEBUG_STREAM("SVHController",
+                         "wmn " << m_current_settings[channel].wmn << " "
+                                << "wmx " << m_current_settings[channel].wmx << " "
+                                << "ky " << m_current_settings[channel].ky << " "
+                                << "dt " << m_current_settings[channel].dt << " "
+                                << "imn " << m_current_settings[channel].imn << " "
+                                << "imx " << m_current_settings[channel].imx << " "
+                                << "kp " << m_current_settings[channel].kp << " "
+                                << "ki " << m_current_settings[channel].ki << " "
+                                << "umn " << m_current_settings[channel].umn << " "
+                                << "umx " << m_current_settings[channel].umx << " ");
+  }
+  else
+  {
+    SVH_LOG_ERROR_STREAM("SVHController",
+                         "Received a get/set current setting packet for ILLEGAL channel "
+                           << channel << "- packet ignored!");
   }
 }
 
+void SVHController::handleControllerState(const SVHSerialPacket& packet)
+{
+  receivedPayload(packet) >> m_controller_state;
+  SVH_LOG_DEBUG_STREAM("SVHController", "Received a get/set controler state packet ");
+  SVH_LOG_DEBUG_STREAM("SVHController",
+                       "Controllerstate (NO HEX):"
+                         << "pwm_fault "
+                         << "0x" << static_cast<int>(m_controller_state.pwm_fault) << " "
+                         << "pwm_otw "
+                         << "0x" << static_cast<int>(m_controller_state.pwm_otw) << " "
+                         << "pwm_reset "
+                         << "0x" << static_cast<int>(m_controller_state.pwm_reset) << " "
+                         << "pwm_active "
+                         << "0x" << static_cast<int>(m_controller_state.pwm_active) << " "
+                         << "pos_ctr "
+                         << "0x" << static_cast<int>(m_controller_state.pos_ctrl) << " "
+                         << "cur_ctrl "
+                         << "0x" << static_cast<int>(m_controller_state.cur_ctrl));
+}
+
+void SVHController::handleEncoderValues(const SVHSerialPacket& packet)
+{
+  SVH_LOG_DEBUG_STREAM("SVHController", "Received a get/set encoder settings packet ");
+  receivedPayload(packet) >> m_encoder_settings;
+}
+
+void SVHController::handleFirmwareInfo(const SVHSerialPacket& packet)
+{
+  receivedPayload(packet) >> m_firmware_info;
+  SVH_LOG_INFO_STREAM("SVHController",
+                      "Hardware is using the following Firmware: "
+                        << m_firmware_info.svh << " Version: " << m_firmware_info.version_major
+                        << "." << m_firmware_info.version_minor << " : " << m_firmware_info.text);
+}
+
 bool SVHController::getControllerFeedback(const SVHChannel& channel,
                                           SVHControllerFeedback& controller_feedback)
 {
@@ -786,7 +1029,16 @@ unsigned int SVHController::getReceivedPackageCount()
 
 bool SVHController::isEnabled(const SVHChannel& channel)
 {
-  return ((1 << channel & m_enable_mask) > 0);
+  if (channel == SVH_ALL)
+  {
+    return m_enable_mask.load() == SVH_ALL_CHANNELS_MASK;
+  }
+  return channel >= 0 && channel < SVH_DIMENSION && ((1 << channel & m_enable_mask.load()) > 0);
+}
+
+uint16_t SVHController::enabledMask() const
+{
+  return m_enable_mask.load();
 }
 
 
@@ -38,8 +38,11 @@
  */
 //----------------------------------------------------------------------
 #include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHProbes.h>
+#include <schunk_svh_library/SVHTrace.h>
 #include <schunk_svh_library/control/SVHFingerManager.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <functional>
@@ -49,10 +52,57 @@
 
 namespace driver_svh {
 
+namespace {
+
+//! Attempts per channel when all channels are reset
+const size_t C_RESET_ATTEMPTS = 3;
+
+//! Periods of the steps of the asynchronous operations
+const std::chrono::microseconds C_ASYNC_CONNECT_PERIOD(50000);
+const std::chrono::microseconds C_ASYNC_HOMING_PERIOD(1000);
+const std::chrono::microseconds C_ASYNC_FIRMWARE_PERIOD(100000);
+const std::chrono::microseconds C_ASYNC_SETTINGS_PERIOD(2000);
+
+//! Time a settings round trip waits for the echo of the hand
+const std::chrono::milliseconds C_ASYNC_SETTINGS_TIMEOUT(1000);
+
+//! Period in which settled fingers update the encoder positions of the stored calibration
+const std::chrono::seconds C_CALIBRATION_POSITION_PERIOD(1);
+
+//! Wraps the completion of an asynchronous operation so that only its first call has an effect,
+//! as an operation may finish while it is cancelled
+template <typename... Args>
+std::function<void(Args...)> callOnce(const std::function<void(Args...)>& done)
+{
+  auto called = std::make_shared<std::atomic<bool> >(false);
+  return [called, done](Args... args) {
+    if (!called->exchange(true) && done)
+    {
+      done(args...);
+    }
+  };
+}
+
+//! Period in which the speed of a channel searching its hard stop is sampled
+const std::chrono::milliseconds C_SPEED_SAMPLE_PERIOD(20);
+
+//! Ends the traced homing phase \a name of a channel and starts the next one
+void traceHomingPhase(uint64_t& start_ns, const char* name, SVHChannel channel)
+{
+  if (start_ns != 0 && SVHTrace::isEnabled())
+  {
+    SVHTrace::complete("homing", name, start_ns, "channel", channel);
+  }
+  start_ns = SVHTrace::isEnabled() ? SVHTrace::now() : 0;
+}
+
+} // namespace
+
 SVHFingerManager::SVHFingerManager(const std::vector<bool>& disable_mask,
                                    const uint32_t& reset_timeout)
   : m_controller(new SVHController())
   , m_feedback_thread()
+  , m_uses_reactor(false)
   , m_connected(false)
   , m_connection_feedback_given(false)
   , m_homing_timeout(10)
@@ -60,8 +110,10 @@ SVHFingerManager::SVHFingerManager(const std::vector<bool>& disable_mask,
   , m_position_min(SVH_DIMENSION, 0)
   , m_position_max(SVH_DIMENSION, 0)
   , m_position_home(SVH_DIMENSION, 0)
-  , m_is_homed(SVH_DIMENSION, false)
-  , m_is_switched_off(SVH_DIMENSION, false)
+  , m_controller_state_published(false)
+  , m_homed_mask(0)
+  , m_switched_off_mask(0)
+  , m_faulted_mask(0)
   , m_diagnostic_encoder_state(SVH_DIMENSION, false)
   , m_diagnostic_current_state(SVH_DIMENSION, false)
   , m_diagnostic_current_maximum(SVH_DIMENSION, 0)
@@ -71,6 +123,13 @@ SVHFingerManager::SVHFingerManager(const std::vector<bool>& disable_mask,
   , m_diagnostic_deadlock(SVH_DIMENSION, 0)
   , m_reset_speed_factor(0.2)
   , m_reset_timeout(reset_timeout)
+  , m_channel_calibrations(SVH_DIMENSION)
+  , m_unchecked_calibration_mask(0)
+  , m_calibration_position_samples(SVH_DIMENSION, 0)
+  , m_calibration_position_time()
+  , m_hardstop_hints(SVH_DIMENSION, 0)
+  , m_hardstop_hint_mask(0)
+  , m_homing_timings(SVH_DIMENSION)
   , m_current_settings(SVH_DIMENSION)
   , m_current_settings_given(SVH_DIMENSION, false)
   , m_position_settings(SVH_DIMENSION)
@@ -95,8 +154,8 @@ SVHFingerManager::SVHFingerManager(const std::vector<bool>& disable_mask,
 
   for (size_t i = 0; i < SVH_DIMENSION; ++i)
   {
-    m_is_switched_off[i] = disable_mask[i];
-    if (m_is_switched_off[i])
+    updateMask(m_switched_off_mask, static_cast<uint16_t>(1 << i), disable_mask[i]);
+    if (disable_mask[i])
     {
       SVH_LOG_INFO_STREAM("SVHFingerManager",
                           "Joint: "
@@ -115,10 +174,31 @@ SVHFingerManager::SVHFingerManager(const std::vector<bool>& disable_mask,
 
   m_firmware_info.version_major = 0;
   m_firmware_info.version_minor = 0;
+
+  // Decoded packets are turned into events for the subscriptions
+  const uint8_t published_types[] = {SVH_GET_CONTROL_FEEDBACK,
+                                     SVH_SET_CONTROL_COMMAND,
+                                     SVH_GET_CONTROL_FEEDBACK_ALL,
+                                     SVH_SET_CONTROL_COMMAND_ALL,
+                                     SVH_GET_POSITION_SETTINGS,
+                                     SVH_SET_POSITION_SETTINGS,
+                                     SVH_GET_CURRENT_SETTINGS,
+                                     SVH_SET_CURRENT_SETTINGS,
+                                     SVH_GET_CONTROLLER_STATE,
+                                     SVH_SET_CONTROLLER_STATE,
+                                     SVH_GET_FIRMWARE_INFO};
+  for (uint8_t type : published_types)
+  {
+    m_controller->addPacketObserver(
+      type, std::bind(&SVHFingerManager::publishEvents, this, std::placeholders::_1));
+  }
 }
 
 SVHFingerManager::~SVHFingerManager()
 {
+  // Operations of a reactor that outlives the manager must not run on a destroyed object
+  cancelAsyncOperations();
+
   if (m_connected)
   {
     disconnect();
@@ -139,7 +219,26 @@ bool SVHFingerManager::connect(const std::string& dev_name, const unsigned int&
   // Save device handle for next use
   m_serial_device = dev_name;
 
+  return connectController(
+    [this, &dev_name] { return m_controller->connect(dev_name); }, dev_name, retry_count);
+}
+
+bool SVHFingerManager::connect(const std::shared_ptr<SVHTransport>& transport,
+                               const unsigned int& retry_count)
+{
+  SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                       "Finger manager is trying to connect to the Hardware...");
+
+  return connectController([this, &transport] { return m_controller->connect(transport); },
+                           transport ? transport->deviceName() : std::string(),
+                           retry_count);
+}
 
+bool SVHFingerManager::connectController(const std::function<bool()>& open,
+                                         const std::string& device_name,
+                                         const unsigned int& retry_count)
+{
+  SVH_TRACE_SPAN("connect", "connect");
   if (m_connected)
   {
     disconnect();
@@ -147,135 +246,191 @@ bool SVHFingerManager::connect(const std::string& dev_name, const unsigned int&
 
   if (m_controller != NULL)
   {
-    if (m_controller->connect(dev_name))
+    const bool opened = open();
+    SVH_PROBE1(connect_open, opened);
+    if (opened)
     {
-      unsigned int num_retries = retry_count;
+      unsigned int num_retries    = retry_count;
+      unsigned int received_count = 0;
       do
       {
-        // Reset the package counts (in case a previous attempt was made)
-        m_controller->resetPackageCounts();
+        SVH_TRACE_SPAN_ARG("connect", "attempt", "retries", num_retries);
+        beginConnectAttempt();
+
+        // check for correct response from hardware controller
+        auto start_time = std::chrono::high_resolution_clock::now();
+        while (checkConnectAttempt(start_time, received_count) == CS_PENDING)
+        {
+          std::this_thread::sleep_for(std::chrono::microseconds(50000));
+        }
+        // Keep trying to reconnect several times because the brainbox often makes problems
+      } while (!m_connected && retryConnect(received_count, num_retries));
 
-        // load default position settings before the fingers are resetted
-        std::vector<SVHPositionSettings> position_settings = getDefaultPositionSettings(true);
+      finishConnect(device_name, true);
+    }
+    else
+    {
+      SVH_LOG_ERROR_STREAM("SVHFingerManager", "Connection FAILED! Device could NOT be opened");
+    }
+  }
 
-        // load default current settings
-        std::vector<SVHCurrentSettings> current_settings = getDefaultCurrentSettings();
+  return m_connected;
+}
 
-        m_controller->disableChannel(SVH_ALL);
+void SVHFingerManager::beginConnectAttempt()
+{
+  SVH_TRACE_SPAN("connect", "sendSettings");
+  SVH_PROBE(connect_attempt);
+  // Reset the package counts (in case a previous attempt was made)
+  m_controller->resetPackageCounts();
 
-        // initialize all channels
-        for (size_t i = 0; i < SVH_DIMENSION; ++i)
-        {
-          // request controller feedback to have a valid starting point
-          m_controller->requestControllerFeedback(static_cast<SVHChannel>(i));
+  // load default position settings before the fingers are resetted
+  std::vector<SVHPositionSettings> position_settings = getDefaultPositionSettings(true);
 
-          // Actually set the new position settings
-          m_controller->setPositionSettings(static_cast<SVHChannel>(i), position_settings[i]);
+  // load default current settings
+  std::vector<SVHCurrentSettings> current_settings = getDefaultCurrentSettings();
 
-          // set current settings
-          m_controller->setCurrentSettings(static_cast<SVHChannel>(i), current_settings[i]);
-        }
+  m_controller->disableChannel(SVH_ALL);
 
-        // check for correct response from hardware controller
-        auto start_time             = std::chrono::high_resolution_clock::now();
-        bool timeout                = false;
-        unsigned int received_count = 0;
-        unsigned int send_count     = 0;
-        while (!timeout && !m_connected)
-        {
-          send_count     = m_controller->getSentPackageCount();
-          received_count = m_controller->getReceivedPackageCount();
-          if (send_count == received_count)
-          {
-            m_connected = true;
-            SVH_LOG_INFO_STREAM("SVHFingerManager",
-                                "Successfully established connection to SCHUNK five finger hand."
-                                  << "Send packages = " << send_count
-                                  << ", received packages = " << received_count);
-          }
-          SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                               "Try to connect to SCHUNK five finger hand: Send packages = "
-                                 << send_count << ", received packages = " << received_count);
+  // initialize all channels
+  for (size_t i = 0; i < SVH_DIMENSION; ++i)
+  {
+    // request controller feedback to have a valid starting point
+    m_controller->requestControllerFeedback(static_cast<SVHChannel>(i));
 
-          // check for timeout
-          if ((std::chrono::high_resolution_clock::now() - start_time) > m_reset_timeout)
-          {
-            timeout = true;
-            SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                                 "Connection timeout! Could not connect to SCHUNK five finger hand."
-                                   << "Send packages = " << send_count
-                                   << ", received packages = " << received_count);
-          }
-          std::this_thread::sleep_for(std::chrono::microseconds(50000));
-        }
+    // Actually set the new position settings
+    m_controller->setPositionSettings(static_cast<SVHChannel>(i), position_settings[i]);
 
-        // Try again, but ONLY if we at least got one package back, otherwise its futil
-        if (!m_connected)
-        {
-          if (received_count > 0 && num_retries >= 0)
-          {
-            num_retries--;
-            SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                                 "Connection Failed! Send packages = "
-                                   << send_count << ", received packages = " << received_count
-                                   << ". Retrying, count: " << num_retries);
-          }
-          else
-          {
-            num_retries = 0;
-            SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                                 "Connection Failed! Send packages = "
-                                   << send_count << ", received packages = " << received_count
-                                   << ". Not Retrying anymore.");
-          }
-        }
-        // Keep trying to reconnect several times because the brainbox often makes problems
-      } while (!m_connected && num_retries > 0);
+    // set current settings
+    m_controller->setCurrentSettings(static_cast<SVHChannel>(i), current_settings[i]);
+  }
+}
 
+SVHFingerManager::ConnectState SVHFingerManager::checkConnectAttempt(
+  const std::chrono::high_resolution_clock::time_point& start_time, unsigned int& received_count)
+{
+  unsigned int send_count = m_controller->getSentPackageCount();
+  received_count          = m_controller->getReceivedPackageCount();
+  if (send_count == received_count)
+  {
+    m_connected = true;
+    SVH_LOG_INFO_STREAM("SVHFingerManager",
+                        "Successfully established connection to SCHUNK five finger hand."
+                          << "Send packages = " << send_count
+                          << ", received packages = " << received_count);
+    return CS_CONNECTED;
+  }
+  SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                       "Try to connect to SCHUNK five finger hand: Send packages = "
+                         << send_count << ", received packages = " << received_count);
 
-      if (!m_connected && num_retries <= 0)
-      {
-        SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                             "A Stable connection could NOT be made, however some packages where "
-                             "received. Please check the hardware!");
-      }
+  // check for timeout
+  if ((std::chrono::high_resolution_clock::now() - start_time) > m_reset_timeout)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Connection timeout! Could not connect to SCHUNK five finger hand."
+                           << "Send packages = " << send_count
+                           << ", received packages = " << received_count);
+    return CS_TIMEOUT;
+  }
+  return CS_PENDING;
+}
 
+bool SVHFingerManager::retryConnect(unsigned int received_count, unsigned int& num_retries)
+{
+  // Try again, but ONLY if we at least got one package back, otherwise its futil
+  if (received_count > 0)
+  {
+    num_retries--;
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Connection Failed! Send packages = "
+                           << m_controller->getSentPackageCount()
+                           << ", received packages = " << received_count
+                           << ". Retrying, count: " << num_retries);
+  }
+  else
+  {
+    num_retries = 0;
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Connection Failed! Send packages = "
+                           << m_controller->getSentPackageCount()
+                           << ", received packages = " << received_count
+                           << ". Not Retrying anymore.");
+  }
+  return num_retries > 0;
+}
 
-      if (m_connected)
-      {
-        // Request firmware information once at the beginning, it will print out on the console
-        m_controller->requestFirmwareInfo();
+void SVHFingerManager::finishConnect(const std::string& device_name, bool calibrate_gap)
+{
+  SVH_PROBE1(connect_done, m_connected.load());
+  if (!m_connected)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "A Stable connection could NOT be made, however some packages where "
+                         "received. Please check the hardware!");
+  }
 
-        // initialize feedback polling thread
-        if (m_feedback_thread.joinable()) // clean reset
-        {
-          m_poll_feedback = false;
-          m_feedback_thread.join();
-        }
-        m_poll_feedback   = true;
-        m_feedback_thread = std::thread(&SVHFingerManager::pollFeedback, this);
-        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                             "Finger manager is starting the fedback polling thread");
-      }
-      else
-      {
-        // connection open but not stable: close serial port for better reconnect later
-        m_controller->disconnect();
-      }
+  m_gap_calibration_report = SVHGapCalibrationReport();
+  if (m_connected && m_gap_calibration.enabled)
+  {
+    // Nothing else is sent yet, so every reply belongs to a probe
+    if (m_controller->getTransportOptions().transmit_window > 0)
+    {
+      SVH_LOG_INFO_STREAM("SVHFingerManager",
+                          "Frames are paced by the transmit window, the gap is not calibrated");
+    }
+    else if (!calibrate_gap)
+    {
+      SVH_LOG_INFO_STREAM("SVHFingerManager",
+                          "The gap is not calibrated while connecting asynchronously");
     }
     else
     {
-      SVH_LOG_ERROR_STREAM("SVHFingerManager", "Connection FAILED! Device could NOT be opened");
+      SVH_TRACE_SPAN("connect", "gapCalibration");
+      m_gap_calibration_report =
+        SVHGapCalibration(m_gap_calibration).run(*m_controller, device_name);
     }
   }
 
-  return m_connected;
+  restoreHomingCalibration(device_name);
+
+  if (m_connected)
+  {
+    // Request firmware information once at the beginning, it will print out on the console
+    m_controller->requestFirmwareInfo();
+
+    // initialize feedback polling thread
+    if (m_feedback_thread.joinable()) // clean reset
+    {
+      m_poll_feedback = false;
+      m_feedback_thread.join();
+    }
+    if (!m_uses_reactor)
+    {
+      m_poll_feedback   = true;
+      m_feedback_thread = std::thread(&SVHFingerManager::pollFeedback, this);
+      SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                           "Finger manager is starting the fedback polling thread");
+    }
+  }
+  else
+  {
+    // connection open but not stable: close serial port for better reconnect later
+    m_controller->disconnect();
+  }
 }
 
 void SVHFingerManager::disconnect()
 {
   SVH_LOG_DEBUG_STREAM("SVHFingerManager",
                        "Finger manager is trying to discoconnect to the Hardware...");
+  cancelAsyncOperations();
+
+  if (m_connected)
+  {
+    storeHomingCalibrationPositions();
+  }
+
   m_connected                 = false;
   m_connection_feedback_given = false;
 
@@ -297,6 +452,7 @@ void SVHFingerManager::disconnect()
 //! reset function for a single finger
 bool SVHFingerManager::resetChannel(const SVHChannel& channel)
 {
+  SVH_TRACE_SPAN_ARG("homing", "resetChannel", "channel", channel);
   if (m_connected)
   {
     // reset all channels
@@ -306,7 +462,7 @@ bool SVHFingerManager::resetChannel(const SVHChannel& channel)
       for (size_t i = 0; i < SVH_DIMENSION; ++i)
       {
         // try three times to reset each finger
-        size_t max_reset_counter = 3;
+        size_t max_reset_counter = C_RESET_ATTEMPTS;
         bool reset_success       = false;
         while (!reset_success && max_reset_counter > 0)
         {
@@ -326,340 +482,652 @@ bool SVHFingerManager::resetChannel(const SVHChannel& channel)
     }
     else if (channel > SVH_ALL && SVH_ALL < SVH_DIMENSION)
     {
-      m_diagnostic_encoder_state[channel] = false;
-      m_diagnostic_current_state[channel] = false;
-
-      SVH_LOG_DEBUG_STREAM("SVHFingerManager", "Start homing channel " << channel);
-
-      if (!m_is_switched_off[channel])
+      HomingProcess homing;
+      startHoming(homing, channel);
+      while (stepHoming(homing))
       {
-        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                             "Setting reset position values for controller of channel " << channel);
-
-        m_controller->setPositionSettings(channel, getDefaultPositionSettings(true)[channel]);
-
-        // reset homed flag
-        m_is_homed[channel] = false;
-
-        // read default home settings for channel
-        SVHHomeSettings home = m_home_settings[channel];
+      }
+      return homing.success;
+    }
+    else
+    {
+      SVH_LOG_ERROR_STREAM("SVHFingerManager", "Channel " << channel << " is out of bounds!");
+      return false;
+    }
+  }
+  else
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Could not reset channel "
+                           << channel << ": No connection to SCHUNK five finger hand!");
+    return false;
+  }
+}
 
-        SVHPositionSettings pos_set;
-        SVHCurrentSettings cur_set;
-        m_controller->getPositionSettings(channel, pos_set);
-        m_controller->getCurrentSettings(channel, cur_set);
+void SVHFingerManager::startHoming(HomingProcess& homing, const SVHChannel& channel)
+{
+  const uint16_t channel_bit         = static_cast<uint16_t>(1 << channel);
+  homing.channel                      = channel;
+  homing.success                      = true;
+  m_diagnostic_encoder_state[channel] = false;
+  m_diagnostic_current_state[channel] = false;
 
-        // find home position
-        int32_t position = 0;
+  // no phase is running yet, the first one starts the timings
+  homing.timings      = SVHHomingTimings();
+  homing.homing_start = std::chrono::high_resolution_clock::now();
+  homing.phase_start  = homing.homing_start;
+  homing.phase        = HP_DONE;
 
-        if (home.direction > 0)
-        {
-          position = static_cast<int32_t>(pos_set.wmx);
-        }
-        else
-        {
-          position = static_cast<int32_t>(pos_set.wmn);
-        }
+  SVH_LOG_DEBUG_STREAM("SVHFingerManager", "Start homing channel " << channel);
 
-        SVH_LOG_INFO_STREAM("SVHFingerManager",
-                            "Driving channel "
-                              << channel << " to hardstop. Detection thresholds: Current MIN: "
-                              << home.reset_current_factor * cur_set.wmn
-                              << "mA MAX: " << home.reset_current_factor * cur_set.wmx << "mA");
+  if (m_switched_off_mask.load() & channel_bit)
+  {
+    SVH_LOG_INFO_STREAM("SVHFingerManager",
+                        "Channel " << channel << "switched of by user, homing is set to finished");
+    updateMask(m_homed_mask, channel_bit, true);
+    SVH_LOG_INFO_STREAM("SVHFingerManager", "Successfully homed channel " << channel);
+    enterHomingPhase(homing, HP_DONE);
+    return;
+  }
 
-        m_controller->setControllerTarget(channel, position);
-        m_controller->enableChannel(channel);
+  homing.trace_start_ns = SVHTrace::isEnabled() ? SVHTrace::now() : 0;
+  SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                       "Setting reset position values for controller of channel " << channel);
 
-        SVHControllerFeedback control_feedback_previous;
-        SVHControllerFeedback control_feedback;
+  m_controller->setPositionSettings(channel, getDefaultPositionSettings(true)[channel]);
 
-        // initialize timeout
-        auto start_time     = std::chrono::high_resolution_clock::now();
-        auto start_time_log = std::chrono::high_resolution_clock::now();
-        // Debug helper to just notify about fresh stales
-        bool stale_notification_sent = false;
+  // reset homed and fault flags
+  updateMask(m_homed_mask, channel_bit, false);
+  updateMask(m_faulted_mask, channel_bit, false);
 
-        for (size_t hit_count = 0; hit_count < 10;)
-        {
-          m_controller->setControllerTarget(channel, position);
-          // m_controller->requestControllerFeedback(channel);
-          m_controller->getControllerFeedback(channel, control_feedback);
-          // Timeout while no encoder ticks changed
-
-          // Quite extensive Current output!
-          if (std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::high_resolution_clock::now() - start_time_log) >
-              std::chrono::milliseconds(1000))
-          {
-            SVH_LOG_INFO_STREAM("SVHFingerManager",
-                                "Resetting Channel "
-                                  << channel << ":" << m_controller->m_channel_description[channel]
-                                  << " current: " << control_feedback.current << " mA");
-            start_time_log = std::chrono::high_resolution_clock::now();
-          }
+  // read default home settings for channel
+  homing.home = m_home_settings[channel];
+  m_controller->getCurrentSettings(channel, homing.cur_set);
 
-          double threshold = 80;
-          // have a look for deadlocks
-          if (home.direction == +1)
-          {
-            double delta =
-              control_feedback.current -
-              m_diagnostic_current_maximum[channel]; // without deadlocks delta should be positiv
-            if (delta <= -threshold)
-            {
-              if (std::abs(delta) > m_diagnostic_deadlock[channel])
-              {
-                m_diagnostic_deadlock[channel] = std::abs(delta);
-              }
-            }
-          }
-          else
-          {
-            double delta = control_feedback.current - m_diagnostic_current_minimum[channel];
-            if (delta >= threshold)
-            {
-              if (std::abs(delta) > m_diagnostic_deadlock[channel])
-              {
-                m_diagnostic_deadlock[channel] = std::abs(delta);
-              }
-            }
-          }
+  if (!startCalibrationCheck(homing))
+  {
+    startHardstopSearch(homing);
+  }
+}
 
-          // save the maximal/minimal current of the motor
-          if (control_feedback.current > m_diagnostic_current_maximum[channel])
-          {
-            m_diagnostic_current_maximum[channel] = control_feedback.current;
-          }
-          else
-          {
-            if (control_feedback.current < m_diagnostic_current_minimum[channel])
-            {
-              m_diagnostic_current_minimum[channel] = control_feedback.current;
-            }
-          }
+void SVHFingerManager::startHardstopSearch(HomingProcess& homing)
+{
+  const SVHChannel channel   = homing.channel;
+  const uint16_t channel_bit = static_cast<uint16_t>(1 << channel);
 
-          if ((home.reset_current_factor * cur_set.wmn >= control_feedback.current) ||
-              (control_feedback.current >= home.reset_current_factor * cur_set.wmx))
-          {
-            m_diagnostic_current_state[channel] =
-              true; // when in maximum the current controller is ok
-
-            hit_count++;
-            SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                                 "Resetting Channel "
-                                   << channel << ":" << m_controller->m_channel_description[channel]
-                                   << " Hit Count increased: " << hit_count);
-          }
-          else if (hit_count > 0)
-          {
-            hit_count--;
-            SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                                 "Resetting Channel "
-                                   << channel << ":" << m_controller->m_channel_description[channel]
-                                   << " Hit Count Decreased: " << hit_count);
-          }
+  bool hinted      = false;
+  int32_t hardstop = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+    hinted   = (m_hardstop_hint_mask & channel_bit) != 0;
+    hardstop = m_hardstop_hints[channel];
+  }
 
-          // check for time out: Abort, if position does not change after homing timeout.
-          if ((std::chrono::high_resolution_clock::now() - start_time) > m_homing_timeout)
-          {
-            m_controller->disableChannel(SVH_ALL);
-            SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                                 "Timeout: Aborted finding home position for channel " << channel);
-            // Timeout could mean serious hardware issues or just plain wrong settings
-            return false;
-          }
+  // The fast approach ends a margin before the expected hard stop, it is pointless if the channel
+  // is already closer to it
+  SVHControllerFeedback feedback;
+  m_controller->getControllerFeedback(channel, feedback);
+  const int32_t approach_position =
+    hardstop - homing.home.direction * m_homing_profile.approach_margin;
+  if (!m_homing_profile.fast_approach || !hinted ||
+      homing.home.direction * (approach_position - feedback.position) < 1000)
+  {
+    startSlowSearch(homing);
+    return;
+  }
 
-          // reset time if position changes
-          if (control_feedback.position != control_feedback_previous.position)
-          {
-            m_diagnostic_encoder_state[channel] = true;
-            // save the maximal/minimal position the channel can reach
-            if (control_feedback.position > m_diagnostic_position_maximum[channel])
-              m_diagnostic_position_maximum[channel] = control_feedback.position;
-            else if (control_feedback.position < m_diagnostic_position_minimum[channel])
-              m_diagnostic_position_minimum[channel] = control_feedback.position;
-
-            start_time = std::chrono::high_resolution_clock::now();
-            if (stale_notification_sent)
-            {
-              SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                                   "Resetting Channel "
-                                     << channel << ":"
-                                     << m_controller->m_channel_description[channel]
-                                     << " Stale resolved, continuing detection");
-              stale_notification_sent = false;
-            }
-          }
-          else
-          {
-            if (!stale_notification_sent)
-            {
-              SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                                   "Resetting Channel "
-                                     << channel << ":"
-                                     << m_controller->m_channel_description[channel]
-                                     << " Stale detected. Starting Timeout");
-              stale_notification_sent = true;
-            }
-          }
+  SVHPositionSettings pos_set = getDefaultPositionSettings(false)[channel];
+  pos_set.dwmx *= m_homing_profile.approach_speed_factor;
+  m_controller->setPositionSettings(channel, pos_set);
 
-          // save previous control feedback
-          control_feedback_previous = control_feedback;
-          // std::this_thread::sleep_for(std::chrono::microseconds(8000));
-        }
-        // give the last info with highes channel current value
-        SVH_LOG_INFO_STREAM("SVHFingerManager",
-                            "Resetting Channel "
-                              << channel << ":" << m_controller->m_channel_description[channel]
-                              << " current: " << control_feedback.current << " mA");
-
-        SVH_LOG_DEBUG_STREAM("SVHFingerManager", "Hit counter of " << channel << " reached.");
-
-
-        // set reference values
-        m_position_min[channel] = static_cast<int32_t>(
-          control_feedback.position + std::min(home.minimum_offset, home.maximum_offset));
-        m_position_max[channel] = static_cast<int32_t>(
-          control_feedback.position + std::max(home.minimum_offset, home.maximum_offset));
-        m_position_home[channel] =
-          static_cast<int32_t>(control_feedback.position + home.direction * home.idle_position);
-        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                             "Setting soft stops for Channel "
-                               << channel << " min pos = " << m_position_min[channel]
-                               << " max pos = " << m_position_max[channel]
-                               << " home pos = " << m_position_home[channel]);
-
-        // position will now be reached to release the motor and go into soft stops
-        position = m_position_home[channel];
-
-        // go to idle position
-        // use the declared start_time variable for the homing timeout
-        start_time = std::chrono::high_resolution_clock::now();
-        while (true)
-        {
-          m_controller->setControllerTarget(channel, position);
-          // m_controller->requestControllerFeedback(channel);
-          m_controller->getControllerFeedback(channel, control_feedback);
+  homing.position = approach_position;
+  SVH_LOG_INFO_STREAM("SVHFingerManager",
+                      "Driving channel " << channel << " quickly to " << approach_position
+                                         << ", its hardstop is expected at " << hardstop);
 
-          SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                               "Homing Channel "
-                                 << channel << ":" << m_controller->m_channel_description[channel]
-                                 << " current: " << control_feedback.current
-                                 << " mA, position ticks: " << control_feedback.position);
+  m_controller->setControllerTarget(channel, homing.position);
+  m_controller->enableChannel(channel);
 
-          if (abs(position - control_feedback.position) < 1000)
-          {
-            m_is_homed[channel] = true;
-            break;
-          }
+  homing.control_feedback          = SVHControllerFeedback();
+  homing.control_feedback_previous = SVHControllerFeedback();
+  homing.start_time                = std::chrono::high_resolution_clock::now();
+  enterHomingPhase(homing, HP_FAST_APPROACH);
+}
 
-          // if the finger hasn't reached the home position after m_homing_timeout there is an
-          // hardware error
-          if ((std::chrono::high_resolution_clock::now() - start_time) > m_homing_timeout)
-          {
-            m_is_homed[channel] = false;
-            SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                                 "Channel " << channel << " home position is not reachable after "
-                                            << m_homing_timeout.count()
-                                            << "s! There could be an hardware error!");
-            break;
-          }
-        }
+void SVHFingerManager::startSlowSearch(HomingProcess& homing)
+{
+  const SVHChannel channel = homing.channel;
 
-        m_controller->disableChannel(SVH_ALL);
-        // std::this_thread::sleep_for(std::chrono::microseconds(8000));
-        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
-                             "Restoring default position values for controller of channel "
-                               << channel);
-        m_controller->setPositionSettings(channel, getDefaultPositionSettings(false)[channel]);
-      }
-      else
-      {
-        SVH_LOG_INFO_STREAM("SVHFingerManager",
-                            "Channel " << channel
-                                       << "switched of by user, homing is set to finished");
-        m_is_homed[channel] = true;
-      }
+  if (homing.phase == HP_FAST_APPROACH)
+  {
+    m_controller->setPositionSettings(channel, getDefaultPositionSettings(true)[channel]);
+  }
 
-      // Check if this reset has trigger the reset of all the Fingers
-      // bool reset_all_success = true;
-      // for (size_t i = 0; i < SVH_DIMENSION; ++i)
-      // {
-      //   reset_all_success == reset_all_success&& m_is_homed[channel];
-      // }
+  // Lower current limits make the hard stop stop the channel with less force
+  const float current_factor = m_homing_profile.search_current_factor;
+  if (current_factor < 1.0f)
+  {
+    SVHCurrentSettings search_cur_set = homing.cur_set;
+    search_cur_set.wmn *= current_factor;
+    search_cur_set.wmx *= current_factor;
+    m_controller->setCurrentSettings(channel, search_cur_set);
+  }
 
-      SVH_LOG_INFO_STREAM("SVHFingerManager", "Successfully homed channel " << channel);
+  SVHPositionSettings pos_set;
+  m_controller->getPositionSettings(channel, pos_set);
 
-      return true;
-    }
-    else
-    {
-      SVH_LOG_ERROR_STREAM("SVHFingerManager", "Channel " << channel << " is out of bounds!");
-      return false;
-    }
+  // find home position
+  if (homing.home.direction > 0)
+  {
+    homing.search_position = static_cast<int32_t>(pos_set.wmx);
   }
   else
   {
-    SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                         "Could not reset channel "
-                           << channel << ": No connection to SCHUNK five finger hand!");
-    return false;
-  }
+    homing.search_position = static_cast<int32_t>(pos_set.wmn);
+  }
+  homing.position = homing.search_position;
+
+  const float threshold_factor = homing.home.reset_current_factor * current_factor;
+  SVH_LOG_INFO_STREAM("SVHFingerManager",
+                      "Driving channel "
+                        << channel << " to hardstop. Detection thresholds: Current MIN: "
+                        << threshold_factor * homing.cur_set.wmn
+                        << "mA MAX: " << threshold_factor * homing.cur_set.wmx << "mA");
+
+  m_controller->setControllerTarget(channel, homing.position);
+  m_controller->enableChannel(channel);
+
+  SVHControllerFeedback feedback;
+  m_controller->getControllerFeedback(channel, feedback);
+  homing.control_feedback          = SVHControllerFeedback();
+  homing.control_feedback_previous = SVHControllerFeedback();
+
+  // initialize timeout
+  homing.start_time              = std::chrono::high_resolution_clock::now();
+  homing.start_time_log          = homing.start_time;
+  homing.stale_notification_sent = false;
+  homing.hit_count               = 0;
+  homing.contact                 = false;
+  homing.peak_speed              = 0.0;
+  homing.speed_sample_time       = homing.start_time;
+  homing.speed_sample_position   = feedback.position;
+  enterHomingPhase(homing, HP_FIND_HARDSTOP);
 }
 
-bool SVHFingerManager::getDiagnosticStatus(const SVHChannel& channel,
-                                           struct DiagnosticState& diagnostic_status)
+void SVHFingerManager::restoreSearchCurrent(const HomingProcess& homing)
 {
-  if (channel >= 0 && channel < SVH_DIMENSION)
-  {
-    diagnostic_status.diagnostic_encoder_state    = m_diagnostic_encoder_state[channel];
-    diagnostic_status.diagnostic_motor_state      = m_diagnostic_current_state[channel];
-    diagnostic_status.diagnostic_current_maximum  = m_diagnostic_current_maximum[channel];
-    diagnostic_status.diagnostic_current_minimum  = m_diagnostic_current_minimum[channel];
-    diagnostic_status.diagnostic_position_maximum = m_diagnostic_position_maximum[channel];
-    diagnostic_status.diagnostic_position_minimum = m_diagnostic_position_minimum[channel];
-    diagnostic_status.diagnostic_deadlock         = m_diagnostic_deadlock[channel];
-    return true;
-  }
-  else
+  if (m_homing_profile.search_current_factor < 1.0f)
   {
-    SVH_LOG_ERROR_STREAM("SVHFingerManager",
-                         "Could not get diagnostic status for unknown/unsupported channel "
-                           << channel);
-    return false;
+    m_controller->setCurrentSettings(homing.channel, homing.cur_set);
   }
 }
 
+void SVHFingerManager::enterHomingPhase(HomingProcess& homing, HomingPhase phase)
+{
+  const auto now = std::chrono::high_resolution_clock::now();
+  const auto duration =
+    std::chrono::duration_cast<std::chrono::microseconds>(now - homing.phase_start);
+  switch (homing.phase)
+  {
+    case HP_FAST_APPROACH:
+      homing.timings.fast_approach += duration;
+      break;
+    case HP_FIND_HARDSTOP:
+      homing.timings.hardstop_search += duration;
+      break;
+    case HP_VERIFY_CALIBRATION:
+      homing.timings.calibration_check += duration;
+      break;
+    case HP_GO_TO_IDLE:
+      homing.timings.go_to_idle += duration;
+      break;
+    case HP_DONE:
+      break;
+  }
+  homing.phase_start = now;
+  homing.phase       = phase;
+  SVH_PROBE3(homing_phase, homing.channel, homing.phase, homing.success);
+
+  if (phase == HP_DONE)
+  {
+    homing.timings.total =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - homing.homing_start);
+    std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+    m_homing_timings[homing.channel] = homing.timings;
+  }
+}
 
-// enables controller of channel
-bool SVHFingerManager::enableChannel(const SVHChannel& channel)
+bool SVHFingerManager::startCalibrationCheck(HomingProcess& homing)
 {
-  if (isConnected() && isHomed(channel))
+  const SVHChannel channel   = homing.channel;
+  const uint16_t channel_bit = static_cast<uint16_t>(1 << channel);
+
+  SVHChannelCalibration calibration;
   {
-    if (channel == SVH_ALL)
+    std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+    if (!(m_unchecked_calibration_mask & channel_bit))
     {
-      for (size_t i = 0; i < SVH_DIMENSION; ++i)
-      {
-        // Just for safety, enable channels in the same order as we have resetted them (otherwise
-        // developers might geht confused)
-        SVHChannel real_channel = static_cast<SVHChannel>(m_reset_order[i]);
-        if (!m_is_switched_off[real_channel])
-        {
-          // recursion to get the other updates corresponing with activation of a channel
-          enableChannel(real_channel);
-        }
-      }
+      return false;
     }
-    else if (channel > SVH_ALL && SVH_ALL < SVH_DIMENSION)
-    {
-      // Note: This part is another one of these places where the names can lead to confusion. I am
-      // sorry about that Switched off is a logical term. The user has chosen NOT to use this
-      // channel because of hardware trouble. To enable a smooth driver behaviour all replys
-      // regarding these channels will be answered in the most positive way the caller could expect.
+    // A restored calibration is only used once, later resets home the channel completely
+    m_unchecked_calibration_mask &= ~channel_bit;
+    calibration = m_channel_calibrations[channel];
+  }
+
+  m_position_min[channel]  = calibration.position_min;
+  m_position_max[channel]  = calibration.position_max;
+  m_position_home[channel] = calibration.position_home;
+
+  // move away from the hard stop, but stay within the soft stops
+  homing.position = calibration.position_home -
+                    static_cast<int32_t>(homing.home.direction) *
+                      m_homing_calibration.plausibility_distance;
+  homing.position =
+    std::max(calibration.position_min, std::min(calibration.position_max, homing.position));
+
+  SVH_LOG_INFO_STREAM("SVHFingerManager",
+                      "Channel " << channel
+                                 << " uses its stored calibration, checking it with a move to "
+                                 << homing.position);
+
+  m_controller->setControllerTarget(channel, homing.position);
+  m_controller->enableChannel(channel);
+
+  homing.control_feedback          = SVHControllerFeedback();
+  homing.control_feedback_previous = SVHControllerFeedback();
+
+  homing.start_time              = std::chrono::high_resolution_clock::now();
+  homing.start_time_log          = homing.start_time;
+  homing.stale_notification_sent = false;
+  homing.hit_count               = 0;
+  enterHomingPhase(homing, HP_VERIFY_CALIBRATION);
+  return true;
+}
+
+bool SVHFingerManager::stepHoming(HomingProcess& homing)
+{
+  const SVHChannel channel          = homing.channel;
+  const uint16_t channel_bit        = static_cast<uint16_t>(1 << channel);
+  SVHControllerFeedback& feedback   = homing.control_feedback;
+  const SVHHomeSettings& home       = homing.home;
+  const SVHCurrentSettings& cur_set = homing.cur_set;
+
+  if (homing.phase == HP_FAST_APPROACH)
+  {
+    m_controller->setControllerTarget(channel, homing.position);
+    m_controller->getControllerFeedback(channel, feedback);
+
+    // the full current limits apply, a contact ends the approach at once
+    const bool contact = (home.reset_current_factor * cur_set.wmn >= feedback.current) ||
+                         (feedback.current >= home.reset_current_factor * cur_set.wmx);
+    if (contact)
+    {
+      homing.timings.early_contact = true;
+      SVH_LOG_WARN_STREAM("SVHFingerManager",
+                          "Channel " << channel
+                                     << " met its hardstop before it was expected, searching it "
+                                        "slowly from here");
+    }
+    else if (abs(homing.position - feedback.position) >= 1000 &&
+             (std::chrono::high_resolution_clock::now() - homing.start_time) <= m_homing_timeout)
+    {
+      return true;
+    }
+
+    traceHomingPhase(homing.trace_start_ns, "fastApproach", channel);
+    startSlowSearch(homing);
+    return true;
+  }
+
+  if (homing.phase == HP_FIND_HARDSTOP)
+  {
+    m_controller->setControllerTarget(channel, homing.position);
+    m_controller->getControllerFeedback(channel, feedback);
+    // Timeout while no encoder ticks changed
+
+    // Quite extensive Current output!
+    if (std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::high_resolution_clock::now() - homing.start_time_log) >
+        std::chrono::milliseconds(1000))
+    {
+      SVH_LOG_INFO_STREAM("SVHFingerManager",
+                          "Resetting Channel "
+                            << channel << ":" << m_controller->m_channel_description[channel]
+                            << " current: " << feedback.current << " mA");
+      homing.start_time_log = std::chrono::high_resolution_clock::now();
+    }
+
+    double threshold = 80;
+    // have a look for deadlocks
+    if (home.direction == +1)
+    {
+      double delta =
+        feedback.current -
+        m_diagnostic_current_maximum[channel]; // without deadlocks delta should be positiv
+      if (delta <= -threshold)
+      {
+        if (std::abs(delta) > m_diagnostic_deadlock[channel])
+        {
+          m_diagnostic_deadlock[channel] = std::abs(delta);
+        }
+      }
+    }
+    else
+    {
+      double delta = feedback.current - m_diagnostic_current_minimum[channel];
+      if (delta >= threshold)
+      {
+        if (std::abs(delta) > m_diagnostic_deadlock[channel])
+        {
+          m_diagnostic_deadlock[channel] = std::abs(delta);
+        }
+      }
+    }
+
+    // save the maximal/minimal current of the motor
+    if (feedback.current > m_diagnostic_current_maximum[channel])
+    {
+      m_diagnostic_current_maximum[channel] = feedback.current;
+    }
+    else
+    {
+      if (feedback.current < m_diagnostic_current_minimum[channel])
+      {
+        m_diagnostic_current_minimum[channel] = feedback.current;
+      }
+    }
+
+    const auto now             = std::chrono::high_resolution_clock::now();
+    const double search_factor = home.reset_current_factor * m_homing_profile.search_current_factor;
+    if ((search_factor * cur_set.wmn >= feedback.current) ||
+        (feedback.current >= search_factor * cur_set.wmx))
+    {
+      m_diagnostic_current_state[channel] = true; // when in maximum the current controller is ok
+
+      if (!homing.contact)
+      {
+        homing.contact          = true;
+        homing.contact_start    = now;
+        homing.contact_position = feedback.position;
+        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                             "Resetting Channel "
+                               << channel << ":" << m_controller->m_channel_description[channel]
+                               << " Contact at position " << feedback.position);
+      }
+    }
+    else if (homing.contact)
+    {
+      homing.contact = false;
+      SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                           "Resetting Channel "
+                             << channel << ":" << m_controller->m_channel_description[channel]
+                             << " Contact lost");
+    }
+    else if (now - homing.speed_sample_time >= C_SPEED_SAMPLE_PERIOD)
+    {
+      // the speed of the free movement tells how far a channel at the hard stop may still move
+      const double elapsed = std::chrono::duration<double>(now - homing.speed_sample_time).count();
+      homing.peak_speed =
+        std::max(homing.peak_speed,
+                 std::abs(feedback.position - homing.speed_sample_position) / elapsed);
+      homing.speed_sample_time     = now;
+      homing.speed_sample_position = feedback.position;
+    }
+
+    // check for time out: Abort, if position does not change after homing timeout.
+    if ((now - homing.start_time) > m_homing_timeout)
+    {
+      m_controller->disableChannel(SVH_ALL);
+      restoreSearchCurrent(homing);
+      updateMask(m_faulted_mask, channel_bit, true);
+      {
+        std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+        m_hardstop_hint_mask &= ~channel_bit;
+      }
+      SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                           "Timeout: Aborted finding home position for channel " << channel);
+      // Timeout could mean serious hardware issues or just plain wrong settings
+      traceHomingPhase(homing.trace_start_ns, "findHardstop", channel);
+      homing.success = false;
+      enterHomingPhase(homing, HP_DONE);
+      return false;
+    }
+
+    // reset time if position changes
+    if (feedback.position != homing.control_feedback_previous.position)
+    {
+      m_diagnostic_encoder_state[channel] = true;
+      // save the maximal/minimal position the channel can reach
+      if (feedback.position > m_diagnostic_position_maximum[channel])
+        m_diagnostic_position_maximum[channel] = feedback.position;
+      else if (feedback.position < m_diagnostic_position_minimum[channel])
+        m_diagnostic_position_minimum[channel] = feedback.position;
+
+      homing.start_time = std::chrono::high_resolution_clock::now();
+      if (homing.stale_notification_sent)
+      {
+        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                             "Resetting Channel "
+                               << channel << ":" << m_controller->m_channel_description[channel]
+                               << " Stale resolved, continuing detection");
+        homing.stale_notification_sent = false;
+      }
+    }
+    else
+    {
+      if (!homing.stale_notification_sent)
+      {
+        SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                             "Resetting Channel "
+                               << channel << ":" << m_controller->m_channel_description[channel]
+                               << " Stale detected. Starting Timeout");
+        homing.stale_notification_sent = true;
+      }
+    }
+
+    // save previous control feedback
+    homing.control_feedback_previous = feedback;
+
+    // the current has to stay at the threshold for a while
+    if (!homing.contact || (now - homing.contact_start) < m_homing_profile.contact_time)
+    {
+      return true;
+    }
+
+    // and the channel has to stand still, a channel that moves on under load e.g. overcame friction
+    const double contact_duration =
+      std::chrono::duration<double>(now - homing.contact_start).count();
+    const double stall_distance =
+      std::max(static_cast<double>(m_homing_profile.stall_ticks),
+               m_homing_profile.stall_speed_factor * homing.peak_speed * contact_duration);
+    if (std::abs(feedback.position - homing.contact_position) > stall_distance)
+    {
+      homing.contact_start    = now;
+      homing.contact_position = feedback.position;
+      return true;
+    }
+
+    // give the last info with highes channel current value
+    SVH_LOG_INFO_STREAM("SVHFingerManager",
+                        "Resetting Channel "
+                          << channel << ":" << m_controller->m_channel_description[channel]
+                          << " current: " << feedback.current << " mA");
+
+    SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                         "Hardstop of channel " << channel << " found at " << feedback.position);
+    restoreSearchCurrent(homing);
+    {
+      std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+      m_hardstop_hints[channel] = feedback.position;
+      m_hardstop_hint_mask |= channel_bit;
+    }
+
+    // set reference values
+    m_position_min[channel] = static_cast<int32_t>(
+      feedback.position + std::min(home.minimum_offset, home.maximum_offset));
+    m_position_max[channel] = static_cast<int32_t>(
+      feedback.position + std::max(home.minimum_offset, home.maximum_offset));
+    m_position_home[channel] =
+      static_cast<int32_t>(feedback.position + home.direction * home.idle_position);
+    SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                         "Setting soft stops for Channel "
+                           << channel << " min pos = " << m_position_min[channel]
+                           << " max pos = " << m_position_max[channel]
+                           << " home pos = " << m_position_home[channel]);
+
+    // position will now be reached to release the motor and go into soft stops
+    homing.position = m_position_home[channel];
+
+    // go to idle position
+    // use the declared start_time variable for the homing timeout
+    traceHomingPhase(homing.trace_start_ns, "findHardstop", channel);
+    homing.start_time = std::chrono::high_resolution_clock::now();
+    enterHomingPhase(homing, HP_GO_TO_IDLE);
+  }
+
+  if (homing.phase == HP_VERIFY_CALIBRATION)
+  {
+    m_controller->setControllerTarget(channel, homing.position);
+    m_controller->getControllerFeedback(channel, feedback);
+
+    // the move stays clear of the hard stop, so the current must not rise like during homing
+    if ((home.reset_current_factor * cur_set.wmn >= feedback.current) ||
+        (feedback.current >= home.reset_current_factor * cur_set.wmx))
+    {
+      homing.hit_count++;
+    }
+    else if (homing.hit_count > 0)
+    {
+      homing.hit_count--;
+    }
+
+    if (abs(homing.position - feedback.position) < 1000)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+        m_homing_calibration_report.verified_mask |= channel_bit;
+      }
+      SVH_LOG_INFO_STREAM("SVHFingerManager",
+                          "Stored calibration of channel " << channel << " is plausible");
+
+      traceHomingPhase(homing.trace_start_ns, "verifyCalibration", channel);
+      homing.position   = m_position_home[channel];
+      homing.start_time = std::chrono::high_resolution_clock::now();
+      enterHomingPhase(homing, HP_GO_TO_IDLE);
+    }
+    else if (homing.hit_count >= 10 ||
+             (std::chrono::high_resolution_clock::now() - homing.start_time) > m_homing_timeout)
+    {
+      SVH_LOG_WARN_STREAM("SVHFingerManager",
+                          "Stored calibration of channel "
+                            << channel << " is not plausible, homing the channel completely");
+      traceHomingPhase(homing.trace_start_ns, "verifyCalibration", channel);
+      storeHomingCalibration(channel, false, feedback.position);
+      {
+        // the hard stop of the rejected calibration must not be approached quickly either
+        std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+        m_hardstop_hint_mask &= ~channel_bit;
+      }
+      startHardstopSearch(homing);
+      return true;
+    }
+    else
+    {
+      return true;
+    }
+  }
+
+  if (homing.phase == HP_GO_TO_IDLE)
+  {
+    m_controller->setControllerTarget(channel, homing.position);
+    m_controller->getControllerFeedback(channel, feedback);
+
+    SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                         "Homing Channel "
+                           << channel << ":" << m_controller->m_channel_description[channel]
+                           << " current: " << feedback.current
+                           << " mA, position ticks: " << feedback.position);
+
+    if (abs(homing.position - feedback.position) < 1000)
+    {
+      updateMask(m_homed_mask, channel_bit, true);
+      storeHomingCalibration(channel, true, feedback.position);
+    }
+    // if the finger hasn't reached the home position after m_homing_timeout there is an
+    // hardware error
+    else if ((std::chrono::high_resolution_clock::now() - homing.start_time) > m_homing_timeout)
+    {
+      updateMask(m_faulted_mask, channel_bit, true);
+      storeHomingCalibration(channel, false, feedback.position);
+      SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                           "Channel " << channel << " home position is not reachable after "
+                                      << m_homing_timeout.count()
+                                      << "s! There could be an hardware error!");
+    }
+    else
+    {
+      return true;
+    }
+
+    traceHomingPhase(homing.trace_start_ns, "goToIdle", channel);
+    m_controller->disableChannel(SVH_ALL);
+    SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                         "Restoring default position values for controller of channel "
+                           << channel);
+    m_controller->setPositionSettings(channel, getDefaultPositionSettings(false)[channel]);
+    traceHomingPhase(homing.trace_start_ns, "restoreSettings", channel);
+    SVH_LOG_INFO_STREAM("SVHFingerManager", "Successfully homed channel " << channel);
+    enterHomingPhase(homing, HP_DONE);
+  }
+
+  return false;
+}
+
+bool SVHFingerManager::getDiagnosticStatus(const SVHChannel& channel,
+                                           struct DiagnosticState& diagnostic_status)
+{
+  if (channel >= 0 && channel < SVH_DIMENSION)
+  {
+    diagnostic_status.diagnostic_encoder_state    = m_diagnostic_encoder_state[channel];
+    diagnostic_status.diagnostic_motor_state      = m_diagnostic_current_state[channel];
+    diagnostic_status.diagnostic_current_maximum  = m_diagnostic_current_maximum[channel];
+    diagnostic_status.diagnostic_current_minimum  = m_diagnostic_current_minimum[channel];
+    diagnostic_status.diagnostic_position_maximum = m_diagnostic_position_maximum[channel];
+    diagnostic_status.diagnostic_position_minimum = m_diagnostic_position_minimum[channel];
+    diagnostic_status.diagnostic_deadlock         = m_diagnostic_deadlock[channel];
+    return true;
+  }
+  else
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Could not get diagnostic status for unknown/unsupported channel "
+                           << channel);
+    return false;
+  }
+}
+
+
+// enables controller of channel
+bool SVHFingerManager::enableChannel(const SVHChannel& channel)
+{
+  if (isConnected() && isHomed(channel))
+  {
+    if (channel == SVH_ALL)
+    {
+      // All channels are reset and activated together, which takes two controller states instead
+      // of two per channel
+      m_controller->enableChannels(SVH_ALL_CHANNELS_MASK & ~m_switched_off_mask.load());
+    }
+    else if (channel > SVH_ALL && SVH_ALL < SVH_DIMENSION)
+    {
+      // Note: This part is another one of these places where the names can lead to confusion. I am
+      // sorry about that Switched off is a logical term. The user has chosen NOT to use this
+      // channel because of hardware trouble. To enable a smooth driver behaviour all replys
+      // regarding these channels will be answered in the most positive way the caller could expect.
       // Enabled refers to the actual enabled state of the hardware controller loops that drive the
       // motors. As the user has chosen not to use certain channels we explicitly do NOT enable
       // these but tell a calling driver that we did
-      if (!m_is_switched_off[channel])
+      if (!(m_switched_off_mask.load() & (1 << channel)))
       {
         m_controller->enableChannel(channel);
       }
@@ -673,26 +1141,11 @@ void SVHFingerManager::disableChannel(const SVHChannel& channel)
 {
   if (channel == SVH_ALL)
   {
-    for (size_t i = 0; i < SVH_DIMENSION; ++i)
-    {
-      disableChannel(static_cast<SVHChannel>(i));
-    }
+    m_controller->disableChannels(SVH_ALL_CHANNELS_MASK & ~m_switched_off_mask.load());
   }
-  else
+  else if (!(m_switched_off_mask.load() & (1 << channel)))
   {
-    if (!m_is_switched_off[channel])
-    {
-      m_controller->disableChannel(channel);
-    }
-
-    bool all_disabled = true;
-    for (size_t i = 0; i < SVH_DIMENSION; ++i)
-    {
-      // Again only check channels that are not switched off. Switched off channels will always
-      // answer that they are enabled
-      all_disabled =
-        all_disabled && (m_is_switched_off[channel] || !isEnabled(static_cast<SVHChannel>(i)));
-    }
+    m_controller->disableChannel(channel);
   }
 }
 
@@ -700,6 +1153,10 @@ bool SVHFingerManager::requestControllerFeedback(const SVHChannel& channel)
 {
   if (isConnected())
   {
+    if (channel == SVH_ALL)
+    {
+      refreshHomingCalibrationPositions();
+    }
     m_controller->requestControllerFeedback(channel);
     return true;
   }
@@ -719,7 +1176,7 @@ bool SVHFingerManager::getPosition(const SVHChannel& channel, double& position)
   {
     // Switched off channels will always remain at zero position as the tics we get back migh be
     // total gibberish
-    if (m_is_switched_off[channel])
+    if (m_switched_off_mask.load() & (1 << channel))
     {
       position = 0.0;
       return true;
@@ -778,27 +1235,31 @@ bool SVHFingerManager::setAllTargetPositions(const std::vector<double>& position
       // create target positions vector
       std::vector<int32_t> target_positions(SVH_DIMENSION, 0);
 
+      // enable all homed and disabled channels.. except the switched off ones
+      const uint16_t active_mask = SVH_ALL_CHANNELS_MASK & ~m_switched_off_mask.load();
+      const uint16_t enable_mask = active_mask & m_homed_mask.load() & ~m_controller->enabledMask();
+
       bool reject_command = false;
       for (size_t i = 0; i < SVH_DIMENSION; ++i)
       {
         SVHChannel channel = static_cast<SVHChannel>(i);
 
-        // enable all homed and disabled channels.. except its switched of
-        if (!m_is_switched_off[channel] && isHomed(channel) && !isEnabled(channel))
-        {
-          enableChannel(channel);
-        }
-
         // convert all channels to ticks
         target_positions[channel] = convertRad2Ticks(channel, positions[channel]);
 
         // check for out of bounds (except the switched off channels)
-        if (!m_is_switched_off[channel] && !isInsideBounds(channel, target_positions[channel]))
+        if ((active_mask & (1 << channel)) && !isInsideBounds(channel, target_positions[channel]))
         {
           reject_command = true;
         }
       }
 
+      // The channels are enabled together before the targets are sent
+      if (enable_mask != 0)
+      {
+        m_controller->enableChannels(enable_mask);
+      }
+
       // send target position vector to controller and SCHUNK hand
       if (!reject_command)
       {
@@ -840,7 +1301,7 @@ bool SVHFingerManager::setTargetPosition(const SVHChannel& channel, double posit
   {
     if (channel >= 0 && channel < SVH_DIMENSION)
     {
-      if (m_is_switched_off[channel])
+      if (m_switched_off_mask.load() & (1 << channel))
       {
         // Switched off channels  behave transparent so we return a true value while we ignore the
         // input
@@ -913,20 +1374,7 @@ bool SVHFingerManager::isEnabled(const SVHChannel& channel)
 {
   if (channel == SVH_ALL)
   {
-    bool all_enabled = true;
-    for (size_t i = 0; i < SVH_DIMENSION; ++i)
-    {
-      all_enabled = all_enabled && isEnabled(static_cast<SVHChannel>(i));
-      // disabled for now, to noisy
-      //      if (!isEnabled(static_cast<SVHChannel>(i)))
-      //      {
-      //        SVH_LOG_WARN_STREAM("SVHFingerManager", "All finger enabled check failed: Channel: "
-      //        << channel << " : " << SVHController::m_channel_description[i] << " is not
-      //        enabled");
-      //      }
-    }
-
-    return all_enabled;
+    return enabledMask() == SVH_ALL_CHANNELS_MASK;
   }
   else if (channel >= 0 && channel < SVH_DIMENSION)
   {
@@ -940,7 +1388,7 @@ bool SVHFingerManager::isEnabled(const SVHChannel& channel)
     // IF the channel was enabled but is in fact switched off by the user. If you have a better
     // variable name or a better idea how to handle that you are welcome to change it. (GH
     // 2014-05-26)
-    return (m_is_switched_off[channel] || m_controller->isEnabled(channel));
+    return (enabledMask() & (1 << channel)) != 0;
   }
   else
   {
@@ -954,11 +1402,10 @@ bool SVHFingerManager::isHomed(const SVHChannel& channel)
 {
   if (channel == SVH_ALL)
   {
-    bool all_homed = true;
+    const uint16_t missing = SVH_ALL_CHANNELS_MASK & ~homedMask();
     for (size_t i = 0; i < SVH_DIMENSION; ++i)
     {
-      all_homed = all_homed && isHomed(static_cast<SVHChannel>(i));
-      if (!isHomed(static_cast<SVHChannel>(i)))
+      if (missing & (1 << i))
       {
         SVH_LOG_WARN_STREAM("SVHFingerManager",
                             "All finger homed check failed: Channel: "
@@ -967,13 +1414,13 @@ bool SVHFingerManager::isHomed(const SVHChannel& channel)
       }
     }
 
-    return all_homed;
+    return missing == 0;
   }
   else if (channel >= 0 && channel < SVH_DIMENSION)
   {
     // Channels that are switched off will always be reported as homed to simulate everything is
     // fine. Others have to check
-    return (m_is_switched_off[channel] || m_is_homed[channel]);
+    return (homedMask() & (1 << channel)) != 0;
   }
   else // should not happen but better be save than sorry
   {
@@ -983,6 +1430,38 @@ bool SVHFingerManager::isHomed(const SVHChannel& channel)
   }
 }
 
+uint16_t SVHFingerManager::homedMask() const
+{
+  return m_switched_off_mask.load() | m_homed_mask.load();
+}
+
+uint16_t SVHFingerManager::enabledMask() const
+{
+  return m_switched_off_mask.load() | m_controller->enabledMask();
+}
+
+uint16_t SVHFingerManager::switchedOffMask() const
+{
+  return m_switched_off_mask.load();
+}
+
+uint16_t SVHFingerManager::faultedMask() const
+{
+  return m_faulted_mask.load();
+}
+
+void SVHFingerManager::updateMask(std::atomic<uint16_t>& flags, uint16_t mask, bool set)
+{
+  if (set)
+  {
+    flags.fetch_or(mask);
+  }
+  else
+  {
+    flags.fetch_and(static_cast<uint16_t>(~mask));
+  }
+}
+
 bool SVHFingerManager::getCurrentSettings(const SVHChannel& channel,
                                           SVHCurrentSettings& current_settings)
 {
@@ -1423,6 +1902,39 @@ void driver_svh::SVHFingerManager::setResetSpeed(const float& speed)
   }
 }
 
+bool SVHFingerManager::setHomingProfile(const SVHHomingProfile& profile)
+{
+  if (m_connected)
+  {
+    SVH_LOG_WARN_STREAM("SVHFingerManager",
+                        "The homing profile cannot be changed while connected - ignoring request");
+    return false;
+  }
+  if (profile.approach_speed_factor <= 0.0f || profile.approach_speed_factor > 1.0f ||
+      profile.search_current_factor <= 0.0f || profile.search_current_factor > 1.0f ||
+      profile.stall_speed_factor < 0.0 || profile.stall_speed_factor > 1.0 ||
+      profile.approach_margin < 0 || profile.stall_ticks < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "The homing profile is not valid: the factors have to be within 0.0-1.0 "
+                         "and the distances must not be negative");
+    return false;
+  }
+  m_homing_profile = profile;
+  return true;
+}
+
+SVHHomingTimings SVHFingerManager::homingTimings(const SVHChannel& channel)
+{
+  if (channel < 0 || channel >= SVH_DIMENSION)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager", "Channel " << channel << " is out of bounds!");
+    return SVHHomingTimings();
+  }
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  return m_homing_timings[channel];
+}
+
 // Converts joint positions of a specific channel from RAD to ticks
 int32_t SVHFingerManager::convertRad2Ticks(const SVHChannel& channel, const double& position)
 {
@@ -1494,8 +2006,9 @@ double SVHFingerManager::convertmAtoN(const SVHChannel& channel, const int16_t&
 bool SVHFingerManager::isInsideBounds(const SVHChannel& channel, const int32_t& target_position)
 {
   // Switched off channels will always be reported as inside bounds
-  if (m_is_switched_off[channel] || ((target_position >= m_position_min[channel]) &&
-                                     (target_position <= m_position_max[channel])))
+  if ((m_switched_off_mask.load() & (1 << channel)) ||
+      ((target_position >= m_position_min[channel]) &&
+       (target_position <= m_position_max[channel])))
   {
     return true;
   }
@@ -1562,23 +2075,430 @@ float SVHFingerManager::setForceLimit(const SVHChannel& channel, float force_lim
 }
 
 
-SVHFirmwareInfo SVHFingerManager::getFirmwareInfo(const std::string& dev_name,
-                                                  const unsigned int& retry_count)
+void SVHFingerManager::setReactor(const std::shared_ptr<SVHReactor>& reactor)
 {
-  // If firmware was read out befor do not ask for new firmware
-  if (m_firmware_info.version_major == 0 && m_firmware_info.version_major == 0)
+  if (m_connected || pendingAsyncOperations() > 0)
   {
-    bool was_connected = true;
+    SVH_LOG_WARN_STREAM("SVHFingerManager",
+                        "The reactor cannot be changed while connected - ignoring request");
+    return;
+  }
+  m_uses_reactor = (reactor != nullptr);
+  m_reactor      = reactor;
+  m_controller->setReactor(reactor);
+}
 
-    if (!m_connected)
-    {
-      was_connected = false;
-      if (!m_controller->connect(dev_name))
-      {
-        SVH_LOG_ERROR_STREAM("SVHFingerManager", "Connection FAILED! Device could NOT be opened");
-        m_firmware_info.version_major = 0;
-        m_firmware_info.version_minor = 0;
-        return m_firmware_info;
+void SVHFingerManager::setTransportOptions(const SVHTransportOptions& options)
+{
+  m_controller->setTransportOptions(options);
+}
+
+SVHTransportOptions SVHFingerManager::getTransportOptions()
+{
+  return m_controller->getTransportOptions();
+}
+
+void SVHFingerManager::setGapCalibration(const SVHGapCalibrationSettings& settings)
+{
+  if (m_connected)
+  {
+    SVH_LOG_WARN_STREAM("SVHFingerManager",
+                        "The gap calibration cannot be changed while connected - ignoring request");
+    return;
+  }
+  m_gap_calibration = settings;
+}
+
+void SVHFingerManager::setHomingCalibration(const SVHHomingCalibrationSettings& settings)
+{
+  if (m_connected)
+  {
+    SVH_LOG_WARN_STREAM(
+      "SVHFingerManager",
+      "The homing calibration cannot be changed while connected - ignoring request");
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  m_homing_calibration = settings;
+}
+
+SVHHomingCalibrationReport SVHFingerManager::homingCalibrationReport()
+{
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  return m_homing_calibration_report;
+}
+
+void SVHFingerManager::restoreHomingCalibration(const std::string& device_name)
+{
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  const std::string previous_device = m_homing_calibration_report.device;
+  m_homing_calibration_report       = SVHHomingCalibrationReport();
+  m_unchecked_calibration_mask      = 0;
+  m_hardstop_hint_mask              = 0;
+  if (!m_connected || !m_homing_calibration.enabled)
+  {
+    return;
+  }
+
+  SVHHomingCalibrationReport& report = m_homing_calibration_report;
+  report.device =
+    SVHGapCalibration::deviceIdentifier(device_name, m_homing_calibration.sysfs_root);
+  if (!m_homing_calibration.cache_file.empty())
+  {
+    report.loaded = SVHHomingCalibration::load(
+      m_homing_calibration.cache_file, report.device, m_channel_calibrations);
+  }
+  else if (report.device == previous_device)
+  {
+    for (const SVHChannelCalibration& calibration : m_channel_calibrations)
+    {
+      report.loaded = report.loaded || calibration.valid;
+    }
+  }
+  else
+  {
+    m_channel_calibrations.assign(SVH_DIMENSION, SVHChannelCalibration());
+  }
+
+  // The connection attempt requested the feedback of every channel
+  for (size_t channel = 0; channel < SVH_DIMENSION; ++channel)
+  {
+    SVHChannelCalibration& calibration = m_channel_calibrations[channel];
+    if (!calibration.valid)
+    {
+      continue;
+    }
+
+    SVHControllerFeedback feedback;
+    m_controller->getControllerFeedback(static_cast<SVHChannel>(channel), feedback);
+    if (SVHHomingCalibration::isConsistent(
+          calibration, feedback.position, m_homing_calibration.position_tolerance))
+    {
+      // The hard stop lies behind the idle position
+      const SVHHomeSettings& home = m_home_settings[channel];
+      m_hardstop_hints[channel] =
+        calibration.position_home - static_cast<int32_t>(home.direction * home.idle_position);
+      m_hardstop_hint_mask |= static_cast<uint16_t>(1 << channel);
+      report.restored_mask |= static_cast<uint16_t>(1 << channel);
+    }
+    else
+    {
+      // The encoder no longer counts from the calibrated origin, so the stored hard stop says
+      // nothing about the current one and the channel has to search it at the search speed
+      SVH_LOG_INFO_STREAM("SVHFingerManager",
+                          "Encoder of channel "
+                            << channel << " moved from " << calibration.encoder_position << " to "
+                            << feedback.position
+                            << " since its calibration, the hand was probably switched off");
+      calibration.valid = false;
+    }
+  }
+  m_unchecked_calibration_mask = report.restored_mask;
+
+  if (report.restored_mask != 0)
+  {
+    SVH_LOG_INFO_STREAM("SVHFingerManager",
+                        "Restored the calibration of " << report.device << " for channel mask 0x"
+                                                       << std::hex << report.restored_mask
+                                                       << std::dec);
+  }
+}
+
+void SVHFingerManager::storeHomingCalibration(const SVHChannel& channel,
+                                              bool valid,
+                                              int32_t encoder_position)
+{
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  if (!m_homing_calibration.enabled || m_homing_calibration_report.device.empty())
+  {
+    return;
+  }
+
+  SVHChannelCalibration& calibration = m_channel_calibrations[channel];
+  calibration.valid                  = valid;
+  calibration.position_min           = m_position_min[channel];
+  calibration.position_max           = m_position_max[channel];
+  calibration.position_home          = m_position_home[channel];
+  calibration.encoder_position       = encoder_position;
+
+  if (!m_homing_calibration.cache_file.empty() &&
+      !SVHHomingCalibration::store(m_homing_calibration.cache_file,
+                                   m_homing_calibration_report.device,
+                                   m_channel_calibrations))
+  {
+    SVH_LOG_WARN_STREAM("SVHFingerManager",
+                        "Could not write the homing calibration to "
+                          << m_homing_calibration.cache_file);
+  }
+}
+
+void SVHFingerManager::storeHomingCalibrationPositions()
+{
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  if (!m_homing_calibration.enabled || m_homing_calibration_report.device.empty())
+  {
+    return;
+  }
+
+  // The fingers may have been commanded anywhere since they were homed
+  const uint16_t homed_mask = m_homed_mask.load();
+  for (size_t channel = 0; channel < SVH_DIMENSION; ++channel)
+  {
+    if ((homed_mask & (1 << channel)) && m_channel_calibrations[channel].valid)
+    {
+      SVHControllerFeedback feedback;
+      m_controller->getControllerFeedback(static_cast<SVHChannel>(channel), feedback);
+      m_channel_calibrations[channel].encoder_position = feedback.position;
+    }
+  }
+
+  if (!m_homing_calibration.cache_file.empty() &&
+      !SVHHomingCalibration::store(m_homing_calibration.cache_file,
+                                   m_homing_calibration_report.device,
+                                   m_channel_calibrations))
+  {
+    SVH_LOG_WARN_STREAM("SVHFingerManager",
+                        "Could not write the homing calibration to "
+                          << m_homing_calibration.cache_file);
+  }
+}
+
+void SVHFingerManager::refreshHomingCalibrationPositions()
+{
+  std::lock_guard<std::mutex> lock(m_homing_calibration_mutex);
+  const auto now = std::chrono::steady_clock::now();
+  if (!m_homing_calibration.enabled || m_homing_calibration.cache_file.empty() ||
+      m_homing_calibration_report.device.empty() ||
+      now - m_calibration_position_time < C_CALIBRATION_POSITION_PERIOD)
+  {
+    return;
+  }
+  m_calibration_position_time = now;
+
+  // A finger counts as settled if it stayed within half the tolerance since the last sample, the
+  // file is only rewritten if such a finger left the stored position
+  const int32_t threshold    = m_homing_calibration.position_tolerance / 2;
+  const uint16_t homed_mask  = m_homed_mask.load();
+  bool changed               = false;
+  for (size_t channel = 0; channel < SVH_DIMENSION; ++channel)
+  {
+    SVHChannelCalibration& calibration = m_channel_calibrations[channel];
+    SVHControllerFeedback feedback;
+    if (!(homed_mask & (1 << channel)) || !calibration.valid ||
+        !m_controller->getControllerFeedback(static_cast<SVHChannel>(channel), feedback))
+    {
+      continue;
+    }
+
+    const bool settled =
+      std::abs(feedback.position - m_calibration_position_samples[channel]) <= threshold;
+    m_calibration_position_samples[channel] = feedback.position;
+    if (settled && std::abs(feedback.position - calibration.encoder_position) > threshold)
+    {
+      calibration.encoder_position = feedback.position;
+      changed                      = true;
+    }
+  }
+
+  if (changed && !SVHHomingCalibration::store(m_homing_calibration.cache_file,
+                                              m_homing_calibration_report.device,
+                                              m_channel_calibrations))
+  {
+    SVH_LOG_WARN_STREAM("SVHFingerManager",
+                        "Could not write the homing calibration to "
+                          << m_homing_calibration.cache_file);
+  }
+}
+
+void SVHFingerManager::setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder)
+{
+  m_controller->setPacketRecorder(recorder);
+}
+
+bool SVHFingerManager::hasCommunicationFailed()
+{
+  return m_controller->hasCommunicationFailed();
+}
+
+SVHReceiveStatistics SVHFingerManager::getReceiveStatistics()
+{
+  return m_controller->getReceiveStatistics();
+}
+
+SVHTransmitStatistics SVHFingerManager::getTransmitStatistics()
+{
+  return m_controller->getTransmitStatistics();
+}
+
+void SVHFingerManager::holdTransmission()
+{
+  m_controller->holdTransmission();
+}
+
+size_t SVHFingerManager::heldPacketCount()
+{
+  return m_controller->heldPacketCount();
+}
+
+std::chrono::steady_clock::time_point SVHFingerManager::nextTransmissionTime()
+{
+  return m_controller->nextTransmissionTime();
+}
+
+bool SVHFingerManager::releaseHeldPacket(std::chrono::steady_clock::time_point& written)
+{
+  return m_controller->releaseHeldPacket(written);
+}
+
+bool SVHFingerManager::releaseTransmission()
+{
+  return m_controller->releaseTransmission();
+}
+
+bool SVHFingerManager::addPacketObserver(const uint8_t& type, const SVHPacketHandler& observer)
+{
+  return m_controller->addPacketObserver(type, observer);
+}
+
+std::shared_ptr<SVHSubscription> SVHFingerManager::subscribe(const SVHSubscriptionOptions& options,
+                                                             const SVHEventCallback& callback)
+{
+  return m_event_hub.subscribe(options, callback);
+}
+
+bool SVHFingerManager::unsubscribe(const std::shared_ptr<SVHSubscription>& subscription)
+{
+  return m_event_hub.unsubscribe(subscription);
+}
+
+void SVHFingerManager::publishEvents(const SVHSerialPacket& packet)
+{
+  // Nothing is decoded as long as nobody listens
+  const uint32_t events = m_event_hub.subscribedEvents();
+  if (!(events & (1u << SVH_EVENT_CONTROLLER_STATE)))
+  {
+    m_controller_state_published = false;
+  }
+  if (events == 0)
+  {
+    return;
+  }
+
+  SVHEvent event;
+  event.stamp           = std::chrono::steady_clock::now();
+  const uint8_t channel = (packet.address >> 4) & 0x0F;
+
+  switch (packet.address & 0x0F)
+  {
+    case SVH_GET_CONTROL_FEEDBACK:
+    case SVH_SET_CONTROL_COMMAND:
+      if ((events & (1u << SVH_EVENT_FEEDBACK)) && channel < SVH_DIMENSION)
+      {
+        publishFeedback(event, static_cast<SVHChannel>(channel));
+      }
+      break;
+    case SVH_GET_CONTROL_FEEDBACK_ALL:
+    case SVH_SET_CONTROL_COMMAND_ALL:
+      if (events & (1u << SVH_EVENT_FEEDBACK))
+      {
+        for (size_t i = 0; i < SVH_DIMENSION; ++i)
+        {
+          publishFeedback(event, static_cast<SVHChannel>(i));
+        }
+      }
+      break;
+    case SVH_GET_POSITION_SETTINGS:
+    case SVH_SET_POSITION_SETTINGS:
+      if ((events & (1u << SVH_EVENT_POSITION_SETTINGS)) && channel < SVH_DIMENSION)
+      {
+        event.type    = SVH_EVENT_POSITION_SETTINGS;
+        event.channel = static_cast<SVHChannel>(channel);
+        m_controller->getPositionSettings(event.channel, event.position_settings);
+        m_event_hub.publish(event);
+      }
+      break;
+    case SVH_GET_CURRENT_SETTINGS:
+    case SVH_SET_CURRENT_SETTINGS:
+      if ((events & (1u << SVH_EVENT_CURRENT_SETTINGS)) && channel < SVH_DIMENSION)
+      {
+        event.type    = SVH_EVENT_CURRENT_SETTINGS;
+        event.channel = static_cast<SVHChannel>(channel);
+        m_controller->getCurrentSettings(event.channel, event.current_settings);
+        m_event_hub.publish(event);
+      }
+      break;
+    case SVH_GET_CONTROLLER_STATE:
+    case SVH_SET_CONTROLLER_STATE:
+      if (events & (1u << SVH_EVENT_CONTROLLER_STATE))
+      {
+        // The controller keeps no copy of the received state, so it is decoded again
+        ArrayBuilder ab;
+        ab.array.assign(packet.data.begin(), packet.data.end());
+        ab.write_pos = packet.data.size();
+        ab >> event.controller_state;
+
+        if (!m_controller_state_published ||
+            !(event.controller_state == m_published_controller_state))
+        {
+          m_published_controller_state = event.controller_state;
+          m_controller_state_published = true;
+          event.type                   = SVH_EVENT_CONTROLLER_STATE;
+          m_event_hub.publish(event);
+        }
+      }
+      break;
+    case SVH_GET_FIRMWARE_INFO:
+      if (events & (1u << SVH_EVENT_FIRMWARE_INFO))
+      {
+        event.type          = SVH_EVENT_FIRMWARE_INFO;
+        event.firmware_info = m_controller->getFirmwareInfo();
+        m_event_hub.publish(event);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void SVHFingerManager::publishFeedback(SVHEvent& event, const SVHChannel& channel)
+{
+  SVHControllerFeedback controller_feedback;
+  if (!(homedMask() & (1 << channel)) ||
+      !m_controller->getControllerFeedback(channel, controller_feedback))
+  {
+    return;
+  }
+
+  event.type    = SVH_EVENT_FEEDBACK;
+  event.channel = channel;
+  event.current = controller_feedback.current;
+  // Same rules as getPosition: switched off channels stay at zero, negative positions are clamped
+  event.position = 0.0;
+  if (!(m_switched_off_mask.load() & (1 << channel)))
+  {
+    event.position = std::max(0.0, convertTicks2Rad(channel, controller_feedback.position));
+  }
+  m_event_hub.publish(event);
+}
+
+SVHFirmwareInfo SVHFingerManager::getFirmwareInfo(const std::string& dev_name,
+                                                  const unsigned int& retry_count)
+{
+  SVH_TRACE_SPAN("connect", "firmwareInfo");
+  // If firmware was read out befor do not ask for new firmware
+  if (m_firmware_info.version_major == 0 && m_firmware_info.version_major == 0)
+  {
+    bool was_connected = true;
+
+    if (!m_connected)
+    {
+      was_connected = false;
+      if (!m_controller->connect(dev_name))
+      {
+        SVH_LOG_ERROR_STREAM("SVHFingerManager", "Connection FAILED! Device could NOT be opened");
+        m_firmware_info.version_major = 0;
+        m_firmware_info.version_minor = 0;
+        return m_firmware_info;
       }
     }
 
@@ -1610,8 +2530,11 @@ SVHFirmwareInfo SVHFingerManager::getFirmwareInfo(const std::string& dev_name,
              m_firmware_info.version_major == 0);
 
     // Start the feedback process aggain
-    m_poll_feedback   = true;
-    m_feedback_thread = std::thread(&SVHFingerManager::pollFeedback, this);
+    if (!m_uses_reactor)
+    {
+      m_poll_feedback   = true;
+      m_feedback_thread = std::thread(&SVHFingerManager::pollFeedback, this);
+    }
 
     if (!was_connected)
     {
@@ -1624,12 +2547,417 @@ SVHFirmwareInfo SVHFingerManager::getFirmwareInfo(const std::string& dev_name,
   return m_firmware_info;
 }
 
+bool SVHFingerManager::connectAsync(const std::string& dev_name,
+                                    const SVHAsyncCallback& done,
+                                    const unsigned int& retry_count)
+{
+  SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                       "Finger manager is trying to connect to the Hardware asynchronously...");
+
+  // Save device handle for next use
+  m_serial_device = dev_name;
+
+  return connectControllerAsync(
+    [this, &dev_name] { return m_controller->connect(dev_name); }, dev_name, done, retry_count);
+}
+
+bool SVHFingerManager::connectAsync(const std::shared_ptr<SVHTransport>& transport,
+                                    const SVHAsyncCallback& done,
+                                    const unsigned int& retry_count)
+{
+  SVH_LOG_DEBUG_STREAM("SVHFingerManager",
+                       "Finger manager is trying to connect to the Hardware asynchronously...");
+
+  return connectControllerAsync([this, &transport] { return m_controller->connect(transport); },
+                                transport ? transport->deviceName() : std::string(),
+                                done,
+                                retry_count);
+}
+
+bool SVHFingerManager::connectControllerAsync(const std::function<bool()>& open,
+                                              const std::string& device_name,
+                                              const SVHAsyncCallback& done,
+                                              const unsigned int& retry_count)
+{
+  if (!m_reactor || !m_reactor->isRunning())
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Could not connect asynchronously: The reactor is not running");
+    return false;
+  }
+
+  if (m_connected)
+  {
+    disconnect();
+  }
+
+  const bool opened = open();
+  SVH_PROBE1(connect_open, opened);
+  if (!opened)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager", "Connection FAILED! Device could NOT be opened");
+    return false;
+  }
+
+  beginConnectAttempt();
+
+  const SVHAsyncCallback complete = callOnce(done);
+  auto start_time  = std::make_shared<std::chrono::high_resolution_clock::time_point>(
+    std::chrono::high_resolution_clock::now());
+  auto num_retries = std::make_shared<unsigned int>(retry_count);
+  bool started     = startAsync(
+    C_ASYNC_CONNECT_PERIOD,
+    [this, device_name, complete, start_time, num_retries] {
+      unsigned int received_count = 0;
+      ConnectState state          = checkConnectAttempt(*start_time, received_count);
+      if (state == CS_PENDING)
+      {
+        return true;
+      }
+      // Keep trying to reconnect several times because the brainbox often makes problems
+      if (state == CS_TIMEOUT && retryConnect(received_count, *num_retries))
+      {
+        beginConnectAttempt();
+        *start_time = std::chrono::high_resolution_clock::now();
+        return true;
+      }
+
+      finishConnect(device_name, false);
+      complete(m_connected);
+      return false;
+    },
+    [complete] { complete(false); });
+
+  if (!started)
+  {
+    m_controller->disconnect();
+  }
+  return started;
+}
+
+bool SVHFingerManager::resetChannelAsync(const SVHChannel& channel, const SVHAsyncCallback& done)
+{
+  if (!m_connected)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Could not reset channel "
+                           << channel << ": No connection to SCHUNK five finger hand!");
+    return false;
+  }
+  if (channel < SVH_ALL || channel >= SVH_DIMENSION)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager", "Channel " << channel << " is out of bounds!");
+    return false;
+  }
+
+  // Same sequence as resetChannel: each channel in the reset order gets three attempts
+  struct ResetState
+  {
+    std::vector<SVHChannel> channels;
+    size_t index;
+    size_t attempts;
+    bool started;
+    bool success;
+    HomingProcess homing;
+  };
+  auto state      = std::make_shared<ResetState>();
+  state->channels = (channel == SVH_ALL) ? m_reset_order : std::vector<SVHChannel>(1, channel);
+  state->index    = 0;
+  state->attempts = (channel == SVH_ALL) ? C_RESET_ATTEMPTS : 1;
+  state->started  = false;
+  state->success  = true;
+
+  const SVHAsyncCallback complete = callOnce(done);
+  return startAsync(
+    C_ASYNC_HOMING_PERIOD,
+    [this, channel, state, complete] {
+      HomingProcess& homing = state->homing;
+      if (!state->started)
+      {
+        startHoming(homing, state->channels[state->index]);
+        state->started = true;
+      }
+      if (homing.phase != HP_DONE && stepHoming(homing))
+      {
+        return true;
+      }
+
+      // The homing of this channel is finished, retry or continue with the next one
+      state->started = false;
+      state->attempts--;
+      if (!homing.success && state->attempts > 0)
+      {
+        return true;
+      }
+      if (channel == SVH_ALL)
+      {
+        SVH_LOG_DEBUG_STREAM("resetChannel",
+                             "Channel " << homing.channel << " reset success = " << homing.success);
+      }
+      state->success = state->success && homing.success;
+      if (++state->index < state->channels.size())
+      {
+        state->attempts = C_RESET_ATTEMPTS;
+        return true;
+      }
+
+      complete(state->success);
+      return false;
+    },
+    [complete] { complete(false); });
+}
+
+bool SVHFingerManager::getFirmwareInfoAsync(const SVHAsyncResultCallback<SVHFirmwareInfo>& done,
+                                            const unsigned int& retry_count)
+{
+  if (!m_connected)
+  {
+    SVH_LOG_ERROR_STREAM(
+      "SVHFingerManager",
+      "Could not get the firmware info: No connection to SCHUNK five finger hand!");
+    return false;
+  }
+
+  // Firmware that was read out before is reported on the first step without a new request
+  const SVHFirmwareInfo known = m_controller->getFirmwareInfo();
+  if (known.version_major == 0 && known.version_minor == 0)
+  {
+    m_controller->requestFirmwareInfo();
+  }
+
+  const SVHAsyncResultCallback<SVHFirmwareInfo> complete = callOnce(done);
+  auto num_retries = std::make_shared<unsigned int>(retry_count);
+  return startAsync(
+    C_ASYNC_FIRMWARE_PERIOD,
+    [this, complete, num_retries] {
+      // Get the Version number if received yet, else 0.0
+      SVHFirmwareInfo firmware_info = m_controller->getFirmwareInfo();
+      if (firmware_info.version_major != 0 || firmware_info.version_minor != 0)
+      {
+        m_firmware_info = firmware_info;
+        complete(true, firmware_info);
+        return false;
+      }
+
+      if (*num_retries <= 1)
+      {
+        SVH_LOG_ERROR_STREAM("SVHFingerManager", "Getting Firmware Version failed");
+        complete(false, firmware_info);
+        return false;
+      }
+      --*num_retries;
+      SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                           "Getting Firmware Version failed,.Retrying, count: " << *num_retries);
+      m_controller->requestFirmwareInfo();
+      return true;
+    },
+    [complete] { complete(false, SVHFirmwareInfo()); });
+}
+
+bool SVHFingerManager::requestPositionSettingsAsync(
+  const SVHChannel& channel, const SVHAsyncResultCallback<SVHPositionSettings>& done)
+{
+  return awaitSettingsAsync(
+    channel,
+    SVH_EVENT_POSITION_SETTINGS,
+    [this, channel] {
+      m_controller->requestPositionSettings(channel);
+      return true;
+    },
+    nullptr,
+    [done](bool success, const SVHEvent& event) { done(success, event.position_settings); });
+}
+
+bool SVHFingerManager::requestCurrentSettingsAsync(
+  const SVHChannel& channel, const SVHAsyncResultCallback<SVHCurrentSettings>& done)
+{
+  return awaitSettingsAsync(
+    channel,
+    SVH_EVENT_CURRENT_SETTINGS,
+    [this, channel] {
+      m_controller->requestCurrentSettings(channel);
+      return true;
+    },
+    nullptr,
+    [done](bool success, const SVHEvent& event) { done(success, event.current_settings); });
+}
+
+bool SVHFingerManager::setPositionSettingsAsync(
+  const SVHChannel& channel,
+  const SVHPositionSettings& position_settings,
+  const SVHAsyncResultCallback<SVHPositionSettings>& done)
+{
+  return awaitSettingsAsync(
+    channel,
+    SVH_EVENT_POSITION_SETTINGS,
+    [this, channel, position_settings] { return setPositionSettings(channel, position_settings); },
+    [position_settings](const SVHEvent& event) {
+      return event.position_settings == position_settings;
+    },
+    [done](bool success, const SVHEvent& event) { done(success, event.position_settings); });
+}
+
+bool SVHFingerManager::setCurrentSettingsAsync(
+  const SVHChannel& channel,
+  const SVHCurrentSettings& current_settings,
+  const SVHAsyncResultCallback<SVHCurrentSettings>& done)
+{
+  return awaitSettingsAsync(
+    channel,
+    SVH_EVENT_CURRENT_SETTINGS,
+    [this, channel, current_settings] { return setCurrentSettings(channel, current_settings); },
+    [current_settings](const SVHEvent& event) {
+      return event.current_settings == current_settings;
+    },
+    [done](bool success, const SVHEvent& event) { done(success, event.current_settings); });
+}
+
+bool SVHFingerManager::awaitSettingsAsync(const SVHChannel& channel,
+                                          SVHEventType type,
+                                          const std::function<bool()>& request,
+                                          const std::function<bool(const SVHEvent&)>& matches,
+                                          const std::function<void(bool, const SVHEvent&)>& done)
+{
+  if (!m_connected)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Could not exchange settings of channel "
+                           << channel << ": No connection to SCHUNK five finger hand!");
+    return false;
+  }
+  if (channel < 0 || channel >= SVH_DIMENSION)
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Could not exchange settings of channel " << channel
+                                                                   << ": No such channel");
+    return false;
+  }
+
+  // Subscribed before the request is sent, so that the echo cannot be missed
+  SVHSubscriptionOptions options;
+  options.events         = 1u << type;
+  options.channels       = static_cast<uint16_t>(1 << channel);
+  options.delivery       = SVH_DELIVER_QUEUE;
+  options.queue_capacity = 4;
+  std::shared_ptr<SVHSubscription> subscription =
+    m_event_hub.subscribe(options, SVHEventCallback());
+  if (!subscription || !request())
+  {
+    m_event_hub.unsubscribe(subscription);
+    return false;
+  }
+
+  const std::function<void(bool, const SVHEvent&)> complete = callOnce(done);
+  const auto deadline = std::chrono::steady_clock::now() + C_ASYNC_SETTINGS_TIMEOUT;
+  bool started        = startAsync(
+    C_ASYNC_SETTINGS_PERIOD,
+    [this, channel, subscription, matches, complete, deadline] {
+      // Echoes of settings sent before, which may still be queued behind the pacing, are skipped
+      SVHEvent event;
+      while (subscription->poll(event))
+      {
+        if (!matches || matches(event))
+        {
+          m_event_hub.unsubscribe(subscription);
+          complete(true, event);
+          return false;
+        }
+      }
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                             "Settings of channel " << channel << " were not echoed by the hand");
+        m_event_hub.unsubscribe(subscription);
+        complete(false, event);
+        return false;
+      }
+      return true;
+    },
+    [this, subscription, complete] {
+      m_event_hub.unsubscribe(subscription);
+      complete(false, SVHEvent());
+    });
+
+  if (!started)
+  {
+    m_event_hub.unsubscribe(subscription);
+  }
+  return started;
+}
+
+size_t SVHFingerManager::pendingAsyncOperations()
+{
+  std::lock_guard<std::mutex> lock(m_async_mutex);
+  return m_async_operations.size();
+}
+
+bool SVHFingerManager::startAsync(const std::chrono::microseconds& period,
+                                  const std::function<bool()>& step,
+                                  const std::function<void()>& cancel)
+{
+  if (!m_reactor || !m_reactor->isRunning())
+  {
+    SVH_LOG_ERROR_STREAM("SVHFingerManager",
+                         "Asynchronous operations need a running reactor, see setReactor");
+    return false;
+  }
+
+  // The lock is held until the operation is registered, so that its first step can find it
+  std::lock_guard<std::mutex> lock(m_async_mutex);
+  auto id  = std::make_shared<int>(-1);
+  int task = m_reactor->addTask(period, [this, id, step] {
+    const bool running = step();
+
+    std::lock_guard<std::mutex> lock(m_async_mutex);
+    auto it = m_async_operations.find(*id);
+    if (it == m_async_operations.end() || it->second.id != id)
+    {
+      // Cancelled, the canceller removes the task
+      return true;
+    }
+    if (!running)
+    {
+      m_async_operations.erase(it);
+    }
+    return running;
+  });
+  if (task < 0)
+  {
+    return false;
+  }
+
+  *id                       = task;
+  AsyncOperation& operation = m_async_operations[task];
+  operation.id              = id;
+  operation.cancel          = cancel;
+  return true;
+}
+
+void SVHFingerManager::cancelAsyncOperations()
+{
+  std::map<int, AsyncOperation> operations;
+  {
+    std::lock_guard<std::mutex> lock(m_async_mutex);
+    operations.swap(m_async_operations);
+  }
+
+  for (auto& operation : operations)
+  {
+    // Waits for a running step, the operation is not called again afterwards
+    m_reactor->removeTimer(operation.first);
+    operation.second.cancel();
+  }
+}
+
 void SVHFingerManager::pollFeedback()
 {
+  SVHTrace::setThreadName("svh-feedback");
+
   while (m_poll_feedback)
   {
     if (isConnected())
     {
+      SVH_TRACE_SPAN("control", "pollFeedback");
       requestControllerFeedback(SVH_ALL);
     }
     else
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/control/SVHCacheFile.h>
+#include <schunk_svh_library/control/SVHGapCalibration.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef _SYSTEM_LINUX_
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+SVHGapCalibration::SVHGapCalibration(const SVHGapCalibrationSettings& settings)
+  : m_settings(settings)
+{
+}
+
+SVHGapCalibrationReport SVHGapCalibration::run(SVHController& controller,
+                                               const std::string& device_name)
+{
+  SVHGapCalibrationReport report;
+  report.device = deviceIdentifier(device_name, m_settings.sysfs_root);
+
+  const std::chrono::microseconds original_gap = controller.getTransportOptions().transmission_gap;
+  if (!m_settings.cache_file.empty() && loadGap(m_settings.cache_file, report.device, report.gap))
+  {
+    report.cached     = true;
+    report.calibrated = controller.setTransmissionGap(report.gap);
+    if (report.calibrated)
+    {
+      SVH_LOG_INFO_STREAM("SVHGapCalibration",
+                          "Using the cached gap of " << report.gap.count() << "us for device "
+                                                     << report.device);
+      return report;
+    }
+    // The cached gap does not fit the current transport options, e.g. a lower baud rate
+    report.cached = false;
+  }
+
+  // Shorten the gap until a probe is not answered completely
+  std::chrono::microseconds shortest_answered(0);
+  for (std::chrono::microseconds gap = m_settings.longest_gap; gap >= m_settings.shortest_gap;
+       gap -= m_settings.step)
+  {
+    if (!controller.setTransmissionGap(gap))
+    {
+      // Shorter than a frame takes on the serial line
+      break;
+    }
+    SVHGapProbe result = probe(controller, gap);
+    report.probes.push_back(result);
+    SVH_LOG_DEBUG_STREAM("SVHGapCalibration",
+                         "Gap of " << gap.count() << "us: " << result.answered << " of "
+                                   << result.sent << " requests answered");
+    if (result.answered < result.sent)
+    {
+      break;
+    }
+    shortest_answered = gap;
+    if (m_settings.step.count() <= 0)
+    {
+      break;
+    }
+  }
+
+  if (shortest_answered.count() <= 0)
+  {
+    SVH_LOG_WARN_STREAM("SVHGapCalibration",
+                        "Gap calibration failed for device "
+                          << report.device << ", not even a gap of "
+                          << m_settings.longest_gap.count() << "us was answered completely");
+    controller.setTransmissionGap(original_gap);
+    report.gap = original_gap;
+    return report;
+  }
+
+  report.gap = std::min(m_settings.longest_gap,
+                        std::chrono::microseconds(static_cast<int64_t>(
+                          shortest_answered.count() * (1.0 + m_settings.safety_margin))));
+  report.calibrated = controller.setTransmissionGap(report.gap);
+  if (!report.calibrated)
+  {
+    controller.setTransmissionGap(original_gap);
+    report.gap = original_gap;
+    return report;
+  }
+
+  SVH_LOG_INFO_STREAM("SVHGapCalibration",
+                      "Calibrated a gap of " << report.gap.count() << "us for device "
+                                             << report.device << ", the shortest answered gap was "
+                                             << shortest_answered.count() << "us");
+  if (!m_settings.cache_file.empty() && !storeGap(m_settings.cache_file, report.device, report.gap))
+  {
+    SVH_LOG_WARN_STREAM("SVHGapCalibration",
+                        "Could not write the calibrated gap to " << m_settings.cache_file);
+  }
+  return report;
+}
+
+SVHGapProbe SVHGapCalibration::probe(SVHController& controller,
+                                     const std::chrono::microseconds& gap)
+{
+  SVHGapProbe result;
+  result.gap = gap;
+
+  const unsigned int received_before = controller.getReceivedPackageCount();
+  for (unsigned int i = 0; i < m_settings.probe_frames; ++i)
+  {
+    controller.requestControllerFeedback(SVH_ALL);
+    result.sent++;
+  }
+
+  // The last request was written when requestControllerFeedback returned
+  const auto deadline = std::chrono::steady_clock::now() + m_settings.reply_timeout;
+  do
+  {
+    result.answered = controller.getReceivedPackageCount() - received_before;
+    if (result.answered >= result.sent)
+    {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  } while (std::chrono::steady_clock::now() < deadline);
+
+  result.answered = std::min(result.answered, result.sent);
+  return result;
+}
+
+std::string SVHGapCalibration::deviceIdentifier(const std::string& device_name,
+                                                const std::string& sysfs_root)
+{
+#ifdef _SYSTEM_LINUX_
+  // Resolve links like /dev/serial/by-id/... to the actual device node
+  char resolved[PATH_MAX];
+  std::string device = realpath(device_name.c_str(), resolved) != NULL ? resolved : device_name;
+  std::string name   = device.substr(device.rfind('/') + 1);
+
+  // The serial number belongs to the USB device a few levels above the tty
+  std::string tty = sysfs_root + "/class/tty/" + name + "/device";
+  if (realpath(tty.c_str(), resolved) != NULL)
+  {
+    std::string directory = resolved;
+    for (int level = 0; level < 4 && directory.size() > sysfs_root.size(); ++level)
+    {
+      std::ifstream serial_file((directory + "/serial").c_str());
+      std::string serial;
+      if (serial_file >> serial)
+      {
+        return "usb-" + serial;
+      }
+      directory = directory.substr(0, directory.rfind('/'));
+    }
+  }
+#else
+  (void)sysfs_root;
+#endif
+  return device_name;
+}
+
+bool SVHGapCalibration::loadGap(const std::string& cache_file,
+                                const std::string& device,
+                                std::chrono::microseconds& gap)
+{
+  // Every entry holds the gap in us
+  std::vector<std::string> entries;
+  SVHCacheFile::load(cache_file, device, 1, entries);
+  for (const std::string& values : entries)
+  {
+    std::istringstream entry(values);
+    long gap_us = 0;
+    if (entry >> gap_us && gap_us > 0)
+    {
+      gap = std::chrono::microseconds(gap_us);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SVHGapCalibration::storeGap(const std::string& cache_file,
+                                 const std::string& device,
+                                 const std::chrono::microseconds& gap)
+{
+  return SVHCacheFile::store(
+    cache_file, device, 1, std::vector<std::string>(1, std::to_string(gap.count())));
+}
+
+} // namespace driver_svh
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the hand group that sends commands to several SCHUNK
+ * five finger hands at the same time.
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/control/SVHHandGroup.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace driver_svh {
+
+SVHHandGroup::SVHHandGroup(const std::chrono::microseconds& max_skew)
+  : m_max_skew(max_skew)
+{
+}
+
+size_t SVHHandGroup::addHand(SVHFingerManager& hand)
+{
+  m_hands.push_back(&hand);
+  return m_hands.size() - 1;
+}
+
+bool SVHHandGroup::setAllTargetPositions(const std::vector<std::vector<double> >& positions,
+                                         SVHGroupDispatchReport* report)
+{
+  SVHGroupDispatchReport result;
+  if (positions.size() != m_hands.size() || m_hands.empty())
+  {
+    SVH_LOG_WARN_STREAM("SVHHandGroup",
+                        "Size of the position vectors wrong: size = "
+                          << positions.size() << " expected size = " << m_hands.size());
+    if (report != nullptr)
+    {
+      *report = result;
+    }
+    return false;
+  }
+
+  // Prepare the commands of all hands without writing them
+  result.success = true;
+  for (size_t i = 0; i < m_hands.size(); ++i)
+  {
+    m_hands[i]->holdTransmission();
+    result.success = m_hands[i]->setAllTargetPositions(positions[i]) && result.success;
+  }
+
+  if (!result.success)
+  {
+    SVH_LOG_WARN_STREAM("SVHHandGroup",
+                        "Group command was rejected by at least one hand, the others are released");
+  }
+
+  // Packets in front of the commands are written with the regular pacing, interleaved between
+  // the hands
+  bool preceding_packets = true;
+  std::chrono::steady_clock::time_point written;
+  while (preceding_packets)
+  {
+    preceding_packets = false;
+    for (SVHFingerManager* hand : m_hands)
+    {
+      if (hand->heldPacketCount() > 1)
+      {
+        result.success    = hand->releaseHeldPacket(written) && result.success;
+        preceding_packets = true;
+      }
+    }
+  }
+
+  // Wait until every hand may send again, so that no write of the commands has to wait
+  std::chrono::steady_clock::time_point release_time = std::chrono::steady_clock::now();
+  for (SVHFingerManager* hand : m_hands)
+  {
+    release_time = std::max(release_time, hand->nextTransmissionTime());
+  }
+  std::this_thread::sleep_until(release_time);
+
+  // Hands that rejected their command may have nothing left to write
+  std::vector<std::chrono::steady_clock::time_point> write_times(m_hands.size(), release_time);
+  std::vector<bool> has_written(m_hands.size(), false);
+  for (size_t i = 0; i < m_hands.size(); ++i)
+  {
+    if (m_hands[i]->heldPacketCount() > 0)
+    {
+      has_written[i] = m_hands[i]->releaseHeldPacket(write_times[i]);
+      result.success = has_written[i] && result.success;
+    }
+  }
+
+  for (size_t i = 0; i < m_hands.size(); ++i)
+  {
+    result.success = m_hands[i]->releaseTransmission() && result.success;
+  }
+
+  auto first = std::chrono::steady_clock::time_point::max();
+  auto last  = std::chrono::steady_clock::time_point::min();
+  for (size_t i = 0; i < m_hands.size(); ++i)
+  {
+    if (has_written[i])
+    {
+      first = std::min(first, write_times[i]);
+      last  = std::max(last, write_times[i]);
+    }
+  }
+  if (first <= last)
+  {
+    result.skew = last - first;
+    for (size_t i = 0; i < m_hands.size(); ++i)
+    {
+      result.offsets.push_back(has_written[i] ? write_times[i] - first
+                                              : std::chrono::nanoseconds(0));
+    }
+  }
+  result.within_bound = result.success && result.skew <= m_max_skew;
+
+  if (result.success && !result.within_bound)
+  {
+    SVH_LOG_WARN_STREAM("SVHHandGroup",
+                        "Group command skew of "
+                          << std::chrono::duration_cast<std::chrono::microseconds>(result.skew)
+                               .count()
+                          << "us exceeded the bound of " << m_max_skew.count() << "us");
+  }
+
+  if (report != nullptr)
+  {
+    *report = result;
+  }
+  return result.success;
+}
+
+} // namespace driver_svh
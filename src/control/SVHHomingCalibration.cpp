@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/control/SVHCacheFile.h>
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHHomingCalibration.h>
+
+#include <cstdlib>
+#include <sstream>
+
+namespace driver_svh {
+
+namespace {
+
+//! Values of an entry: channel, min, max, home and encoder position
+const size_t C_ENTRY_VALUES = 5;
+
+} // namespace
+
+bool SVHHomingCalibration::load(const std::string& cache_file,
+                                const std::string& device,
+                                std::vector<SVHChannelCalibration>& calibrations)
+{
+  calibrations.assign(SVH_DIMENSION, SVHChannelCalibration());
+
+  std::vector<std::string> entries;
+  SVHCacheFile::load(cache_file, device, C_ENTRY_VALUES, entries);
+  bool found = false;
+  for (const std::string& values : entries)
+  {
+    std::istringstream entry(values);
+    size_t channel = 0;
+    SVHChannelCalibration calibration;
+    if (entry >> channel >> calibration.position_min >> calibration.position_max >>
+          calibration.position_home >> calibration.encoder_position &&
+        channel < SVH_DIMENSION)
+    {
+      calibration.valid     = true;
+      calibrations[channel] = calibration;
+      found                 = true;
+    }
+  }
+  return found;
+}
+
+bool SVHHomingCalibration::store(const std::string& cache_file,
+                                 const std::string& device,
+                                 const std::vector<SVHChannelCalibration>& calibrations)
+{
+  std::vector<std::string> entries;
+  for (size_t channel = 0; channel < calibrations.size() && channel < SVH_DIMENSION; ++channel)
+  {
+    const SVHChannelCalibration& calibration = calibrations[channel];
+    if (calibration.valid)
+    {
+      std::ostringstream entry;
+      entry << channel << " " << calibration.position_min << " " << calibration.position_max << " "
+            << calibration.position_home << " " << calibration.encoder_position;
+      entries.push_back(entry.str());
+    }
+  }
+  return SVHCacheFile::store(cache_file, device, C_ENTRY_VALUES, entries);
+}
+
+bool SVHHomingCalibration::isConsistent(const SVHChannelCalibration& calibration,
+                                        int32_t encoder_position,
+                                        int32_t tolerance)
+{
+  return calibration.valid &&
+         std::abs(encoder_position - calibration.encoder_position) <= tolerance;
+}
+
+} // namespace driver_svh
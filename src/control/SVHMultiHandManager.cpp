@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the multi hand manager that drives several SCHUNK five
+ * finger hands from one process with a single shared I/O thread.
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHTrace.h>
+#include <schunk_svh_library/control/SVHMultiHandManager.h>
+
+#include <stdexcept>
+
+namespace driver_svh {
+
+SVHMultiHandManager::SVHMultiHandManager(const std::chrono::milliseconds& poll_period)
+  : m_reactor(std::make_shared<SVHReactor>())
+  , m_poll_timer(-1)
+{
+  if (!m_reactor->start())
+  {
+    SVH_LOG_ERROR_STREAM("SVHMultiHandManager",
+                         "Could not start the reactor, no hand can be connected");
+    return;
+  }
+
+  // A single timer polls all hands, so the number of wakeups does not grow with the hands
+  m_poll_timer = m_reactor->addTimer(poll_period, [this] { pollFeedback(); });
+  if (m_poll_timer < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHMultiHandManager", "Could not create the feedback poll timer");
+  }
+}
+
+SVHMultiHandManager::~SVHMultiHandManager()
+{
+  m_reactor->removeTimer(m_poll_timer);
+  disconnectAll();
+  m_reactor->stop();
+}
+
+size_t SVHMultiHandManager::addHand(const std::vector<bool>& disable_mask,
+                                    const uint32_t& reset_timeout)
+{
+  std::unique_ptr<Hand> hand(new Hand());
+  hand->manager.reset(new SVHFingerManager(disable_mask, reset_timeout));
+  hand->manager->setReactor(m_reactor);
+
+  std::lock_guard<std::mutex> lock(m_hands_mutex);
+  m_hands.push_back(std::move(hand));
+  return m_hands.size() - 1;
+}
+
+size_t SVHMultiHandManager::size()
+{
+  std::lock_guard<std::mutex> lock(m_hands_mutex);
+  return m_hands.size();
+}
+
+SVHFingerManager& SVHMultiHandManager::hand(size_t index)
+{
+  Hand* hand = findHand(index);
+  if (hand == nullptr)
+  {
+    throw std::out_of_range("SVHMultiHandManager: invalid hand index");
+  }
+  return *hand->manager;
+}
+
+bool SVHMultiHandManager::connect(size_t index,
+                                  const std::string& dev_name,
+                                  const unsigned int& retry_count)
+{
+  Hand* hand = findHand(index);
+  if (hand == nullptr)
+  {
+    SVH_LOG_ERROR_STREAM("SVHMultiHandManager", "Connect failed, invalid hand index " << index);
+    return false;
+  }
+  if (!m_reactor->isRunning())
+  {
+    SVH_LOG_ERROR_STREAM("SVHMultiHandManager", "Connect failed, the reactor is not running");
+    return false;
+  }
+
+  // A connected hand is polled, so it has to be disconnected under the lock first
+  disconnect(index);
+
+  // Hands that are not connected are not polled, the other hands keep running while this one
+  // waits for its answers
+  bool connected = hand->manager->connect(dev_name, retry_count);
+  SVH_LOG_INFO_STREAM("SVHMultiHandManager",
+                      "Hand " << index << " on " << dev_name
+                              << (connected ? " connected" : " could not be connected"));
+  return connected;
+}
+
+void SVHMultiHandManager::disconnect(size_t index)
+{
+  Hand* hand = findHand(index);
+  if (hand != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(m_poll_mutex);
+    hand->manager->disconnect();
+  }
+}
+
+bool SVHMultiHandManager::setAllTargetPositions(const std::vector<std::vector<double> >& positions,
+                                                SVHGroupDispatchReport* report)
+{
+  SVHHandGroup group;
+  for (size_t i = 0; i < size(); ++i)
+  {
+    group.addHand(*findHand(i)->manager);
+  }
+
+  std::lock_guard<std::mutex> lock(m_poll_mutex);
+  return group.setAllTargetPositions(positions, report);
+}
+
+void SVHMultiHandManager::disconnectAll()
+{
+  for (size_t i = 0; i < size(); ++i)
+  {
+    disconnect(i);
+  }
+}
+
+SVHHandStatistics SVHMultiHandManager::statistics(size_t index)
+{
+  SVHHandStatistics statistics;
+  Hand* hand = findHand(index);
+  if (hand != nullptr)
+  {
+    statistics.receive        = hand->manager->getReceiveStatistics();
+    statistics.transmit       = hand->manager->getTransmitStatistics();
+    statistics.feedback_polls = hand->feedback_polls;
+    statistics.connected      = hand->manager->isConnected();
+    statistics.failed         = hand->manager->hasCommunicationFailed();
+  }
+  return statistics;
+}
+
+SVHReactorStatistics SVHMultiHandManager::reactorStatistics() const
+{
+  return m_reactor->statistics();
+}
+
+void SVHMultiHandManager::pollFeedback()
+{
+  SVH_TRACE_SPAN("control", "pollFeedback");
+  std::vector<Hand*> hands;
+  {
+    std::lock_guard<std::mutex> lock(m_hands_mutex);
+    for (auto& hand : m_hands)
+    {
+      hands.push_back(hand.get());
+    }
+  }
+
+  // The poll runs in the reactor thread and must not wait for a group command or a disconnect,
+  // the hands are polled again on the next period
+  std::unique_lock<std::mutex> lock(m_poll_mutex, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    return;
+  }
+  for (Hand* hand : hands)
+  {
+    // Failed hands are skipped, writing to them would only delay the others
+    if (hand->manager->isConnected() && !hand->manager->hasCommunicationFailed())
+    {
+      hand->manager->requestControllerFeedback(SVH_ALL);
+      hand->feedback_polls++;
+    }
+  }
+}
+
+SVHMultiHandManager::Hand* SVHMultiHandManager::findHand(size_t index)
+{
+  std::lock_guard<std::mutex> lock(m_hands_mutex);
+  if (index < m_hands.size())
+  {
+    return m_hands[index].get();
+  }
+  return nullptr;
+}
+
+} // namespace driver_svh
@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/control/SVHSubscription.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace driver_svh {
+
+SVHSubscription::SVHSubscription(const SVHSubscriptionOptions& options,
+                                 const SVHEventCallback& callback)
+  : m_options(options)
+  , m_callback(callback)
+  , m_head(0)
+  , m_tail(0)
+  , m_sampled_mask(0)
+  , m_delivered(0)
+  , m_dropped(0)
+  , m_active(true)
+{
+  if (m_options.delivery != SVH_DELIVER_RECEIVE_THREAD)
+  {
+    size_t capacity = 1;
+    while (capacity < m_options.queue_capacity)
+    {
+      capacity <<= 1;
+    }
+    m_ring.resize(capacity);
+  }
+
+  std::fill(m_last_position, m_last_position + SVH_DIMENSION, 0.0);
+  std::fill(m_last_current, m_last_current + SVH_DIMENSION, 0.0);
+}
+
+bool SVHSubscription::poll(SVHEvent& event)
+{
+  return m_options.delivery == SVH_DELIVER_QUEUE && pop(event);
+}
+
+bool SVHSubscription::accepts(const SVHEvent& event)
+{
+  if (!(m_options.events & (1u << event.type)))
+  {
+    return false;
+  }
+
+  if (event.channel == SVH_ALL)
+  {
+    return true;
+  }
+
+  const uint16_t channel_bit = static_cast<uint16_t>(1 << event.channel);
+  if (!(m_options.channels & channel_bit))
+  {
+    return false;
+  }
+
+  if (event.type == SVH_EVENT_FEEDBACK &&
+      (m_options.position_deadband > 0.0 || m_options.current_deadband > 0.0))
+  {
+    if ((m_sampled_mask & channel_bit) &&
+        std::fabs(event.position - m_last_position[event.channel]) <= m_options.position_deadband &&
+        std::fabs(event.current - m_last_current[event.channel]) <= m_options.current_deadband)
+    {
+      return false;
+    }
+    m_sampled_mask |= channel_bit;
+    m_last_position[event.channel] = event.position;
+    m_last_current[event.channel]  = event.current;
+  }
+  return true;
+}
+
+bool SVHSubscription::push(const SVHEvent& event)
+{
+  const size_t head = m_head.load(std::memory_order_relaxed);
+  if (head - m_tail.load() >= m_ring.size())
+  {
+    m_dropped++;
+    return false;
+  }
+
+  m_ring[head & (m_ring.size() - 1)] = event;
+  m_head.store(head + 1);
+  m_delivered++;
+
+  // The tail is read after publishing the event, so either the reader sees the event or the writer
+  // sees that the reader caught up and has to wake it
+  return m_tail.load() == head;
+}
+
+bool SVHSubscription::pop(SVHEvent& event)
+{
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  if (tail == m_head.load())
+  {
+    return false;
+  }
+
+  event = m_ring[tail & (m_ring.size() - 1)];
+  m_tail.store(tail + 1);
+  return true;
+}
+
+SVHEventHub::SVHEventHub()
+  : m_subscribed_events(0)
+  , m_dispatch_pending(false)
+  , m_dispatch_stop(false)
+{
+}
+
+SVHEventHub::~SVHEventHub()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+    m_dispatch_stop = true;
+  }
+  m_dispatch_cv.notify_one();
+
+  if (m_dispatch_thread.joinable())
+  {
+    m_dispatch_thread.join();
+  }
+}
+
+std::shared_ptr<SVHSubscription> SVHEventHub::subscribe(const SVHSubscriptionOptions& options,
+                                                        const SVHEventCallback& callback)
+{
+  if ((options.delivery == SVH_DELIVER_QUEUE) == static_cast<bool>(callback))
+  {
+    SVH_LOG_ERROR_STREAM("SVHEventHub",
+                         "Subscriptions delivered by queue take no callback, all others need one");
+    return std::shared_ptr<SVHSubscription>();
+  }
+  if (options.delivery != SVH_DELIVER_RECEIVE_THREAD && options.queue_capacity == 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHEventHub", "Queued subscriptions need a queue capacity above 0");
+    return std::shared_ptr<SVHSubscription>();
+  }
+  if (options.position_deadband < 0.0 || options.current_deadband < 0.0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHEventHub", "Deadbands must not be negative");
+    return std::shared_ptr<SVHSubscription>();
+  }
+
+  std::shared_ptr<SVHSubscription> subscription(new SVHSubscription(options, callback));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (options.delivery == SVH_DELIVER_DISPATCH_THREAD && !m_dispatch_thread.joinable())
+  {
+    m_dispatch_thread = std::thread(&SVHEventHub::dispatch, this);
+  }
+  m_subscriptions.push_back(subscription);
+  m_subscribed_events |= options.events & SVH_ALL_EVENTS;
+
+  SVH_LOG_DEBUG_STREAM("SVHEventHub",
+                       "Added subscription for events 0x" << std::hex << options.events
+                                                          << " of channels 0x" << options.channels
+                                                          << std::dec);
+  return subscription;
+}
+
+bool SVHEventHub::unsubscribe(const std::shared_ptr<SVHSubscription>& subscription)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find(m_subscriptions.begin(), m_subscriptions.end(), subscription);
+    if (it == m_subscriptions.end())
+    {
+      return false;
+    }
+    m_subscriptions.erase(it);
+    subscription->m_active = false;
+
+    uint32_t events = 0;
+    for (const std::shared_ptr<SVHSubscription>& remaining : m_subscriptions)
+    {
+      events |= remaining->m_options.events;
+    }
+    m_subscribed_events = events & SVH_ALL_EVENTS;
+  }
+
+  // Wait for a callback that is currently running in the dispatch thread
+  if (subscription->m_options.delivery == SVH_DELIVER_DISPATCH_THREAD &&
+      std::this_thread::get_id() != m_dispatch_thread.get_id())
+  {
+    std::lock_guard<std::mutex> lock(m_callback_mutex);
+  }
+  return true;
+}
+
+void SVHEventHub::publish(const SVHEvent& event)
+{
+  bool wake_dispatch = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const std::shared_ptr<SVHSubscription>& subscription : m_subscriptions)
+    {
+      if (!subscription->accepts(event))
+      {
+        continue;
+      }
+
+      switch (subscription->m_options.delivery)
+      {
+        case SVH_DELIVER_RECEIVE_THREAD:
+          subscription->m_delivered++;
+          subscription->m_callback(event);
+          break;
+        case SVH_DELIVER_DISPATCH_THREAD:
+          wake_dispatch = subscription->push(event) || wake_dispatch;
+          break;
+        case SVH_DELIVER_QUEUE:
+          subscription->push(event);
+          break;
+      }
+    }
+  }
+
+  // The dispatch thread drains all queues once woken, so only events into empty queues wake it
+  if (wake_dispatch)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_dispatch_mutex);
+      m_dispatch_pending = true;
+    }
+    m_dispatch_cv.notify_one();
+  }
+}
+
+void SVHEventHub::dispatch()
+{
+  std::vector<std::shared_ptr<SVHSubscription> > subscriptions;
+  SVHEvent event;
+
+  std::unique_lock<std::mutex> wake(m_dispatch_mutex);
+  while (true)
+  {
+    m_dispatch_cv.wait(wake, [this] { return m_dispatch_pending || m_dispatch_stop; });
+    if (m_dispatch_stop)
+    {
+      break;
+    }
+    m_dispatch_pending = false;
+    wake.unlock();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      subscriptions = m_subscriptions;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_callback_mutex);
+      for (const std::shared_ptr<SVHSubscription>& subscription : subscriptions)
+      {
+        if (subscription->m_options.delivery != SVH_DELIVER_DISPATCH_THREAD)
+        {
+          continue;
+        }
+        while (subscription->isActive() && subscription->pop(event))
+        {
+          subscription->m_callback(event);
+        }
+      }
+    }
+    subscriptions.clear();
+
+    wake.lock();
+  }
+}
+
+} // namespace driver_svh
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHFrameDecoder that extracts serial packets from
+ * a byte stream.
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace driver_svh {
+
+SVHFrameDecoder::SVHFrameDecoder()
+  : m_fill(0)
+{
+}
+
+size_t SVHFrameDecoder::feed(const uint8_t* data,
+                             size_t size,
+                             const SVHFrameCallback& callback,
+                             const SVHFrameCallback& rejected)
+{
+  const uint64_t frames_before = m_statistics.frames;
+
+  // Complete a frame that was split between chunks. Only as many bytes as a frame can have are
+  // copied, everything else is decoded directly from the caller's memory.
+  while (m_fill > 0 && size > 0)
+  {
+    size_t old_fill = m_fill;
+    size_t appended = std::min(size, m_buffer.size() - m_fill);
+    std::memcpy(m_buffer.data() + m_fill, data, appended);
+    m_fill += appended;
+
+    size_t consumed = parse(m_buffer.data(), m_fill, callback, rejected);
+    if (consumed >= old_fill)
+    {
+      // The buffered bytes are done, continue in the chunk with the first unconsumed byte
+      size_t used = consumed - old_fill;
+      data += used;
+      size -= used;
+      m_fill = 0;
+    }
+    else
+    {
+      // The frame starting in the buffer is still incomplete
+      std::memmove(m_buffer.data(), m_buffer.data() + consumed, m_fill - consumed);
+      m_fill -= consumed;
+      data += appended;
+      size -= appended;
+    }
+  }
+
+  if (size > 0)
+  {
+    size_t consumed = parse(data, size, callback, rejected);
+    m_fill          = size - consumed;
+    std::memcpy(m_buffer.data(), data + consumed, m_fill);
+  }
+
+  return static_cast<size_t>(m_statistics.frames - frames_before);
+}
+
+size_t SVHFrameDecoder::parse(const uint8_t* data,
+                              size_t size,
+                              const SVHFrameCallback& callback,
+                              const SVHFrameCallback& rejected)
+{
+  const uint8_t* position = data;
+  const uint8_t* end      = data + size;
+
+  while (position < end)
+  {
+    // Skip everything up to the next possible header in one go
+    const uint8_t* header =
+      static_cast<const uint8_t*>(std::memchr(position, PACKET_HEADER1, end - position));
+    if (header == nullptr)
+    {
+      m_statistics.skipped_bytes += end - position;
+      return size;
+    }
+    m_statistics.skipped_bytes += header - position;
+    position = header;
+
+    size_t available = end - position;
+    if (available < 2)
+    {
+      break;
+    }
+    if (position[1] != PACKET_HEADER2)
+    {
+      m_statistics.skipped_bytes++;
+      position++;
+      continue;
+    }
+    if (available < C_FRAME_HEADER_SIZE)
+    {
+      break;
+    }
+
+    uint16_t length = static_cast<uint16_t>(position[4] | (position[5] << 8));
+    if (length > C_MAXIMUM_PACKET_SIZE)
+    {
+      // A corrupted length would make us wait for data that never belongs to this frame
+      m_statistics.oversized_frames++;
+      m_statistics.skipped_bytes++;
+      position++;
+      continue;
+    }
+
+    size_t frame_size = C_FRAME_HEADER_SIZE + length + 2;
+    if (available < frame_size)
+    {
+      break;
+    }
+
+    const uint8_t* payload = position + C_FRAME_HEADER_SIZE;
+    uint8_t check_sum1     = 0;
+    uint8_t check_sum2     = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+      check_sum1 += payload[i];
+      check_sum2 ^= payload[i];
+    }
+
+    SVHFrameView frame;
+    frame.index   = position[2];
+    frame.address = position[3];
+    frame.payload = payload;
+    frame.length  = length;
+
+    if (check_sum1 != payload[length] || check_sum2 != payload[length + 1])
+    {
+      // The header may have been part of the noise, look for the next one right behind it
+      m_statistics.checksum_errors++;
+      if (rejected)
+      {
+        rejected(frame);
+      }
+      m_statistics.skipped_bytes++;
+      position++;
+      continue;
+    }
+
+    m_statistics.frames++;
+    if (callback)
+    {
+      callback(frame);
+    }
+    position += frame_size;
+  }
+
+  return static_cast<size_t>(position - data);
+}
+
+} // namespace driver_svh
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#ifdef _SYSTEM_LINUX_
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+static_assert(sizeof(SVHCaptureFileHeader) == 64, "The capture file layout must not change");
+static_assert(sizeof(SVHCaptureRecord) == 96, "The capture file layout must not change");
+
+const char SVHPacketRecorder::C_CAPTURE_MAGIC[8] = {'S', 'V', 'H', 'C', 'A', 'P', 'T', '\0'};
+const uint32_t SVHPacketRecorder::C_CAPTURE_VERSION;
+
+namespace {
+
+int64_t nanoseconds(const std::chrono::steady_clock::time_point& time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+} // namespace
+
+SVHPacketRecorder::SVHPacketRecorder()
+  : m_header(nullptr)
+  , m_records(nullptr)
+  , m_mapped_size(0)
+{
+}
+
+SVHPacketRecorder::~SVHPacketRecorder()
+{
+  close();
+}
+
+bool SVHPacketRecorder::open(const std::string& path, size_t capacity)
+{
+  close();
+
+#ifdef _SYSTEM_LINUX_
+  if (capacity == 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHPacketRecorder", "The capacity of a capture file must not be 0");
+    return false;
+  }
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHPacketRecorder",
+                         "Could not create capture file " << path << ": " << strerror(errno));
+    return false;
+  }
+
+  // Allocate the blocks up front. A full disk would otherwise kill the process with SIGBUS on the
+  // first write to an unallocated page.
+  size_t size = sizeof(SVHCaptureFileHeader) + capacity * sizeof(SVHCaptureRecord);
+  int result  = posix_fallocate(fd, 0, static_cast<off_t>(size));
+  if (result == EOPNOTSUPP || result == EINVAL)
+  {
+    result = ftruncate(fd, static_cast<off_t>(size)) == 0 ? 0 : errno;
+  }
+  if (result != 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHPacketRecorder",
+                         "Could not allocate capture file " << path << ": " << strerror(result));
+    ::close(fd);
+    return false;
+  }
+
+  void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    SVH_LOG_ERROR_STREAM("SVHPacketRecorder",
+                         "Could not map capture file " << path << ": " << strerror(errno));
+    return false;
+  }
+
+  // Touch every page now so that recording never runs into a page fault
+  std::memset(mapping, 0, size);
+
+  SVHCaptureFileHeader* header = static_cast<SVHCaptureFileHeader*>(mapping);
+  std::memcpy(header->magic, C_CAPTURE_MAGIC, sizeof(header->magic));
+  header->version     = C_CAPTURE_VERSION;
+  header->record_size = sizeof(SVHCaptureRecord);
+  header->capacity    = capacity;
+  header->realtime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  header->steady_ns = nanoseconds(std::chrono::steady_clock::now());
+  header->next      = 0;
+
+  m_records     = reinterpret_cast<SVHCaptureRecord*>(header + 1);
+  m_mapped_size = size;
+  m_header      = header;
+
+  SVH_LOG_DEBUG_STREAM("SVHPacketRecorder",
+                       "Recording the last " << capacity << " frames into " << path);
+  return true;
+#else
+  SVH_LOG_ERROR_STREAM("SVHPacketRecorder", "Packet recording is not supported on this system");
+  return false;
+#endif
+}
+
+void SVHPacketRecorder::close()
+{
+#ifdef _SYSTEM_LINUX_
+  if (m_header != nullptr)
+  {
+    munmap(m_header, m_mapped_size);
+  }
+#endif
+  m_header      = nullptr;
+  m_records     = nullptr;
+  m_mapped_size = 0;
+}
+
+void SVHPacketRecorder::record(SVHCaptureDirection direction,
+                               SVHCaptureStatus status,
+                               const struct iovec* buffers,
+                               int count)
+{
+  if (m_header == nullptr)
+  {
+    return;
+  }
+
+  uint64_t sequence;
+  SVHCaptureRecord* record = beginRecord(direction, status, sequence);
+  size_t length            = 0;
+  for (int i = 0; i < count && length < sizeof(record->frame); ++i)
+  {
+    size_t piece = std::min(buffers[i].iov_len, sizeof(record->frame) - length);
+    std::memcpy(record->frame + length, buffers[i].iov_base, piece);
+    length += piece;
+  }
+  record->length = static_cast<uint16_t>(length);
+  commitRecord(record, sequence);
+}
+
+void SVHPacketRecorder::record(SVHCaptureStatus status, const SVHFrameView& frame)
+{
+  if (m_header == nullptr)
+  {
+    return;
+  }
+
+  uint64_t sequence;
+  SVHCaptureRecord* record = beginRecord(CD_RECEIVE, status, sequence);
+  record->frame[0]         = PACKET_HEADER1;
+  record->frame[1]         = PACKET_HEADER2;
+  record->frame[2]         = frame.index;
+  record->frame[3]         = frame.address;
+  record->frame[4]         = static_cast<uint8_t>(frame.length & 0xFF);
+  record->frame[5]         = static_cast<uint8_t>(frame.length >> 8);
+
+  // The checksum follows the payload, the decoder guarantees that the frame fits
+  size_t length = SVHFrameDecoder::C_FRAME_HEADER_SIZE + frame.length + 2;
+  std::memcpy(
+    record->frame + SVHFrameDecoder::C_FRAME_HEADER_SIZE, frame.payload, frame.length + 2);
+  record->length = static_cast<uint16_t>(length);
+  commitRecord(record, sequence);
+}
+
+SVHCaptureRecord* SVHPacketRecorder::beginRecord(SVHCaptureDirection direction,
+                                                 SVHCaptureStatus status,
+                                                 uint64_t& sequence)
+{
+  // Each writer owns its slot, so concurrent writers only share the counter
+  uint64_t position        = __atomic_fetch_add(&m_header->next, 1, __ATOMIC_RELAXED);
+  SVHCaptureRecord* record = m_records + position % m_header->capacity;
+  sequence                 = position + 1;
+
+  // A record that is cut short by a crash stays marked as incomplete
+  __atomic_store_n(&record->sequence, 0, __ATOMIC_RELAXED);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  record->timestamp_ns = nanoseconds(std::chrono::steady_clock::now());
+  record->direction    = static_cast<uint8_t>(direction);
+  record->status       = static_cast<uint8_t>(status);
+  return record;
+}
+
+void SVHPacketRecorder::commitRecord(SVHCaptureRecord* record, uint64_t sequence)
+{
+  __atomic_store_n(&record->sequence, sequence, __ATOMIC_RELEASE);
+}
+
+uint64_t SVHPacketRecorder::recordedFrames() const
+{
+  if (m_header == nullptr)
+  {
+    return 0;
+  }
+  return __atomic_load_n(&m_header->next, __ATOMIC_RELAXED);
+}
+
+bool SVHPacketRecorder::flush()
+{
+#ifdef _SYSTEM_LINUX_
+  return m_header != nullptr && msync(m_header, m_mapped_size, MS_SYNC) == 0;
+#else
+  return false;
+#endif
+}
+
+bool SVHPacketRecorder::readCapture(const std::string& path,
+                                    SVHCaptureFileHeader& header,
+                                    std::vector<SVHCaptureRecord>& records)
+{
+  records.clear();
+
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+  {
+    SVH_LOG_ERROR_STREAM("SVHPacketRecorder", "Could not read capture file " << path);
+    return false;
+  }
+  if (!isCaptureHeader(header))
+  {
+    SVH_LOG_ERROR_STREAM("SVHPacketRecorder", path << " is no capture file of a known version");
+    return false;
+  }
+
+  SVHCaptureRecord record;
+  for (uint64_t i = 0; i < header.capacity; ++i)
+  {
+    if (!file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+      SVH_LOG_ERROR_STREAM("SVHPacketRecorder", "Capture file " << path << " is truncated");
+      return false;
+    }
+    if (record.sequence != 0 && record.length <= sizeof(record.frame))
+    {
+      records.push_back(record);
+    }
+  }
+
+  std::sort(records.begin(),
+            records.end(),
+            [](const SVHCaptureRecord& a, const SVHCaptureRecord& b) {
+              return a.sequence < b.sequence;
+            });
+  return true;
+}
+
+bool SVHPacketRecorder::isCaptureHeader(const SVHCaptureFileHeader& header)
+{
+  return std::memcmp(header.magic, C_CAPTURE_MAGIC, sizeof(header.magic)) == 0 &&
+         header.version == C_CAPTURE_VERSION && header.record_size == sizeof(SVHCaptureRecord);
+}
+
+} // namespace driver_svh
@@ -0,0 +1,425 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _SYSTEM_LINUX_
+#  include <poll.h>
+#  include <sys/eventfd.h>
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+namespace {
+
+//! Wakes up whoever polls the eventfd
+void signalEvent(int fd)
+{
+#ifdef _SYSTEM_LINUX_
+  uint64_t value = 1;
+  ssize_t result = ::write(fd, &value, sizeof(value));
+  (void)result;
+#endif
+}
+
+//! Resets the eventfd so that it polls readable on the next signal only
+void clearEvent(int fd)
+{
+#ifdef _SYSTEM_LINUX_
+  uint64_t value = 0;
+  ssize_t result = ::read(fd, &value, sizeof(value));
+  (void)result;
+#endif
+}
+
+//! Waits at most \a time us for the eventfd to be signalled, returns 1, 0 or -errno
+int waitEvent(int fd, unsigned long time)
+{
+#ifdef _SYSTEM_LINUX_
+  struct pollfd descriptor;
+  descriptor.fd     = fd;
+  descriptor.events = POLLIN;
+
+  struct timespec timeout;
+  timeout.tv_sec  = time / 1000000;
+  timeout.tv_nsec = (time % 1000000) * 1000;
+
+  int result = ::ppoll(&descriptor, 1, &timeout, NULL);
+  return result < 0 ? -errno : result;
+#else
+  std::this_thread::sleep_for(std::chrono::microseconds(std::min(time, 1000ul)));
+  return 1;
+#endif
+}
+
+} // namespace
+
+const size_t SVHPipeTransport::C_DEFAULT_CAPACITY;
+
+//! Bytes travelling in one direction
+struct SVHPipeTransport::Ring
+{
+  explicit Ring(size_t capacity)
+    : buffer(capacity)
+    , mask(capacity - 1)
+    , head(0)
+    , tail(0)
+    , writer_waiting(false)
+    , data_fd(-1)
+    , space_fd(-1)
+  {
+#ifdef _SYSTEM_LINUX_
+    data_fd  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    space_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+  }
+
+  ~Ring()
+  {
+#ifdef _SYSTEM_LINUX_
+    if (data_fd >= 0)
+    {
+      ::close(data_fd);
+    }
+    if (space_fd >= 0)
+    {
+      ::close(space_fd);
+    }
+#endif
+  }
+
+  std::vector<uint8_t> buffer;
+  size_t mask;
+
+  //! Total number of bytes written, only changed by the writer
+  std::atomic<uint64_t> head;
+  //! Keeps the counters of reader and writer in different cache lines
+  char padding[64];
+  //! Total number of bytes read, only changed by the reader
+  std::atomic<uint64_t> tail;
+
+  //! Set while the writer waits for space
+  std::atomic<bool> writer_waiting;
+
+  //! Signalled when data is written to an empty ring
+  int data_fd;
+  //! Signalled when the reader makes room for a waiting writer
+  int space_fd;
+};
+
+//! State shared by both ends of a pipe
+struct SVHPipeTransport::Channel
+{
+  std::unique_ptr<Ring> rings[2];
+
+  //! Set as soon as either end is closed
+  std::atomic<bool> closed{false};
+};
+
+bool SVHPipeTransport::createPair(std::shared_ptr<SVHPipeTransport>& first,
+                                  std::shared_ptr<SVHPipeTransport>& second,
+                                  size_t capacity)
+{
+  // Index arithmetic on the rings needs a power of two
+  size_t rounded_capacity = 1;
+  while (rounded_capacity < capacity)
+  {
+    rounded_capacity <<= 1;
+  }
+
+  std::shared_ptr<Channel> channel = std::make_shared<Channel>();
+  for (std::unique_ptr<Ring>& ring : channel->rings)
+  {
+    ring.reset(new Ring(rounded_capacity));
+#ifdef _SYSTEM_LINUX_
+    if (ring->data_fd < 0 || ring->space_fd < 0)
+    {
+      return false;
+    }
+#endif
+  }
+
+  first.reset(new SVHPipeTransport(channel, 0));
+  second.reset(new SVHPipeTransport(channel, 1));
+  return true;
+}
+
+SVHPipeTransport::SVHPipeTransport(const std::shared_ptr<Channel>& channel, int side)
+  : m_channel(channel)
+  , m_in(channel->rings[1 - side].get())
+  , m_out(channel->rings[side].get())
+  , m_open(true)
+  , m_status(0)
+  , m_name("pipe:" + std::to_string(side))
+{
+}
+
+SVHPipeTransport::~SVHPipeTransport()
+{
+  close();
+}
+
+void SVHPipeTransport::close()
+{
+  if (!m_open.exchange(false))
+  {
+    return;
+  }
+
+  // Wake up everybody waiting on either end, they will notice the closed channel
+  m_channel->closed = true;
+  for (std::unique_ptr<Ring>& ring : m_channel->rings)
+  {
+    signalEvent(ring->data_fd);
+    signalEvent(ring->space_fd);
+  }
+}
+
+size_t SVHPipeTransport::consume(uint8_t* data, size_t size)
+{
+  const uint64_t tail  = m_in->tail.load(std::memory_order_relaxed);
+  const uint64_t head  = m_in->head.load(std::memory_order_acquire);
+  const size_t count   = static_cast<size_t>(std::min<uint64_t>(head - tail, size));
+  const size_t offset  = static_cast<size_t>(tail) & m_in->mask;
+  const size_t first   = std::min(count, m_in->buffer.size() - offset);
+  const uint8_t* begin = m_in->buffer.data();
+
+  std::memcpy(data, begin + offset, first);
+  std::memcpy(data + first, begin, count - first);
+  m_in->tail.store(tail + count, std::memory_order_seq_cst);
+
+  if (count > 0 && m_in->writer_waiting.load(std::memory_order_seq_cst) &&
+      m_in->writer_waiting.exchange(false))
+  {
+    signalEvent(m_in->space_fd);
+  }
+
+  if (tail + count == head)
+  {
+    // The ring looks empty, so the writer signals the next data. Data written before the event
+    // was reset would be missed by a poll, so it is signalled again.
+    clearEvent(m_in->data_fd);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_in->head.load(std::memory_order_acquire) != head)
+    {
+      signalEvent(m_in->data_fd);
+    }
+  }
+
+  return count;
+}
+
+ssize_t SVHPipeTransport::read(void* data,
+                               ssize_t size,
+                               unsigned long time,
+                               bool return_on_less_data)
+{
+  if (!m_open)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+
+  const auto end_time = std::chrono::steady_clock::now() + std::chrono::microseconds(time);
+  uint8_t* buffer     = static_cast<uint8_t*>(data);
+  ssize_t bytes_read  = 0;
+  m_status            = 0;
+
+  while (bytes_read < size)
+  {
+    bytes_read += static_cast<ssize_t>(
+      consume(buffer + bytes_read, static_cast<size_t>(size - bytes_read)));
+    if (bytes_read == size || (bytes_read > 0 && return_on_less_data))
+    {
+      break;
+    }
+    if (m_channel->closed &&
+        m_in->head.load(std::memory_order_acquire) == m_in->tail.load(std::memory_order_relaxed))
+    {
+      if (bytes_read == 0)
+      {
+        m_status = -EPIPE;
+        return m_status;
+      }
+      break;
+    }
+
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+      end_time - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0)
+    {
+      break;
+    }
+    waitEvent(m_in->data_fd, static_cast<unsigned long>(remaining.count()));
+  }
+
+  return bytes_read;
+}
+
+ssize_t SVHPipeTransport::writev(const struct iovec* buffers, int count)
+{
+  if (!m_open)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+  if (m_channel->closed)
+  {
+    m_status = -EPIPE;
+    return m_status;
+  }
+
+  const uint64_t head = m_out->head.load(std::memory_order_relaxed);
+  const uint64_t tail = m_out->tail.load(std::memory_order_acquire);
+  const size_t space  = m_out->buffer.size() - static_cast<size_t>(head - tail);
+  if (space == 0)
+  {
+    m_status = -EAGAIN;
+    return m_status;
+  }
+
+  uint8_t* begin = m_out->buffer.data();
+  size_t written = 0;
+  for (int i = 0; i < count && written < space; ++i)
+  {
+    const uint8_t* source = static_cast<const uint8_t*>(buffers[i].iov_base);
+    const size_t length   = std::min(buffers[i].iov_len, space - written);
+    const size_t offset   = static_cast<size_t>(head + written) & m_out->mask;
+    const size_t first    = std::min(length, m_out->buffer.size() - offset);
+    std::memcpy(begin + offset, source, first);
+    std::memcpy(begin, source + first, length - first);
+    written += length;
+  }
+  m_out->head.store(head + written, std::memory_order_seq_cst);
+
+  // Only a reader that consumed everything may be waiting, see consume
+  if (m_out->tail.load(std::memory_order_seq_cst) == head)
+  {
+    signalEvent(m_out->data_fd);
+  }
+
+  m_status = 0;
+  return static_cast<ssize_t>(written);
+}
+
+int SVHPipeTransport::waitWritable(unsigned long time)
+{
+  auto has_space = [this] {
+    return m_out->head.load(std::memory_order_relaxed) -
+             m_out->tail.load(std::memory_order_seq_cst) <
+           m_out->buffer.size();
+  };
+
+  if (!m_open)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+  if (m_channel->closed)
+  {
+    m_status = -EPIPE;
+    return m_status;
+  }
+  if (has_space())
+  {
+    return 1;
+  }
+
+  clearEvent(m_out->space_fd);
+  m_out->writer_waiting.store(true, std::memory_order_seq_cst);
+  int result = has_space() ? 1 : waitEvent(m_out->space_fd, time);
+  m_out->writer_waiting = false;
+
+  if (m_channel->closed)
+  {
+    m_status = -EPIPE;
+    return m_status;
+  }
+  if (result < 0)
+  {
+    m_status = result;
+    return m_status;
+  }
+  return has_space() ? 1 : 0;
+}
+
+int SVHPipeTransport::waitReadable(unsigned long time)
+{
+  auto has_data = [this] {
+    return m_in->head.load(std::memory_order_acquire) !=
+           m_in->tail.load(std::memory_order_relaxed);
+  };
+
+  if (!m_open)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+  if (!has_data())
+  {
+    // Behaves like a hung up device once the remaining data was read
+    if (m_channel->closed)
+    {
+      m_status = -EIO;
+      return m_status;
+    }
+    int result = waitEvent(m_in->data_fd, time);
+    if (result < 0)
+    {
+      m_status = result;
+      return m_status;
+    }
+    if (result == 0)
+    {
+      return 0;
+    }
+  }
+
+  m_status = 0;
+  return 1;
+}
+
+int SVHPipeTransport::fileDescriptor()
+{
+  return m_in->data_fd;
+}
+
+std::string SVHPipeTransport::statusText() const
+{
+  return strerror(-m_status);
+}
+
+} // namespace driver_svh
@@ -0,0 +1,444 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHReactor, an event loop that services the file
+ * descriptors of several serial interfaces and timers from a single thread.
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHTrace.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+
+#include <cstring>
+#include <exception>
+
+#ifdef _SYSTEM_LINUX_
+#  include <errno.h>
+#  include <sys/epoll.h>
+#  include <sys/eventfd.h>
+#  include <sys/timerfd.h>
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+namespace {
+
+//! epoll user data of the wakeup eventfd, no registration can ever produce this value
+const uint64_t C_WAKEUP_DATA = ~uint64_t(0);
+
+//! Maximum number of events handled per wakeup
+const int C_MAX_EVENTS = 32;
+
+//! Reactor whose thread is the calling thread, if any
+thread_local const SVHReactor* t_current_reactor = nullptr;
+
+} // namespace
+
+SVHReactor::SVHReactor()
+  : m_epoll_fd(-1)
+  , m_wakeup_fd(-1)
+  , m_running(false)
+  , m_next_generation(0)
+  , m_wakeups(0)
+  , m_events(0)
+  , m_handler_errors(0)
+{
+#ifdef _SYSTEM_LINUX_
+  m_epoll_fd  = epoll_create1(EPOLL_CLOEXEC);
+  m_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (m_epoll_fd < 0 || m_wakeup_fd < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Could not create the event loop: " << strerror(errno));
+    return;
+  }
+
+  epoll_event event;
+  event.events   = EPOLLIN;
+  event.data.u64 = C_WAKEUP_DATA;
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &event) < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Could not register the wakeup event: " << strerror(errno));
+  }
+#else
+  SVH_LOG_ERROR_STREAM("SVHReactor", "The reactor is only available on Linux");
+#endif
+}
+
+SVHReactor::~SVHReactor()
+{
+  stop();
+
+#ifdef _SYSTEM_LINUX_
+  if (m_wakeup_fd >= 0)
+  {
+    ::close(m_wakeup_fd);
+  }
+  if (m_epoll_fd >= 0)
+  {
+    ::close(m_epoll_fd);
+  }
+#endif
+}
+
+bool SVHReactor::start()
+{
+  if (m_running)
+  {
+    return true;
+  }
+  if (m_epoll_fd < 0 || m_wakeup_fd < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Cannot start the reactor, the event loop is not available");
+    return false;
+  }
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+
+  m_running = true;
+  m_thread  = std::thread(&SVHReactor::run, this);
+  SVH_LOG_DEBUG_STREAM("SVHReactor", "Reactor thread started");
+  return true;
+}
+
+void SVHReactor::stop()
+{
+  m_running = false;
+
+#ifdef _SYSTEM_LINUX_
+  if (m_wakeup_fd >= 0)
+  {
+    uint64_t one = 1;
+    if (::write(m_wakeup_fd, &one, sizeof(one)) < 0)
+    {
+      SVH_LOG_DEBUG_STREAM("SVHReactor", "Could not wake up the reactor: " << strerror(errno));
+    }
+  }
+#endif
+
+  if (m_thread.joinable())
+  {
+    // A handler that stops the reactor cannot wait for its own thread
+    if (isReactorThread())
+    {
+      m_thread.detach();
+    }
+    else
+    {
+      m_thread.join();
+    }
+    SVH_LOG_DEBUG_STREAM("SVHReactor", "Reactor thread terminated");
+  }
+}
+
+bool SVHReactor::isReactorThread() const
+{
+  return t_current_reactor == this;
+}
+
+bool SVHReactor::addDescriptor(int fd, const SVHReactorHandler& handler)
+{
+#ifdef _SYSTEM_LINUX_
+  if (fd < 0 || !handler || m_epoll_fd < 0)
+  {
+    SVH_LOG_WARN_STREAM("SVHReactor", "Invalid descriptor " << fd << " was given, ignoring it");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_entries_mutex);
+  if (m_entries.count(fd) > 0)
+  {
+    SVH_LOG_WARN_STREAM("SVHReactor", "Descriptor " << fd << " is already registered");
+    return false;
+  }
+
+  auto entry        = std::make_shared<Entry>();
+  entry->generation = m_next_generation++;
+  entry->handler    = handler;
+
+  epoll_event event;
+  event.events   = EPOLLIN | EPOLLRDHUP;
+  event.data.u64 = (static_cast<uint64_t>(entry->generation) << 32) | static_cast<uint32_t>(fd);
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHReactor",
+                         "Could not register descriptor " << fd << ": " << strerror(errno));
+    return false;
+  }
+
+  m_entries[fd] = entry;
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool SVHReactor::removeDescriptor(int fd)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(m_entries_mutex);
+    auto it = m_entries.find(fd);
+    if (it == m_entries.end())
+    {
+      return false;
+    }
+    entry = it->second;
+    m_entries.erase(it);
+#ifdef _SYSTEM_LINUX_
+    // Fails for descriptors that were closed before, they are removed from epoll already
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+  }
+
+  if (isReactorThread())
+  {
+    // No other handler can run concurrently in the reactor thread
+    entry->active = false;
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    entry->active = false;
+  }
+  return true;
+}
+
+int SVHReactor::addTimer(const std::chrono::microseconds& period,
+                         const std::function<void()>& handler)
+{
+#ifdef _SYSTEM_LINUX_
+  if (!handler)
+  {
+    SVH_LOG_WARN_STREAM("SVHReactor", "Invalid timer was given, ignoring it");
+    return -1;
+  }
+
+  int timer = createTimer(period);
+  if (timer < 0)
+  {
+    return -1;
+  }
+
+  bool added = addDescriptor(timer, [timer, handler](uint32_t) {
+    // Missed expirations are not made up for, the handler is called once per wakeup
+    uint64_t expirations = 0;
+    if (::read(timer, &expirations, sizeof(expirations)) == sizeof(expirations))
+    {
+      handler();
+    }
+  });
+  if (!added)
+  {
+    ::close(timer);
+    return -1;
+  }
+  return timer;
+#else
+  return -1;
+#endif
+}
+
+int SVHReactor::addTask(const std::chrono::microseconds& period, const std::function<bool()>& step)
+{
+#ifdef _SYSTEM_LINUX_
+  if (!step)
+  {
+    SVH_LOG_WARN_STREAM("SVHReactor", "Invalid task was given, ignoring it");
+    return -1;
+  }
+
+  int timer = createTimer(period);
+  if (timer < 0)
+  {
+    return -1;
+  }
+
+  // The id is known before the first step, so a finished task can remove itself
+  bool added = addDescriptor(timer, [this, timer, step](uint32_t) {
+    uint64_t expirations = 0;
+    if (::read(timer, &expirations, sizeof(expirations)) == sizeof(expirations) && !step())
+    {
+      removeTimer(timer);
+    }
+  });
+  if (!added)
+  {
+    ::close(timer);
+    return -1;
+  }
+  return timer;
+#else
+  return -1;
+#endif
+}
+
+int SVHReactor::createTimer(const std::chrono::microseconds& period)
+{
+#ifdef _SYSTEM_LINUX_
+  if (period.count() <= 0)
+  {
+    SVH_LOG_WARN_STREAM("SVHReactor", "Invalid timer period was given, ignoring it");
+    return -1;
+  }
+
+  int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Could not create timer: " << strerror(errno));
+    return -1;
+  }
+
+  itimerspec spec;
+  spec.it_interval.tv_sec  = period.count() / 1000000;
+  spec.it_interval.tv_nsec = (period.count() % 1000000) * 1000;
+  spec.it_value            = spec.it_interval;
+  if (timerfd_settime(timer, 0, &spec, nullptr) < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Could not arm timer: " << strerror(errno));
+    ::close(timer);
+    return -1;
+  }
+  return timer;
+#else
+  return -1;
+#endif
+}
+
+void SVHReactor::removeTimer(int timer)
+{
+  // Only the remover of the registration closes the timer, its number may be reused afterwards
+  if (timer < 0 || !removeDescriptor(timer))
+  {
+    return;
+  }
+#ifdef _SYSTEM_LINUX_
+  ::close(timer);
+#endif
+}
+
+SVHReactorStatistics SVHReactor::statistics() const
+{
+  SVHReactorStatistics statistics;
+  statistics.wakeups        = m_wakeups;
+  statistics.events         = m_events;
+  statistics.handler_errors = m_handler_errors;
+  return statistics;
+}
+
+void SVHReactor::run()
+{
+#ifdef _SYSTEM_LINUX_
+  SVHTrace::setThreadName("svh-reactor");
+  t_current_reactor = this;
+
+  epoll_event events[C_MAX_EVENTS];
+  while (m_running)
+  {
+    int count = epoll_wait(m_epoll_fd, events, C_MAX_EVENTS, -1);
+    if (count < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      SVH_LOG_ERROR_STREAM("SVHReactor", "Waiting for events failed: " << strerror(errno));
+      break;
+    }
+
+    m_wakeups++;
+    for (int i = 0; i < count && m_running; ++i)
+    {
+      if (events[i].data.u64 == C_WAKEUP_DATA)
+      {
+        uint64_t value;
+        while (::read(m_wakeup_fd, &value, sizeof(value)) > 0)
+        {
+        }
+        continue;
+      }
+
+      uint32_t reactor_events = 0;
+      if (events[i].events & (EPOLLIN | EPOLLPRI))
+      {
+        reactor_events |= EV_READABLE;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+      {
+        reactor_events |= EV_HANGUP;
+      }
+      dispatch(events[i].data.u64, reactor_events);
+    }
+  }
+
+  t_current_reactor = nullptr;
+#endif
+}
+
+void SVHReactor::dispatch(uint64_t data, uint32_t events)
+{
+  int fd              = static_cast<int>(data & 0xFFFFFFFF);
+  uint32_t generation = static_cast<uint32_t>(data >> 32);
+
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(m_entries_mutex);
+    auto it = m_entries.find(fd);
+    // Events of a removed registration may still be pending in the current batch
+    if (it == m_entries.end() || it->second->generation != generation)
+    {
+      return;
+    }
+    entry = it->second;
+  }
+
+  std::lock_guard<std::mutex> lock(entry->mutex);
+  if (!entry->active)
+  {
+    return;
+  }
+
+  m_events++;
+  try
+  {
+    entry->handler(events);
+  }
+  catch (const std::exception& e)
+  {
+    m_handler_errors++;
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Handler of descriptor " << fd << " failed: " << e.what());
+  }
+  catch (...)
+  {
+    m_handler_errors++;
+    SVH_LOG_ERROR_STREAM("SVHReactor", "Handler of descriptor " << fd << " failed");
+  }
+}
+
+} // namespace driver_svh
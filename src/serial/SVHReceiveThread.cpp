@@ -30,31 +30,36 @@
  * This file contains the ReceiveThread for the serial communication.
  * In order to receive packages independently from the sending direction
  * this thread periodically polls the serial interface for new data. If data
- * is present a statemachine will evaluate the right packet structure and send the
+ * is present a frame decoder will evaluate the right packet structure and send the
  * data to further parsing once a complete serial packaged is received
  */
 //----------------------------------------------------------------------
 #include <chrono>
 #include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHProbes.h>
+#include <schunk_svh_library/SVHTrace.h>
 #include <schunk_svh_library/serial/SVHReceiveThread.h>
 #include <sstream>
 #include <thread>
 
-using driver_svh::ArrayBuilder;
-
 namespace driver_svh {
 
 SVHReceiveThread::SVHReceiveThread(const std::chrono::microseconds& idle_sleep,
-                                   std::shared_ptr<Serial> device,
-                                   ReceivedPacketCallback const& received_callback)
+                                   std::shared_ptr<SVHTransport> device,
+                                   ReceivedPacketCallback const& received_callback,
+                                   size_t read_buffer_size,
+                                   SVHReceiveStrategy strategy)
   : m_idle_sleep(idle_sleep)
+  , m_strategy(strategy)
+  , m_read_buffer(read_buffer_size)
   , m_serial_device(device)
-  , m_received_state(RS_HEADE_R1)
-  , m_length(0)
-  , m_data(0, 0)
-  , m_ab(0)
   , m_packets_received(0)
-  , m_skipped_bytes(0)
+  , m_stat_wakeups(0)
+  , m_stat_bytes(0)
+  , m_stat_packets(0)
+  , m_stat_skipped_bytes(0)
+  , m_stat_checksum_errors(0)
+  , m_stat_read_errors(0)
   , m_received_callback(received_callback)
 {
 }
@@ -65,7 +70,21 @@ void SVHReceiveThread::run()
   {
     if (m_serial_device) // != NULL)
     {
-      if (m_serial_device->isOpen())
+      if (m_serial_device->isOpen() && m_strategy == RS_BLOCKING)
+      {
+        // The timeout only bounds how long stop() takes, data wakes the thread immediately
+        int ready = m_serial_device->waitReadable(static_cast<unsigned long>(m_idle_sleep.count()));
+        if (ready > 0)
+        {
+          receiveAvailableData();
+        }
+        else if (ready < 0)
+        {
+          // Do not spin on a broken device
+          std::this_thread::sleep_for(m_idle_sleep);
+        }
+      }
+      else if (m_serial_device->isOpen())
       {
         auto start = std::chrono::high_resolution_clock::now();
 
@@ -99,21 +118,54 @@ void SVHReceiveThread::run()
   }
 }
 
+bool SVHReceiveThread::receiveAvailableData()
+{
+  if (!m_serial_device || !m_serial_device->isOpen())
+  {
+    m_stat_read_errors++;
+    return false;
+  }
+
+  m_stat_wakeups++;
+
+  // Drain the device in chunks, a short read means that nothing is left for now
+  const ssize_t size = static_cast<ssize_t>(m_read_buffer.size());
+  ssize_t bytes      = 0;
+  do
+  {
+    bytes = m_serial_device->read(m_read_buffer.data(), size, 0);
+    if (bytes < 0)
+    {
+      m_stat_read_errors++;
+      SVH_LOG_DEBUG_STREAM("SVHReceiveThread", "Serial read error:" << bytes);
+      return false;
+    }
+    processData(m_read_buffer.data(), static_cast<size_t>(bytes));
+  } while (bytes == size);
+
+  return true;
+}
+
+SVHReceiveStatistics SVHReceiveThread::statistics() const
+{
+  SVHReceiveStatistics statistics;
+  statistics.wakeups         = m_stat_wakeups;
+  statistics.bytes           = m_stat_bytes;
+  statistics.packets         = m_stat_packets;
+  statistics.skipped_bytes   = m_stat_skipped_bytes;
+  statistics.checksum_errors = m_stat_checksum_errors;
+  statistics.read_errors     = m_stat_read_errors;
+  return statistics;
+}
+
 bool SVHReceiveThread::receiveData()
 {
-  /*
-   * Each packet has to follow the defined packet structure which is ensured by the following state
-   * machine. The "Bytestream" (not realy a stream) is interpreted byte by byte. If the structure is
-   * still right the next state is entered, if a wrong byte is detected the whole packet is
-   * discarded and the SM switches to the synchronization state aggain. If the SM reaches the final
-   * state the packet will be given to the packet handler to decide what to do with its content.
-   *  NOTE: All layers working with a SerialPacket (except this one) assume that the packet has a
-   * valid structure and all data fields present.
-   */
-  uint8_t data_byte;
-  ssize_t bytes = m_serial_device->read(&data_byte, sizeof(uint8_t));
+  ssize_t bytes =
+    m_serial_device->read(m_read_buffer.data(), static_cast<ssize_t>(m_read_buffer.size()));
+  m_stat_wakeups++;
   if (bytes < 0)
   {
+    m_stat_read_errors++;
     SVH_LOG_DEBUG_STREAM("SVHReceiveThread", "Serial read error:" << bytes);
     return false;
   }
@@ -122,149 +174,85 @@ bool SVHReceiveThread::receiveData()
     return false;
   }
 
-  switch (m_received_state)
-  {
-    case RS_HEADE_R1: {
-      if (data_byte == PACKET_HEADER1)
-      {
-        m_received_state = RS_HEADE_R2;
-      }
-      else
-      {
-        m_skipped_bytes++;
-      }
-      break;
-    }
-    case RS_HEADE_R2: {
-      switch (data_byte)
-      {
-        case PACKET_HEADER2: {
-          m_received_state = RS_INDEX;
-          break;
-        }
-        case PACKET_HEADER1: {
-          m_received_state = RS_HEADE_R2;
-          m_skipped_bytes++;
-          break;
-        }
-        default: {
-          m_received_state = RS_HEADE_R1;
-          m_skipped_bytes += 2;
-          break;
-        }
-      }
-      break;
-    }
-    case RS_INDEX: {
-      // Reset Array Builder for each fresh packet
-      m_ab.reset(0);
+  processData(m_read_buffer.data(), static_cast<size_t>(bytes));
+  return true;
+}
 
-      // Data bytes are not cenverted in endianess at this point
-      m_ab.appendWithoutConversion(data_byte);
-      m_received_state = RS_ADDRESS;
-      break;
-    }
-    case RS_ADDRESS: {
-      // get the address
-      m_ab.appendWithoutConversion(data_byte);
-      m_received_state = RS_LENGT_H1;
-      break;
-    }
-    case RS_LENGT_H1: {
-      // get payload length
-      m_ab.appendWithoutConversion(data_byte);
-      m_received_state = RS_LENGT_H2;
-      break;
-    }
-    case RS_LENGT_H2: {
-      // get payload length
-      m_ab.appendWithoutConversion(data_byte);
-      m_length         = m_ab.readBack<uint16_t>();
-      m_received_state = RS_DATA;
-      m_data.clear();
-      m_data.reserve(m_length);
-      break;
-    }
-    case RS_DATA: {
-      // get the payload itself
-      // Some conversion due to legacy hardware calls
-      m_data.push_back(data_byte);
-      m_ab.appendWithoutConversion(data_byte);
-      if (m_data.size() >= m_length)
-      {
-        m_received_state = RS_CHECKSU_M1;
-      }
-      break;
-    }
-    case RS_CHECKSU_M1: {
-      m_checksum1      = data_byte;
-      m_checksum2      = 0;
-      m_received_state = RS_CHECKSU_M2;
-      break;
-    }
-    case RS_CHECKSU_M2: {
-      m_checksum2       = data_byte;
-      uint8_t checksum1 = m_checksum1;
-      uint8_t checksum2 = m_checksum2;
-      // probe for correct checksum
-      for (size_t i = 0; i < m_data.size(); ++i)
-      {
-        checksum1 -= m_data[i];
-        checksum2 ^= m_data[i];
-      }
+void SVHReceiveThread::processData(const uint8_t* data, size_t size)
+{
+  SVH_TRACE_SPAN_ARG("serial", "receive", "bytes", size);
+  /*
+   * Each packet has to follow the defined packet structure which is ensured by the frame decoder.
+   * Bytes in front of a header and packets with a wrong checksum are discarded. Only complete
+   * packets are given to the packet handler to decide what to do with their content.
+   *  NOTE: All layers working with a SerialPacket (except this one) assume that the packet has a
+   * valid structure and all data fields present.
+   */
+  const SVHFrameDecoderStatistics& decoder_statistics = m_decoder.statistics();
+  const uint64_t skipped_before                       = decoder_statistics.skipped_bytes;
+  const uint64_t checksum_errors_before               = decoder_statistics.checksum_errors;
 
-      if ((checksum1 == 0) && (checksum2 == 0))
-      {
-        // start with an empty package
-        // Warning: It is imperative for correct readouts to create the received_packet with the
-        // correct length!
-        SVHSerialPacket received_packet(m_length);
-        m_ab >> received_packet;
+  m_stat_bytes += size;
+  if (m_recorder)
+  {
+    m_decoder.feed(
+      data,
+      size,
+      [this](const SVHFrameView& frame) { processFrame(frame); },
+      [this](const SVHFrameView& frame) { m_recorder->record(CS_CHECKSUM_ERROR, frame); });
+  }
+  else
+  {
+    m_decoder.feed(data, size, [this](const SVHFrameView& frame) { processFrame(frame); });
+  }
 
-        m_packets_received++;
+  if (decoder_statistics.skipped_bytes > skipped_before)
+  {
+    m_stat_skipped_bytes += decoder_statistics.skipped_bytes - skipped_before;
+    SVH_PROBE1(resync, decoder_statistics.skipped_bytes - skipped_before);
+    SVH_LOG_DEBUG_STREAM("SVHReceiveThread",
+                         "Skipped " << decoder_statistics.skipped_bytes - skipped_before
+                                    << " bytes");
+  }
+  if (decoder_statistics.checksum_errors > checksum_errors_before)
+  {
+    m_stat_checksum_errors += decoder_statistics.checksum_errors - checksum_errors_before;
+    SVH_PROBE1(checksum_error, decoder_statistics.checksum_errors - checksum_errors_before);
+    SVH_LOG_DEBUG_STREAM("SVHReceiveThread",
+                         "Checksum error, dropped "
+                           << decoder_statistics.checksum_errors - checksum_errors_before
+                           << " packets");
+  }
+}
 
-        if (m_skipped_bytes > 0)
-          SVH_LOG_DEBUG_STREAM("SVHReceiveThread", "Skipped " << m_skipped_bytes << " bytes ");
-        SVH_LOG_DEBUG_STREAM("SVHReceiveThread",
-                             "Received packet index:" << received_packet.index
-                                                      << ", address:" << received_packet.address
-                                                      << ", size:" << received_packet.data.size());
-        m_skipped_bytes = 0;
+void SVHReceiveThread::processFrame(const SVHFrameView& frame)
+{
+  SVH_TRACE_SPAN_ARG("serial", "frame", "address", frame.address);
+  SVH_PROBE3(frame_rx, frame.index, frame.address, frame.length);
+  if (m_recorder)
+  {
+    m_recorder->record(CS_OK, frame);
+  }
 
-        // notify whoever is waiting for this
-        if (m_received_callback)
-        {
-          m_received_callback(received_packet, m_packets_received);
-        }
+  // The packet object is reused, so its payload storage is only allocated once
+  m_received_packet.index   = frame.index;
+  m_received_packet.address = frame.address;
+  m_received_packet.data.assign(frame.payload, frame.payload + frame.length);
 
-        m_received_state = RS_HEADE_R1;
-      }
-      else
-      {
-        m_received_state = RS_HEADE_R1;
+  m_packets_received++;
+  m_stat_packets++;
 
-        SVHSerialPacket received_packet(m_length);
-        m_ab >> received_packet;
+  SVH_LOG_DEBUG_STREAM("SVHReceiveThread",
+                       "Received packet index:" << static_cast<int>(m_received_packet.index)
+                                                << ", address:"
+                                                << static_cast<int>(m_received_packet.address)
+                                                << ", size:" << m_received_packet.data.size());
 
-        if (m_skipped_bytes > 0)
-          SVH_LOG_DEBUG_STREAM("SVHReceiveThread", "Skipped " << m_skipped_bytes << " bytes: ");
-        SVH_LOG_DEBUG_STREAM("SVHReceiveThread",
-                             "Checksum error: " << (int)checksum1 << "," << (int)checksum2
-                                                << "!=0, skipping " << m_length + 8
-                                                << "bytes, packet index:" << received_packet.index
-                                                << ", address:" << received_packet.address
-                                                << ", size:" << received_packet.data.size());
-        m_skipped_bytes = 0;
-        if (m_received_callback)
-        {
-          m_received_callback(received_packet, m_packets_received);
-        }
-      }
-      break;
-    }
+  // notify whoever is waiting for this
+  if (m_received_callback)
+  {
+    m_received_callback(m_received_packet, m_packets_received);
   }
-
-  return true;
 }
 
 } // namespace driver_svh
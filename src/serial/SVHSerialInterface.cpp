@@ -36,20 +36,80 @@
 //----------------------------------------------------------------------
 #include "schunk_svh_library/serial/SVHSerialInterface.h"
 #include "schunk_svh_library/Logger.h"
+#include "schunk_svh_library/SVHProbes.h"
+#include "schunk_svh_library/SVHTrace.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <schunk_svh_library/serial/ByteOrderConversion.h>
 #include <thread>
 
+#ifdef _SYSTEM_LINUX_
+#  include <pthread.h>
+#endif
 
 using driver_svh::serial::SerialFlags;
 
 namespace driver_svh {
 
+namespace {
+
+//! Map a baud rate to its SerialFlags constant, BR_0 if there is none
+SerialFlags::BaudRate standardBaudRate(uint32_t baud_rate)
+{
+  const SerialFlags::BaudRate rates[] = {SerialFlags::BR_9600,
+                                         SerialFlags::BR_19200,
+                                         SerialFlags::BR_38400,
+                                         SerialFlags::BR_57600,
+                                         SerialFlags::BR_115200,
+                                         SerialFlags::BR_230400,
+                                         SerialFlags::BR_500000,
+                                         SerialFlags::BR_921600};
+  for (SerialFlags::BaudRate rate : rates)
+  {
+    if (static_cast<uint32_t>(rate) == baud_rate)
+    {
+      return rate;
+    }
+  }
+  return SerialFlags::BR_0;
+}
+
+//! Shortest period of the reactor task that writes the packets queued by the reactor thread
+const std::chrono::microseconds C_MINIMUM_FLUSH_PERIOD(100);
+
+} // namespace
+
+const int SVHSerialInterface::C_MAXIMUM_FRAME_BUFFERS;
+const size_t SVHSerialInterface::C_PACKET_INDICES;
+
 SVHSerialInterface::SVHSerialInterface(ReceivedPacketCallback const& received_packet_callback)
   : m_connected(false)
+  , m_serial_line(true)
+  , m_failed(false)
+  , m_reactor_fd(-1)
+  , m_transmitting(false)
+  , m_transmit_sequence(0)
+  , m_flush_task(-1)
+  , m_hold(false)
+  , m_window_sent()
+  , m_window_count(0)
+  , m_stat_frames(0)
+  , m_stat_bytes(0)
+  , m_stat_partial_writes(0)
+  , m_stat_blocked_writes(0)
+  , m_stat_timeouts(0)
+  , m_stat_write_errors(0)
+  , m_stat_priority_frames()
+  , m_stat_priority_max_latency_us()
+  , m_stat_replies(0)
+  , m_stat_lost_replies(0)
+  , m_stat_unexpected_replies(0)
+  , m_stat_max_round_trip_us(0)
   , m_received_packet_callback(received_packet_callback)
   , m_packets_transmitted(0)
 {
@@ -60,19 +120,88 @@ SVHSerialInterface::~SVHSerialInterface()
   // close();
 }
 
+void SVHSerialInterface::setReactor(const std::shared_ptr<SVHReactor>& reactor)
+{
+  if (m_connected)
+  {
+    SVH_LOG_WARN_STREAM("SVHSerialInterface",
+                        "The reactor cannot be changed while connected - ignoring request");
+    return;
+  }
+  m_reactor = reactor;
+}
+
+void SVHSerialInterface::setPacketRecorder(const std::shared_ptr<SVHPacketRecorder>& recorder)
+{
+  if (m_connected)
+  {
+    SVH_LOG_WARN_STREAM("SVHSerialInterface",
+                        "The packet recorder cannot be changed while connected - ignoring request");
+    return;
+  }
+  m_recorder = recorder;
+}
+
+void SVHSerialInterface::setTransportOptions(const SVHTransportOptions& options)
+{
+  if (m_connected)
+  {
+    SVH_LOG_WARN_STREAM("SVHSerialInterface",
+                        "The transport options cannot be changed while connected - ignoring "
+                        "request");
+    return;
+  }
+  m_options = options;
+}
+
+SVHTransportOptions SVHSerialInterface::transportOptions()
+{
+  std::lock_guard<std::mutex> lock(m_send_mutex);
+  return m_options;
+}
+
+bool SVHSerialInterface::setTransmissionGap(const std::chrono::microseconds& gap)
+{
+  std::lock_guard<std::mutex> lock(m_send_mutex);
+  SVHTransportOptions options = m_options;
+  options.transmission_gap    = gap;
+
+  std::string error;
+  if (!options.validate(error, m_serial_line))
+  {
+    SVH_LOG_WARN_STREAM("SVHSerialInterface", "Transmission gap not changed: " << error);
+    return false;
+  }
+  m_options = options;
+  return true;
+}
+
 bool SVHSerialInterface::connect(const std::string& dev_name)
 {
+  SVH_TRACE_SPAN("connect", "open");
   // close device if already opened
   close();
 
+  std::string error;
+  if (!m_options.validate(error))
+  {
+    SVH_LOG_ERROR_STREAM("SVHSerialInterface", "Invalid transport options: " << error);
+    return false;
+  }
+
+  // Rates without a termios constant are set after opening the device
+  SerialFlags::BaudRate baud_rate = standardBaudRate(m_options.baud_rate);
+  bool custom_baud_rate           = baud_rate == SerialFlags::BR_0;
+
   // create serial device
-  m_serial_device.reset(
-    new Serial(dev_name.c_str(), SerialFlags(SerialFlags::BR_921600, SerialFlags::DB_8)));
+  std::shared_ptr<Serial> serial_device(new Serial(
+    dev_name.c_str(),
+    SerialFlags(custom_baud_rate ? SerialFlags::BR_921600 : baud_rate, SerialFlags::DB_8)));
 
-  if (m_serial_device)
+  if (serial_device)
   {
     // open serial device
-    if (!m_serial_device->open())
+    if (!serial_device->open())
     {
       SVH_LOG_ERROR_STREAM("SVHSerialInterface",
                            "Could not open serial device: " << dev_name.c_str());
@@ -86,22 +215,132 @@ bool SVHSerialInterface::connect(const std::string& dev_name)
     return false;
   }
 
+  if (custom_baud_rate && serial_device->setCustomBaudrate(m_options.baud_rate) != 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHSerialInterface",
+                         "Serial device " << dev_name.c_str() << " does not support a baud rate of "
+                                          << m_options.baud_rate << " bit/s");
+    serial_device->close();
+    return false;
+  }
+
+  // The default latency timer of USB adapters delays every response by several milliseconds
+  m_latency_report = SerialLatencyReport();
+  if (m_options.latency.low_latency || m_options.latency.latency_timer > 0)
+  {
+    m_latency_report = serial_device->tuneLatency(m_options.latency);
+    if (m_latency_report.applied)
+    {
+      SVH_LOG_INFO_STREAM("SVHSerialInterface",
+                          "Serial device " << dev_name.c_str() << " tuned for low latency, latency "
+                                           << "timer: " << m_latency_report.latency_timer << " ms");
+    }
+    else
+    {
+      // Usually a missing udev rule for the sysfs attribute, or the device is no USB adapter
+      SVH_LOG_WARN_STREAM("SVHSerialInterface",
+                          "Latency tuning of serial device "
+                            << dev_name.c_str() << " did not fully take effect (low latency: "
+                            << m_latency_report.low_latency
+                            << ", latency timer: " << m_latency_report.latency_timer
+                            << " ms). The device does not support it or permissions are missing.");
+    }
+  }
+
+  m_serial_device = serial_device;
+  m_serial_line   = true;
+  return startCommunication();
+}
+
+bool SVHSerialInterface::connect(const std::shared_ptr<SVHTransport>& transport)
+{
+  SVH_TRACE_SPAN("connect", "open");
+  close();
+
+  std::string error;
+  if (!m_options.validate(error, false))
+  {
+    SVH_LOG_ERROR_STREAM("SVHSerialInterface", "Invalid transport options: " << error);
+    return false;
+  }
+
+  if (!transport || !transport->isOpen())
+  {
+    SVH_LOG_ERROR_STREAM("SVHSerialInterface", "Cannot connect to a transport that is not open");
+    return false;
+  }
+
+  // Baud rate and latency settings only apply to serial devices
+  m_latency_report = SerialLatencyReport();
+  m_serial_device  = transport;
+  m_serial_line    = false;
+  return startCommunication();
+}
+
+bool SVHSerialInterface::startCommunication()
+{
   m_svh_receiver =
-    std::make_unique<SVHReceiveThread>(std::chrono::microseconds(500),
+    std::make_unique<SVHReceiveThread>(m_options.receive_idle_period,
                                        m_serial_device,
                                        std::bind(&SVHSerialInterface::receivedPacketCallback,
                                                  this,
                                                  std::placeholders::_1,
-                                                 std::placeholders::_2));
+                                                 std::placeholders::_2),
+                                       m_options.read_buffer_size,
+                                       m_options.receive_strategy);
+  m_svh_receiver->setPacketRecorder(m_recorder);
 
-  // create receive thread
-  m_receive_thread = std::thread([this] { m_svh_receiver->run(); });
+  m_failed              = false;
+  m_stat_frames         = 0;
+  m_stat_bytes          = 0;
+  m_stat_partial_writes = 0;
+  m_stat_blocked_writes = 0;
+  m_stat_timeouts       = 0;
+  m_stat_write_errors   = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    std::fill(m_stat_priority_frames, m_stat_priority_frames + TP_DIMENSION, 0);
+    std::fill(m_stat_priority_max_latency_us, m_stat_priority_max_latency_us + TP_DIMENSION, 0);
+    std::fill(m_window_sent,
+              m_window_sent + C_PACKET_INDICES,
+              std::chrono::steady_clock::time_point());
+    m_window_count            = 0;
+    m_stat_replies            = 0;
+    m_stat_lost_replies       = 0;
+    m_stat_unexpected_replies = 0;
+    m_stat_max_round_trip_us  = 0;
+  }
+  if (m_reactor)
+  {
+    // let the shared reactor receive the data
+    int fd = m_serial_device->fileDescriptor();
+    if (fd < 0 || !m_reactor->addDescriptor(
+                    fd, [this, fd](uint32_t events) { handleDeviceEvents(fd, events); }))
+    {
+      SVH_LOG_ERROR_STREAM("SVHSerialInterface",
+                           "Could not register serial device at the reactor: "
+                             << m_serial_device->deviceName());
+      m_serial_device->close();
+      m_serial_device.reset();
+      return false;
+    }
+    m_reactor_fd = fd;
+  }
+  else
+  {
+    // create receive thread
+    m_receive_thread = std::thread([this] {
+      SVHTrace::setThreadName("svh-receive");
+      tuneReceiveThread();
+      m_svh_receiver->run();
+    });
+  }
 
   m_connected = true;
   SVH_LOG_DEBUG_STREAM("SVHSerialInterface",
                        "Serial device  "
-                         << dev_name.c_str()
-                         << " opened and receive thread started. Communication can now begin.");
+                         << m_serial_device->deviceName()
+                         << " opened and receiving started. Communication can now begin.");
 
   return true;
 }
@@ -110,6 +349,13 @@ void SVHSerialInterface::close()
 {
   m_connected = false;
 
+  // stop receiving through the reactor, this waits for a running handler
+  if (m_reactor && m_reactor_fd >= 0)
+  {
+    m_reactor->removeDescriptor(m_reactor_fd);
+    m_reactor_fd = -1;
+  }
+
   // cancel and delete receive packet thread
   if (m_svh_receiver)
   {
@@ -129,65 +375,516 @@ void SVHSerialInterface::close()
     m_serial_device.reset();
     SVH_LOG_DEBUG_STREAM("SVHSerialInterface", "Serial device handle was closed and terminated.");
   }
+
+  // Packets queued by the reactor thread are dropped with the device
+  int flush_task = -1;
+  {
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    for (TransmitRequest* request : m_posted_queue)
+    {
+      delete request;
+    }
+    m_posted_queue.clear();
+    std::swap(flush_task, m_flush_task);
+  }
+  if (m_reactor)
+  {
+    m_reactor->removeTimer(flush_task);
+  }
 }
 
 bool SVHSerialInterface::sendPacket(SVHSerialPacket& packet)
 {
-  if (m_serial_device != NULL)
+  return sendPacket(packet, transmitPriority(packet.address));
+}
+
+bool SVHSerialInterface::sendPacket(SVHSerialPacket& packet,
+                                    SVHTransmitPriority priority,
+                                    const std::chrono::microseconds& spacing)
+{
+  SVH_TRACE_SPAN_ARG("serial", "sendPacket", "address", packet.address);
+  SVH_PROBE2(send_queued, packet.address, static_cast<int>(priority));
+  // The reactor thread reads the replies of all hands, so it never waits for the device
+  const bool reactor_thread = m_reactor && m_reactor->isReactorThread();
+  std::unique_lock<std::mutex> lock(m_send_mutex);
+  // Packets of other threads wait while a group command is prepared, stops are never held back
+  if (priority != TP_EMERGENCY && !reactor_thread)
+  {
+    m_hold_cv.wait(lock,
+                   [this] { return !m_hold || m_hold_owner == std::this_thread::get_id(); });
+  }
+
+  if (m_serial_device == NULL)
+  {
+    return true;
+  }
+  if (!m_serial_device->isOpen())
   {
-    // For alignment: Always 64Byte data, padded with zeros
-    packet.data.resize(64, 0);
+    SVH_LOG_DEBUG_STREAM("SVHSerialInterface",
+                         "sendPacket failed, serial device was not properly initialized.");
+    return false;
+  }
 
-    uint8_t check_sum1 = 0;
-    uint8_t check_sum2 = 0;
+  // For alignment: Always 64Byte data, padded with zeros
+  packet.data.resize(C_MAXIMUM_PACKET_SIZE, 0);
 
-    // Calculate Checksum for the packet
-    for (size_t i = 0; i < packet.data.size(); i++)
+  if (m_hold && m_hold_owner == std::this_thread::get_id() && priority != TP_EMERGENCY)
+  {
+    packet.index = static_cast<uint8_t>(m_packets_transmitted % uint8_t(-1));
+
+    ArrayBuilder frame(packet.data.size() + C_PACKET_APPENDIX_SIZE);
+    uint8_t check_sum1;
+    uint8_t check_sum2;
+    calcCheckSum(check_sum1, check_sum2, packet);
+    frame << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+    m_held_frames.push_back(std::move(frame.array));
+    m_packets_transmitted++;
+    return true;
+  }
+
+  if (reactor_thread)
+  {
+    postPacket(lock, packet, priority, spacing);
+    return true;
+  }
+
+  // Flat combining: whoever finds the device idle writes the queued packets of all callers, the
+  // others only wait for their packet to be written. As the packet is picked right before it is
+  // written, a stop waits for at most the frame on the wire and the transmission gap.
+  TransmitRequest request = {&packet,
+                             std::chrono::steady_clock::now(),
+                             spacing,
+                             priority,
+                             m_transmit_sequence++,
+                             false,
+                             false,
+                             nullptr};
+  m_transmit_queues[priority].push_back(&request);
+  m_transmit_cv.notify_all();
+  while (!request.done)
+  {
+    if (m_transmitting)
     {
-      check_sum1 += packet.data[i];
-      check_sum2 ^= packet.data[i];
+      m_transmit_cv.wait(lock);
+      continue;
     }
 
-    // set packet counter
-    packet.index = static_cast<uint8_t>(m_packets_transmitted % uint8_t(-1));
+    m_transmitting = true;
+    writeQueuedPackets(lock, request);
+    m_transmitting = false;
+    m_transmit_cv.notify_all();
+  }
+
+  return request.success;
+}
+
+void SVHSerialInterface::writeQueuedPackets(std::unique_lock<std::mutex>& lock,
+                                            const TransmitRequest& own)
+{
+  while (!own.done)
+  {
+    // The own request stays queued until it is done, so there is always a packet
+    std::deque<TransmitRequest*>& queue = *nextQueue();
 
-    if (m_serial_device->isOpen())
+    // A packet of a higher priority queued during the wait overtakes the others
+    std::chrono::steady_clock::time_point transmission_time =
+      queuedTransmissionTime(*queue.front());
+    if (std::chrono::steady_clock::now() < transmission_time)
     {
-      // Prepare arraybuilder
-      ssize_t size = static_cast<ssize_t>(packet.data.size() + C_PACKET_APPENDIX_SIZE);
-      driver_svh::ArrayBuilder send_array(size);
-      // Write header and packet information and checksum
-      send_array << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+      m_transmit_cv.wait_until(lock, transmission_time);
+      continue;
+    }
+
+    writeQueuedPacket(lock, queue);
+  }
+}
+
+std::deque<SVHSerialInterface::TransmitRequest*>* SVHSerialInterface::nextQueue()
+{
+  std::deque<TransmitRequest*>* next = nullptr;
+  for (std::deque<TransmitRequest*>& queue : m_transmit_queues)
+  {
+    if (!queue.empty())
+    {
+      next = &queue;
+      break;
+    }
+  }
+  if (m_posted_queue.empty())
+  {
+    return next;
+  }
+  if (next == nullptr)
+  {
+    return &m_posted_queue;
+  }
 
-      // actual hardware call to send the packet
-      ssize_t bytes_send = 0;
-      while (bytes_send < size)
+  // The packets of the reactor thread keep their order like those of a blocking caller, only the
+  // first one competes with the other callers by its priority
+  const TransmitRequest* waiting = next->front();
+  const TransmitRequest* posted  = m_posted_queue.front();
+  if (posted->priority < waiting->priority ||
+      (posted->priority == waiting->priority && posted->sequence < waiting->sequence))
+  {
+    return &m_posted_queue;
+  }
+
+  // Controller states keep their order as well, a stop does not overtake an older posted enable
+  if (waiting->priority == TP_EMERGENCY)
+  {
+    for (const TransmitRequest* request : m_posted_queue)
+    {
+      if (request->priority == TP_EMERGENCY && request->sequence < waiting->sequence)
       {
-        bytes_send +=
-          m_serial_device->write(send_array.array.data() + bytes_send, size - bytes_send);
+        return &m_posted_queue;
       }
+    }
+  }
+  return next;
+}
+
+void SVHSerialInterface::writeQueuedPacket(std::unique_lock<std::mutex>& lock,
+                                           std::deque<TransmitRequest*>& queue)
+{
+  TransmitRequest* request = queue.front();
+  queue.pop_front();
+  const SVHTransmitPriority priority = request->priority;
+  SVHSerialPacket& packet            = *request->packet;
+
+  // set packet counter
+  packet.index = static_cast<uint8_t>(m_packets_transmitted % uint8_t(-1));
+
+  // Only header and checksum are packed, the payload is written straight from the packet.
+  // The checksum is the sum and the xor of all payload bytes.
+  uint16_t length   = static_cast<uint16_t>(packet.data.size());
+  uint8_t header[6] = {PACKET_HEADER1,
+                       PACKET_HEADER2,
+                       packet.index,
+                       packet.address,
+                       static_cast<uint8_t>(length & 0xFF),
+                       static_cast<uint8_t>(length >> 8)};
+  uint8_t trailer[2] = {0, 0};
+  for (uint8_t byte : packet.data)
+  {
+    trailer[0] += byte;
+    trailer[1] ^= byte;
+  }
+
+  struct iovec buffers[3];
+  buffers[0].iov_base = header;
+  buffers[0].iov_len  = sizeof(header);
+  buffers[1].iov_base = packet.data.data();
+  buffers[1].iov_len  = packet.data.size();
+  buffers[2].iov_base = trailer;
+  buffers[2].iov_len  = sizeof(trailer);
+
+  request->success = m_serial_device && m_serial_device->isOpen() &&
+                     writeFrame(lock, packet.index, buffers, 3, priority == TP_EMERGENCY);
+  request->done    = true;
+  if (request->success)
+  {
+    SVH_PROBE3(frame_tx, packet.index, packet.address, length);
+    m_packets_transmitted++;
+
+    uint64_t latency = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                            request->queued)
+        .count());
+    m_stat_priority_frames[priority]++;
+    m_stat_priority_max_latency_us[priority] =
+      std::max(m_stat_priority_max_latency_us[priority], latency);
+  }
+  if (request->posted)
+  {
+    delete request;
+  }
+  m_transmit_cv.notify_all();
+}
+
+void SVHSerialInterface::postPacket(std::unique_lock<std::mutex>& lock,
+                                    const SVHSerialPacket& packet,
+                                    SVHTransmitPriority priority,
+                                    const std::chrono::microseconds& spacing)
+{
+  TransmitRequest* request = new TransmitRequest{nullptr,
+                                                 std::chrono::steady_clock::now(),
+                                                 spacing,
+                                                 priority,
+                                                 m_transmit_sequence++,
+                                                 false,
+                                                 false,
+                                                 nullptr};
+  request->posted.reset(new SVHSerialPacket(packet));
+  request->packet = request->posted.get();
+  m_posted_queue.push_back(request);
+  m_transmit_cv.notify_all();
+
+  // A packet that is due is written right away, the others by a task of the reactor
+  writeDuePackets(lock);
+  if (!m_posted_queue.empty() && m_flush_task < 0)
+  {
+    m_flush_task = m_reactor->addTask(std::max(m_options.transmission_gap, C_MINIMUM_FLUSH_PERIOD),
+                                      [this] { return flushPostedPackets(); });
+  }
+}
+
+void SVHSerialInterface::writeDuePackets(std::unique_lock<std::mutex>& lock)
+{
+  // A thread owning the transmission writes the queued packets anyway
+  while (!m_transmitting)
+  {
+    std::deque<TransmitRequest*>* queue = nextQueue();
+    if (queue == nullptr || (m_hold && queue->front()->priority != TP_EMERGENCY) ||
+        std::chrono::steady_clock::now() < queuedTransmissionTime(*queue->front()))
+    {
+      return;
+    }
+
+    m_transmitting = true;
+    writeQueuedPacket(lock, *queue);
+    m_transmitting = false;
+    m_transmit_cv.notify_all();
+  }
+}
+
+std::chrono::steady_clock::time_point
+SVHSerialInterface::queuedTransmissionTime(const TransmitRequest& request)
+{
+  return std::max(transmissionTime(request.priority == TP_EMERGENCY),
+                  m_last_transmission + request.spacing);
+}
+
+bool SVHSerialInterface::flushPostedPackets()
+{
+  std::unique_lock<std::mutex> lock(m_send_mutex);
+  writeDuePackets(lock);
+  if (m_posted_queue.empty())
+  {
+    m_flush_task = -1;
+    return false;
+  }
+  return true;
+}
+
+bool SVHSerialInterface::writeFrame(std::unique_lock<std::mutex>& lock,
+                                    uint8_t index,
+                                    const struct iovec* buffers,
+                                    int count,
+                                    bool emergency)
+{
+  SVH_TRACE_SPAN_ARG("serial", "writeFrame", "index", index);
+  // Instead of sleeping after every frame only the next frame waits for the gap. Single commands
+  // return immediately this way and frames of different hands can be written back to back.
+  for (std::chrono::steady_clock::time_point transmission_time = transmissionTime(emergency);
+       std::chrono::steady_clock::now() < transmission_time;
+       transmission_time = transmissionTime(emergency))
+  {
+    m_transmit_cv.wait_until(lock, transmission_time);
+  }
+
+  // The copy is advanced on partial writes, the original is kept for the recorder
+  struct iovec pending[C_MAXIMUM_FRAME_BUFFERS];
+  int pending_count = std::min(count, C_MAXIMUM_FRAME_BUFFERS);
+  std::copy(buffers, buffers + pending_count, pending);
+
+  // The reply may arrive before the write returns, so the frame enters the window beforehand. A
+  // frame that reuses the index of a pending one replaces it.
+  std::chrono::steady_clock::time_point& sent = m_window_sent[index % C_PACKET_INDICES];
+  if (m_options.transmit_window > 0)
+  {
+    if (sent == std::chrono::steady_clock::time_point())
+    {
+      m_window_count++;
+    }
+    sent = std::chrono::steady_clock::now();
+  }
+
+  // Other callers queue their packets meanwhile, the transmission is owned by this thread
+  lock.unlock();
+  bool success = writeBuffers(pending, pending_count);
+  if (m_recorder)
+  {
+    m_recorder->record(CD_TRANSMIT, success ? CS_OK : CS_WRITE_FAILED, buffers, count);
+  }
+  lock.lock();
+  if (!success)
+  {
+    // No reply is coming for a frame that was not written completely
+    if (m_options.transmit_window > 0 && sent != std::chrono::steady_clock::time_point())
+    {
+      sent = std::chrono::steady_clock::time_point();
+      m_window_count--;
+    }
+    return false;
+  }
 
-      // Small delay -> THIS SHOULD NOT BE NECESSARY as the communication speed should be handable
-      // by the HW. However, it will die if this sleep is not used and this may also depend on your
-      // computer speed -> This issue might stem also from the hardware and will hopefully be fixed
-      // soon. 782µs are needed to send 72bytes via a baudrate of 921600
-      std::this_thread::sleep_for(std::chrono::microseconds(782));
-      // Instead you could wait for the response of the packet (or on of the previous n packets).
-      // This slows down the speed to the 2-way latency, which is platform dependent
+  m_stat_frames++;
+  m_last_transmission = std::chrono::steady_clock::now();
+  m_next_transmission = m_last_transmission + m_options.transmission_gap;
+  return true;
+}
+
+std::chrono::steady_clock::time_point SVHSerialInterface::transmissionTime(bool emergency)
+{
+  if (m_options.transmit_window == 0)
+  {
+    return m_next_transmission;
+  }
+
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point oldest    = std::chrono::steady_clock::time_point::max();
+  for (size_t index = 0; index < C_PACKET_INDICES && m_window_count > 0; ++index)
+  {
+    std::chrono::steady_clock::time_point& sent = m_window_sent[index];
+    if (sent == std::chrono::steady_clock::time_point())
+    {
+      continue;
+    }
+    if (now - sent >= m_options.reply_timeout)
+    {
+      // The frame or its reply was lost, the hand does not answer twice
+      sent = std::chrono::steady_clock::time_point();
+      m_window_count--;
+      m_stat_lost_replies++;
+      SVH_LOG_DEBUG_STREAM("SVHSerialInterface", "Reply to packet index " << index << " was lost");
     }
     else
     {
-      SVH_LOG_DEBUG_STREAM("SVHSerialInterface",
-                           "sendPacket failed, serial device was not properly initialized.");
+      oldest = std::min(oldest, sent);
+    }
+  }
+
+  // Stops do not wait for a free slot, the window only holds back the other traffic
+  if (emergency || m_window_count < m_options.transmit_window)
+  {
+    return m_next_transmission;
+  }
+  return std::max(m_next_transmission, oldest + m_options.reply_timeout);
+}
+
+bool SVHSerialInterface::writeBuffers(struct iovec* buffers, int count)
+{
+  // The device is non blocking. If its output buffer is full we wait until it is writable again,
+  // but only until the deadline so that a stalled device cannot block the caller forever.
+  const auto deadline = std::chrono::steady_clock::now() + m_options.write_timeout;
+  while (count > 0)
+  {
+    ssize_t bytes = m_serial_device->writev(buffers, count);
+    if (bytes > 0)
+    {
+      m_stat_bytes += bytes;
+
+      // skip everything that was written and continue with the rest
+      size_t written = static_cast<size_t>(bytes);
+      while (count > 0 && written >= buffers->iov_len)
+      {
+        written -= buffers->iov_len;
+        ++buffers;
+        --count;
+      }
+      if (count > 0)
+      {
+        buffers->iov_base = static_cast<uint8_t*>(buffers->iov_base) + written;
+        buffers->iov_len -= written;
+        m_stat_partial_writes++;
+      }
+      continue;
+    }
+
+    if (bytes < 0 && m_serial_device->status() != -EAGAIN && m_serial_device->status() != -EINTR)
+    {
+      m_stat_write_errors++;
+      SVH_LOG_ERROR_STREAM("SVHSerialInterface",
+                           "sendPacket failed, could not write to serial device: "
+                             << m_serial_device->statusText());
       return false;
     }
 
-    m_packets_transmitted++;
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+      deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0)
+    {
+      m_stat_timeouts++;
+      SVH_LOG_ERROR_STREAM("SVHSerialInterface",
+                           "sendPacket failed, serial device did not take the packet within "
+                             << m_options.write_timeout.count() << "us");
+      return false;
+    }
+    m_stat_blocked_writes++;
+    if (m_serial_device->waitWritable(remaining.count()) < 0)
+    {
+      m_stat_write_errors++;
+      SVH_LOG_ERROR_STREAM("SVHSerialInterface",
+                           "sendPacket failed, could not wait for serial device: "
+                             << m_serial_device->statusText());
+      return false;
+    }
   }
 
   return true;
 }
 
+void SVHSerialInterface::holdTransmission()
+{
+  std::lock_guard<std::mutex> lock(m_send_mutex);
+  m_hold       = true;
+  m_hold_owner = std::this_thread::get_id();
+}
+
+size_t SVHSerialInterface::heldPacketCount()
+{
+  std::lock_guard<std::mutex> lock(m_send_mutex);
+  return m_held_frames.size();
+}
+
+std::chrono::steady_clock::time_point SVHSerialInterface::nextTransmissionTime()
+{
+  std::lock_guard<std::mutex> lock(m_send_mutex);
+  return transmissionTime();
+}
+
+bool SVHSerialInterface::releaseHeldPacket(std::chrono::steady_clock::time_point& written)
+{
+  std::unique_lock<std::mutex> lock(m_send_mutex);
+  m_transmit_cv.wait(lock, [this] { return !m_transmitting; });
+  if (m_held_frames.empty())
+  {
+    return false;
+  }
+
+  m_transmitting             = true;
+  std::vector<uint8_t> frame = std::move(m_held_frames.front());
+  m_held_frames.pop_front();
+
+  struct iovec buffer;
+  buffer.iov_base = frame.data();
+  buffer.iov_len  = frame.size();
+
+  bool success = m_serial_device && m_serial_device->isOpen() &&
+                 writeFrame(lock, frame[2], &buffer, 1, false);
+  written        = std::chrono::steady_clock::now();
+  m_transmitting = false;
+  m_transmit_cv.notify_all();
+  return success;
+}
+
+bool SVHSerialInterface::releaseTransmission()
+{
+  bool success = true;
+  std::chrono::steady_clock::time_point written;
+  while (heldPacketCount() > 0)
+  {
+    success = releaseHeldPacket(written) && success;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    m_hold = false;
+  }
+  m_hold_cv.notify_all();
+  return success;
+}
+
 void SVHSerialInterface::resetTransmitPackageCount()
 {
   m_packets_transmitted = 0;
@@ -195,17 +892,44 @@ void SVHSerialInterface::resetTransmitPackageCount()
   m_svh_receiver->resetReceivedPackageCount();
 }
 
-void SVHSerialInterface::printPacketOnConsole(SVHSerialPacket& packet)
+SVHReceiveStatistics SVHSerialInterface::receiveStatistics()
 {
-  uint8_t check_sum1 = 0;
-  uint8_t check_sum2 = 0;
-
-  // Calculate Checksum for the packet
-  for (size_t i = 0; i < packet.data.size(); i++)
+  if (m_svh_receiver)
   {
-    check_sum1 += packet.data[i];
-    check_sum2 ^= packet.data[i];
+    return m_svh_receiver->statistics();
   }
+  return SVHReceiveStatistics();
+}
+
+SVHTransmitStatistics SVHSerialInterface::transmitStatistics()
+{
+  SVHTransmitStatistics statistics;
+  statistics.frames         = m_stat_frames;
+  statistics.bytes          = m_stat_bytes;
+  statistics.partial_writes = m_stat_partial_writes;
+  statistics.blocked_writes = m_stat_blocked_writes;
+  statistics.timeouts       = m_stat_timeouts;
+  statistics.write_errors   = m_stat_write_errors;
+
+  std::lock_guard<std::mutex> lock(m_send_mutex);
+  statistics.replies            = m_stat_replies;
+  statistics.lost_replies       = m_stat_lost_replies;
+  statistics.unexpected_replies = m_stat_unexpected_replies;
+  statistics.max_round_trip_us  = m_stat_max_round_trip_us;
+  std::copy(
+    m_stat_priority_frames, m_stat_priority_frames + TP_DIMENSION, statistics.priority_frames);
+  std::copy(m_stat_priority_max_latency_us,
+            m_stat_priority_max_latency_us + TP_DIMENSION,
+            statistics.priority_max_latency_us);
+  return statistics;
+}
+
+void SVHSerialInterface::printPacketOnConsole(SVHSerialPacket& packet)
+{
+  // Calculate Checksum for the packet
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, packet);
 
   // set packet counter
   packet.index = static_cast<uint8_t>(m_dummy_packets_printed % uint8_t(-1));
@@ -222,10 +946,82 @@ void SVHSerialInterface::printPacketOnConsole(SVHSerialPacket& packet)
   m_dummy_packets_printed++;
 }
 
+void SVHSerialInterface::tuneReceiveThread()
+{
+#ifdef _SYSTEM_LINUX_
+  // Both need privileges that are often missing, receiving works without them anyway
+  if (m_options.receive_thread_priority > 0)
+  {
+    sched_param parameters;
+    parameters.sched_priority = m_options.receive_thread_priority;
+    int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+    if (result != 0)
+    {
+      SVH_LOG_WARN_STREAM("SVHSerialInterface",
+                          "Could not set the receive thread priority to "
+                            << m_options.receive_thread_priority << ": " << strerror(result));
+    }
+  }
+  if (m_options.receive_thread_cpu >= 0)
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(m_options.receive_thread_cpu, &cpus);
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (result != 0)
+    {
+      SVH_LOG_WARN_STREAM("SVHSerialInterface",
+                          "Could not pin the receive thread to cpu "
+                            << m_options.receive_thread_cpu << ": " << strerror(result));
+    }
+  }
+#endif
+}
+
+void SVHSerialInterface::handleDeviceEvents(int fd, uint32_t events)
+{
+  // Process what is left in the buffers even if the device was hung up
+  bool read_ok = m_svh_receiver->receiveAvailableData();
+  if (!read_ok || (events & SVHReactor::EV_HANGUP))
+  {
+    // Stop listening so that the reactor does not spin on the broken device. Other devices
+    // serviced by the same reactor are not affected.
+    m_failed = true;
+    m_reactor->removeDescriptor(fd);
+    SVH_LOG_ERROR_STREAM("SVHSerialInterface",
+                         "Serial device " << m_serial_device->deviceName()
+                                          << " failed and is no longer read. Reconnect it.");
+  }
+}
+
 void SVHSerialInterface::receivedPacketCallback(const SVHSerialPacket& packet,
                                                 unsigned int packet_count)
 {
   m_last_index = packet.index;
+
+  if (m_options.transmit_window > 0)
+  {
+    // Each reply frees the slot of its frame in the transmit window
+    std::lock_guard<std::mutex> lock(m_send_mutex);
+    std::chrono::steady_clock::time_point& sent = m_window_sent[packet.index % C_PACKET_INDICES];
+    if (sent != std::chrono::steady_clock::time_point())
+    {
+      uint64_t round_trip = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                              sent)
+          .count());
+      m_stat_max_round_trip_us = std::max(m_stat_max_round_trip_us, round_trip);
+      m_stat_replies++;
+      sent = std::chrono::steady_clock::time_point();
+      m_window_count--;
+      m_transmit_cv.notify_all();
+    }
+    else
+    {
+      m_stat_unexpected_replies++;
+    }
+  }
+
   m_received_packet_callback(packet, packet_count);
 }
 
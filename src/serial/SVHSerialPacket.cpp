@@ -67,4 +67,16 @@ std::ostream& operator<<(std::ostream& o, const SVHSerialPacket& sp)
   return o;
 }
 
+void calcCheckSum(uint8_t& check_sum1, uint8_t& check_sum2, const SVHSerialPacket& packet)
+{
+  check_sum1 = 0;
+  check_sum2 = 0;
+
+  for (size_t i = 0; i < packet.data.size(); i++)
+  {
+    check_sum1 += packet.data[i];
+    check_sum2 ^= packet.data[i];
+  }
+}
+
 } // namespace driver_svh
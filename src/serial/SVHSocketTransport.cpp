@@ -0,0 +1,391 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/serial/SVHSocketTransport.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifdef _SYSTEM_LINUX_
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+namespace driver_svh {
+
+namespace {
+
+#ifdef _SYSTEM_LINUX_
+//! Fills the socket address of \a path, returns false if the path is too long
+bool socketAddress(const std::string& path, sockaddr_un& address)
+{
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path))
+  {
+    return false;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size());
+  return true;
+}
+
+//! Switches a descriptor to non blocking mode
+bool setNonBlocking(int fd)
+{
+  int flags = fcntl(fd, F_GETFL);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+} // namespace
+
+SVHSocketTransport::SVHSocketTransport()
+  : m_file_descr(-1)
+  , m_status(0)
+  , m_name("socket")
+{
+}
+
+SVHSocketTransport::~SVHSocketTransport()
+{
+  close();
+}
+
+void SVHSocketTransport::attach(int fd, const std::string& name)
+{
+#ifdef _SYSTEM_LINUX_
+  if (!setNonBlocking(fd))
+  {
+    m_status = -errno;
+    ::close(fd);
+    return;
+  }
+#endif
+  m_name       = name;
+  m_status     = 0;
+  m_file_descr = fd;
+}
+
+bool SVHSocketTransport::connect(const std::string& path)
+{
+  close();
+
+#ifdef _SYSTEM_LINUX_
+  sockaddr_un address;
+  if (!socketAddress(path, address))
+  {
+    m_status = -ENAMETOOLONG;
+    SVH_LOG_ERROR_STREAM("SVHSocketTransport", "Invalid socket path: " << path);
+    return false;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+  {
+    m_status = -errno;
+    SVH_LOG_ERROR_STREAM("SVHSocketTransport",
+                         "Could not connect to " << path << ": " << strerror(-m_status));
+    if (fd >= 0)
+    {
+      ::close(fd);
+    }
+    return false;
+  }
+
+  attach(fd, path);
+  return isOpen();
+#else
+  m_status = -ENOSYS;
+  return false;
+#endif
+}
+
+bool SVHSocketTransport::accept(const std::string& path, unsigned long time)
+{
+  close();
+
+#ifdef _SYSTEM_LINUX_
+  sockaddr_un address;
+  if (!socketAddress(path, address))
+  {
+    m_status = -ENAMETOOLONG;
+    SVH_LOG_ERROR_STREAM("SVHSocketTransport", "Invalid socket path: " << path);
+    return false;
+  }
+
+  int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listener < 0)
+  {
+    m_status = -errno;
+    return false;
+  }
+
+  ::unlink(path.c_str());
+  int fd = -1;
+  if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+      listen(listener, 1) == 0)
+  {
+    struct pollfd descriptor;
+    descriptor.fd     = listener;
+    descriptor.events = POLLIN;
+
+    struct timespec timeout;
+    timeout.tv_sec  = time / 1000000;
+    timeout.tv_nsec = (time % 1000000) * 1000;
+
+    int result = ::ppoll(&descriptor, 1, &timeout, NULL);
+    if (result > 0)
+    {
+      fd = ::accept4(listener, NULL, NULL, SOCK_CLOEXEC);
+    }
+    m_status = result == 0 ? -ETIMEDOUT : (fd < 0 ? -errno : 0);
+  }
+  else
+  {
+    m_status = -errno;
+  }
+
+  ::close(listener);
+  ::unlink(path.c_str());
+
+  if (fd < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHSocketTransport",
+                         "No peer connected to " << path << ": " << statusText());
+    return false;
+  }
+
+  attach(fd, path);
+  return isOpen();
+#else
+  (void)time;
+  m_status = -ENOSYS;
+  return false;
+#endif
+}
+
+bool SVHSocketTransport::createPair(std::shared_ptr<SVHSocketTransport>& first,
+                                    std::shared_ptr<SVHSocketTransport>& second)
+{
+#ifdef _SYSTEM_LINUX_
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHSocketTransport",
+                         "Could not create a socket pair: " << strerror(errno));
+    return false;
+  }
+
+  first  = std::make_shared<SVHSocketTransport>();
+  second = std::make_shared<SVHSocketTransport>();
+  first->attach(fds[0], "socketpair:0");
+  second->attach(fds[1], "socketpair:1");
+  return first->isOpen() && second->isOpen();
+#else
+  return false;
+#endif
+}
+
+void SVHSocketTransport::close()
+{
+#ifdef _SYSTEM_LINUX_
+  int fd = m_file_descr.exchange(-1);
+  if (fd >= 0)
+  {
+    ::close(fd);
+  }
+#endif
+}
+
+ssize_t SVHSocketTransport::read(void* data,
+                                 ssize_t size,
+                                 unsigned long time,
+                                 bool return_on_less_data)
+{
+#ifdef _SYSTEM_LINUX_
+  const int fd = m_file_descr;
+  if (fd < 0)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+
+  const auto end_time = std::chrono::steady_clock::now() + std::chrono::microseconds(time);
+  char* buffer        = static_cast<char*>(data);
+  ssize_t bytes_read  = 0;
+  m_status            = 0;
+
+  while (bytes_read < size)
+  {
+    ssize_t bytes = ::recv(fd, buffer + bytes_read, static_cast<size_t>(size - bytes_read), 0);
+    if (bytes > 0)
+    {
+      bytes_read += bytes;
+      if (return_on_less_data)
+      {
+        break;
+      }
+      continue;
+    }
+    if (bytes == 0)
+    {
+      // The peer closed the connection, what was read before is still returned
+      if (bytes_read == 0)
+      {
+        m_status = -EPIPE;
+        return m_status;
+      }
+      break;
+    }
+    if (errno != EAGAIN && errno != EINTR)
+    {
+      m_status = -errno;
+      SVH_LOG_DEBUG_STREAM("SVHSocketTransport",
+                           "Error on reading '" << m_name << "'. Status (" << m_status << ":"
+                                                << strerror(-m_status) << ")");
+      return m_status;
+    }
+
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+      end_time - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0 || waitForEvents(POLLIN, remaining.count()) < 0)
+    {
+      break;
+    }
+  }
+
+  return bytes_read;
+#else
+  return -1;
+#endif
+}
+
+ssize_t SVHSocketTransport::writev(const struct iovec* buffers, int count)
+{
+#ifdef _SYSTEM_LINUX_
+  const int fd = m_file_descr;
+  if (fd < 0)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+
+  // sendmsg instead of writev, as writing to a closed peer must not raise SIGPIPE
+  struct msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_iov    = const_cast<struct iovec*>(buffers);
+  message.msg_iovlen = static_cast<size_t>(count);
+
+  ssize_t bytes_out = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+  if (bytes_out < 0)
+  {
+    m_status = -errno;
+    if (m_status != -EAGAIN)
+    {
+      SVH_LOG_DEBUG_STREAM("SVHSocketTransport",
+                           "Error on writing '" << m_name << "'. Status (" << m_status << ":"
+                                                << strerror(-m_status) << ")");
+    }
+    return m_status;
+  }
+
+  m_status = 0;
+  return bytes_out;
+#else
+  return -1;
+#endif
+}
+
+int SVHSocketTransport::waitWritable(unsigned long time)
+{
+#ifdef _SYSTEM_LINUX_
+  return waitForEvents(POLLOUT, time);
+#else
+  return -1;
+#endif
+}
+
+int SVHSocketTransport::waitReadable(unsigned long time)
+{
+#ifdef _SYSTEM_LINUX_
+  return waitForEvents(POLLIN, time);
+#else
+  return -1;
+#endif
+}
+
+int SVHSocketTransport::waitForEvents(int events, unsigned long time)
+{
+#ifdef _SYSTEM_LINUX_
+  const int fd = m_file_descr;
+  if (fd < 0)
+  {
+    m_status = -EBADF;
+    return m_status;
+  }
+
+  struct pollfd descriptor;
+  descriptor.fd     = fd;
+  descriptor.events = static_cast<short>(events);
+
+  struct timespec timeout;
+  timeout.tv_sec  = time / 1000000;
+  timeout.tv_nsec = (time % 1000000) * 1000;
+
+  int result = ::ppoll(&descriptor, 1, &timeout, NULL);
+  if (result < 0)
+  {
+    m_status = -errno;
+    return m_status;
+  }
+  // Data that arrived before a hangup can still be read
+  if (result > 0 && !(descriptor.revents & events) &&
+      (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)))
+  {
+    m_status = -EIO;
+    return m_status;
+  }
+
+  m_status = 0;
+  return result;
+#else
+  return -1;
+#endif
+}
+
+std::string SVHSocketTransport::statusText() const
+{
+  return strerror(-m_status);
+}
+
+} // namespace driver_svh
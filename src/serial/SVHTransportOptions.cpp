@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+#include <schunk_svh_library/serial/SVHTransportOptions.h>
+
+#include <sstream>
+#include <thread>
+
+namespace driver_svh {
+
+bool SVHTransportOptions::validate(std::string& error, bool serial_line) const
+{
+  std::ostringstream message;
+
+  // Sending a frame takes ten bits per byte with start and stop bit
+  const std::chrono::microseconds frame_time(
+    serial_line && baud_rate > 0
+      ? SVHFrameDecoder::C_MAXIMUM_FRAME_SIZE * 10 * 1000000 / baud_rate
+      : 0);
+
+  if (baud_rate == 0 || baud_rate > 12000000)
+  {
+    message << "baud rate " << baud_rate << " is not within 1 and 12000000";
+  }
+  else if (receive_idle_period.count() <= 0 || receive_idle_period > std::chrono::seconds(1))
+  {
+    message << "receive idle period of " << receive_idle_period.count()
+            << "us is not within 1us and 1s";
+  }
+  else if (read_buffer_size < SVHFrameDecoder::C_MAXIMUM_FRAME_SIZE || read_buffer_size > 65536)
+  {
+    message << "read buffer size " << read_buffer_size << " is not within "
+            << SVHFrameDecoder::C_MAXIMUM_FRAME_SIZE << " and 65536";
+  }
+  else if (transmission_gap < frame_time)
+  {
+    message << "transmission gap of " << transmission_gap.count()
+            << "us is shorter than sending a frame at " << baud_rate << " bit/s ("
+            << frame_time.count() << "us)";
+  }
+  else if (write_timeout < frame_time || write_timeout > std::chrono::seconds(1))
+  {
+    message << "write timeout of " << write_timeout.count() << "us is not within "
+            << frame_time.count() << "us and 1s";
+  }
+  else if (transmit_window > 254)
+  {
+    message << "transmit window of " << transmit_window << " frames is not within 0 and 254";
+  }
+  else if (transmit_window > 0 &&
+           (reply_timeout.count() <= 0 || reply_timeout > std::chrono::seconds(1)))
+  {
+    message << "reply timeout of " << reply_timeout.count() << "us is not within 1us and 1s";
+  }
+  else if (receive_thread_priority < 0 || receive_thread_priority > 99)
+  {
+    message << "receive thread priority " << receive_thread_priority << " is not within 0 and 99";
+  }
+  else if (receive_thread_cpu < -1 ||
+           receive_thread_cpu >= static_cast<int>(std::thread::hardware_concurrency()))
+  {
+    message << "receive thread cpu " << receive_thread_cpu << " does not exist";
+  }
+  else if (latency.latency_timer < 0 || latency.latency_timer > 255)
+  {
+    message << "latency timer of " << latency.latency_timer << "ms is not within 0 and 255";
+  }
+
+  error = message.str();
+  return error.empty();
+}
+
+} // namespace driver_svh
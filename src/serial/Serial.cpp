@@ -48,8 +48,14 @@
 #ifdef _SYSTEM_LINUX_
 #  include <errno.h>
 #  include <fcntl.h>
+#  include <fstream>
+#  include <linux/serial.h>
+#  include <limits.h>
+#  include <poll.h>
 #  include <stdio.h>
+#  include <stdlib.h>
 #  include <string.h>
+#  include <sys/ioctl.h>
 #  include <sys/time.h>
 #endif
 
@@ -67,6 +73,51 @@
 namespace driver_svh {
 namespace serial {
 
+#if defined _SYSTEM_LINUX_
+namespace {
+
+#  ifdef TCGETS2
+// struct termios2 of the kernel, which cannot be included together with termios.h. Its requests
+// allow baud rates that have no termios constant.
+struct KernelTermios2
+{
+  tcflag_t c_iflag;
+  tcflag_t c_oflag;
+  tcflag_t c_cflag;
+  tcflag_t c_lflag;
+  cc_t c_line;
+  cc_t c_cc[19];
+  speed_t c_ispeed;
+  speed_t c_ospeed;
+};
+const unsigned long C_TCGETS2 = _IOR('T', 0x2A, KernelTermios2);
+const unsigned long C_TCSETS2 = _IOW('T', 0x2B, KernelTermios2);
+const tcflag_t C_BOTHER       = 0010000;
+#  endif
+
+//! Find the latency timer attribute of the USB serial adapter behind \a dev_name below \a root
+std::string latencyTimerPath(const char* dev_name, const std::string& root)
+{
+  // Resolve links like /dev/serial/by-id/... to the actual device node
+  char resolved[PATH_MAX];
+  std::string device = realpath(dev_name, resolved) != NULL ? resolved : dev_name;
+  std::string name   = device.substr(device.rfind('/') + 1);
+
+  const std::string candidates[] = {root + "/bus/usb-serial/devices/" + name + "/latency_timer",
+                                    root + "/class/tty/" + name + "/device/latency_timer"};
+  for (const std::string& candidate : candidates)
+  {
+    if (access(candidate.c_str(), F_OK) == 0)
+    {
+      return candidate;
+    }
+  }
+  return std::string();
+}
+
+} // namespace
+#endif
+
 Serial::Serial(const char* dev_name, const SerialFlags& flags)
   : m_dev_name(strdup(dev_name))
   , m_serial_flags(flags)
@@ -489,6 +540,222 @@ ssize_t Serial::write(const void* data, ssize_t size)
 #endif
 }
 
+ssize_t Serial::writev(const struct iovec* buffers, int count)
+{
+#if defined _SYSTEM_LINUX_
+  if (m_file_descr < 0)
+    return m_status;
+
+  ssize_t bytes_out = ::writev(m_file_descr, buffers, count);
+  if (bytes_out < 0)
+  {
+    m_status = -errno;
+    // A full output buffer is expected with a non blocking device, see waitWritable()
+    if (m_status != -EAGAIN)
+    {
+      SVH_LOG_DEBUG_STREAM("Serial",
+                           "Serial(" << m_dev_name << "): Error on writing. Status (" << m_status
+                                     << ":" << strerror(-m_status) << ").");
+    }
+  }
+  else
+  {
+    m_status = 0;
+  }
+
+  return bytes_out;
+
+#elif defined _SYSTEM_WIN32_
+
+  ssize_t bytes_out = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    ssize_t bytes = write(buffers[i].iov_base, buffers[i].iov_len);
+    if (bytes < 0)
+    {
+      return bytes_out > 0 ? bytes_out : bytes;
+    }
+    bytes_out += bytes;
+    if (bytes < static_cast<ssize_t>(buffers[i].iov_len))
+    {
+      break;
+    }
+  }
+  return bytes_out;
+
+#else
+  return -1;
+#endif
+}
+
+int Serial::waitWritable(unsigned long time)
+{
+#if defined _SYSTEM_LINUX_
+  return waitForEvents(POLLOUT, time);
+#elif defined _SYSTEM_WIN32_
+  // Writes block on windows, so the device is always considered writable
+  return 1;
+#else
+  return -1;
+#endif
+}
+
+int Serial::waitReadable(unsigned long time)
+{
+#if defined _SYSTEM_LINUX_
+  return waitForEvents(POLLIN, time);
+#else
+  return -1;
+#endif
+}
+
+int Serial::waitForEvents(int events, unsigned long time)
+{
+#if defined _SYSTEM_LINUX_
+  if (m_file_descr < 0)
+    return m_status;
+
+  struct pollfd descriptor;
+  descriptor.fd     = m_file_descr;
+  descriptor.events = static_cast<short>(events);
+
+  struct timespec timeout;
+  timeout.tv_sec  = time / 1000000;
+  timeout.tv_nsec = (time % 1000000) * 1000;
+
+  int result = ::ppoll(&descriptor, 1, &timeout, NULL);
+  if (result < 0)
+  {
+    m_status = -errno;
+    return m_status;
+  }
+  // Data that arrived before a hangup can still be read
+  if (result > 0 && !(descriptor.revents & events) &&
+      (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)))
+  {
+    m_status = -EIO;
+    return m_status;
+  }
+
+  m_status = 0;
+  return result;
+#else
+  return -1;
+#endif
+}
+
+int Serial::setCustomBaudrate(unsigned int baud_rate)
+{
+#if defined _SYSTEM_LINUX_ && defined TCGETS2
+  if (m_file_descr < 0)
+    return m_status;
+
+  KernelTermios2 io_set;
+  if (ioctl(m_file_descr, C_TCGETS2, &io_set) < 0)
+  {
+    m_status = -errno;
+    SVH_LOG_DEBUG_STREAM("Serial",
+                         "Serial(" << m_dev_name << "): Error>> TCGETS2 failed. Status ("
+                                   << m_status << ":" << strerror(-m_status));
+    return m_status;
+  }
+
+  // Input and output use the same rate if no input rate is given
+  io_set.c_cflag &= ~(CBAUD | CIBAUD);
+  io_set.c_cflag |= C_BOTHER;
+  io_set.c_ispeed = baud_rate;
+  io_set.c_ospeed = baud_rate;
+  if (ioctl(m_file_descr, C_TCSETS2, &io_set) < 0 || ioctl(m_file_descr, C_TCGETS2, &io_set) < 0)
+  {
+    m_status = -errno;
+    SVH_LOG_DEBUG_STREAM("Serial",
+                         "Serial(" << m_dev_name << "): Error>> TCSETS2 failed. Status ("
+                                   << m_status << ":" << strerror(-m_status));
+    return m_status;
+  }
+
+  // The driver reports the rate the adapter actually uses. A deviation of more than 2% garbles
+  // the communication.
+  unsigned int deviation = io_set.c_ospeed > baud_rate ? io_set.c_ospeed - baud_rate
+                                                       : baud_rate - io_set.c_ospeed;
+  if (deviation > baud_rate / 50)
+  {
+    m_status = -EINVAL;
+    SVH_LOG_DEBUG_STREAM("Serial",
+                         "Serial(" << m_dev_name << "): Adapter uses " << io_set.c_ospeed
+                                   << " bit/s instead of " << baud_rate << " bit/s.");
+    return m_status;
+  }
+
+  m_status = 0;
+  return 0;
+#else
+  SVH_LOG_WARN_STREAM("Serial", "Serial:setCustomBaudrate() >> not supported on this system");
+  return -1;
+#endif
+}
+
+SerialLatencyReport Serial::tuneLatency(const SerialLatencySettings& settings)
+{
+  SerialLatencyReport report;
+#if defined _SYSTEM_LINUX_
+  if (m_file_descr < 0)
+    return report;
+
+  struct serial_struct serial_info;
+  if (ioctl(m_file_descr, TIOCGSERIAL, &serial_info) == 0)
+  {
+    if (settings.low_latency && !(serial_info.flags & ASYNC_LOW_LATENCY))
+    {
+      serial_info.flags |= ASYNC_LOW_LATENCY;
+      if (ioctl(m_file_descr, TIOCSSERIAL, &serial_info) < 0)
+      {
+        SVH_LOG_DEBUG_STREAM("Serial",
+                             "Serial(" << m_dev_name << "): Cannot set ASYNC_LOW_LATENCY ("
+                                       << strerror(errno) << ").");
+      }
+      // read back what the driver actually did
+      if (ioctl(m_file_descr, TIOCGSERIAL, &serial_info) < 0)
+      {
+        serial_info.flags = 0;
+      }
+    }
+    report.low_latency = (serial_info.flags & ASYNC_LOW_LATENCY) != 0;
+  }
+  else
+  {
+    SVH_LOG_DEBUG_STREAM("Serial",
+                         "Serial(" << m_dev_name << "): Device does not support TIOCGSERIAL ("
+                                   << strerror(errno) << ").");
+  }
+
+  report.latency_timer_path = latencyTimerPath(m_dev_name, settings.sysfs_root);
+  if (!report.latency_timer_path.empty())
+  {
+    if (settings.latency_timer > 0)
+    {
+      std::ofstream timer_out(report.latency_timer_path.c_str());
+      timer_out << settings.latency_timer << std::endl;
+      if (!timer_out)
+      {
+        SVH_LOG_DEBUG_STREAM("Serial",
+                             "Serial(" << m_dev_name << "): Cannot write "
+                                       << report.latency_timer_path << ".");
+      }
+    }
+    std::ifstream timer_in(report.latency_timer_path.c_str());
+    if (!(timer_in >> report.latency_timer))
+    {
+      report.latency_timer = -1;
+    }
+  }
+
+  report.applied = (!settings.low_latency || report.low_latency) &&
+                   (settings.latency_timer <= 0 || report.latency_timer == settings.latency_timer);
+#endif
+  return report;
+}
+
 ssize_t Serial::read(void* data, ssize_t size, unsigned long time, bool return_on_less_data)
 {
   // tTime end_time = tTime().FutureUSec(time);
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHAwaitable.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHAwaitable)
+
+namespace {
+
+//! Outcome of the startup coroutine as seen by the test thread
+struct Startup
+{
+  std::atomic<bool> connected{false};
+  std::atomic<bool> homed{false};
+  std::atomic<bool> settings_echoed{false};
+  std::atomic<uint16_t> firmware_major{0};
+  std::atomic<bool> finished{false};
+};
+
+//! Connects, homes and configures a hand step by step without blocking a thread
+SVHTask startHand(SVHFingerManager& manager,
+                  std::shared_ptr<SVHTransport> transport,
+                  Startup& startup)
+{
+  SVHAsyncResult<bool> connected = co_await asyncConnect(manager, transport);
+  startup.connected              = connected.success;
+  if (connected.success)
+  {
+    startup.homed = (co_await asyncResetChannel(manager, SVH_FINGER_SPREAD)).success;
+
+    SVHAsyncResult<SVHFirmwareInfo> firmware = co_await asyncFirmwareInfo(manager);
+    startup.firmware_major                   = firmware.value.version_major;
+
+    SVHPositionSettings settings = manager.getDefaultPositionSettings(false)[SVH_FINGER_SPREAD];
+    settings.wmx                 = 1000.0f;
+    SVHAsyncResult<SVHPositionSettings> echo =
+      co_await asyncSetPositionSettings(manager, SVH_FINGER_SPREAD, settings);
+    startup.settings_echoed = echo.success && echo.value.wmx == settings.wmx;
+  }
+  startup.finished = true;
+}
+
+std::vector<bool> spreadOnly()
+{
+  std::vector<bool> disable_mask(SVH_DIMENSION, true);
+  disable_mask[SVH_FINGER_SPREAD] = false;
+  return disable_mask;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(CoroutineDrivesTheStartupSequence)
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  SVHSimulator simulator(settings);
+  std::shared_ptr<SVHPipeTransport> library_end;
+  std::shared_ptr<SVHPipeTransport> hand_end;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+  BOOST_REQUIRE(simulator.start(hand_end));
+
+  auto reactor = std::make_shared<SVHReactor>();
+  BOOST_REQUIRE(reactor->start());
+  SVHFingerManager manager(spreadOnly());
+  manager.setReactor(reactor);
+
+  Startup startup;
+  startHand(manager, library_end, startup);
+  // The coroutine suspended at the first operation and is resumed by the reactor
+  BOOST_CHECK(!startup.finished);
+
+  auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!startup.finished && std::chrono::steady_clock::now() < end_time)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  BOOST_REQUIRE(startup.finished);
+  BOOST_CHECK(startup.connected);
+  BOOST_CHECK(startup.homed);
+  BOOST_CHECK_EQUAL(startup.firmware_major, 1);
+  BOOST_CHECK(startup.settings_echoed);
+
+  manager.disconnect();
+  simulator.stop();
+}
+
+BOOST_AUTO_TEST_CASE(OperationsThatCannotStartDoNotSuspend)
+{
+  // Without a reactor the first operation fails right away
+  SVHFingerManager manager(spreadOnly());
+  std::shared_ptr<SVHPipeTransport> library_end;
+  std::shared_ptr<SVHPipeTransport> hand_end;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+
+  Startup startup;
+  startHand(manager, library_end, startup);
+  BOOST_CHECK(startup.finished);
+  BOOST_CHECK(!startup.connected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHAsync)
+
+namespace {
+
+//! Polls the condition until it holds or the timeout expires
+template <typename Condition>
+bool waitFor(Condition condition, const std::chrono::milliseconds& timeout)
+{
+  auto end_time = std::chrono::steady_clock::now() + timeout;
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > end_time)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+//! Completion of one asynchronous operation as seen by the test thread
+struct Completion
+{
+  std::atomic<unsigned int> calls{0};
+  std::atomic<bool> success{false};
+  std::atomic<bool> in_reactor_thread{false};
+
+  SVHAsyncCallback callback(const std::shared_ptr<SVHReactor>& reactor)
+  {
+    return [this, reactor](bool result) {
+      in_reactor_thread = reactor->isReactorThread();
+      success           = result;
+      calls++;
+    };
+  }
+
+  bool wait() { return waitFor([this] { return calls > 0; }, std::chrono::milliseconds(10000)); }
+};
+
+//! Finger manager on a reactor with a simulated hand, only the finger spread is used
+struct AsyncHand
+{
+  AsyncHand(double speed_scale = 50)
+    : reactor(std::make_shared<SVHReactor>())
+    , manager(disableMask())
+  {
+    settings.speed_scale = speed_scale;
+    simulator.reset(new SVHSimulator(settings));
+
+    std::shared_ptr<SVHPipeTransport> hand_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+    BOOST_REQUIRE(simulator->start(hand_end));
+    BOOST_REQUIRE(reactor->start());
+    manager.setReactor(reactor);
+  }
+
+  ~AsyncHand()
+  {
+    manager.disconnect();
+    simulator->stop();
+  }
+
+  void connect()
+  {
+    Completion connected;
+    BOOST_REQUIRE(manager.connectAsync(library_end, connected.callback(reactor)));
+    BOOST_REQUIRE(connected.wait());
+    BOOST_REQUIRE(connected.success);
+  }
+
+  static std::vector<bool> disableMask()
+  {
+    std::vector<bool> disable_mask(SVH_DIMENSION, true);
+    disable_mask[SVH_FINGER_SPREAD] = false;
+    return disable_mask;
+  }
+
+  SVHSimulatorSettings settings;
+  std::unique_ptr<SVHSimulator> simulator;
+  std::shared_ptr<SVHPipeTransport> library_end;
+  std::shared_ptr<SVHReactor> reactor;
+  SVHFingerManager manager;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ConnectAndResetWithoutBlocking)
+{
+  AsyncHand hand;
+
+  Completion connected;
+  BOOST_REQUIRE(hand.manager.connectAsync(hand.library_end, connected.callback(hand.reactor)));
+  // The attempt is still running in the reactor thread
+  BOOST_CHECK(!hand.manager.isConnected());
+  BOOST_CHECK_EQUAL(hand.manager.pendingAsyncOperations(), 1u);
+  BOOST_REQUIRE(connected.wait());
+  BOOST_CHECK(connected.success);
+  BOOST_CHECK(connected.in_reactor_thread);
+  BOOST_CHECK(hand.manager.isConnected());
+
+  Completion homed;
+  BOOST_REQUIRE(hand.manager.resetChannelAsync(SVH_ALL, homed.callback(hand.reactor)));
+  BOOST_CHECK(homed.wait());
+  BOOST_CHECK(homed.success);
+  BOOST_CHECK(hand.manager.isHomed(SVH_ALL));
+  BOOST_CHECK_EQUAL(hand.manager.faultedMask(), 0u);
+
+  BOOST_CHECK(waitFor([&] { return hand.manager.pendingAsyncOperations() == 0; },
+                      std::chrono::milliseconds(1000)));
+  BOOST_CHECK_EQUAL(connected.calls, 1u);
+  BOOST_CHECK_EQUAL(homed.calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(StepsDoNotWaitForTheTransmitWindow)
+{
+  AsyncHand hand;
+  SVHTransportOptions options;
+  options.transmit_window = 1;
+  hand.manager.setTransportOptions(options);
+
+  // Measures how long the reactor thread was kept from servicing its timers
+  std::atomic<int64_t> longest_stall_us{0};
+  auto last_call = std::make_shared<std::chrono::steady_clock::time_point>();
+
+  int timer = hand.reactor->addTimer(std::chrono::milliseconds(1), [&longest_stall_us, last_call] {
+    const auto now = std::chrono::steady_clock::now();
+    if (*last_call != std::chrono::steady_clock::time_point())
+    {
+      int64_t stall =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - *last_call).count();
+      longest_stall_us = std::max(longest_stall_us.load(), stall);
+    }
+    *last_call = now;
+  });
+  BOOST_REQUIRE(timer >= 0);
+
+  // The steps send several packets each, the replies are read by the same thread
+  hand.connect();
+  Completion homed;
+  BOOST_REQUIRE(hand.manager.resetChannelAsync(SVH_ALL, homed.callback(hand.reactor)));
+  BOOST_REQUIRE(homed.wait());
+  BOOST_CHECK(homed.success);
+  hand.reactor->removeTimer(timer);
+
+  SVHTransmitStatistics statistics = hand.manager.getTransmitStatistics();
+  BOOST_TEST_MESSAGE("Longest stall of the reactor " << longest_stall_us.load() << "us");
+  // A step waiting for the window would stall until the reply timeout, margin for loaded machines
+  BOOST_CHECK(longest_stall_us < options.reply_timeout.count());
+  BOOST_CHECK(statistics.replies > 0u);
+  BOOST_CHECK_EQUAL(statistics.lost_replies, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(HomingStepsKeepTheOrderOfTheirCommands)
+{
+  AsyncHand hand;
+  SVHHomingProfile profile;
+  profile.search_current_factor = 0.5f;
+  BOOST_REQUIRE(hand.manager.setHomingProfile(profile));
+  hand.connect();
+
+  // Packets of the connect that are still queued arrive first
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const size_t connect_frames = hand.simulator->receivedAddresses().size();
+
+  Completion homed;
+  BOOST_REQUIRE(hand.manager.resetChannelAsync(SVH_FINGER_SPREAD, homed.callback(hand.reactor)));
+  BOOST_REQUIRE(homed.wait());
+  BOOST_CHECK(homed.success);
+
+  // The steps send their packets without waiting, still the hand has to be configured for the
+  // hard stop search before the finger is commanded and enabled
+  const std::vector<uint8_t> received = hand.simulator->receivedAddresses();
+  auto first = [&](uint8_t address) {
+    auto it = std::find(received.begin() + connect_frames, received.end(), address);
+    return static_cast<size_t>(it - received.begin());
+  };
+  const uint8_t channel = static_cast<uint8_t>(SVH_FINGER_SPREAD << 4);
+  const size_t position_settings = first(SVH_SET_POSITION_SETTINGS | channel);
+  const size_t current_settings  = first(SVH_SET_CURRENT_SETTINGS | channel);
+  const size_t target            = first(SVH_SET_CONTROL_COMMAND | channel);
+  const size_t enable            = first(SVH_SET_CONTROLLER_STATE);
+  BOOST_REQUIRE(enable < received.size());
+  BOOST_CHECK(position_settings < current_settings);
+  BOOST_CHECK(current_settings < target);
+  BOOST_CHECK(target < enable);
+}
+
+BOOST_AUTO_TEST_CASE(SettingsAndFirmwareRoundTrips)
+{
+  AsyncHand hand;
+  hand.connect();
+
+  std::atomic<bool> done{false};
+  std::atomic<bool> success{false};
+  SVHFirmwareInfo firmware_info;
+  BOOST_REQUIRE(
+    hand.manager.getFirmwareInfoAsync([&](bool result, const SVHFirmwareInfo& info) {
+      firmware_info = info;
+      success       = result;
+      done          = true;
+    }));
+  BOOST_REQUIRE(waitFor([&] { return done.load(); }, std::chrono::milliseconds(2000)));
+  BOOST_CHECK(success);
+  BOOST_CHECK_EQUAL(firmware_info.version_major, 1);
+
+  // The echo of the hand carries the new settings
+  SVHPositionSettings settings = hand.manager.getDefaultPositionSettings(false)[SVH_FINGER_SPREAD];
+  settings.wmx                 = 1000.0f;
+  SVHPositionSettings echo;
+  done = false;
+  BOOST_REQUIRE(hand.manager.setPositionSettingsAsync(
+    SVH_FINGER_SPREAD, settings, [&](bool result, const SVHPositionSettings& result_settings) {
+      echo    = result_settings;
+      success = result;
+      done    = true;
+    }));
+  BOOST_REQUIRE(waitFor([&] { return done.load(); }, std::chrono::milliseconds(2000)));
+  BOOST_CHECK(success);
+  BOOST_CHECK_CLOSE(echo.wmx, 1000.0f, 1e-3);
+
+  SVHCurrentSettings current_settings;
+  done = false;
+  BOOST_REQUIRE(hand.manager.requestCurrentSettingsAsync(
+    SVH_FINGER_SPREAD, [&](bool result, const SVHCurrentSettings& result_settings) {
+      current_settings = result_settings;
+      success          = result;
+      done             = true;
+    }));
+  BOOST_REQUIRE(waitFor([&] { return done.load(); }, std::chrono::milliseconds(2000)));
+  BOOST_CHECK(success);
+  BOOST_CHECK_CLOSE(current_settings.wmx,
+                    hand.manager.getDefaultCurrentSettings()[SVH_FINGER_SPREAD].wmx,
+                    1e-3);
+
+  // Invalid channels are rejected before anything is sent
+  const SVHChannel invalid = static_cast<SVHChannel>(SVH_DIMENSION);
+  BOOST_CHECK(!hand.manager.setCurrentSettingsAsync(
+    invalid, current_settings, [](bool, const SVHCurrentSettings&) {}));
+  BOOST_CHECK(waitFor([&] { return hand.manager.pendingAsyncOperations() == 0; },
+                      std::chrono::milliseconds(1000)));
+}
+
+BOOST_AUTO_TEST_CASE(DisconnectCancelsPendingOperations)
+{
+  // Slow enough for the homing to be interrupted
+  AsyncHand hand(1);
+  hand.connect();
+
+  Completion homed;
+  BOOST_REQUIRE(hand.manager.resetChannelAsync(SVH_FINGER_SPREAD, homed.callback(hand.reactor)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(homed.calls, 0u);
+
+  hand.manager.disconnect();
+  BOOST_CHECK_EQUAL(homed.calls, 1u);
+  BOOST_CHECK(!homed.success);
+  BOOST_CHECK(!homed.in_reactor_thread);
+  BOOST_CHECK_EQUAL(hand.manager.pendingAsyncOperations(), 0u);
+
+  // Nothing is called later on
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(homed.calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(OperationsNeedARunningReactorAndConnection)
+{
+  SVHFingerManager manager;
+  std::shared_ptr<SVHPipeTransport> library_end;
+  std::shared_ptr<SVHPipeTransport> hand_end;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+
+  bool called = false;
+  BOOST_CHECK(!manager.connectAsync(library_end, [&](bool) { called = true; }));
+  BOOST_CHECK(!manager.resetChannelAsync(SVH_ALL, [&](bool) { called = true; }));
+  BOOST_CHECK(!manager.requestPositionSettingsAsync(
+    SVH_FINGER_SPREAD, [&](bool, const SVHPositionSettings&) { called = true; }));
+  BOOST_CHECK(!called);
+  BOOST_CHECK(!manager.isConnected());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
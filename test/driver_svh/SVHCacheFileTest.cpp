@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <schunk_svh_library/control/SVHCacheFile.h>
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHCacheFile)
+
+BOOST_AUTO_TEST_CASE(ConcurrentUpdatesKeepAllDevices)
+{
+  char directory[] = "/tmp/svh_cache_file_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(directory) != NULL);
+  const std::string cache_file = std::string(directory) + "/cache";
+
+  // Every hand rewrites its own entries over and over while the others do the same
+  const size_t hands   = 4;
+  const size_t updates = 50;
+  std::vector<std::thread> writers;
+  for (size_t hand = 0; hand < hands; ++hand)
+  {
+    writers.emplace_back([&cache_file, hand, updates] {
+      const std::string device = "usb hand " + std::to_string(hand);
+      for (size_t update = 0; update < updates; ++update)
+      {
+        const std::vector<std::string> entries = {std::to_string(update) + " 1",
+                                                  std::to_string(update) + " 2"};
+        BOOST_CHECK(SVHCacheFile::store(cache_file, device, 2, entries));
+      }
+    });
+  }
+  for (std::thread& writer : writers)
+  {
+    writer.join();
+  }
+
+  for (size_t hand = 0; hand < hands; ++hand)
+  {
+    std::vector<std::string> entries;
+    BOOST_REQUIRE(SVHCacheFile::load(cache_file, "usb hand " + std::to_string(hand), 2, entries));
+    BOOST_REQUIRE_EQUAL(entries.size(), 2u);
+    BOOST_CHECK_EQUAL(entries[0], std::to_string(updates - 1) + " 1");
+    BOOST_CHECK_EQUAL(entries[1], std::to_string(updates - 1) + " 2");
+  }
+  std::vector<std::string> entries;
+  BOOST_CHECK(!SVHCacheFile::load(cache_file, "usb hand", 2, entries));
+  BOOST_CHECK(entries.empty());
+
+  // No temporary file is left behind, only the cache and its lock file
+  size_t files = 0;
+  DIR* listing = opendir(directory);
+  BOOST_REQUIRE(listing != NULL);
+  while (const dirent* file = readdir(listing))
+  {
+    const std::string name = file->d_name;
+    if (name != "." && name != "..")
+    {
+      BOOST_CHECK_MESSAGE(name == "cache" || name == "cache.lock", name);
+      ++files;
+    }
+  }
+  closedir(listing);
+  BOOST_CHECK_EQUAL(files, 2u);
+
+  unlink(cache_file.c_str());
+  unlink((cache_file + ".lock").c_str());
+  rmdir(directory);
+}
+
+BOOST_AUTO_TEST_CASE(EntriesOfDifferentWidthsShareAFile)
+{
+  char directory[] = "/tmp/svh_cache_file_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(directory) != NULL);
+  const std::string cache_file = std::string(directory) + "/cache";
+
+  // The gap and the homing calibration of the same hand are cached in one file
+  const std::string device = "usb hand";
+  BOOST_REQUIRE(SVHCacheFile::store(cache_file, device, 1, {"1500"}));
+  BOOST_REQUIRE(SVHCacheFile::store(cache_file, device, 5, {"8 1 2 3 4", "9 5 6 7 8"}));
+  BOOST_REQUIRE(SVHCacheFile::store(cache_file, device, 5, {"8 1 2 3 5"}));
+  BOOST_REQUIRE(SVHCacheFile::store(cache_file, "other hand", 1, {"2500"}));
+
+  std::vector<std::string> entries;
+  BOOST_REQUIRE(SVHCacheFile::load(cache_file, device, 1, entries));
+  BOOST_REQUIRE_EQUAL(entries.size(), 1u);
+  BOOST_CHECK_EQUAL(entries[0], "1500");
+
+  BOOST_REQUIRE(SVHCacheFile::load(cache_file, device, 5, entries));
+  BOOST_REQUIRE_EQUAL(entries.size(), 1u);
+  BOOST_CHECK_EQUAL(entries[0], "8 1 2 3 5");
+
+  BOOST_REQUIRE(SVHCacheFile::store(cache_file, device, 1, {"1600"}));
+  BOOST_REQUIRE(SVHCacheFile::load(cache_file, device, 1, entries));
+  BOOST_REQUIRE_EQUAL(entries.size(), 1u);
+  BOOST_CHECK_EQUAL(entries[0], "1600");
+  BOOST_CHECK(SVHCacheFile::load(cache_file, device, 5, entries));
+  BOOST_CHECK(SVHCacheFile::load(cache_file, "other hand", 1, entries));
+
+  unlink(cache_file.c_str());
+  unlink((cache_file + ".lock").c_str());
+  rmdir(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include "SVHCaptureAnalysis.h"
+
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+
+#include <algorithm>
+#include <sstream>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHCaptureAnalysis)
+
+namespace {
+
+//! Unique capture file that is removed again
+struct CaptureFile
+{
+  CaptureFile()
+  {
+    char name[] = "/tmp/svh_analysis_XXXXXX";
+    int fd      = mkstemp(name);
+    BOOST_REQUIRE(fd >= 0);
+    ::close(fd);
+    path = name;
+  }
+
+  ~CaptureFile() { unlink(path.c_str()); }
+
+  std::string path;
+};
+
+//! Records a frame with the given payload and a dummy checksum
+void recordPacket(SVHPacketRecorder& recorder,
+                  SVHCaptureDirection direction,
+                  SVHCaptureStatus status,
+                  uint8_t index,
+                  uint8_t address,
+                  const std::vector<uint8_t>& payload)
+{
+  std::vector<uint8_t> frame = {PACKET_HEADER1,
+                                PACKET_HEADER2,
+                                index,
+                                address,
+                                static_cast<uint8_t>(payload.size() & 0xFF),
+                                static_cast<uint8_t>(payload.size() >> 8)};
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  frame.push_back(0);
+  frame.push_back(0);
+
+  struct iovec buffer;
+  buffer.iov_base = frame.data();
+  buffer.iov_len  = frame.size();
+  recorder.record(direction, status, &buffer, 1);
+}
+
+//! Feedback of all channels for request number i
+std::vector<uint8_t> feedbackPayload(int i)
+{
+  std::vector<SVHControllerFeedback> feedbacks;
+  for (int channel = 0; channel < 9; ++channel)
+  {
+    feedbacks.push_back(SVHControllerFeedback(i * 10 + channel, channel - i % 50));
+  }
+  SVHControllerFeedbackAllChannels feedback_all(feedbacks);
+  ArrayBuilder ab;
+  ab << feedback_all;
+  return ab.array;
+}
+
+/*!
+ * Records requests for the feedback of all channels. Every 100th request stays unanswered, the
+ * others are answered right away.
+ */
+void recordTraffic(SVHPacketRecorder& recorder, int requests)
+{
+  for (int i = 0; i < requests; ++i)
+  {
+    const uint8_t index = static_cast<uint8_t>(i % 255);
+    recordPacket(recorder,
+                 CD_TRANSMIT,
+                 CS_OK,
+                 index,
+                 SVH_GET_CONTROL_FEEDBACK_ALL,
+                 std::vector<uint8_t>(64, 0));
+    if (i % 100 != 99)
+    {
+      recordPacket(
+        recorder, CD_RECEIVE, CS_OK, index, SVH_GET_CONTROL_FEEDBACK_ALL, feedbackPayload(i));
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(RecordsAreDecodedWithTheControlCodecs)
+{
+  CaptureFile file;
+  SVHPacketRecorder recorder;
+  BOOST_REQUIRE(recorder.open(file.path, 16));
+
+  ArrayBuilder feedback;
+  feedback << SVHControllerFeedback(1234, -56);
+  recordPacket(
+    recorder, CD_RECEIVE, CS_OK, 7, SVH_SET_CONTROL_COMMAND | (3 << 4), feedback.array);
+
+  ArrayBuilder command;
+  command << SVHControlCommandAllChannels(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  recordPacket(recorder, CD_TRANSMIT, CS_OK, 8, SVH_SET_CONTROL_COMMAND_ALL, command.array);
+
+  recordPacket(
+    recorder, CD_TRANSMIT, CS_OK, 9, SVH_GET_FIRMWARE_INFO, std::vector<uint8_t>(40, 0));
+
+  // Laid out like the hand sends it: 4 bytes name, major, minor and 48 bytes text
+  std::vector<uint8_t> svh(4, 0);
+  std::vector<uint8_t> text(48, 0);
+  std::string name        = "SVH";
+  std::string description = "firmware";
+  std::copy(name.begin(), name.end(), svh.begin());
+  std::copy(description.begin(), description.end(), text.begin());
+  ArrayBuilder firmware;
+  firmware << svh << static_cast<uint16_t>(5) << static_cast<uint16_t>(2) << text;
+  recordPacket(recorder, CD_RECEIVE, CS_OK, 9, SVH_GET_FIRMWARE_INFO, firmware.array);
+
+  recordPacket(
+    recorder, CD_RECEIVE, CS_CHECKSUM_ERROR, 10, SVH_SET_CONTROL_COMMAND, feedback.array);
+  recorder.close();
+
+  SVHCaptureFileHeader header;
+  std::vector<SVHCaptureRecord> records;
+  BOOST_REQUIRE(SVHPacketRecorder::readCapture(file.path, header, records));
+  BOOST_REQUIRE_EQUAL(records.size(), 5u);
+
+  SVHCaptureDecoder decoder;
+  SVHDecodedFrame frame;
+
+  BOOST_REQUIRE(decoder.decode(header, records[0], frame));
+  BOOST_CHECK_EQUAL(frame.direction, CD_RECEIVE);
+  BOOST_CHECK_EQUAL(frame.index, 7);
+  BOOST_CHECK_EQUAL(frame.channel, 3);
+  BOOST_CHECK_EQUAL(std::string(SVHCaptureDecoder::typeName(frame.type)), "set_control_command");
+  BOOST_REQUIRE_EQUAL(frame.fields.size(), 2u);
+  BOOST_CHECK_EQUAL(frame.fields[0].value, 1234);
+  BOOST_CHECK_EQUAL(frame.fields[1].value, -56);
+
+  BOOST_REQUIRE(decoder.decode(header, records[1], frame));
+  BOOST_REQUIRE_EQUAL(frame.fields.size(), 9u);
+  BOOST_CHECK_EQUAL(frame.fields[4].channel, 4);
+  BOOST_CHECK_EQUAL(frame.fields[4].value, 5);
+
+  // Requests only carry padding
+  BOOST_REQUIRE(decoder.decode(header, records[2], frame));
+  BOOST_CHECK(frame.fields.empty());
+
+  BOOST_REQUIRE(decoder.decode(header, records[3], frame));
+  BOOST_REQUIRE_EQUAL(frame.fields.size(), 2u);
+  BOOST_CHECK_EQUAL(frame.fields[0].value, 5);
+  BOOST_CHECK_EQUAL(frame.text, "SVH firmware");
+
+  // The payload of a frame with a checksum error is not trusted
+  BOOST_REQUIRE(decoder.decode(header, records[4], frame));
+  BOOST_CHECK_EQUAL(frame.status, CS_CHECKSUM_ERROR);
+  BOOST_CHECK(frame.fields.empty());
+}
+
+BOOST_AUTO_TEST_CASE(SummaryMatchesTheRecordedTraffic)
+{
+  CaptureFile file;
+  SVHPacketRecorder recorder;
+  BOOST_REQUIRE(recorder.open(file.path, 4096));
+
+  recordTraffic(recorder, 1000);
+  for (int i = 0; i < 3; ++i)
+  {
+    recordPacket(recorder,
+                 CD_RECEIVE,
+                 CS_CHECKSUM_ERROR,
+                 0,
+                 SVH_GET_CONTROL_FEEDBACK_ALL,
+                 feedbackPayload(-1));
+  }
+  // The last request with index 250 has been answered already
+  recordPacket(
+    recorder, CD_RECEIVE, CS_OK, 250, SVH_GET_CONTROLLER_STATE, std::vector<uint8_t>(12));
+  recorder.close();
+
+  SVHCaptureAnalyzer analyzer;
+  BOOST_REQUIRE(analyzer.open(file.path));
+  SVHCaptureAnalysisOptions options;
+  options.threads       = 3;
+  options.chunk_records = 100;
+  SVHCaptureSummary summary;
+  BOOST_REQUIRE(analyzer.analyze(options, summary));
+
+  BOOST_CHECK_EQUAL(summary.records, 1994u);
+  BOOST_CHECK_EQUAL(summary.first_sequence, 1u);
+  BOOST_CHECK_EQUAL(summary.last_sequence, 1994u);
+  BOOST_CHECK_EQUAL(summary.missing_records, 0u);
+  BOOST_CHECK_EQUAL(summary.transmitted, 1000u);
+  BOOST_CHECK_EQUAL(summary.received, 994u);
+  BOOST_CHECK_EQUAL(summary.checksum_errors, 3u);
+  BOOST_CHECK_EQUAL(summary.type_transmitted[SVH_GET_CONTROL_FEEDBACK_ALL], 1000u);
+  BOOST_CHECK_EQUAL(summary.type_received[SVH_GET_CONTROL_FEEDBACK_ALL], 993u);
+  BOOST_CHECK_EQUAL(summary.type_received[SVH_GET_CONTROLLER_STATE], 1u);
+
+  // Requests 99 to 699 are unanswered when their index is reused, 799 to 999 are never reused
+  BOOST_CHECK_EQUAL(summary.rtt_samples, 990u);
+  BOOST_CHECK_EQUAL(summary.unanswered, 7u);
+  BOOST_CHECK_EQUAL(summary.unmatched_responses, 1u);
+  BOOST_CHECK(summary.rtt_min_ns >= 0);
+  BOOST_CHECK(summary.rttPercentile(0.5) <= summary.rtt_max_ns);
+
+  for (int channel = 0; channel < 9; ++channel)
+  {
+    const SVHCaptureChannelRange& range = summary.channels[channel];
+    BOOST_CHECK_EQUAL(range.samples, 990u);
+    BOOST_CHECK_EQUAL(range.position_min, channel);
+    BOOST_CHECK_EQUAL(range.position_max, 9980 + channel);
+    BOOST_CHECK_EQUAL(range.current_min, channel - 49);
+    BOOST_CHECK_EQUAL(range.current_max, channel);
+  }
+
+  std::ostringstream json;
+  summary.writeJson(json);
+  BOOST_CHECK(json.str().find("\"unanswered\": 7") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelAnalysisMatchesSequentialAnalysis)
+{
+  CaptureFile file;
+  SVHPacketRecorder recorder;
+  BOOST_REQUIRE(recorder.open(file.path, 700));
+  recordTraffic(recorder, 1000);
+  recorder.close();
+
+  SVHCaptureAnalyzer analyzer;
+  BOOST_REQUIRE(analyzer.open(file.path));
+
+  SVHCaptureAnalysisOptions sequential;
+  sequential.threads       = 1;
+  sequential.chunk_records = 1000;
+  SVHCaptureSummary expected;
+  std::ostringstream expected_export;
+  BOOST_REQUIRE(analyzer.analyze(sequential, expected, &expected_export));
+
+  SVHCaptureAnalysisOptions parallel;
+  parallel.threads       = 4;
+  parallel.chunk_records = 37;
+  SVHCaptureSummary summary;
+  std::ostringstream parallel_export;
+  BOOST_REQUIRE(analyzer.analyze(parallel, summary, &parallel_export));
+
+  // The ring only holds the newest 700 of the 1990 frames
+  BOOST_CHECK_EQUAL(expected.records, 700u);
+  BOOST_CHECK_EQUAL(expected.first_sequence, 1291u);
+  BOOST_CHECK_EQUAL(summary.records, expected.records);
+  BOOST_CHECK_EQUAL(summary.first_sequence, expected.first_sequence);
+  BOOST_CHECK_EQUAL(summary.last_sequence, expected.last_sequence);
+  BOOST_CHECK_EQUAL(summary.rtt_samples, expected.rtt_samples);
+  BOOST_CHECK_EQUAL(summary.unanswered, expected.unanswered);
+  BOOST_CHECK_EQUAL(summary.unmatched_responses, expected.unmatched_responses);
+  BOOST_CHECK_EQUAL(summary.gap_max_ns, expected.gap_max_ns);
+  BOOST_CHECK(summary.rtt_histogram == expected.rtt_histogram);
+  for (int channel = 0; channel < 9; ++channel)
+  {
+    BOOST_CHECK_EQUAL(summary.channels[channel].samples, expected.channels[channel].samples);
+    BOOST_CHECK_EQUAL(summary.channels[channel].position_min,
+                      expected.channels[channel].position_min);
+  }
+  BOOST_CHECK(parallel_export.str() == expected_export.str());
+
+  // One line per frame behind the column names
+  const std::string csv = parallel_export.str();
+  BOOST_CHECK_EQUAL(std::count(csv.begin(), csv.end(), '\n'), 701);
+
+  parallel.export_format = EF_JSON;
+  std::ostringstream json_export;
+  BOOST_REQUIRE(analyzer.analyze(parallel, summary, &json_export));
+  const std::string json = json_export.str();
+  BOOST_CHECK_EQUAL(std::count(json.begin(), json.end(), '\n'), 700);
+  BOOST_CHECK(json.find("\"type\":\"get_control_feedback_all\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
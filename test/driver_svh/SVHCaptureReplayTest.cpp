@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include "SVHCaptureReplay.h"
+#include "SVHSimulator.h"
+
+#include <schunk_svh_library/control/SVHController.h>
+
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHCaptureReplay)
+
+namespace {
+
+//! Unique capture file that is removed again
+struct CaptureFile
+{
+  CaptureFile()
+  {
+    char name[] = "/tmp/svh_replay_XXXXXX";
+    int fd      = mkstemp(name);
+    BOOST_REQUIRE(fd >= 0);
+    ::close(fd);
+    path = name;
+  }
+
+  ~CaptureFile() { unlink(path.c_str()); }
+
+  std::string path;
+};
+
+//! Records a received feedback frame, with a broken checksum if requested
+void recordFeedback(SVHPacketRecorder& recorder, uint8_t channel, int32_t position, bool broken)
+{
+  ArrayBuilder ab;
+  ab << SVHControllerFeedback(position, 10);
+
+  std::vector<uint8_t> frame = {PACKET_HEADER1,
+                                PACKET_HEADER2,
+                                0,
+                                static_cast<uint8_t>(SVH_GET_CONTROL_FEEDBACK | (channel << 4)),
+                                static_cast<uint8_t>(ab.array.size()),
+                                0};
+  uint8_t checksum[2] = {0, 0};
+  for (uint8_t byte : ab.array)
+  {
+    checksum[0] += byte;
+    checksum[1] ^= byte;
+  }
+  frame.insert(frame.end(), ab.array.begin(), ab.array.end());
+  frame.push_back(broken ? static_cast<uint8_t>(checksum[0] + 1) : checksum[0]);
+  frame.push_back(checksum[1]);
+
+  struct iovec buffer;
+  buffer.iov_base = frame.data();
+  buffer.iov_len  = frame.size();
+  recorder.record(CD_RECEIVE, broken ? CS_CHECKSUM_ERROR : CS_OK, &buffer, 1);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ReplayReproducesTheRecordedSession)
+{
+  CaptureFile file;
+  SVHSimulator simulator;
+  BOOST_REQUIRE(simulator.start());
+
+  // Record a session with every kind of answer the controller handles
+  auto recorder = std::make_shared<SVHPacketRecorder>();
+  BOOST_REQUIRE(recorder->open(file.path, 4096));
+  {
+    SVHController controller;
+    controller.setPacketRecorder(recorder);
+    BOOST_REQUIRE(controller.connect(simulator.deviceName()));
+
+    controller.requestFirmwareInfo();
+    for (int channel = 0; channel < SVH_DIMENSION; ++channel)
+    {
+      controller.requestPositionSettings(static_cast<SVHChannel>(channel));
+      controller.requestCurrentSettings(static_cast<SVHChannel>(channel));
+      controller.requestControllerFeedback(static_cast<SVHChannel>(channel));
+    }
+    controller.requestControllerFeedback(SVH_ALL);
+    controller.requestControllerState();
+
+    const unsigned int requests = 3 * SVH_DIMENSION + 3;
+    for (int i = 0; i < 200 && controller.getReceivedPackageCount() < requests; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    BOOST_REQUIRE_EQUAL(controller.getReceivedPackageCount(), requests);
+    controller.disconnect();
+  }
+  recorder->close();
+  simulator.stop();
+
+  SVHCaptureReplay replay;
+  BOOST_REQUIRE(replay.load(file.path));
+  BOOST_REQUIRE(replay.receivedFrames() >= 3 * SVH_DIMENSION + 3);
+
+  SVHReplayOptions options;
+  options.speed = 0;
+  SVHReplayResult result;
+  BOOST_REQUIRE(replay.run(options, result));
+  for (size_t i = 0; i < result.mismatches.size(); ++i)
+  {
+    BOOST_TEST_MESSAGE(result.mismatches[i]);
+  }
+  BOOST_CHECK(result.verified());
+  BOOST_CHECK_EQUAL(result.frames, replay.receivedFrames());
+  BOOST_CHECK_EQUAL(result.receive.packets, result.frames);
+  BOOST_CHECK_EQUAL(result.receive.skipped_bytes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TimedReplayKeepsTheRecordedPace)
+{
+  CaptureFile file;
+  SVHPacketRecorder recorder;
+  BOOST_REQUIRE(recorder.open(file.path, 64));
+  for (int i = 0; i < 6; ++i)
+  {
+    recordFeedback(recorder, static_cast<uint8_t>(i % 2), 100 * i, false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  // Dropped again on replay, so channel 1 keeps its last valid position
+  recordFeedback(recorder, 1, -1, true);
+  recorder.close();
+
+  SVHCaptureReplay replay;
+  BOOST_REQUIRE(replay.load(file.path));
+
+  SVHReplayOptions options;
+  options.speed = 2;
+  SVHReplayResult result;
+  BOOST_REQUIRE(replay.run(options, result));
+  BOOST_CHECK(result.verified());
+  BOOST_CHECK_EQUAL(result.frames, 7u);
+  BOOST_CHECK_EQUAL(result.receive.packets, 6u);
+  BOOST_CHECK_EQUAL(result.receive.checksum_errors, 1u);
+  BOOST_CHECK(result.recorded_seconds >= 0.05);
+  BOOST_CHECK(result.replay_seconds >= result.recorded_seconds / options.speed);
+
+  options.speed = 0;
+  BOOST_REQUIRE(replay.run(options, result));
+  BOOST_CHECK(result.verified());
+  BOOST_CHECK(result.replay_seconds < result.recorded_seconds);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
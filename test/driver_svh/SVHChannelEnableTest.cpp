@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHChannelEnable)
+
+namespace {
+
+//! Simulated hand connected to a controller
+struct SimulatedHand
+{
+  SimulatedHand()
+  {
+    std::shared_ptr<SVHPipeTransport> library_end;
+    std::shared_ptr<SVHPipeTransport> hand_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+    BOOST_REQUIRE(simulator.start(hand_end));
+    BOOST_REQUIRE(controller.connect(library_end));
+  }
+
+  ~SimulatedHand()
+  {
+    controller.disconnect();
+    simulator.stop();
+  }
+
+  //! Waits until the simulator answered everything sent so far
+  void settle()
+  {
+    for (int i = 0; i < 200 && simulator.sentFrameCount() < controller.getSentPackageCount(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(simulator.sentFrameCount(), controller.getSentPackageCount());
+  }
+
+  //! Channels enabled in the simulated hand as mask
+  uint16_t enabledMask()
+  {
+    uint16_t mask = 0;
+    for (size_t i = 0; i < SVH_DIMENSION; ++i)
+    {
+      if (simulator.isEnabled(static_cast<SVHChannel>(i)))
+      {
+        mask |= static_cast<uint16_t>(1 << i);
+      }
+    }
+    return mask;
+  }
+
+  SVHSimulator simulator;
+  SVHController controller;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(WholeHandIsEnabledWithOneSequence)
+{
+  SimulatedHand hand;
+
+  // Powering the drivers takes three states, all channels together take another two
+  auto start = std::chrono::steady_clock::now();
+  hand.controller.enableChannels(SVH_ALL_CHANNELS_MASK);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.controller.getSentPackageCount(), 5u);
+  BOOST_CHECK_EQUAL(hand.enabledMask(), SVH_ALL_CHANNELS_MASK);
+  BOOST_TEST_MESSAGE("Enabling the whole hand took "
+                     << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+                     << "us");
+  BOOST_CHECK(elapsed < std::chrono::milliseconds(20));
+
+  // Re-enabling after a protective stop costs the same instead of one sequence per channel
+  hand.controller.disableChannel(SVH_ALL);
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.enabledMask(), 0);
+
+  start = std::chrono::steady_clock::now();
+  hand.controller.enableChannels(SVH_ALL_CHANNELS_MASK);
+  elapsed = std::chrono::steady_clock::now() - start;
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.controller.getSentPackageCount(), 11u);
+  BOOST_CHECK_EQUAL(hand.enabledMask(), SVH_ALL_CHANNELS_MASK);
+  BOOST_TEST_MESSAGE("Re-enabling after a stop took "
+                     << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+                     << "us");
+  BOOST_CHECK(elapsed < std::chrono::milliseconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(SubsetsKeepTheOtherChannels)
+{
+  SimulatedHand hand;
+
+  const uint16_t thumb = (1 << SVH_THUMB_FLEXION) | (1 << SVH_THUMB_OPPOSITION);
+  const uint16_t index = (1 << SVH_INDEX_FINGER_DISTAL) | (1 << SVH_INDEX_FINGER_PROXIMAL);
+  hand.controller.enableChannels(thumb);
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.enabledMask(), thumb);
+
+  // With the drivers powered only the reset and the activation are sent
+  const unsigned int sent = hand.controller.getSentPackageCount();
+  hand.controller.enableChannels(index);
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.controller.getSentPackageCount() - sent, 2u);
+  BOOST_CHECK_EQUAL(hand.enabledMask(), thumb | index);
+  BOOST_CHECK(hand.controller.isEnabled(SVH_INDEX_FINGER_DISTAL));
+
+  hand.controller.disableChannels(thumb);
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.controller.getSentPackageCount() - sent, 3u);
+  BOOST_CHECK_EQUAL(hand.enabledMask(), index);
+  BOOST_CHECK(!hand.controller.isEnabled(SVH_THUMB_FLEXION));
+
+  hand.controller.disableChannels(SVH_ALL_CHANNELS_MASK);
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.enabledMask(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentUpdatesKeepAllBits)
+{
+  SimulatedHand hand;
+
+  // Two threads enabling and disabling their own fingers must not lose each other's bits
+  const uint16_t thumb = (1 << SVH_THUMB_FLEXION) | (1 << SVH_THUMB_OPPOSITION);
+  const uint16_t index = (1 << SVH_INDEX_FINGER_DISTAL) | (1 << SVH_INDEX_FINGER_PROXIMAL);
+  auto toggle = [&hand](uint16_t mask) {
+    for (int i = 0; i < 20; ++i)
+    {
+      hand.controller.enableChannels(mask);
+      hand.controller.disableChannels(mask);
+    }
+    hand.controller.enableChannels(mask);
+  };
+  std::thread thumb_thread(toggle, thumb);
+  std::thread index_thread(toggle, index);
+  thumb_thread.join();
+  index_thread.join();
+
+  BOOST_CHECK_EQUAL(hand.controller.enabledMask(), thumb | index);
+  hand.settle();
+  BOOST_CHECK_EQUAL(hand.enabledMask(), thumb | index);
+}
+
+BOOST_AUTO_TEST_CASE(StopIsNotUndoneByAnOvertakenEnable)
+{
+  SimulatedHand hand;
+  const uint16_t thumb = (1 << SVH_THUMB_FLEXION) | (1 << SVH_THUMB_OPPOSITION);
+  const uint16_t index = (1 << SVH_INDEX_FINGER_DISTAL) | (1 << SVH_INDEX_FINGER_PROXIMAL);
+  hand.controller.enableChannels(thumb);
+
+  for (int i = 0; i < 20; ++i)
+  {
+    // Setpoints keep the control lane busy, an enable queued behind them must not switch the
+    // fingers on again after the stop that follows it was written
+    std::atomic<bool> running(true);
+    std::vector<std::thread> setpoints;
+    for (int j = 0; j < 3; ++j)
+    {
+      setpoints.emplace_back([&hand, &running] {
+        while (running)
+        {
+          hand.controller.setControllerTarget(SVH_THUMB_FLEXION, 0);
+        }
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    std::thread enabler([&hand, index] { hand.controller.enableChannels(index); });
+    std::this_thread::sleep_for(std::chrono::microseconds(200 + 50 * i));
+    hand.controller.disableChannels(index);
+    enabler.join();
+    running = false;
+    for (std::thread& setpoint : setpoints)
+    {
+      setpoint.join();
+    }
+
+    hand.settle();
+    BOOST_REQUIRE_EQUAL(hand.enabledMask(), hand.controller.enabledMask());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FingerManagerReportsChannelStateMasks)
+{
+  std::vector<bool> disable_mask(SVH_DIMENSION, false);
+  disable_mask[SVH_PINKY] = true;
+  SVHFingerManager finger_manager(disable_mask);
+
+  // Switched off channels count as homed and enabled, all others are neither before homing
+  const uint16_t pinky = 1 << SVH_PINKY;
+  BOOST_CHECK_EQUAL(finger_manager.switchedOffMask(), pinky);
+  BOOST_CHECK_EQUAL(finger_manager.homedMask(), pinky);
+  BOOST_CHECK_EQUAL(finger_manager.enabledMask(), pinky);
+  BOOST_CHECK_EQUAL(finger_manager.faultedMask(), 0);
+  BOOST_CHECK(finger_manager.isHomed(SVH_PINKY));
+  BOOST_CHECK(!finger_manager.isHomed(SVH_THUMB_FLEXION));
+  BOOST_CHECK(!finger_manager.isHomed(SVH_ALL));
+  BOOST_CHECK(!finger_manager.isEnabled(SVH_ALL));
+  BOOST_CHECK(finger_manager.isEnabled(SVH_PINKY));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHControllerFeedback.h>
+#include <schunk_svh_library/serial/ByteOrderConversion.h>
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+
+using driver_svh::ArrayBuilder;
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHControllerDispatch)
+
+//! Creates a single channel feedback packet as it would be sent by the hardware
+SVHSerialPacket createFeedbackPacket(const SVHChannel& channel,
+                                     const SVHControllerFeedback& feedback)
+{
+  ArrayBuilder payload(64);
+  payload << feedback;
+  SVHSerialPacket packet(0, SVH_SET_CONTROL_COMMAND | static_cast<uint8_t>(channel << 4));
+  packet.data = payload.array;
+  return packet;
+}
+
+BOOST_AUTO_TEST_CASE(ObserverSeesDecodedData)
+{
+  SVHController controller;
+  SVHChannel channel = SVH_RING_FINGER;
+  SVHControllerFeedback feedback_in(-1234, 56);
+
+  SVHControllerFeedback observed;
+  unsigned int observer_calls = 0;
+  BOOST_CHECK(controller.addPacketObserver(SVH_SET_CONTROL_COMMAND, [&](const SVHSerialPacket&) {
+    controller.getControllerFeedback(channel, observed);
+    observer_calls++;
+  }));
+
+  controller.receivedPacketCallback(createFeedbackPacket(channel, feedback_in), 1);
+
+  BOOST_CHECK_EQUAL(observer_calls, 1u);
+  BOOST_CHECK_EQUAL(observed, feedback_in);
+  BOOST_CHECK_EQUAL(controller.getReceivedPackageCount(), 1u);
+
+  // Observers of other types are not involved
+  controller.clearPacketObservers(SVH_SET_CONTROL_COMMAND);
+  controller.receivedPacketCallback(createFeedbackPacket(channel, feedback_in), 2);
+  BOOST_CHECK_EQUAL(observer_calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(CustomHandlerReplacesDecoding)
+{
+  SVHController controller;
+  SVHChannel channel = SVH_PINKY;
+
+  unsigned int handler_calls = 0;
+  BOOST_CHECK(controller.setPacketHandler(
+    SVH_SET_CONTROL_COMMAND, [&](const SVHSerialPacket&) { handler_calls++; }));
+
+  controller.receivedPacketCallback(createFeedbackPacket(channel, SVHControllerFeedback(42, 7)), 1);
+
+  SVHControllerFeedback feedback_out;
+  controller.getControllerFeedback(channel, feedback_out);
+  BOOST_CHECK_EQUAL(handler_calls, 1u);
+  BOOST_CHECK_EQUAL(feedback_out, SVHControllerFeedback());
+
+  // The built-in decoding is back after a reset
+  BOOST_CHECK(controller.resetPacketHandler(SVH_SET_CONTROL_COMMAND));
+  controller.receivedPacketCallback(createFeedbackPacket(channel, SVHControllerFeedback(42, 7)), 2);
+  controller.getControllerFeedback(channel, feedback_out);
+  BOOST_CHECK_EQUAL(handler_calls, 1u);
+  BOOST_CHECK_EQUAL(feedback_out, SVHControllerFeedback(42, 7));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidTypesAreRejected)
+{
+  SVHController controller;
+  BOOST_CHECK(!controller.setPacketHandler(SVH_PACKET_TYPE_DIMENSION, SVHPacketHandler()));
+  BOOST_CHECK(!controller.addPacketObserver(SVH_PACKET_TYPE_DIMENSION,
+                                            [](const SVHSerialPacket&) {}));
+  BOOST_CHECK(!controller.addPacketObserver(SVH_GET_FIRMWARE_INFO, SVHPacketHandler()));
+
+  // Unhandled types can still be observed
+  unsigned int observer_calls = 0;
+  BOOST_CHECK(
+    controller.addPacketObserver(0x0F, [&](const SVHSerialPacket&) { observer_calls++; }));
+  controller.receivedPacketCallback(SVHSerialPacket(64, 0x0F), 1);
+  BOOST_CHECK_EQUAL(observer_calls, 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHFaultInjectionTransport.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHReceiveThread.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHFaultInjection)
+
+namespace {
+
+//! Serialized frame whose payload is derived from \a sequence
+std::vector<uint8_t> buildFrame(uint16_t sequence)
+{
+  SVHSerialPacket packet(C_MAXIMUM_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK);
+  packet.index = static_cast<uint8_t>(sequence % 255);
+  for (size_t i = 0; i < packet.data.size(); ++i)
+  {
+    packet.data[i] = static_cast<uint8_t>(i < 2 ? sequence >> (8 * i) : sequence * 7 + i);
+  }
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, packet);
+  ArrayBuilder frame(packet.data.size() + C_PACKET_APPENDIX_SIZE);
+  frame << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+  return frame.array;
+}
+
+//! Pipe whose reading end is wrapped by a fault injection transport
+struct FaultyPipe
+{
+  explicit FaultyPipe(const SVHFaultSettings& settings)
+  {
+    std::shared_ptr<SVHPipeTransport> reading_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(writing_end, reading_end, 1 << 20));
+    faulty = std::make_shared<SVHFaultInjectionTransport>(reading_end, settings);
+  }
+
+  //! Writes frames 0 to count - 1 and returns what was written
+  std::vector<uint8_t> writeFrames(uint16_t count)
+  {
+    std::vector<uint8_t> stream;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+      std::vector<uint8_t> frame = buildFrame(i);
+      struct iovec buffer        = {frame.data(), frame.size()};
+      BOOST_REQUIRE_EQUAL(writing_end->writev(&buffer, 1), static_cast<ssize_t>(frame.size()));
+      stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    return stream;
+  }
+
+  //! Reads until nothing arrives for a while
+  std::vector<uint8_t> readAll()
+  {
+    std::vector<uint8_t> data;
+    uint8_t buffer[256];
+    ssize_t bytes = 0;
+    while ((bytes = faulty->read(buffer, sizeof(buffer), 20000)) > 0)
+    {
+      data.insert(data.end(), buffer, buffer + bytes);
+    }
+    return data;
+  }
+
+  std::shared_ptr<SVHPipeTransport> writing_end;
+  std::shared_ptr<SVHFaultInjectionTransport> faulty;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PartialReadsKeepTheStreamIntact)
+{
+  SVHFaultSettings settings;
+  settings.max_read_size = 5;
+  FaultyPipe pipe(settings);
+
+  std::vector<uint64_t> observed;
+  pipe.faulty->setObserver([&](uint64_t frame, uint32_t faults) {
+    BOOST_CHECK_EQUAL(faults, 0u);
+    observed.push_back(frame);
+  });
+
+  // Junk in front of the frames is passed on as well
+  uint8_t junk[3]    = {0x01, PACKET_HEADER1, 0x02};
+  struct iovec noise = {junk, sizeof(junk)};
+  BOOST_REQUIRE_EQUAL(pipe.writing_end->writev(&noise, 1), 3);
+  std::vector<uint8_t> stream = pipe.writeFrames(50);
+  stream.insert(stream.begin(), junk, junk + sizeof(junk));
+
+  BOOST_CHECK(pipe.readAll() == stream);
+  BOOST_REQUIRE_EQUAL(observed.size(), 50u);
+  for (size_t i = 0; i < observed.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(observed[i], i);
+  }
+
+  SVHFaultStatistics statistics = pipe.faulty->statistics();
+  BOOST_CHECK_EQUAL(statistics.frames, 50u);
+  BOOST_CHECK_EQUAL(statistics.damaged_frames, 0u);
+  BOOST_CHECK_GT(statistics.partial_reads, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(FramesAreDuplicatedAndDropped)
+{
+  SVHFaultSettings settings;
+  settings.duplicate_probability = 1.0;
+  FaultyPipe duplicating(settings);
+
+  std::vector<uint8_t> expected;
+  for (uint16_t i = 0; i < 10; ++i)
+  {
+    std::vector<uint8_t> frame = buildFrame(i);
+    expected.insert(expected.end(), frame.begin(), frame.end());
+    expected.insert(expected.end(), frame.begin(), frame.end());
+  }
+  duplicating.writeFrames(10);
+  BOOST_CHECK(duplicating.readAll() == expected);
+  BOOST_CHECK_EQUAL(duplicating.faulty->statistics().duplicated_frames, 10u);
+
+  settings.duplicate_probability = 0.0;
+  settings.drop_probability      = 1.0;
+  FaultyPipe dropping(settings);
+  dropping.writeFrames(10);
+  BOOST_CHECK(dropping.readAll().empty());
+  SVHFaultStatistics statistics = dropping.faulty->statistics();
+  BOOST_CHECK_EQUAL(statistics.damaged_frames, 10u);
+  BOOST_CHECK_EQUAL(statistics.dropped_bytes,
+                    10 * (C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE));
+}
+
+BOOST_AUTO_TEST_CASE(BurstsHoldFramesBack)
+{
+  SVHFaultSettings settings;
+  settings.burst_probability = 1.0;
+  settings.burst_delay       = std::chrono::milliseconds(50);
+  FaultyPipe pipe(settings);
+
+  auto start                  = std::chrono::steady_clock::now();
+  std::vector<uint8_t> stream = pipe.writeFrames(3);
+  uint8_t buffer[256];
+  BOOST_CHECK_EQUAL(pipe.faulty->read(buffer, sizeof(buffer), 0), 0);
+  BOOST_CHECK_EQUAL(pipe.faulty->waitReadable(10000), 0);
+
+  // All frames of the burst become readable at once
+  BOOST_CHECK_EQUAL(pipe.faulty->waitReadable(1000000), 1);
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(45));
+  BOOST_CHECK_EQUAL(pipe.faulty->read(buffer, sizeof(buffer), 0),
+                    static_cast<ssize_t>(stream.size()));
+  BOOST_CHECK_EQUAL(pipe.faulty->statistics().bursts, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiverRecoversEveryIntactFrame)
+{
+  SVHFaultSettings settings;
+  settings.corrupt_probability   = 1e-3;
+  settings.drop_probability      = 2.5e-4;
+  settings.duplicate_probability = 0.01;
+  settings.max_read_size         = 16;
+  FaultyPipe pipe(settings);
+
+  const uint16_t frames = 2000;
+  std::vector<uint32_t> faults(frames, 0);
+  std::vector<bool> received(frames, false);
+  pipe.faulty->setObserver([&](uint64_t frame, uint32_t frame_faults) {
+    if (frame < frames)
+    {
+      faults[frame] = frame_faults;
+    }
+  });
+
+  SVHReceiveThread receiver(
+    std::chrono::microseconds(1000),
+    pipe.faulty,
+    [&](const SVHSerialPacket& packet, unsigned int) {
+      uint16_t sequence = static_cast<uint16_t>(packet.data[0] | (packet.data[1] << 8));
+      if (sequence < frames)
+      {
+        std::vector<uint8_t> frame = buildFrame(sequence);
+        if (std::equal(packet.data.begin(), packet.data.end(), frame.begin() + 6))
+        {
+          received[sequence] = true;
+        }
+      }
+    },
+    256,
+    RS_BLOCKING);
+  std::thread receive_thread([&] { receiver.run(); });
+
+  pipe.writeFrames(frames);
+
+  // The partial reads take a while to drain the pipe
+  uint64_t bytes = 0;
+  for (int i = 0; i < 100 && (pipe.faulty->statistics().frames < frames ||
+                              receiver.statistics().bytes != bytes);
+       ++i)
+  {
+    bytes = receiver.statistics().bytes;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  receiver.stop();
+  receive_thread.join();
+
+  // The decoder resynchronizes right behind a damaged frame, so no intact frame is lost
+  SVHFaultStatistics statistics = pipe.faulty->statistics();
+  BOOST_CHECK_EQUAL(statistics.frames, frames);
+  BOOST_CHECK_GT(statistics.damaged_frames, 0u);
+  size_t lost = 0;
+  for (size_t i = 0; i < frames; ++i)
+  {
+    if (!(faults[i] & (FF_CORRUPTED | FF_DROPPED)) && !received[i])
+    {
+      lost++;
+    }
+  }
+  BOOST_CHECK_EQUAL(lost, 0u);
+  BOOST_CHECK_GT(receiver.statistics().checksum_errors, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
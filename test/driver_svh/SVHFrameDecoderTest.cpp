@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <schunk_svh_library/serial/ByteOrderConversion.h>
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+
+#include <random>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHFrameDecoder)
+
+//! Serializes a packet the way SVHSerialInterface sends it
+std::vector<uint8_t> encodeFrame(const SVHSerialPacket& packet)
+{
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, packet);
+
+  ArrayBuilder ab(packet.data.size() + C_PACKET_APPENDIX_SIZE);
+  ab << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+  return ab.array;
+}
+
+//! Creates a packet with pseudo random payload
+SVHSerialPacket randomPacket(std::mt19937& random, size_t length)
+{
+  std::uniform_int_distribution<int> byte(0, 255);
+  SVHSerialPacket packet(length, static_cast<uint8_t>(byte(random)));
+  packet.index = static_cast<uint8_t>(byte(random));
+  for (uint8_t& value : packet.data)
+  {
+    value = static_cast<uint8_t>(byte(random));
+  }
+  return packet;
+}
+
+//! Collects the decoded frames as packets
+struct FrameCollector
+{
+  std::vector<SVHSerialPacket> packets;
+
+  SVHFrameCallback callback()
+  {
+    return [this](const SVHFrameView& frame) {
+      SVHSerialPacket packet(0, frame.address);
+      packet.index = frame.index;
+      packet.data.assign(frame.payload, frame.payload + frame.length);
+      packets.push_back(packet);
+    };
+  }
+};
+
+//! Feeds the stream in chunks of random size
+void feedInRandomChunks(SVHFrameDecoder& decoder,
+                        const std::vector<uint8_t>& stream,
+                        std::mt19937& random,
+                        const SVHFrameCallback& callback)
+{
+  std::uniform_int_distribution<size_t> chunk(1, 200);
+  size_t position = 0;
+  while (position < stream.size())
+  {
+    size_t size = std::min(chunk(random), stream.size() - position);
+    decoder.feed(stream.data() + position, size, callback);
+    position += size;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FramesSplitAtEveryPosition)
+{
+  std::mt19937 random(1);
+  SVHSerialPacket packet = randomPacket(random, 64);
+  std::vector<uint8_t> frame = encodeFrame(packet);
+
+  for (size_t split = 0; split <= frame.size(); ++split)
+  {
+    SVHFrameDecoder decoder;
+    FrameCollector collector;
+    decoder.feed(frame.data(), split, collector.callback());
+    decoder.feed(frame.data() + split, frame.size() - split, collector.callback());
+
+    BOOST_REQUIRE_EQUAL(collector.packets.size(), 1u);
+    BOOST_CHECK(collector.packets[0] == packet);
+    BOOST_CHECK_EQUAL(decoder.pendingBytes(), 0u);
+    BOOST_CHECK_EQUAL(decoder.statistics().skipped_bytes, 0u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ByteWiseFeedingFindsAllFrames)
+{
+  std::mt19937 random(2);
+  std::vector<SVHSerialPacket> packets;
+  std::vector<uint8_t> stream;
+  for (size_t length = 0; length <= C_MAXIMUM_PACKET_SIZE; length += 8)
+  {
+    packets.push_back(randomPacket(random, length));
+    std::vector<uint8_t> frame = encodeFrame(packets.back());
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+
+  SVHFrameDecoder decoder;
+  FrameCollector collector;
+  for (uint8_t byte : stream)
+  {
+    decoder.feed(&byte, 1, collector.callback());
+  }
+
+  BOOST_REQUIRE_EQUAL(collector.packets.size(), packets.size());
+  for (size_t i = 0; i < packets.size(); ++i)
+  {
+    BOOST_CHECK(collector.packets[i] == packets[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(BrokenFramesAreDropped)
+{
+  std::mt19937 random(3);
+  SVHSerialPacket first  = randomPacket(random, 64);
+  SVHSerialPacket second = randomPacket(random, 64);
+  std::vector<uint8_t> corrupted = encodeFrame(randomPacket(random, 64));
+  corrupted[20] ^= 0x01;
+  std::vector<uint8_t> oversized = encodeFrame(randomPacket(random, 16));
+  oversized[5] = 0x01; // length of 272 bytes
+
+  std::vector<uint8_t> stream = encodeFrame(first);
+  stream.insert(stream.end(), corrupted.begin(), corrupted.end());
+  stream.insert(stream.end(), oversized.begin(), oversized.end());
+  std::vector<uint8_t> frame = encodeFrame(second);
+  stream.insert(stream.end(), frame.begin(), frame.end());
+
+  SVHFrameDecoder decoder;
+  FrameCollector collector;
+  decoder.feed(stream.data(), stream.size(), collector.callback());
+
+  BOOST_REQUIRE_EQUAL(collector.packets.size(), 2u);
+  BOOST_CHECK(collector.packets[0] == first);
+  BOOST_CHECK(collector.packets[1] == second);
+  BOOST_CHECK_EQUAL(decoder.statistics().frames, 2u);
+  BOOST_CHECK_EQUAL(decoder.statistics().checksum_errors, 1u);
+  BOOST_CHECK_EQUAL(decoder.statistics().oversized_frames, 1u);
+  BOOST_CHECK_EQUAL(decoder.statistics().skipped_bytes, corrupted.size() + oversized.size());
+}
+
+BOOST_AUTO_TEST_CASE(FuzzFramesInNoise)
+{
+  std::mt19937 random(4);
+  std::uniform_int_distribution<int> noise_length(0, 100);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<size_t> length(0, C_MAXIMUM_PACKET_SIZE);
+
+  for (int round = 0; round < 50; ++round)
+  {
+    // Noise contains header bytes and may by chance even form a valid frame. The gap behind the
+    // noise is as long as the largest frame, so such a frame cannot overlap the real one.
+    std::vector<SVHSerialPacket> packets;
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 20; ++i)
+    {
+      for (int n = noise_length(random); n > 0; --n)
+      {
+        stream.push_back(n % 7 == 0 ? PACKET_HEADER1 : static_cast<uint8_t>(byte(random)));
+      }
+      stream.insert(stream.end(), C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE, 0);
+      packets.push_back(randomPacket(random, length(random)));
+      std::vector<uint8_t> frame = encodeFrame(packets.back());
+      stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    SVHFrameDecoder decoder;
+    FrameCollector collector;
+    feedInRandomChunks(decoder, stream, random, collector.callback());
+
+    // Every frame has to be found in order, frames formed by the noise are tolerated
+    size_t found = 0;
+    for (const SVHSerialPacket& packet : collector.packets)
+    {
+      if (found < packets.size() && packet == packets[found])
+      {
+        found++;
+      }
+    }
+    BOOST_CHECK_EQUAL(found, packets.size());
+    BOOST_CHECK(decoder.statistics().skipped_bytes > 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FuzzRandomBytes)
+{
+  std::mt19937 random(5);
+  std::uniform_int_distribution<int> byte(0, 255);
+
+  // Arbitrary input must never produce invalid frames or let the decoder hold more than a frame
+  SVHFrameDecoder decoder;
+  uint64_t frames = 0;
+  for (int round = 0; round < 200; ++round)
+  {
+    std::vector<uint8_t> stream(1000);
+    for (uint8_t& value : stream)
+    {
+      // Bias towards the header bytes to reach the deeper states more often
+      int pick = byte(random);
+      value    = pick < 32 ? PACKET_HEADER1 : (pick < 64 ? PACKET_HEADER2 : byte(random));
+    }
+    feedInRandomChunks(decoder, stream, random, [&](const SVHFrameView& frame) {
+      BOOST_REQUIRE(frame.length <= C_MAXIMUM_PACKET_SIZE);
+      uint8_t check_sum1 = 0;
+      uint8_t check_sum2 = 0;
+      for (size_t i = 0; i < frame.length; ++i)
+      {
+        check_sum1 += frame.payload[i];
+        check_sum2 ^= frame.payload[i];
+      }
+      BOOST_REQUIRE_EQUAL(check_sum1, frame.payload[frame.length]);
+      BOOST_REQUIRE_EQUAL(check_sum2, frame.payload[frame.length + 1]);
+      frames++;
+    });
+    BOOST_REQUIRE(decoder.pendingBytes() < SVHFrameDecoder::C_MAXIMUM_FRAME_SIZE);
+  }
+  BOOST_CHECK_EQUAL(decoder.statistics().frames, frames);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
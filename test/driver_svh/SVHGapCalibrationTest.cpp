@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/control/SVHGapCalibration.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <chrono>
+#include <fstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHGapCalibration)
+
+BOOST_AUTO_TEST_CASE(ShortestAnsweredGapIsCalibratedAndCached)
+{
+  char directory[] = "/tmp/svh_gap_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(directory) != NULL);
+  const std::string cache_file = std::string(directory) + "/gaps";
+
+  // The simulated hand drops requests that follow each other within 1ms
+  SVHSimulatorSettings simulator_settings;
+  simulator_settings.minimum_gap = std::chrono::microseconds(1000);
+
+  SVHGapCalibrationSettings settings;
+  settings.enabled       = true;
+  settings.longest_gap   = std::chrono::microseconds(3000);
+  settings.shortest_gap  = std::chrono::microseconds(200);
+  settings.step          = std::chrono::microseconds(400);
+  settings.probe_frames  = 10;
+  settings.safety_margin = 0.2;
+  settings.cache_file    = cache_file;
+
+  // The connection itself has to use a gap the hand can take
+  SVHTransportOptions options;
+  options.transmission_gap = std::chrono::microseconds(3000);
+
+  SVHGapCalibrationReport first;
+  for (int connection = 0; connection < 2; ++connection)
+  {
+    std::shared_ptr<SVHPipeTransport> library_end;
+    std::shared_ptr<SVHPipeTransport> hand_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+    SVHSimulator simulator(simulator_settings);
+    BOOST_REQUIRE(simulator.start(hand_end));
+
+    SVHFingerManager manager;
+    manager.setTransportOptions(options);
+    manager.setGapCalibration(settings);
+    BOOST_REQUIRE(manager.connect(library_end));
+    SVHGapCalibrationReport report = manager.gapCalibrationReport();
+    BOOST_REQUIRE(report.calibrated);
+    BOOST_CHECK_EQUAL(report.device, library_end->deviceName());
+
+    if (connection == 0)
+    {
+      // Delayed scheduling can only make a probe fail early, never let a too short gap pass
+      BOOST_CHECK(!report.cached);
+      BOOST_REQUIRE(!report.probes.empty());
+      BOOST_CHECK(report.gap >= simulator_settings.minimum_gap);
+      BOOST_CHECK(report.gap <= settings.longest_gap);
+      BOOST_CHECK_EQUAL(report.probes.front().gap.count(), settings.longest_gap.count());
+      BOOST_CHECK_EQUAL(report.probes.front().answered, settings.probe_frames);
+      BOOST_CHECK(report.probes.back().answered < report.probes.back().sent);
+      BOOST_CHECK(report.probes.back().gap < 2 * simulator_settings.minimum_gap);
+      first = report;
+    }
+    else
+    {
+      BOOST_CHECK(report.cached);
+      BOOST_CHECK(report.probes.empty());
+      BOOST_CHECK_EQUAL(report.gap.count(), first.gap.count());
+    }
+    BOOST_CHECK_EQUAL(manager.getTransmitStatistics().write_errors, 0u);
+    BOOST_CHECK_EQUAL(manager.getTransportOptions().transmission_gap.count(), report.gap.count());
+    manager.disconnect();
+    simulator.stop();
+  }
+
+  unlink(cache_file.c_str());
+  rmdir(directory);
+}
+
+BOOST_AUTO_TEST_CASE(CacheKeepsTheEntriesOfOtherDevices)
+{
+  char path[] = "/tmp/svh_gap_cache_XXXXXX";
+  int fd      = mkstemp(path);
+  BOOST_REQUIRE(fd >= 0);
+  ::close(fd);
+
+  std::chrono::microseconds gap(0);
+  BOOST_CHECK(!SVHGapCalibration::loadGap(path, "usb-A", gap));
+  BOOST_REQUIRE(SVHGapCalibration::storeGap(path, "usb-A", std::chrono::microseconds(600)));
+  BOOST_REQUIRE(
+    SVHGapCalibration::storeGap(path, "/dev/tty with space", std::chrono::microseconds(700)));
+  BOOST_REQUIRE(SVHGapCalibration::storeGap(path, "usb-A", std::chrono::microseconds(650)));
+
+  BOOST_CHECK(SVHGapCalibration::loadGap(path, "usb-A", gap));
+  BOOST_CHECK_EQUAL(gap.count(), 650);
+  BOOST_CHECK(SVHGapCalibration::loadGap(path, "/dev/tty with space", gap));
+  BOOST_CHECK_EQUAL(gap.count(), 700);
+  BOOST_CHECK(!SVHGapCalibration::loadGap(path, "usb-B", gap));
+
+  unlink(path);
+}
+
+BOOST_AUTO_TEST_CASE(UsbAdaptersAreIdentifiedBySerialNumber)
+{
+  // Minimal sysfs tree of an adapter: the tty links into the interface of the USB device
+  char root[] = "/tmp/svh_sysfs_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(root) != NULL);
+  const std::string base      = root;
+  const std::string usb       = base + "/devices/usb1/1-1";
+  const std::string interface = usb + "/1-1:1.0";
+  BOOST_REQUIRE(mkdir((base + "/devices").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir((base + "/devices/usb1").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir(usb.c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir(interface.c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir((base + "/class").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir((base + "/class/tty").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir((base + "/class/tty/ttyUSB7").c_str(), 0755) == 0);
+  BOOST_REQUIRE(symlink(interface.c_str(), (base + "/class/tty/ttyUSB7/device").c_str()) == 0);
+  std::ofstream(usb + "/serial") << "FT12AB34" << std::endl;
+
+  BOOST_CHECK_EQUAL(SVHGapCalibration::deviceIdentifier("/dev/ttyUSB7", base), "usb-FT12AB34");
+  BOOST_CHECK_EQUAL(SVHGapCalibration::deviceIdentifier("/dev/ttyUSB8", base), "/dev/ttyUSB8");
+
+  unlink((usb + "/serial").c_str());
+  unlink((base + "/class/tty/ttyUSB7/device").c_str());
+  rmdir((base + "/class/tty/ttyUSB7").c_str());
+  rmdir((base + "/class/tty").c_str());
+  rmdir((base + "/class").c_str());
+  rmdir(interface.c_str());
+  rmdir(usb.c_str());
+  rmdir((base + "/devices/usb1").c_str());
+  rmdir((base + "/devices").c_str());
+  rmdir(root);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/control/SVHHomingCalibration.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHHomingCalibration)
+
+namespace {
+
+const uint16_t C_SPREAD_BIT = 1 << SVH_FINGER_SPREAD;
+
+//! Only the finger spread is used
+std::vector<bool> disableMask()
+{
+  std::vector<bool> disable_mask(SVH_DIMENSION, true);
+  disable_mask[SVH_FINGER_SPREAD] = false;
+  return disable_mask;
+}
+
+//! Connects a new finger manager to the simulator, like a restarted application
+struct Connection
+{
+  Connection(SVHSimulator& simulator, const SVHHomingCalibrationSettings& settings)
+    : simulator(simulator)
+    , manager(disableMask())
+  {
+    std::shared_ptr<SVHPipeTransport> hand_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+    BOOST_REQUIRE(simulator.start(hand_end));
+    manager.setHomingCalibration(settings);
+    BOOST_REQUIRE(manager.connect(library_end));
+  }
+
+  ~Connection()
+  {
+    manager.disconnect();
+    simulator.stop();
+  }
+
+  //! Homes the finger spread and returns the furthest position it reached meanwhile
+  int32_t resetSpread()
+  {
+    std::atomic<bool> running(true);
+    std::atomic<int32_t> furthest(0);
+    std::thread sampler([&] {
+      while (running)
+      {
+        furthest = std::max<int32_t>(furthest, std::abs(simulator.position(SVH_FINGER_SPREAD)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+    BOOST_CHECK(manager.resetChannel(SVH_FINGER_SPREAD));
+    running = false;
+    sampler.join();
+    return furthest;
+  }
+
+  SVHSimulator& simulator;
+  std::shared_ptr<SVHPipeTransport> library_end;
+  SVHFingerManager manager;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(RestartedManagerChecksTheStoredCalibrationInsteadOfHoming)
+{
+  char directory[] = "/tmp/svh_homing_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(directory) != NULL);
+
+  SVHHomingCalibrationSettings settings;
+  settings.enabled    = true;
+  settings.cache_file = std::string(directory) + "/calibration";
+
+  SVHSimulatorSettings simulator_settings;
+  simulator_settings.speed_scale = 50;
+  SVHSimulator simulator(simulator_settings);
+
+  int32_t home = 0;
+  double home_rad = 0;
+  {
+    Connection first(simulator, settings);
+    SVHHomingCalibrationReport report = first.manager.homingCalibrationReport();
+    BOOST_CHECK_EQUAL(report.device, first.library_end->deviceName());
+    BOOST_CHECK(!report.loaded);
+    BOOST_CHECK_EQUAL(report.restored_mask, 0);
+
+    // The homing drives against the hard stop
+    BOOST_CHECK(first.resetSpread() >= simulator_settings.hard_stop);
+    BOOST_REQUIRE(first.manager.isHomed(SVH_FINGER_SPREAD));
+    home = simulator.position(SVH_FINGER_SPREAD);
+    BOOST_REQUIRE(first.manager.getPosition(SVH_FINGER_SPREAD, home_rad));
+  }
+
+  {
+    Connection second(simulator, settings);
+    SVHHomingCalibrationReport report = second.manager.homingCalibrationReport();
+    BOOST_CHECK(report.loaded);
+    BOOST_CHECK_EQUAL(report.restored_mask, C_SPREAD_BIT);
+
+    // The check stays clear of the hard stop and ends at the same idle position. Both homings
+    // stop within 1000 ticks of it, approaching it from different sides.
+    BOOST_CHECK(second.resetSpread() < simulator_settings.hard_stop);
+    BOOST_CHECK(second.manager.isHomed(SVH_FINGER_SPREAD));
+    BOOST_CHECK_EQUAL(second.manager.homingCalibrationReport().verified_mask, C_SPREAD_BIT);
+    BOOST_CHECK(std::abs(simulator.position(SVH_FINGER_SPREAD) - home) < 2000);
+
+    double position = 0;
+    BOOST_REQUIRE(second.manager.getPosition(SVH_FINGER_SPREAD, position));
+    BOOST_CHECK_SMALL(position - home_rad, 0.05);
+  }
+
+  {
+    // A switched off hand starts counting at zero, the channel is homed completely
+    SVHSimulator power_cycled(simulator_settings);
+    Connection third(power_cycled, settings);
+    SVHHomingCalibrationReport report = third.manager.homingCalibrationReport();
+    BOOST_CHECK(report.loaded);
+    BOOST_CHECK_EQUAL(report.restored_mask, 0);
+    BOOST_CHECK(third.resetSpread() >= simulator_settings.hard_stop);
+    BOOST_CHECK_EQUAL(third.manager.homingCalibrationReport().verified_mask, 0);
+    BOOST_CHECK(third.manager.isHomed(SVH_FINGER_SPREAD));
+  }
+
+  unlink(settings.cache_file.c_str());
+  rmdir(directory);
+}
+
+BOOST_AUTO_TEST_CASE(SettledFingerUpdatesTheStoredEncoderPosition)
+{
+  char directory[] = "/tmp/svh_homing_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(directory) != NULL);
+
+  SVHHomingCalibrationSettings settings;
+  settings.enabled    = true;
+  settings.cache_file = std::string(directory) + "/calibration";
+
+  SVHSimulatorSettings simulator_settings;
+  simulator_settings.speed_scale = 50;
+  SVHSimulator simulator(simulator_settings);
+
+  {
+    Connection connection(simulator, settings);
+    connection.resetSpread();
+    BOOST_REQUIRE(connection.manager.isHomed(SVH_FINGER_SPREAD));
+    const int32_t home = simulator.position(SVH_FINGER_SPREAD);
+    BOOST_REQUIRE(connection.manager.setTargetPosition(SVH_FINGER_SPREAD, 0.1, 0.0));
+
+    // The cache follows the finger without a disconnect, as after a crash of the application
+    const std::string device = connection.library_end->deviceName();
+    std::vector<SVHChannelCalibration> loaded;
+    int32_t position = 0;
+    for (size_t i = 0; i < 50; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      position = simulator.position(SVH_FINGER_SPREAD);
+      BOOST_REQUIRE(SVHHomingCalibration::load(settings.cache_file, device, loaded));
+      if (std::abs(loaded[SVH_FINGER_SPREAD].encoder_position - position) <=
+          settings.position_tolerance)
+      {
+        break;
+      }
+    }
+    BOOST_CHECK(loaded[SVH_FINGER_SPREAD].valid);
+    BOOST_CHECK(std::abs(loaded[SVH_FINGER_SPREAD].encoder_position - position) <=
+                settings.position_tolerance);
+    BOOST_CHECK(std::abs(position - simulator.target(SVH_FINGER_SPREAD)) < 1000);
+    BOOST_CHECK(std::abs(position - home) > 2 * settings.position_tolerance);
+  }
+
+  unlink(settings.cache_file.c_str());
+  rmdir(directory);
+}
+
+BOOST_AUTO_TEST_CASE(CacheKeepsTheCalibrationsOfOtherDevices)
+{
+  char path[] = "/tmp/svh_homing_cache_XXXXXX";
+  int fd      = mkstemp(path);
+  BOOST_REQUIRE(fd >= 0);
+  ::close(fd);
+
+  std::vector<SVHChannelCalibration> calibrations(SVH_DIMENSION);
+  calibrations[SVH_PINKY].valid            = true;
+  calibrations[SVH_PINKY].position_min     = -45000;
+  calibrations[SVH_PINKY].position_max     = -100;
+  calibrations[SVH_PINKY].position_home    = -6000;
+  calibrations[SVH_PINKY].encoder_position = -6100;
+
+  std::vector<SVHChannelCalibration> loaded;
+  BOOST_CHECK(!SVHHomingCalibration::load(path, "usb-A", loaded));
+  BOOST_CHECK_EQUAL(loaded.size(), static_cast<size_t>(SVH_DIMENSION));
+  BOOST_REQUIRE(SVHHomingCalibration::store(path, "usb-A", calibrations));
+  BOOST_REQUIRE(SVHHomingCalibration::store(path, "/dev/tty with space", calibrations));
+  calibrations[SVH_PINKY].encoder_position = -5900;
+  BOOST_REQUIRE(SVHHomingCalibration::store(path, "usb-A", calibrations));
+
+  BOOST_REQUIRE(SVHHomingCalibration::load(path, "usb-A", loaded));
+  BOOST_CHECK(loaded[SVH_PINKY].valid);
+  BOOST_CHECK(!loaded[SVH_THUMB_FLEXION].valid);
+  BOOST_CHECK_EQUAL(loaded[SVH_PINKY].position_min, -45000);
+  BOOST_CHECK_EQUAL(loaded[SVH_PINKY].position_max, -100);
+  BOOST_CHECK_EQUAL(loaded[SVH_PINKY].position_home, -6000);
+  BOOST_CHECK_EQUAL(loaded[SVH_PINKY].encoder_position, -5900);
+  BOOST_REQUIRE(SVHHomingCalibration::load(path, "/dev/tty with space", loaded));
+  BOOST_CHECK_EQUAL(loaded[SVH_PINKY].encoder_position, -6100);
+  BOOST_CHECK(!SVHHomingCalibration::load(path, "usb-B", loaded));
+
+  BOOST_CHECK(SVHHomingCalibration::isConsistent(calibrations[SVH_PINKY], -6800, 1000));
+  BOOST_CHECK(!SVHHomingCalibration::isConsistent(calibrations[SVH_PINKY], 0, 1000));
+  BOOST_CHECK(!SVHHomingCalibration::isConsistent(calibrations[SVH_THUMB_FLEXION], 0, 1000));
+
+  unlink(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/control/SVHHomingProfile.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <cstdlib>
+#include <memory>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHHomingProfile)
+
+namespace {
+
+//! Only the finger spread is used
+std::vector<bool> disableMask()
+{
+  std::vector<bool> disable_mask(SVH_DIMENSION, true);
+  disable_mask[SVH_FINGER_SPREAD] = false;
+  return disable_mask;
+}
+
+//! Finger manager connected to a simulated hand
+struct Hand
+{
+  explicit Hand(const SVHSimulatorSettings& settings)
+    : settings(settings)
+    , simulator(settings)
+    , manager(disableMask())
+  {
+  }
+
+  ~Hand()
+  {
+    manager.disconnect();
+    simulator.stop();
+  }
+
+  void connect()
+  {
+    std::shared_ptr<SVHPipeTransport> hand_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+    BOOST_REQUIRE(simulator.start(hand_end));
+    BOOST_REQUIRE(manager.connect(library_end));
+  }
+
+  //! Idle position of the finger spread in the simulator, 25000 ticks before its hard stop
+  int32_t expectedHome() const { return settings.hard_stop - 25000; }
+
+  SVHSimulatorSettings settings;
+  SVHSimulator simulator;
+  std::shared_ptr<SVHPipeTransport> library_end;
+  SVHFingerManager manager;
+};
+
+SVHSimulatorSettings fastSimulator()
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  return settings;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(KnownHardstopIsApproachedQuickly)
+{
+  Hand hand(fastSimulator());
+  hand.connect();
+
+  // Nothing is known about the hard stop yet, it is searched slowly all the way
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  const SVHHomingTimings first = hand.manager.homingTimings(SVH_FINGER_SPREAD);
+  BOOST_CHECK_EQUAL(first.fast_approach.count(), 0);
+  BOOST_CHECK(first.hardstop_search.count() > 0);
+  BOOST_CHECK(first.go_to_idle.count() > 0);
+  BOOST_CHECK(first.total >= first.hardstop_search + first.go_to_idle);
+  const int32_t home = hand.simulator.position(SVH_FINGER_SPREAD);
+  BOOST_CHECK(std::abs(home - hand.expectedHome()) < 3000);
+
+  // The second homing knows where to expect it
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  const SVHHomingTimings second = hand.manager.homingTimings(SVH_FINGER_SPREAD);
+  BOOST_CHECK(second.fast_approach.count() > 0);
+  BOOST_CHECK(!second.early_contact);
+  BOOST_CHECK(second.hardstop_search * 2 < first.hardstop_search);
+  BOOST_CHECK(hand.manager.isHomed(SVH_FINGER_SPREAD));
+  BOOST_CHECK(std::abs(hand.simulator.position(SVH_FINGER_SPREAD) - home) < 2000);
+}
+
+BOOST_AUTO_TEST_CASE(EarlyContactEndsTheFastApproach)
+{
+  Hand hand(fastSimulator());
+  hand.connect();
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  const int32_t home = hand.simulator.position(SVH_FINGER_SPREAD);
+
+  // An object now blocks the finger well before the hard stop measured by the first homing
+  hand.simulator.setHardStop(home + 7000, 5000);
+
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  const SVHHomingTimings timings = hand.manager.homingTimings(SVH_FINGER_SPREAD);
+  BOOST_CHECK(timings.fast_approach.count() > 0);
+  BOOST_CHECK(timings.early_contact);
+  BOOST_CHECK(timings.hardstop_search.count() > 0);
+  BOOST_CHECK(hand.manager.isHomed(SVH_FINGER_SPREAD));
+  BOOST_CHECK(hand.simulator.position(SVH_FINGER_SPREAD) < home);
+}
+
+BOOST_AUTO_TEST_CASE(MovedEncoderIsSearchedSlowly)
+{
+  char directory[] = "/tmp/svh_homing_profile_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(directory) != NULL);
+
+  SVHHomingCalibrationSettings calibration;
+  calibration.enabled    = true;
+  calibration.cache_file = std::string(directory) + "/calibration";
+
+  {
+    Hand hand(fastSimulator());
+    hand.manager.setHomingCalibration(calibration);
+    hand.connect();
+    BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  }
+
+  {
+    // The hand was switched off, the stored hard stop says nothing about the current one
+    SVHSimulatorSettings moved = fastSimulator();
+    moved.hard_stop            = 12000;
+    moved.stop_compliance      = 5000;
+    Hand hand(moved);
+    hand.manager.setHomingCalibration(calibration);
+    hand.connect();
+    BOOST_CHECK_EQUAL(hand.manager.homingCalibrationReport().restored_mask, 0);
+
+    BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+    const SVHHomingTimings timings = hand.manager.homingTimings(SVH_FINGER_SPREAD);
+    BOOST_CHECK_EQUAL(timings.fast_approach.count(), 0);
+    BOOST_CHECK(!timings.early_contact);
+    BOOST_CHECK(hand.manager.isHomed(SVH_FINGER_SPREAD));
+    BOOST_CHECK(std::abs(hand.simulator.position(SVH_FINGER_SPREAD) - hand.expectedHome()) < 3000);
+  }
+
+  unlink(calibration.cache_file.c_str());
+  rmdir(directory);
+}
+
+BOOST_AUTO_TEST_CASE(RejectedCalibrationIsSearchedSlowly)
+{
+  SVHHomingCalibrationSettings calibration;
+  calibration.enabled = true;
+
+  Hand hand(fastSimulator());
+  hand.manager.setHomingCalibration(calibration);
+  hand.connect();
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  const int32_t home = hand.simulator.position(SVH_FINGER_SPREAD);
+
+  // While disconnected, an object is placed right in the way of the plausibility move
+  hand.manager.disconnect();
+  hand.simulator.stop();
+  hand.simulator.setHardStops(home - 2000, hand.settings.hard_stop, 1000);
+  hand.connect();
+  BOOST_REQUIRE_EQUAL(hand.manager.homingCalibrationReport().restored_mask,
+                      1 << SVH_FINGER_SPREAD);
+
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  BOOST_CHECK_EQUAL(hand.manager.homingCalibrationReport().verified_mask, 0);
+  const SVHHomingTimings timings = hand.manager.homingTimings(SVH_FINGER_SPREAD);
+  BOOST_CHECK_EQUAL(timings.fast_approach.count(), 0);
+  BOOST_CHECK(timings.hardstop_search.count() > 0);
+  BOOST_CHECK(hand.manager.isHomed(SVH_FINGER_SPREAD));
+  BOOST_CHECK(std::abs(hand.simulator.position(SVH_FINGER_SPREAD) - home) < 2000);
+}
+
+BOOST_AUTO_TEST_CASE(ReducedSearchCurrentFindsTheSameHardstop)
+{
+  Hand hand(fastSimulator());
+
+  SVHHomingProfile profile;
+  profile.search_current_factor = 1.5f;
+  BOOST_CHECK(!hand.manager.setHomingProfile(profile));
+  profile.search_current_factor = 0.5f;
+  profile.approach_speed_factor = 0.0f;
+  BOOST_CHECK(!hand.manager.setHomingProfile(profile));
+  profile.approach_speed_factor = 1.0f;
+  profile.fast_approach         = false;
+  BOOST_REQUIRE(hand.manager.setHomingProfile(profile));
+
+  hand.connect();
+  BOOST_CHECK(!hand.manager.setHomingProfile(profile));
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  BOOST_CHECK(std::abs(hand.simulator.position(SVH_FINGER_SPREAD) - hand.expectedHome()) < 3000);
+
+  // Without the fast approach the known hard stop is searched slowly again
+  BOOST_REQUIRE(hand.manager.resetChannel(SVH_FINGER_SPREAD));
+  BOOST_CHECK_EQUAL(hand.manager.homingTimings(SVH_FINGER_SPREAD).fast_approach.count(), 0);
+  BOOST_CHECK(hand.manager.isHomed(SVH_FINGER_SPREAD));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
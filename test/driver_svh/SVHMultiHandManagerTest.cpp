@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHMultiHandManager.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHMultiHandManager)
+
+//! Polls the condition until it holds or the timeout expires
+template <typename Condition>
+bool waitFor(Condition condition, const std::chrono::milliseconds& timeout)
+{
+  auto end_time = std::chrono::steady_clock::now() + timeout;
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > end_time)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(ReactorDispatchesDescriptorsAndTimers)
+{
+  SVHReactor reactor;
+  BOOST_REQUIRE(reactor.start());
+
+  int pipe_fds[2];
+  BOOST_REQUIRE(pipe(pipe_fds) == 0);
+
+  std::atomic<unsigned int> bytes_read{0};
+  BOOST_CHECK(reactor.addDescriptor(pipe_fds[0], [&](uint32_t events) {
+    BOOST_CHECK(events & SVHReactor::EV_READABLE);
+    char buffer[16];
+    bytes_read += static_cast<unsigned int>(read(pipe_fds[0], buffer, sizeof(buffer)));
+  }));
+  BOOST_CHECK(!reactor.addDescriptor(pipe_fds[0], [](uint32_t) {}));
+
+  std::atomic<unsigned int> timer_calls{0};
+  int timer = reactor.addTimer(std::chrono::milliseconds(5), [&] { timer_calls++; });
+  BOOST_CHECK(timer >= 0);
+
+  BOOST_CHECK(write(pipe_fds[1], "abc", 3) == 3);
+  BOOST_CHECK(waitFor([&] { return bytes_read == 3; }, std::chrono::milliseconds(1000)));
+  BOOST_CHECK(waitFor([&] { return timer_calls >= 3; }, std::chrono::milliseconds(1000)));
+
+  // Nothing is dispatched after the removal returned
+  reactor.removeTimer(timer);
+  reactor.removeDescriptor(pipe_fds[0]);
+  unsigned int calls = timer_calls;
+  BOOST_CHECK(write(pipe_fds[1], "def", 3) == 3);
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  BOOST_CHECK_EQUAL(bytes_read, 3u);
+  BOOST_CHECK_EQUAL(timer_calls, calls);
+
+  reactor.stop();
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(AllHandsAreServiced)
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  std::vector<std::unique_ptr<SVHSimulator>> simulators;
+
+  SVHMultiHandManager manager(std::chrono::milliseconds(20));
+  for (size_t i = 0; i < 3; ++i)
+  {
+    simulators.emplace_back(new SVHSimulator(settings));
+    BOOST_REQUIRE(simulators.back()->start());
+    BOOST_CHECK_EQUAL(manager.addHand(), i);
+  }
+  BOOST_CHECK_EQUAL(manager.size(), 3u);
+
+  for (size_t i = 0; i < simulators.size(); ++i)
+  {
+    BOOST_REQUIRE(manager.connect(i, simulators[i]->deviceName()));
+  }
+
+  // Every hand is polled and answers through the shared reactor
+  BOOST_CHECK(waitFor(
+    [&] {
+      for (size_t i = 0; i < manager.size(); ++i)
+      {
+        if (manager.statistics(i).feedback_polls < 5)
+        {
+          return false;
+        }
+      }
+      return true;
+    },
+    std::chrono::milliseconds(2000)));
+
+  for (size_t i = 0; i < manager.size(); ++i)
+  {
+    SVHHandStatistics statistics = manager.statistics(i);
+    BOOST_CHECK(statistics.connected);
+    BOOST_CHECK(!statistics.failed);
+    BOOST_CHECK(statistics.receive.packets > statistics.feedback_polls / 2);
+    BOOST_CHECK_EQUAL(statistics.receive.read_errors, 0u);
+  }
+
+  // Each hand has its own command interface
+  BOOST_REQUIRE(manager.hand(1).resetChannel(SVH_FINGER_SPREAD));
+  BOOST_CHECK(manager.hand(1).isHomed(SVH_FINGER_SPREAD));
+  BOOST_CHECK(!manager.hand(0).isHomed(SVH_FINGER_SPREAD));
+  BOOST_CHECK(manager.hand(1).setTargetPosition(SVH_FINGER_SPREAD, 0.2, 0.0));
+  BOOST_CHECK(!manager.hand(0).setTargetPosition(SVH_FINGER_SPREAD, 0.2, 0.0));
+  BOOST_CHECK(waitFor([&] { return simulators[1]->isEnabled(SVH_FINGER_SPREAD); },
+                      std::chrono::milliseconds(1000)));
+  BOOST_CHECK(!simulators[0]->isEnabled(SVH_FINGER_SPREAD));
+  BOOST_CHECK(!simulators[2]->isEnabled(SVH_FINGER_SPREAD));
+
+  BOOST_CHECK_THROW(manager.hand(3), std::out_of_range);
+  BOOST_CHECK(!manager.connect(3, simulators[0]->deviceName()));
+
+  manager.disconnectAll();
+  BOOST_CHECK(!manager.statistics(0).connected);
+}
+
+BOOST_AUTO_TEST_CASE(FailedHandDoesNotStallOthers)
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  SVHSimulator first(settings);
+  SVHSimulator second(settings);
+  BOOST_REQUIRE(first.start());
+  BOOST_REQUIRE(second.start());
+
+  SVHMultiHandManager manager(std::chrono::milliseconds(20));
+  manager.addHand();
+  manager.addHand();
+  BOOST_REQUIRE(manager.connect(0, first.deviceName()));
+  BOOST_REQUIRE(manager.connect(1, second.deviceName()));
+
+  // Closing the pseudo terminal hangs up the serial device of the first hand
+  first.stop();
+  BOOST_CHECK(waitFor([&] { return manager.statistics(0).failed; },
+                      std::chrono::milliseconds(2000)));
+  uint64_t failed_polls = manager.statistics(0).feedback_polls;
+
+  uint64_t packets = manager.statistics(1).receive.packets;
+  BOOST_CHECK(waitFor([&] { return manager.statistics(1).receive.packets >= packets + 10; },
+                      std::chrono::milliseconds(2000)));
+  BOOST_CHECK(!manager.statistics(1).failed);
+  BOOST_CHECK_EQUAL(manager.statistics(0).feedback_polls, failed_polls);
+
+  // The failed hand can be reconnected once its device is back
+  BOOST_REQUIRE(first.start());
+  BOOST_CHECK(manager.connect(0, first.deviceName()));
+  BOOST_CHECK(!manager.statistics(0).failed);
+}
+
+BOOST_AUTO_TEST_CASE(HeldHandDoesNotStallThePolls)
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  SVHSimulator first(settings);
+  SVHSimulator second(settings);
+  BOOST_REQUIRE(first.start());
+  BOOST_REQUIRE(second.start());
+
+  SVHMultiHandManager manager(std::chrono::milliseconds(20));
+  manager.addHand();
+  manager.addHand();
+  BOOST_REQUIRE(manager.connect(0, first.deviceName()));
+  BOOST_REQUIRE(manager.connect(1, second.deviceName()));
+
+  // The polls of the held hand are queued, the reactor keeps servicing the other one
+  manager.hand(0).holdTransmission();
+  uint64_t frames  = manager.statistics(0).transmit.frames;
+  uint64_t packets = manager.statistics(1).receive.packets;
+  BOOST_CHECK(waitFor([&] { return manager.statistics(1).receive.packets >= packets + 10; },
+                      std::chrono::milliseconds(2000)));
+  BOOST_CHECK_EQUAL(manager.statistics(0).transmit.frames, frames);
+
+  // The queued polls are written once the hand is released
+  BOOST_CHECK(manager.hand(0).releaseTransmission());
+  BOOST_CHECK(waitFor([&] { return manager.statistics(0).transmit.frames > frames; },
+                      std::chrono::milliseconds(1000)));
+}
+
+BOOST_AUTO_TEST_CASE(WindowedHandIsPolledWithoutLosingReplies)
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  SVHSimulator simulator(settings);
+  BOOST_REQUIRE(simulator.start());
+
+  SVHTransportOptions options;
+  options.transmit_window = 1;
+
+  SVHMultiHandManager manager(std::chrono::milliseconds(5));
+  manager.addHand();
+  manager.hand(0).setTransportOptions(options);
+  BOOST_REQUIRE(manager.connect(0, simulator.deviceName()));
+
+  // The replies to the frames of the application are read by the reactor, a poll waiting for the
+  // free window in the reactor thread would block them until the reply timeout
+  const auto end_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+  while (std::chrono::steady_clock::now() < end_time)
+  {
+    manager.hand(0).requestControllerFeedback(SVH_ALL);
+  }
+
+  SVHHandStatistics statistics = manager.statistics(0);
+  BOOST_CHECK(statistics.feedback_polls > 10u);
+  BOOST_CHECK(statistics.transmit.replies > 0u);
+  BOOST_CHECK_EQUAL(statistics.transmit.lost_replies, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GroupCommandIsReleasedTogether)
+{
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  SVHSimulator first(settings);
+  SVHSimulator second(settings);
+  BOOST_REQUIRE(first.start());
+  BOOST_REQUIRE(second.start());
+
+  // Only the finger spread is used, it homes quickly
+  std::vector<bool> disable_mask(SVH_DIMENSION, true);
+  disable_mask[SVH_FINGER_SPREAD] = false;
+
+  SVHMultiHandManager manager;
+  manager.addHand(disable_mask);
+  manager.addHand(disable_mask);
+  BOOST_REQUIRE(manager.connect(0, first.deviceName()));
+  BOOST_REQUIRE(manager.connect(1, second.deviceName()));
+  BOOST_REQUIRE(manager.hand(0).resetChannel(SVH_FINGER_SPREAD));
+  BOOST_REQUIRE(manager.hand(1).resetChannel(SVH_FINGER_SPREAD));
+
+  std::vector<std::vector<double> > positions(2, std::vector<double>(SVH_DIMENSION, 0.0));
+  positions[0][SVH_FINGER_SPREAD] = 0.1;
+  positions[1][SVH_FINGER_SPREAD] = 0.2;
+
+  SVHGroupDispatchReport report;
+  BOOST_CHECK(manager.setAllTargetPositions(positions, &report));
+  BOOST_CHECK(report.success);
+  BOOST_REQUIRE_EQUAL(report.offsets.size(), 2u);
+  BOOST_CHECK(report.offsets[0] == std::chrono::nanoseconds(0) ||
+              report.offsets[1] == std::chrono::nanoseconds(0));
+  BOOST_CHECK(std::max(report.offsets[0], report.offsets[1]) == report.skew);
+  // Far below the frame time that separated the hands before, with margin for loaded machines
+  BOOST_CHECK(report.skew < std::chrono::milliseconds(5));
+
+  // The channels were enabled before the commands were released
+  int32_t first_target  = manager.hand(0).convertRad2Ticks(SVH_FINGER_SPREAD, 0.1);
+  int32_t second_target = manager.hand(1).convertRad2Ticks(SVH_FINGER_SPREAD, 0.2);
+  BOOST_CHECK(waitFor([&] { return first.target(SVH_FINGER_SPREAD) == first_target; },
+                      std::chrono::milliseconds(1000)));
+  BOOST_CHECK(waitFor([&] { return second.target(SVH_FINGER_SPREAD) == second_target; },
+                      std::chrono::milliseconds(1000)));
+  BOOST_CHECK(first.isEnabled(SVH_FINGER_SPREAD));
+  BOOST_CHECK(second.isEnabled(SVH_FINGER_SPREAD));
+
+  // Mismatching input is rejected before anything is sent
+  positions.pop_back();
+  BOOST_CHECK(!manager.setAllTargetPositions(positions, &report));
+  BOOST_CHECK(!report.success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
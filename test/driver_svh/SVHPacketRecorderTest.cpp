@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+
+#include <set>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHPacketRecorder)
+
+//! Unique capture file that is removed again
+struct CaptureFile
+{
+  CaptureFile()
+  {
+    char name[] = "/tmp/svh_capture_XXXXXX";
+    int fd      = mkstemp(name);
+    BOOST_REQUIRE(fd >= 0);
+    ::close(fd);
+    path = name;
+  }
+
+  ~CaptureFile() { unlink(path.c_str()); }
+
+  std::string path;
+};
+
+//! Records a transmitted frame whose bytes are derived from value
+void recordFrame(SVHPacketRecorder& recorder, uint32_t value)
+{
+  uint8_t frame[12];
+  for (size_t i = 0; i < sizeof(frame); ++i)
+  {
+    frame[i] = static_cast<uint8_t>(value >> (8 * (i % 4)));
+  }
+  struct iovec buffers[2];
+  buffers[0].iov_base = frame;
+  buffers[0].iov_len  = 4;
+  buffers[1].iov_base = frame + 4;
+  buffers[1].iov_len  = sizeof(frame) - 4;
+  recorder.record(CD_TRANSMIT, CS_OK, buffers, 2);
+}
+
+//! Restores the value of a frame written by recordFrame, or returns false if it is torn
+bool frameValue(const SVHCaptureRecord& record, uint32_t& value)
+{
+  if (record.length != 12)
+  {
+    return false;
+  }
+  value = static_cast<uint32_t>(record.frame[0] | (record.frame[1] << 8) |
+                                (record.frame[2] << 16) | (record.frame[3] << 24));
+  for (size_t i = 4; i < record.length; ++i)
+  {
+    if (record.frame[i] != record.frame[i % 4])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(RingKeepsTheNewestFrames)
+{
+  CaptureFile file;
+  SVHPacketRecorder recorder;
+  BOOST_REQUIRE(recorder.open(file.path, 8));
+
+  for (uint32_t i = 0; i < 20; ++i)
+  {
+    recordFrame(recorder, 1000 + i);
+  }
+  BOOST_CHECK_EQUAL(recorder.recordedFrames(), 20u);
+
+  // The file is complete without closing the recorder, as it would be after a crash
+  SVHCaptureFileHeader header;
+  std::vector<SVHCaptureRecord> records;
+  BOOST_REQUIRE(SVHPacketRecorder::readCapture(file.path, header, records));
+  BOOST_CHECK_EQUAL(header.capacity, 8u);
+  BOOST_CHECK_EQUAL(header.next, 20u);
+  BOOST_REQUIRE_EQUAL(records.size(), 8u);
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    uint32_t value;
+    BOOST_CHECK_EQUAL(records[i].sequence, 13 + i);
+    BOOST_CHECK(frameValue(records[i], value));
+    BOOST_CHECK_EQUAL(value, 1012 + i);
+    BOOST_CHECK_EQUAL(records[i].direction, CD_TRANSMIT);
+    BOOST_CHECK_EQUAL(records[i].status, CS_OK);
+    if (i > 0)
+    {
+      BOOST_CHECK(records[i].timestamp_ns >= records[i - 1].timestamp_ns);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentWritersDoNotTearRecords)
+{
+  CaptureFile file;
+  SVHPacketRecorder recorder;
+  BOOST_REQUIRE(recorder.open(file.path, 4096));
+
+  const uint32_t frames_per_thread = 1000;
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&recorder, t, frames_per_thread] {
+      for (uint32_t i = 0; i < frames_per_thread; ++i)
+      {
+        recordFrame(recorder, (t << 16) | i);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  recorder.close();
+
+  SVHCaptureFileHeader header;
+  std::vector<SVHCaptureRecord> records;
+  BOOST_REQUIRE(SVHPacketRecorder::readCapture(file.path, header, records));
+  BOOST_REQUIRE_EQUAL(records.size(), 4 * frames_per_thread);
+
+  std::set<uint32_t> values;
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    uint32_t value;
+    BOOST_CHECK_EQUAL(records[i].sequence, i + 1);
+    BOOST_REQUIRE(frameValue(records[i], value));
+    values.insert(value);
+  }
+  BOOST_CHECK_EQUAL(values.size(), 4 * frames_per_thread);
+}
+
+BOOST_AUTO_TEST_CASE(ForeignFilesAreRejected)
+{
+  CaptureFile file;
+  SVHCaptureFileHeader header;
+  std::vector<SVHCaptureRecord> records;
+  BOOST_CHECK(!SVHPacketRecorder::readCapture(file.path, header, records));
+
+  SVHPacketRecorder recorder;
+  BOOST_CHECK(!recorder.open(file.path, 0));
+  BOOST_CHECK(!recorder.isOpen());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
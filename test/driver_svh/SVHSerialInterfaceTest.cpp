@@ -0,0 +1,596 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+#include <schunk_svh_library/serial/SVHSerialInterface.h>
+
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHSerialInterface)
+
+//! Pseudo terminal whose master side stands in for the hand
+struct PseudoTerminal
+{
+  PseudoTerminal()
+  {
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    BOOST_REQUIRE(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0);
+    device_name = ptsname(master);
+
+    // keep the slave open so that the master does not see hangups between connections
+    slave = ::open(device_name.c_str(), O_RDWR | O_NOCTTY);
+    BOOST_REQUIRE(slave >= 0);
+    termios io_set;
+    tcgetattr(slave, &io_set);
+    cfmakeraw(&io_set);
+    tcsetattr(slave, TCSANOW, &io_set);
+  }
+
+  ~PseudoTerminal()
+  {
+    ::close(slave);
+    ::close(master);
+  }
+
+  //! Reads from the master until size bytes arrived or the timeout expired
+  std::vector<uint8_t> read(size_t size, const std::chrono::milliseconds& timeout)
+  {
+    std::vector<uint8_t> data;
+    uint8_t buffer[256];
+    auto end_time = std::chrono::steady_clock::now() + timeout;
+    while (data.size() < size && std::chrono::steady_clock::now() < end_time)
+    {
+      ssize_t bytes = ::read(master, buffer, sizeof(buffer));
+      if (bytes > 0)
+      {
+        data.insert(data.end(), buffer, buffer + bytes);
+      }
+      else
+      {
+        usleep(1000);
+      }
+    }
+    return data;
+  }
+
+  int master;
+  int slave;
+  std::string device_name;
+};
+
+BOOST_AUTO_TEST_CASE(FramesMatchSerializedPackets)
+{
+  PseudoTerminal terminal;
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  BOOST_REQUIRE(serial_interface.connect(terminal.device_name));
+
+  // The frames have to look exactly like packets serialized by the ArrayBuilder
+  std::vector<uint8_t> expected;
+  for (uint8_t i = 0; i < 3; ++i)
+  {
+    SVHSerialPacket packet(8 + 20 * i, SVH_SET_CONTROL_COMMAND);
+    for (size_t j = 0; j < packet.data.size(); ++j)
+    {
+      packet.data[j] = static_cast<uint8_t>(j * 37 + i);
+    }
+    BOOST_REQUIRE(serial_interface.sendPacket(packet));
+
+    uint8_t check_sum1;
+    uint8_t check_sum2;
+    calcCheckSum(check_sum1, check_sum2, packet);
+    ArrayBuilder frame(packet.data.size() + C_PACKET_APPENDIX_SIZE);
+    frame << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+    expected.insert(expected.end(), frame.array.begin(), frame.array.end());
+  }
+
+  std::vector<uint8_t> received = terminal.read(expected.size(), std::chrono::milliseconds(1000));
+  BOOST_CHECK(received == expected);
+
+  SVHTransmitStatistics statistics = serial_interface.transmitStatistics();
+  BOOST_CHECK_EQUAL(statistics.frames, 3u);
+  BOOST_CHECK_EQUAL(statistics.bytes, expected.size());
+  BOOST_CHECK_EQUAL(statistics.timeouts, 0u);
+  BOOST_CHECK_EQUAL(statistics.write_errors, 0u);
+
+  serial_interface.close();
+}
+
+BOOST_AUTO_TEST_CASE(StalledDeviceTimesOut)
+{
+  PseudoTerminal terminal;
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  BOOST_REQUIRE(serial_interface.connect(terminal.device_name));
+
+  // Nobody reads the master, so its buffer fills up until the device does not take data anymore
+  std::chrono::steady_clock::duration failed_call;
+  bool failed = false;
+  for (int i = 0; i < 10000 && !failed; ++i)
+  {
+    SVHSerialPacket packet(C_MAXIMUM_PACKET_SIZE, SVH_SET_CONTROL_COMMAND);
+    auto start  = std::chrono::steady_clock::now();
+    failed      = !serial_interface.sendPacket(packet);
+    failed_call = std::chrono::steady_clock::now() - start;
+  }
+  BOOST_REQUIRE(failed);
+
+  // The failing call is bounded by the write timeout instead of blocking forever
+  BOOST_CHECK(failed_call < std::chrono::milliseconds(100));
+
+  SVHTransmitStatistics statistics = serial_interface.transmitStatistics();
+  BOOST_CHECK_EQUAL(statistics.timeouts, 1u);
+  BOOST_CHECK(statistics.blocked_writes > 0);
+  BOOST_CHECK_EQUAL(statistics.write_errors, 0u);
+
+  serial_interface.close();
+}
+
+BOOST_AUTO_TEST_CASE(LatencyTimerIsWrittenAndVerified)
+{
+  PseudoTerminal terminal;
+
+  // Fake sysfs tree of an USB serial adapter with the default latency timer of 16ms
+  char root[] = "/tmp/svh_sysfs_XXXXXX";
+  BOOST_REQUIRE(mkdtemp(root) != NULL);
+  std::string name      = terminal.device_name.substr(terminal.device_name.rfind('/') + 1);
+  std::string directory = std::string(root) + "/bus/usb-serial/devices/" + name;
+  BOOST_REQUIRE(mkdir((std::string(root) + "/bus").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir((std::string(root) + "/bus/usb-serial").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir((std::string(root) + "/bus/usb-serial/devices").c_str(), 0755) == 0);
+  BOOST_REQUIRE(mkdir(directory.c_str(), 0755) == 0);
+  std::string timer_path = directory + "/latency_timer";
+  std::ofstream(timer_path.c_str()) << "16" << std::endl;
+
+  SVHTransportOptions options;
+  options.latency.latency_timer = 1;
+  options.latency.sysfs_root    = root;
+
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  serial_interface.setTransportOptions(options);
+  BOOST_REQUIRE(serial_interface.connect(terminal.device_name));
+
+  SerialLatencyReport report = serial_interface.latencyReport();
+  BOOST_CHECK(report.applied);
+  BOOST_CHECK_EQUAL(report.latency_timer, 1);
+  BOOST_CHECK_EQUAL(report.latency_timer_path, timer_path);
+  int written = 0;
+  std::ifstream(timer_path.c_str()) >> written;
+  BOOST_CHECK_EQUAL(written, 1);
+  serial_interface.close();
+
+  unlink(timer_path.c_str());
+  rmdir(directory.c_str());
+  rmdir((std::string(root) + "/bus/usb-serial/devices").c_str());
+  rmdir((std::string(root) + "/bus/usb-serial").c_str());
+  rmdir((std::string(root) + "/bus").c_str());
+  rmdir(root);
+}
+
+BOOST_AUTO_TEST_CASE(UnsupportedLatencySettingsAreReported)
+{
+  PseudoTerminal terminal;
+
+  // A pseudo terminal neither knows ASYNC_LOW_LATENCY nor has a latency timer
+  SVHTransportOptions options;
+  options.latency.low_latency   = true;
+  options.latency.latency_timer = 1;
+  options.latency.sysfs_root    = "/nonexistent";
+
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  serial_interface.setTransportOptions(options);
+  BOOST_REQUIRE(serial_interface.connect(terminal.device_name));
+
+  SerialLatencyReport report = serial_interface.latencyReport();
+  BOOST_CHECK(!report.applied);
+  BOOST_CHECK(!report.low_latency);
+  BOOST_CHECK_EQUAL(report.latency_timer, -1);
+  BOOST_CHECK(report.latency_timer_path.empty());
+
+  // The device stays usable
+  SVHSerialPacket packet(8, SVH_SET_CONTROL_COMMAND);
+  BOOST_CHECK(serial_interface.sendPacket(packet));
+  serial_interface.close();
+}
+
+BOOST_AUTO_TEST_CASE(InvalidTransportOptionsAreRejected)
+{
+  PseudoTerminal terminal;
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+
+  std::string error;
+  BOOST_CHECK(SVHTransportOptions().validate(error));
+  BOOST_CHECK(error.empty());
+
+  // At 115200 bit/s a frame takes longer to send than the default gap
+  SVHTransportOptions options;
+  options.baud_rate = 115200;
+  BOOST_CHECK(!options.validate(error));
+  BOOST_CHECK(!error.empty());
+  serial_interface.setTransportOptions(options);
+  BOOST_CHECK(!serial_interface.connect(terminal.device_name));
+  BOOST_CHECK(!serial_interface.isConnected());
+
+  options                  = SVHTransportOptions();
+  options.read_buffer_size = 16;
+  BOOST_CHECK(!options.validate(error));
+
+  options                    = SVHTransportOptions();
+  options.receive_thread_cpu = 100000;
+  BOOST_CHECK(!options.validate(error));
+}
+
+BOOST_AUTO_TEST_CASE(CustomBaudRateWithBlockingReceive)
+{
+  PseudoTerminal terminal;
+  std::atomic<unsigned int> received{0};
+  SVHSerialInterface serial_interface(
+    [&](const SVHSerialPacket&, unsigned int) { received++; });
+
+  // 1000000 bit/s has no termios constant, pseudo terminals accept any custom rate
+  SVHTransportOptions options;
+  options.baud_rate           = 1000000;
+  options.receive_strategy    = RS_BLOCKING;
+  options.receive_idle_period = std::chrono::milliseconds(50);
+  options.read_buffer_size    = 128;
+  serial_interface.setTransportOptions(options);
+  BOOST_REQUIRE(serial_interface.connect(terminal.device_name));
+  BOOST_CHECK_EQUAL(serial_interface.transportOptions().baud_rate, 1000000u);
+
+  // The blocked receive thread wakes up for the data
+  SVHSerialPacket packet(C_DEFAULT_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK);
+  packet.index = 0;
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, packet);
+  ArrayBuilder frame(packet.data.size() + C_PACKET_APPENDIX_SIZE);
+  frame << PACKET_HEADER1 << PACKET_HEADER2 << packet << check_sum1 << check_sum2;
+  BOOST_REQUIRE(write(terminal.master, frame.array.data(), frame.array.size()) ==
+                static_cast<ssize_t>(frame.array.size()));
+
+  auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (received == 0 && std::chrono::steady_clock::now() < end_time)
+  {
+    usleep(1000);
+  }
+  BOOST_CHECK_EQUAL(received, 1u);
+
+  serial_interface.close();
+}
+
+BOOST_AUTO_TEST_CASE(RecorderCapturesBothDirections)
+{
+  char path[] = "/tmp/svh_capture_XXXXXX";
+  int fd      = mkstemp(path);
+  BOOST_REQUIRE(fd >= 0);
+  ::close(fd);
+  std::shared_ptr<SVHPacketRecorder> recorder = std::make_shared<SVHPacketRecorder>();
+  BOOST_REQUIRE(recorder->open(path, 64));
+
+  PseudoTerminal terminal;
+  std::atomic<unsigned int> received{0};
+  SVHSerialInterface serial_interface(
+    [&](const SVHSerialPacket&, unsigned int) { received++; });
+  serial_interface.setPacketRecorder(recorder);
+  BOOST_REQUIRE(serial_interface.connect(terminal.device_name));
+
+  SVHSerialPacket sent(8, SVH_SET_CONTROL_COMMAND);
+  BOOST_REQUIRE(serial_interface.sendPacket(sent));
+  std::vector<uint8_t> sent_frame = terminal.read(72, std::chrono::milliseconds(1000));
+  BOOST_REQUIRE_EQUAL(sent_frame.size(), 72u);
+
+  // A valid answer followed by one with a broken checksum
+  SVHSerialPacket answer(C_DEFAULT_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK);
+  answer.index   = 7;
+  answer.data[0] = 42;
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, answer);
+  ArrayBuilder frame(answer.data.size() + C_PACKET_APPENDIX_SIZE);
+  frame << PACKET_HEADER1 << PACKET_HEADER2 << answer << check_sum1 << check_sum2;
+  std::vector<uint8_t> stream = frame.array;
+  stream.insert(stream.end(), frame.array.begin(), frame.array.end());
+  stream.back() ^= 0xFF;
+  BOOST_REQUIRE(write(terminal.master, stream.data(), stream.size()) ==
+                static_cast<ssize_t>(stream.size()));
+
+  auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (recorder->recordedFrames() < 3 && std::chrono::steady_clock::now() < end_time)
+  {
+    usleep(1000);
+  }
+  serial_interface.close();
+
+  SVHCaptureFileHeader header;
+  std::vector<SVHCaptureRecord> records;
+  BOOST_REQUIRE(SVHPacketRecorder::readCapture(path, header, records));
+  BOOST_REQUIRE_EQUAL(records.size(), 3u);
+
+  BOOST_CHECK_EQUAL(records[0].direction, CD_TRANSMIT);
+  BOOST_CHECK_EQUAL(records[0].status, CS_OK);
+  BOOST_CHECK(std::vector<uint8_t>(records[0].frame, records[0].frame + records[0].length) ==
+              sent_frame);
+
+  BOOST_CHECK_EQUAL(records[1].direction, CD_RECEIVE);
+  BOOST_CHECK_EQUAL(records[1].status, CS_OK);
+  BOOST_CHECK(std::vector<uint8_t>(records[1].frame, records[1].frame + records[1].length) ==
+              frame.array);
+
+  BOOST_CHECK_EQUAL(records[2].direction, CD_RECEIVE);
+  BOOST_CHECK_EQUAL(records[2].status, CS_CHECKSUM_ERROR);
+  BOOST_CHECK(std::vector<uint8_t>(records[2].frame, records[2].frame + records[2].length) ==
+              std::vector<uint8_t>(stream.begin() + frame.array.size(), stream.end()));
+  BOOST_CHECK_EQUAL(received, 1u);
+
+  unlink(path);
+}
+
+//! Sends stops during a burst of settings uploads to a hand that never answers
+void checkStopsOvertakeQueuedSettings(const SVHTransportOptions& options)
+{
+  std::shared_ptr<SVHPipeTransport> hand;
+  std::shared_ptr<SVHPipeTransport> transport;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(hand, transport));
+
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  serial_interface.setTransportOptions(options);
+  BOOST_REQUIRE(serial_interface.connect(transport));
+
+  // A burst of settings uploads from many threads keeps up to 15 packets queued, i.e. 75ms
+  const int threads = 16;
+  const int uploads = 4;
+  std::vector<std::thread> senders;
+  for (int i = 0; i < threads; ++i)
+  {
+    senders.emplace_back([&serial_interface] {
+      for (int j = 0; j < uploads; ++j)
+      {
+        SVHSerialPacket packet(C_DEFAULT_PACKET_SIZE, SVH_SET_POSITION_SETTINGS);
+        serial_interface.sendPacket(packet);
+      }
+    });
+  }
+
+  // Each stop waits for at most the frame on the wire and the gap, plus the scheduling of threads
+  const std::chrono::microseconds bound = options.transmission_gap + std::chrono::milliseconds(10);
+  const int stops = 5;
+  std::chrono::steady_clock::duration worst_case(0);
+  for (int i = 0; i < stops; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    SVHSerialPacket stop(40, SVH_SET_CONTROLLER_STATE);
+    auto start = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(serial_interface.sendPacket(stop, TP_EMERGENCY));
+    worst_case = std::max(worst_case, std::chrono::steady_clock::now() - start);
+  }
+  for (std::thread& sender : senders)
+  {
+    sender.join();
+  }
+
+  BOOST_TEST_MESSAGE("Worst case time to wire of a stop: "
+                     << std::chrono::duration_cast<std::chrono::microseconds>(worst_case).count()
+                     << "us");
+  BOOST_CHECK(worst_case < bound);
+
+  SVHTransmitStatistics statistics = serial_interface.transmitStatistics();
+  BOOST_CHECK_EQUAL(statistics.priority_frames[TP_EMERGENCY], static_cast<uint64_t>(stops));
+  BOOST_CHECK_EQUAL(statistics.priority_frames[TP_SETTINGS],
+                    static_cast<uint64_t>(threads * uploads));
+  BOOST_CHECK(statistics.priority_max_latency_us[TP_EMERGENCY] <
+              static_cast<uint64_t>(bound.count()));
+  serial_interface.close();
+
+  // All stops were written while settings were still queued
+  const size_t frame_size = C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE;
+  std::vector<uint8_t> stream((threads * uploads + stops) * frame_size);
+  BOOST_REQUIRE_EQUAL(hand->read(stream.data(), static_cast<ssize_t>(stream.size()), 0, false),
+                      static_cast<ssize_t>(stream.size()));
+  size_t last_stop = 0;
+  for (size_t i = 0; i < stream.size() / frame_size; ++i)
+  {
+    if (stream[i * frame_size + 3] == SVH_SET_CONTROLLER_STATE)
+    {
+      last_stop = i;
+    }
+  }
+  BOOST_CHECK(last_stop + 1 < stream.size() / frame_size);
+}
+
+BOOST_AUTO_TEST_CASE(StopsOvertakeQueuedSettings)
+{
+  SVHTransportOptions options;
+  options.transmission_gap = std::chrono::microseconds(5000);
+  checkStopsOvertakeQueuedSettings(options);
+}
+
+BOOST_AUTO_TEST_CASE(StopsOvertakeQueuedSettingsWithFullWindow)
+{
+  // Without replies the window stays full and the settings wait for the reply timeout
+  SVHTransportOptions options;
+  options.transmission_gap = std::chrono::microseconds(5000);
+  options.transmit_window  = 2;
+  options.reply_timeout    = std::chrono::microseconds(40000);
+  checkStopsOvertakeQueuedSettings(options);
+}
+
+BOOST_AUTO_TEST_CASE(WindowPacesByReplies)
+{
+  std::shared_ptr<SVHPipeTransport> hand;
+  std::shared_ptr<SVHPipeTransport> transport;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(hand, transport));
+
+  // A conservative gap would need 500ms for the packets, replies come much faster. The gap of the
+  // window only keeps the frames apart on the wire.
+  const std::chrono::microseconds conservative_gap(5000);
+  SVHTransportOptions options;
+  options.transmit_window = 4;
+  std::atomic<unsigned int> received{0};
+  SVHSerialInterface serial_interface(
+    [&](const SVHSerialPacket&, unsigned int) { received++; });
+  serial_interface.setTransportOptions(options);
+  BOOST_REQUIRE(serial_interface.connect(transport));
+
+  // The hand echoes every frame, which is a valid reply with the same index. It never sees more
+  // frames than fit into the window at a time.
+  const size_t frame_size = C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE;
+  const unsigned int packets = 100;
+  size_t most_unanswered     = 0;
+  std::thread echo([&] {
+    std::vector<uint8_t> buffer(8 * frame_size);
+    size_t echoed = 0;
+    while (echoed < packets * frame_size && hand->waitReadable(1000000) > 0)
+    {
+      ssize_t bytes = hand->read(buffer.data(), static_cast<ssize_t>(buffer.size()), 0);
+      if (bytes <= 0)
+      {
+        continue;
+      }
+      most_unanswered     = std::max(most_unanswered, static_cast<size_t>(bytes) / frame_size);
+      struct iovec reply = {buffer.data(), static_cast<size_t>(bytes)};
+      hand->writev(&reply, 1);
+      echoed += static_cast<size_t>(bytes);
+    }
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < packets; ++i)
+  {
+    SVHSerialPacket packet(C_DEFAULT_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK_ALL);
+    BOOST_REQUIRE(serial_interface.sendPacket(packet));
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  echo.join();
+  for (int i = 0; i < 1000 && received < packets; ++i)
+  {
+    usleep(1000);
+  }
+
+  BOOST_CHECK_EQUAL(received, packets);
+  BOOST_CHECK(most_unanswered <= options.transmit_window);
+  BOOST_CHECK(elapsed < packets * conservative_gap / 2);
+  BOOST_CHECK(elapsed >= (packets - 1) * options.transmission_gap);
+
+  SVHTransmitStatistics statistics = serial_interface.transmitStatistics();
+  BOOST_CHECK_EQUAL(statistics.replies, packets);
+  BOOST_CHECK_EQUAL(statistics.lost_replies, 0u);
+  BOOST_CHECK_EQUAL(statistics.unexpected_replies, 0u);
+  serial_interface.close();
+}
+
+BOOST_AUTO_TEST_CASE(LostRepliesFreeTheWindow)
+{
+  std::shared_ptr<SVHPipeTransport> hand;
+  std::shared_ptr<SVHPipeTransport> transport;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(hand, transport));
+
+  SVHTransportOptions options;
+  options.transmit_window = 2;
+  options.reply_timeout   = std::chrono::microseconds(20000);
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  serial_interface.setTransportOptions(options);
+  BOOST_REQUIRE(serial_interface.connect(transport));
+
+  // The hand does not answer, so the window is full after two packets
+  SVHSerialPacket first(C_DEFAULT_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK_ALL);
+  SVHSerialPacket second(C_DEFAULT_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK_ALL);
+  BOOST_REQUIRE(serial_interface.sendPacket(first));
+  BOOST_REQUIRE(serial_interface.sendPacket(second));
+  std::vector<uint8_t> stream(4 * (C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE));
+  BOOST_CHECK_EQUAL(hand->read(stream.data(), static_cast<ssize_t>(stream.size()), 0),
+                    static_cast<ssize_t>(2 * (C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE)));
+
+  // The third packet is written once the first reply is considered lost
+  SVHSerialPacket third(C_DEFAULT_PACKET_SIZE, SVH_GET_CONTROL_FEEDBACK_ALL);
+  auto start = std::chrono::steady_clock::now();
+  BOOST_REQUIRE(serial_interface.sendPacket(third));
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(15));
+
+  SVHTransmitStatistics statistics = serial_interface.transmitStatistics();
+  // The second reply may have expired meanwhile as well
+  BOOST_CHECK(statistics.lost_replies >= 1u && statistics.lost_replies <= 2u);
+  BOOST_CHECK_EQUAL(statistics.replies, 0u);
+  serial_interface.close();
+}
+
+BOOST_AUTO_TEST_CASE(PostedPacketsKeepTheirOrder)
+{
+  std::shared_ptr<SVHPipeTransport> hand;
+  std::shared_ptr<SVHPipeTransport> transport;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(hand, transport));
+
+  auto reactor = std::make_shared<SVHReactor>();
+  BOOST_REQUIRE(reactor->start());
+  SVHSerialInterface serial_interface([](const SVHSerialPacket&, unsigned int) {});
+  SVHTransportOptions options;
+  options.transmission_gap = std::chrono::microseconds(5000);
+  serial_interface.setTransportOptions(options);
+  serial_interface.setReactor(reactor);
+  BOOST_REQUIRE(serial_interface.connect(transport));
+
+  // Like a homing step, a task configures a channel, commands it and enables it. Only the first
+  // packet is due, the others are queued behind the gap in spite of their higher priority.
+  const uint8_t addresses[] = {
+    SVH_SET_POSITION_SETTINGS, SVH_SET_CONTROL_COMMAND, SVH_SET_CONTROLLER_STATE};
+  BOOST_REQUIRE(reactor->addTask(std::chrono::milliseconds(1), [&] {
+    for (uint8_t address : addresses)
+    {
+      SVHSerialPacket packet(40, address);
+      serial_interface.sendPacket(packet);
+    }
+    return false;
+  }) >= 0);
+
+  const size_t frame_size = C_MAXIMUM_PACKET_SIZE + C_PACKET_APPENDIX_SIZE;
+  std::vector<uint8_t> stream(3 * frame_size);
+  const ssize_t size = static_cast<ssize_t>(stream.size());
+  BOOST_REQUIRE_EQUAL(hand->read(stream.data(), size, 1000000, false), size);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_CHECK_EQUAL(static_cast<int>(stream[i * frame_size + 3]),
+                      static_cast<int>(addresses[i]));
+  }
+
+  serial_interface.close();
+  reactor->stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHSubscription)
+
+namespace {
+
+//! Polls the condition until it holds or the timeout expires
+template <typename Condition>
+bool waitFor(Condition condition, const std::chrono::milliseconds& timeout)
+{
+  auto end_time = std::chrono::steady_clock::now() + timeout;
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > end_time)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+//! Finger manager connected to a simulated hand, only the finger spread is used and homed
+struct HomedHand
+{
+  HomedHand()
+    : manager(disableMask())
+  {
+    settings.speed_scale = 50;
+    simulator.reset(new SVHSimulator(settings));
+
+    std::shared_ptr<SVHPipeTransport> library_end;
+    std::shared_ptr<SVHPipeTransport> hand_end;
+    BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+    BOOST_REQUIRE(simulator->start(hand_end));
+    BOOST_REQUIRE(manager.connect(library_end));
+    BOOST_REQUIRE(manager.resetChannel(SVH_FINGER_SPREAD));
+  }
+
+  ~HomedHand()
+  {
+    manager.disconnect();
+    simulator->stop();
+  }
+
+  static std::vector<bool> disableMask()
+  {
+    std::vector<bool> disable_mask(SVH_DIMENSION, true);
+    disable_mask[SVH_FINGER_SPREAD] = false;
+    return disable_mask;
+  }
+
+  SVHSimulatorSettings settings;
+  std::unique_ptr<SVHSimulator> simulator;
+  SVHFingerManager manager;
+};
+
+const uint16_t C_SPREAD = 1 << SVH_FINGER_SPREAD;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(QueueReceivesFeedbackOfSelectedChannels)
+{
+  HomedHand hand;
+
+  SVHSubscriptionOptions options;
+  options.events   = 1u << SVH_EVENT_FEEDBACK;
+  options.channels = C_SPREAD;
+  options.delivery = SVH_DELIVER_QUEUE;
+  std::shared_ptr<SVHSubscription> subscription = hand.manager.subscribe(options);
+  BOOST_REQUIRE(subscription);
+
+  // The polled feedback arrives without calling any getter
+  BOOST_CHECK(waitFor([&] { return subscription->deliveredCount() >= 5; },
+                      std::chrono::milliseconds(2000)));
+  SVHEvent event;
+  unsigned int events = 0;
+  while (subscription->poll(event))
+  {
+    BOOST_CHECK_EQUAL(event.type, SVH_EVENT_FEEDBACK);
+    BOOST_CHECK_EQUAL(event.channel, SVH_FINGER_SPREAD);
+    BOOST_CHECK(event.position >= 0.0);
+    events++;
+  }
+  BOOST_CHECK(events >= 5);
+
+  double position = 0;
+  BOOST_CHECK(hand.manager.getPosition(SVH_FINGER_SPREAD, position));
+  BOOST_CHECK(hand.manager.unsubscribe(subscription));
+  BOOST_CHECK(!hand.manager.unsubscribe(subscription));
+  BOOST_CHECK(!subscription->isActive());
+}
+
+BOOST_AUTO_TEST_CASE(DeadbandSuppressesUnchangedSamples)
+{
+  HomedHand hand;
+
+  std::atomic<unsigned int> all_samples{0};
+  SVHSubscriptionOptions every_sample;
+  every_sample.events   = 1u << SVH_EVENT_FEEDBACK;
+  every_sample.channels = C_SPREAD;
+  BOOST_REQUIRE(hand.manager.subscribe(every_sample, [&](const SVHEvent&) { all_samples++; }));
+
+  std::atomic<unsigned int> changes{0};
+  SVHSubscriptionOptions deadband = every_sample;
+  deadband.position_deadband      = 0.05;
+  deadband.current_deadband       = 1000.0;
+  deadband.delivery               = SVH_DELIVER_DISPATCH_THREAD;
+  const std::thread::id test_thread = std::this_thread::get_id();
+  std::atomic<bool> called_by_test_thread{false};
+  std::shared_ptr<SVHSubscription> subscription =
+    hand.manager.subscribe(deadband, [&](const SVHEvent&) {
+      called_by_test_thread = called_by_test_thread || std::this_thread::get_id() == test_thread;
+      changes++;
+    });
+  BOOST_REQUIRE(subscription);
+
+  // A finger at rest produces one sample only
+  BOOST_CHECK(waitFor([&] { return all_samples >= 20; }, std::chrono::milliseconds(3000)));
+  BOOST_CHECK(waitFor([&] { return changes >= 1; }, std::chrono::milliseconds(1000)));
+  BOOST_CHECK_EQUAL(changes, 1u);
+  BOOST_CHECK(!called_by_test_thread);
+
+  // Moving it produces more, but less than every sample
+  const unsigned int samples_before = all_samples;
+  std::vector<double> positions(SVH_DIMENSION, 0.0);
+  positions[SVH_FINGER_SPREAD] = 0.4;
+  BOOST_REQUIRE(hand.manager.setAllTargetPositions(positions));
+  BOOST_CHECK(waitFor([&] { return changes >= 2; }, std::chrono::milliseconds(3000)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  BOOST_CHECK(all_samples - samples_before > changes);
+  BOOST_CHECK_EQUAL(subscription->droppedCount(), 0u);
+
+  BOOST_CHECK(hand.manager.unsubscribe(subscription));
+  const unsigned int after_unsubscribe = changes;
+  positions[SVH_FINGER_SPREAD] = 0.1;
+  BOOST_REQUIRE(hand.manager.setAllTargetPositions(positions));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  BOOST_CHECK_EQUAL(changes, after_unsubscribe);
+}
+
+BOOST_AUTO_TEST_CASE(StateChangesAndSettingsEchoes)
+{
+  HomedHand hand;
+
+  std::mutex mutex;
+  std::vector<SVHEvent> received;
+  SVHSubscriptionOptions options;
+  options.events = (1u << SVH_EVENT_CONTROLLER_STATE) | (1u << SVH_EVENT_POSITION_SETTINGS);
+  BOOST_REQUIRE(hand.manager.subscribe(options, [&](const SVHEvent& event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.push_back(event);
+  }));
+
+  auto count = [&](SVHEventType type) {
+    std::lock_guard<std::mutex> lock(mutex);
+    unsigned int events = 0;
+    for (const SVHEvent& event : received)
+    {
+      events += event.type == type ? 1 : 0;
+    }
+    return events;
+  };
+
+  // Repeated states are reported once
+  hand.manager.requestControllerState();
+  BOOST_CHECK(waitFor([&] { return count(SVH_EVENT_CONTROLLER_STATE) >= 1; },
+                      std::chrono::milliseconds(1000)));
+  hand.manager.requestControllerState();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  BOOST_CHECK_EQUAL(count(SVH_EVENT_CONTROLLER_STATE), 1u);
+
+  // Enabling the channel changes it
+  BOOST_REQUIRE(hand.manager.enableChannel(SVH_FINGER_SPREAD));
+  BOOST_CHECK(waitFor([&] { return count(SVH_EVENT_CONTROLLER_STATE) >= 2; },
+                      std::chrono::milliseconds(1000)));
+
+  SVHPositionSettings settings = hand.manager.getDefaultPositionSettings(false)[SVH_FINGER_SPREAD];
+  BOOST_REQUIRE(hand.manager.setPositionSettings(SVH_FINGER_SPREAD, settings));
+  BOOST_CHECK(waitFor([&] { return count(SVH_EVENT_POSITION_SETTINGS) >= 1; },
+                      std::chrono::milliseconds(1000)));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const SVHEvent& event : received)
+  {
+    if (event.type == SVH_EVENT_POSITION_SETTINGS)
+    {
+      BOOST_CHECK_EQUAL(event.channel, SVH_FINGER_SPREAD);
+      BOOST_CHECK_CLOSE(event.position_settings.wmx, settings.wmx, 1e-3);
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(event.channel, SVH_ALL);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(InvalidOptionsAreRejected)
+{
+  SVHFingerManager manager;
+  SVHSubscriptionOptions options;
+
+  // Callbacks are needed unless the events are polled
+  BOOST_CHECK(!manager.subscribe(options));
+  options.delivery = SVH_DELIVER_QUEUE;
+  BOOST_CHECK(!manager.subscribe(options, [](const SVHEvent&) {}));
+  options.queue_capacity = 0;
+  BOOST_CHECK(!manager.subscribe(options));
+
+  options.queue_capacity    = 3;
+  options.position_deadband = -1.0;
+  BOOST_CHECK(!manager.subscribe(options));
+  options.position_deadband = 0.0;
+  BOOST_CHECK(manager.subscribe(options));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
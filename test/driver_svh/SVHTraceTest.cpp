@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/SVHTrace.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHTrace)
+
+namespace {
+
+size_t countEvents(const std::vector<SVHTraceEvent>& events, const char* name)
+{
+  return static_cast<size_t>(
+    std::count_if(events.begin(), events.end(), [name](const SVHTraceEvent& event) {
+      return std::strcmp(event.name, name) == 0;
+    }));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(SpansAreOnlyRecordedWhileEnabled)
+{
+  BOOST_REQUIRE(SVHTrace::start(64));
+  SVHTrace::stop();
+  {
+    SVH_TRACE_SPAN("test", "disabled");
+  }
+  BOOST_CHECK_EQUAL(SVHTrace::recordedCount(), 0u);
+
+  BOOST_REQUIRE(SVHTrace::start(64));
+  {
+    SVH_TRACE_SPAN_ARG("test", "span", "channel", 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  SVH_TRACE_INSTANT("test", "instant", "value", 7);
+  SVHTrace::stop();
+
+  std::vector<SVHTraceEvent> events = SVHTrace::events();
+  BOOST_REQUIRE_EQUAL(events.size(), 2u);
+  BOOST_CHECK_EQUAL(std::string(events[0].name), "span");
+  BOOST_CHECK_EQUAL(events[0].phase, 'X');
+  BOOST_CHECK(events[0].duration_ns >= 2000000u);
+  BOOST_CHECK_EQUAL(std::string(events[0].arg_name), "channel");
+  BOOST_CHECK_EQUAL(events[0].arg, 3);
+  BOOST_CHECK_EQUAL(events[1].phase, 'i');
+  BOOST_CHECK(events[1].start_ns >= events[0].start_ns + events[0].duration_ns);
+  BOOST_CHECK_EQUAL(events[0].thread, events[1].thread);
+  BOOST_CHECK_EQUAL(SVHTrace::threadNames().count(events[0].thread), 1u);
+
+  BOOST_CHECK(!SVHTrace::start(0));
+}
+
+BOOST_AUTO_TEST_CASE(FullRingKeepsTheNewestEvents)
+{
+  BOOST_REQUIRE(SVHTrace::start(5));
+  for (int i = 0; i < 20; ++i)
+  {
+    SVH_TRACE_INSTANT("test", "instant", "i", i);
+  }
+  SVHTrace::stop();
+
+  // The capacity is rounded up to 8
+  std::vector<SVHTraceEvent> events = SVHTrace::events();
+  BOOST_REQUIRE_EQUAL(events.size(), 8u);
+  BOOST_CHECK_EQUAL(events.front().arg, 12);
+  BOOST_CHECK_EQUAL(events.back().arg, 19);
+  BOOST_CHECK_EQUAL(SVHTrace::recordedCount(), 20u);
+}
+
+BOOST_AUTO_TEST_CASE(RestartDiscardsTheEventsOfTheReusedRing)
+{
+  BOOST_REQUIRE(SVHTrace::start(64));
+  for (int i = 0; i < 40; ++i)
+  {
+    SVH_TRACE_INSTANT("test", "before", "i", i);
+  }
+
+  // A smaller trace reuses the ring but only keeps as many events as requested
+  BOOST_REQUIRE(SVHTrace::start(4));
+  BOOST_CHECK(SVHTrace::events().empty());
+  BOOST_CHECK_EQUAL(SVHTrace::recordedCount(), 0u);
+  for (int i = 0; i < 10; ++i)
+  {
+    SVH_TRACE_INSTANT("test", "after", "i", i);
+  }
+  SVHTrace::stop();
+
+  std::vector<SVHTraceEvent> events = SVHTrace::events();
+  BOOST_REQUIRE_EQUAL(events.size(), 4u);
+  BOOST_CHECK_EQUAL(countEvents(events, "before"), 0u);
+  BOOST_CHECK_EQUAL(events.front().arg, 6);
+  BOOST_CHECK_EQUAL(events.back().arg, 9);
+  BOOST_CHECK_EQUAL(SVHTrace::recordedCount(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentWritersLoseNoEvents)
+{
+  const int threads    = 4;
+  const int per_thread = 2000;
+  BOOST_REQUIRE(SVHTrace::start(threads * per_thread));
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < threads; ++t)
+  {
+    writers.emplace_back([per_thread] {
+      for (int i = 0; i < per_thread; ++i)
+      {
+        SVH_TRACE_SPAN_ARG("test", "span", "i", i);
+      }
+    });
+  }
+  for (std::thread& writer : writers)
+  {
+    writer.join();
+  }
+  SVHTrace::stop();
+
+  std::vector<SVHTraceEvent> events = SVHTrace::events();
+  BOOST_CHECK_EQUAL(events.size(), static_cast<size_t>(threads * per_thread));
+  std::set<uint32_t> thread_numbers;
+  for (const SVHTraceEvent& event : events)
+  {
+    thread_numbers.insert(event.thread);
+  }
+  BOOST_CHECK_EQUAL(thread_numbers.size(), static_cast<size_t>(threads));
+}
+
+BOOST_AUTO_TEST_CASE(HomingAndPacketTrafficAreExported)
+{
+  std::vector<bool> disable_mask(SVH_DIMENSION, true);
+  disable_mask[SVH_FINGER_SPREAD] = false;
+  SVHFingerManager manager(disable_mask);
+
+  SVHSimulatorSettings settings;
+  settings.speed_scale = 50;
+  SVHSimulator simulator(settings);
+  std::shared_ptr<SVHPipeTransport> library_end;
+  std::shared_ptr<SVHPipeTransport> hand_end;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+  BOOST_REQUIRE(simulator.start(hand_end));
+
+  BOOST_REQUIRE(SVHTrace::start());
+  BOOST_REQUIRE(manager.connect(library_end));
+  BOOST_REQUIRE(manager.resetChannel(SVH_FINGER_SPREAD));
+  SVHTrace::stop();
+  manager.disconnect();
+  simulator.stop();
+
+  std::vector<SVHTraceEvent> events = SVHTrace::events();
+  BOOST_CHECK_EQUAL(countEvents(events, "connect"), 1u);
+  BOOST_CHECK_EQUAL(countEvents(events, "attempt"), 1u);
+  BOOST_CHECK(countEvents(events, "sendPacket") > 0);
+  BOOST_CHECK(countEvents(events, "frame") > 0);
+  BOOST_CHECK(countEvents(events, "SET_CONTROL_COMMAND") > 0);
+  BOOST_CHECK_EQUAL(countEvents(events, "resetChannel"), 1u);
+  BOOST_CHECK_EQUAL(countEvents(events, "findHardstop"), 1u);
+  BOOST_CHECK_EQUAL(countEvents(events, "goToIdle"), 1u);
+  BOOST_CHECK_EQUAL(countEvents(events, "restoreSettings"), 1u);
+
+  std::ostringstream out;
+  SVHTrace::writeChromeTrace(out);
+  const std::string json = out.str();
+  BOOST_CHECK_EQUAL(json.compare(0, 17, "{\"displayTimeUnit"), 0);
+  BOOST_CHECK(json.find("\"name\":\"thread_name\"") != std::string::npos);
+  BOOST_CHECK(json.find("svh-receive") != std::string::npos);
+  BOOST_CHECK(json.find("\"name\":\"findHardstop\",\"cat\":\"homing\",\"ph\":\"X\"") !=
+              std::string::npos);
+  BOOST_CHECK(json.find("\"args\":{\"channel\":8}") != std::string::npos);
+  BOOST_CHECK_EQUAL(std::count(json.begin(), json.end(), '{'),
+                    std::count(json.begin(), json.end(), '}'));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include <boost/test/unit_test.hpp>
+
+#include <SVHSimulator.h>
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHFingerManager.h>
+#include <schunk_svh_library/serial/SVHPipeTransport.h>
+#include <schunk_svh_library/serial/SVHReactor.h>
+#include <schunk_svh_library/serial/SVHSocketTransport.h>
+
+#include <chrono>
+#include <poll.h>
+#include <thread>
+#include <vector>
+
+using namespace driver_svh;
+
+BOOST_AUTO_TEST_SUITE(ts_SVHTransport)
+
+namespace {
+
+//! Writes \a data completely, waiting for space in between
+bool writeAll(SVHTransport& transport, const std::vector<uint8_t>& data)
+{
+  size_t written = 0;
+  while (written < data.size())
+  {
+    struct iovec buffer;
+    buffer.iov_base = const_cast<uint8_t*>(data.data()) + written;
+    buffer.iov_len  = data.size() - written;
+    ssize_t bytes   = transport.writev(&buffer, 1);
+    if (bytes < 0)
+    {
+      if (transport.status() != -EAGAIN || transport.waitWritable(1000000) <= 0)
+      {
+        return false;
+      }
+      continue;
+    }
+    written += static_cast<size_t>(bytes);
+  }
+  return true;
+}
+
+//! Requests feedback until \a count packets were answered
+void exchangeFeedback(SVHController& controller, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    controller.requestControllerFeedback(static_cast<SVHChannel>(i % SVH_DIMENSION));
+  }
+  for (int i = 0; i < 400 && controller.getReceivedPackageCount() < count; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  BOOST_CHECK_EQUAL(controller.getReceivedPackageCount(), count);
+  BOOST_CHECK_EQUAL(controller.getReceiveStatistics().checksum_errors, 0u);
+  BOOST_CHECK(!controller.hasCommunicationFailed());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PipeKeepsTheByteOrderAcrossTheRingBoundary)
+{
+  std::shared_ptr<SVHPipeTransport> first;
+  std::shared_ptr<SVHPipeTransport> second;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(first, second, 50));
+
+  // The capacity is rounded up to 64 bytes, so the second block wraps around
+  std::vector<uint8_t> received(40);
+  for (uint8_t block = 0; block < 3; ++block)
+  {
+    std::vector<uint8_t> header(8, block);
+    std::vector<uint8_t> payload(32);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+      payload[i] = static_cast<uint8_t>(block * 64 + i);
+    }
+    struct iovec buffers[2] = {{header.data(), header.size()}, {payload.data(), payload.size()}};
+    BOOST_REQUIRE_EQUAL(first->writev(buffers, 2), 40);
+
+    BOOST_REQUIRE_EQUAL(second->waitReadable(0), 1);
+    BOOST_REQUIRE_EQUAL(second->read(received.data(), 40, 0, false), 40);
+    BOOST_CHECK(std::equal(header.begin(), header.end(), received.begin()));
+    BOOST_CHECK(std::equal(payload.begin(), payload.end(), received.begin() + 8));
+  }
+  BOOST_CHECK_EQUAL(second->read(received.data(), 40, 0), 0);
+  BOOST_CHECK_EQUAL(second->waitReadable(1000), 0);
+
+  // A full pipe takes what fits and then refuses data until the reader makes room
+  std::vector<uint8_t> data(100, 0x5A);
+  struct iovec buffer = {data.data(), data.size()};
+  BOOST_CHECK_EQUAL(first->writev(&buffer, 1), 64);
+  BOOST_CHECK_LT(first->writev(&buffer, 1), 0);
+  BOOST_CHECK_EQUAL(first->status(), -EAGAIN);
+  BOOST_CHECK_EQUAL(first->waitWritable(1000), 0);
+
+  std::thread reader([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    second->read(received.data(), 10, 0);
+  });
+  BOOST_CHECK_EQUAL(first->waitWritable(2000000), 1);
+  reader.join();
+  BOOST_CHECK_EQUAL(first->writev(&buffer, 1), 10);
+
+  // The remaining data can be read after the writer closed its end
+  first->close();
+  BOOST_CHECK(!first->isOpen());
+  BOOST_CHECK_LT(first->writev(&buffer, 1), 0);
+  BOOST_CHECK_EQUAL(second->read(received.data(), 40, 0, false), 40);
+  BOOST_CHECK_EQUAL(second->read(received.data(), 40, 0, false), 24);
+  BOOST_CHECK_LT(second->read(received.data(), 40, 0), 0);
+  BOOST_CHECK_EQUAL(second->status(), -EPIPE);
+  BOOST_CHECK_LT(second->waitReadable(1000), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PipeDescriptorSignalsData)
+{
+  std::shared_ptr<SVHPipeTransport> first;
+  std::shared_ptr<SVHPipeTransport> second;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(first, second, 4096));
+
+  // The descriptor has to poll readable whenever data is pending, as the reactor relies on it
+  pollfd descriptor = {second->fileDescriptor(), POLLIN, 0};
+  BOOST_CHECK_EQUAL(poll(&descriptor, 1, 0), 0);
+
+  std::vector<uint8_t> data(3000);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::thread writer([&] {
+    for (size_t offset = 0; offset < data.size(); offset += 100)
+    {
+      std::vector<uint8_t> chunk(data.begin() + offset, data.begin() + offset + 100);
+      writeAll(*first, chunk);
+    }
+  });
+
+  std::vector<uint8_t> received;
+  uint8_t buffer[256];
+  while (received.size() < data.size() && poll(&descriptor, 1, 2000) > 0)
+  {
+    ssize_t bytes = second->read(buffer, sizeof(buffer), 0);
+    BOOST_REQUIRE_GE(bytes, 0);
+    received.insert(received.end(), buffer, buffer + bytes);
+  }
+  writer.join();
+  BOOST_CHECK(received == data);
+  BOOST_CHECK_EQUAL(poll(&descriptor, 1, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SocketPairTransfersData)
+{
+  std::shared_ptr<SVHSocketTransport> first;
+  std::shared_ptr<SVHSocketTransport> second;
+  BOOST_REQUIRE(SVHSocketTransport::createPair(first, second));
+  BOOST_CHECK_GE(first->fileDescriptor(), 0);
+
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<uint8_t>(i * 13);
+  }
+  BOOST_REQUIRE(writeAll(*first, data));
+
+  std::vector<uint8_t> received(data.size());
+  BOOST_CHECK_EQUAL(second->read(received.data(), received.size(), 1000000, false), 1000);
+  BOOST_CHECK(received == data);
+  BOOST_CHECK_EQUAL(second->read(received.data(), 10, 0), 0);
+
+  // A closed peer is reported instead of silently returning nothing
+  first->close();
+  BOOST_CHECK_LT(second->read(received.data(), 10, 1000), 0);
+  BOOST_CHECK_EQUAL(second->status(), -EPIPE);
+  struct iovec buffer = {data.data(), data.size()};
+  BOOST_CHECK_LT(second->writev(&buffer, 1), 0);
+  BOOST_CHECK_EQUAL(second->status(), -EPIPE);
+}
+
+BOOST_AUTO_TEST_CASE(ControllerTalksToTheSimulatorOverEveryTransport)
+{
+  auto reactor = std::make_shared<SVHReactor>();
+  BOOST_REQUIRE(reactor->start());
+
+  for (int variant = 0; variant < 4; ++variant)
+  {
+    std::shared_ptr<SVHTransport> library_end;
+    std::shared_ptr<SVHTransport> hand_end;
+    if (variant % 2 == 0)
+    {
+      std::shared_ptr<SVHPipeTransport> first;
+      std::shared_ptr<SVHPipeTransport> second;
+      BOOST_REQUIRE(SVHPipeTransport::createPair(first, second));
+      library_end = first;
+      hand_end    = second;
+    }
+    else
+    {
+      std::shared_ptr<SVHSocketTransport> first;
+      std::shared_ptr<SVHSocketTransport> second;
+      BOOST_REQUIRE(SVHSocketTransport::createPair(first, second));
+      library_end = first;
+      hand_end    = second;
+    }
+    BOOST_TEST_MESSAGE("Transport " << library_end->deviceName() << ", reactor: " << (variant / 2));
+
+    SVHSimulator simulator;
+    BOOST_REQUIRE(simulator.start(hand_end));
+
+    SVHController controller;
+    if (variant >= 2)
+    {
+      controller.setReactor(reactor);
+    }
+    else
+    {
+      // Without a serial line the frames need no pacing
+      SVHTransportOptions options;
+      options.receive_strategy = RS_BLOCKING;
+      options.transmission_gap = std::chrono::microseconds(0);
+      controller.setTransportOptions(options);
+    }
+    BOOST_REQUIRE(controller.connect(library_end));
+    exchangeFeedback(controller, 100);
+
+    // The library notices when the hand goes away
+    simulator.stop();
+    for (int i = 0; i < 200 && variant >= 2 && !controller.hasCommunicationFailed(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    if (variant >= 2)
+    {
+      BOOST_CHECK(controller.hasCommunicationFailed());
+    }
+    controller.disconnect();
+  }
+
+  reactor->stop();
+}
+
+BOOST_AUTO_TEST_CASE(FingerManagerConnectsOverAPipe)
+{
+  std::shared_ptr<SVHPipeTransport> library_end;
+  std::shared_ptr<SVHPipeTransport> hand_end;
+  BOOST_REQUIRE(SVHPipeTransport::createPair(library_end, hand_end));
+
+  SVHSimulator simulator;
+  BOOST_REQUIRE(simulator.start(hand_end));
+
+  SVHFingerManager manager;
+  BOOST_REQUIRE(manager.connect(library_end));
+  BOOST_CHECK(manager.isConnected());
+  manager.disconnect();
+  BOOST_CHECK(!library_end->isOpen());
+  simulator.stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
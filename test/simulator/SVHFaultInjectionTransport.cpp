@@ -0,0 +1,325 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ */
+//----------------------------------------------------------------------
+#include "SVHFaultInjectionTransport.h"
+
+#include <schunk_svh_library/serial/SVHFrameDecoder.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+namespace driver_svh {
+
+SVHFaultInjectionTransport::SVHFaultInjectionTransport(
+  const std::shared_ptr<SVHTransport>& transport, const SVHFaultSettings& settings)
+  : m_transport(transport)
+  , m_settings(settings)
+  , m_frame_random(settings.seed)
+  , m_read_random(settings.seed + 1)
+  , m_probability(0.0, 1.0)
+  , m_transport_status(0)
+  , m_status(0)
+  , m_name(std::string("faulty:") + transport->deviceName())
+  , m_stat_frames(0)
+  , m_stat_damaged_frames(0)
+  , m_stat_corrupted_bytes(0)
+  , m_stat_dropped_bytes(0)
+  , m_stat_duplicated_frames(0)
+  , m_stat_bursts(0)
+  , m_stat_partial_reads(0)
+{
+}
+
+SVHFaultStatistics SVHFaultInjectionTransport::statistics() const
+{
+  SVHFaultStatistics statistics;
+  statistics.frames            = m_stat_frames;
+  statistics.damaged_frames    = m_stat_damaged_frames;
+  statistics.corrupted_bytes   = m_stat_corrupted_bytes;
+  statistics.dropped_bytes     = m_stat_dropped_bytes;
+  statistics.duplicated_frames = m_stat_duplicated_frames;
+  statistics.bursts            = m_stat_bursts;
+  statistics.partial_reads     = m_stat_partial_reads;
+  return statistics;
+}
+
+void SVHFaultInjectionTransport::pull()
+{
+  if (m_transport_status < 0)
+  {
+    return;
+  }
+
+  uint8_t chunk[4096];
+  ssize_t bytes = 0;
+  do
+  {
+    bytes = m_transport->read(chunk, sizeof(chunk), 0);
+    if (bytes < 0)
+    {
+      m_transport_status = m_transport->status() < 0 ? m_transport->status() : -EIO;
+      break;
+    }
+    m_incoming.insert(m_incoming.end(), chunk, chunk + bytes);
+  } while (bytes == static_cast<ssize_t>(sizeof(chunk)));
+
+  // The wrapped stream is intact, so the length field tells where each frame ends
+  size_t pos = 0;
+  while (m_incoming.size() - pos >= SVHFrameDecoder::C_FRAME_HEADER_SIZE)
+  {
+    const uint8_t* data = m_incoming.data() + pos;
+    const size_t length = static_cast<size_t>(data[4]) | (static_cast<size_t>(data[5]) << 8);
+    if (data[0] != PACKET_HEADER1 || data[1] != PACKET_HEADER2 || length > C_MAXIMUM_PACKET_SIZE)
+    {
+      m_pending.push_back({Clock::now(), std::vector<uint8_t>(1, data[0]), 0, false, 0, 0});
+      pos++;
+      continue;
+    }
+
+    const size_t size = length + C_PACKET_APPENDIX_SIZE;
+    if (m_incoming.size() - pos < size)
+    {
+      break;
+    }
+    inject(data, size);
+    pos += size;
+  }
+  m_incoming.erase(m_incoming.begin(), m_incoming.begin() + static_cast<ptrdiff_t>(pos));
+}
+
+void SVHFaultInjectionTransport::inject(const uint8_t* frame, size_t size)
+{
+  const Clock::time_point now = Clock::now();
+  uint32_t faults             = 0;
+
+  Segment segment;
+  segment.release = now;
+  segment.offset  = 0;
+  segment.notify  = true;
+  segment.frame   = m_stat_frames;
+  if (m_settings.corrupt_probability > 0 || m_settings.drop_probability > 0)
+  {
+    segment.bytes.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      uint8_t byte = frame[i];
+      if (m_probability(m_frame_random) < m_settings.drop_probability)
+      {
+        faults |= FF_DROPPED;
+        m_stat_dropped_bytes++;
+        continue;
+      }
+      if (m_probability(m_frame_random) < m_settings.corrupt_probability)
+      {
+        faults |= FF_CORRUPTED;
+        m_stat_corrupted_bytes++;
+        byte ^= static_cast<uint8_t>(1u << (m_frame_random() % 8));
+      }
+      segment.bytes.push_back(byte);
+    }
+  }
+  else
+  {
+    segment.bytes.assign(frame, frame + size);
+  }
+
+  // The random number is drawn for every frame, so that the faults do not depend on the timing
+  bool burst = m_settings.burst_probability > 0 &&
+               m_probability(m_frame_random) < m_settings.burst_probability;
+  if (now < m_burst_end)
+  {
+    segment.release = m_burst_end;
+    faults |= FF_DELAYED;
+  }
+  else if (burst)
+  {
+    m_burst_end     = now + m_settings.burst_delay;
+    segment.release = m_burst_end;
+    faults |= FF_DELAYED;
+    m_stat_bursts++;
+  }
+
+  bool duplicate = m_settings.duplicate_probability > 0 &&
+                   m_probability(m_frame_random) < m_settings.duplicate_probability;
+  if (duplicate)
+  {
+    faults |= FF_DUPLICATED;
+    m_stat_duplicated_frames++;
+  }
+  if (faults & (FF_CORRUPTED | FF_DROPPED))
+  {
+    m_stat_damaged_frames++;
+  }
+
+  m_stat_frames++;
+
+  segment.faults = faults;
+  m_pending.push_back(segment);
+  if (duplicate)
+  {
+    segment.notify = false;
+    m_pending.push_back(std::move(segment));
+  }
+}
+
+bool SVHFaultInjectionTransport::hasReleasedData(const Clock::time_point& now) const
+{
+  return !m_pending.empty() && m_pending.front().release <= now;
+}
+
+size_t SVHFaultInjectionTransport::deliver(uint8_t* data, size_t size)
+{
+  const Clock::time_point now = Clock::now();
+  size_t delivered            = 0;
+  while (delivered < size && hasReleasedData(now))
+  {
+    Segment& segment = m_pending.front();
+    size_t count     = std::min(size - delivered, segment.bytes.size() - segment.offset);
+    std::memcpy(data + delivered, segment.bytes.data() + segment.offset, count);
+    delivered += count;
+    segment.offset += count;
+    if (segment.offset == segment.bytes.size())
+    {
+      if (segment.notify && m_observer)
+      {
+        m_observer(segment.frame, segment.faults);
+      }
+      m_pending.pop_front();
+    }
+  }
+  return delivered;
+}
+
+void SVHFaultInjectionTransport::waitForData(const Clock::time_point& now,
+                                             const Clock::time_point& end)
+{
+  Clock::time_point until = end;
+  if (!m_pending.empty() && m_pending.front().release < until)
+  {
+    until = m_pending.front().release;
+  }
+  if (until <= now)
+  {
+    return;
+  }
+
+  // A failed transport returns immediately, only held back data is left to wait for
+  if (m_transport_status < 0)
+  {
+    std::this_thread::sleep_until(until);
+  }
+  else
+  {
+    m_transport->waitReadable(static_cast<unsigned long>(
+      std::chrono::duration_cast<std::chrono::microseconds>(until - now).count()));
+  }
+}
+
+ssize_t SVHFaultInjectionTransport::read(void* data,
+                                         ssize_t size,
+                                         unsigned long time,
+                                         bool return_on_less_data)
+{
+  const Clock::time_point end = Clock::now() + std::chrono::microseconds(time);
+  uint8_t* buffer             = static_cast<uint8_t*>(data);
+
+  // A partial read is limited once per call, like a serial driver that returns what it has
+  size_t limit = static_cast<size_t>(size);
+  if (m_settings.max_read_size > 0)
+  {
+    limit = std::min(limit, 1 + m_read_random() % m_settings.max_read_size);
+  }
+
+  size_t bytes_read = 0;
+  m_status          = 0;
+  while (true)
+  {
+    pull();
+    bytes_read += deliver(buffer + bytes_read, limit - bytes_read);
+    if (bytes_read == limit || (bytes_read > 0 && return_on_less_data))
+    {
+      break;
+    }
+    if (m_pending.empty() && m_transport_status < 0)
+    {
+      if (bytes_read > 0)
+      {
+        break;
+      }
+      m_status = m_transport_status;
+      return m_status;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (now >= end)
+    {
+      break;
+    }
+    waitForData(now, end);
+  }
+
+  if (bytes_read == limit && limit < static_cast<size_t>(size) && hasReleasedData(Clock::now()))
+  {
+    m_stat_partial_reads++;
+  }
+  return static_cast<ssize_t>(bytes_read);
+}
+
+int SVHFaultInjectionTransport::waitReadable(unsigned long time)
+{
+  const Clock::time_point end = Clock::now() + std::chrono::microseconds(time);
+  while (true)
+  {
+    pull();
+    const Clock::time_point now = Clock::now();
+    if (hasReleasedData(now))
+    {
+      m_status = 0;
+      return 1;
+    }
+    if (m_pending.empty() && m_transport_status < 0)
+    {
+      m_status = m_transport_status;
+      return m_status;
+    }
+    if (now >= end)
+    {
+      return 0;
+    }
+    waitForData(now, end);
+  }
+}
+
+std::string SVHFaultInjectionTransport::statusText() const
+{
+  return strerror(-m_status);
+}
+
+} // namespace driver_svh
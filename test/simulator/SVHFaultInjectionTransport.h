@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the SVHFaultInjectionTransport, which wraps another
+ * transport and damages the stream read from it the way a noisy link
+ * does: flipped bits, lost bytes, repeated frames, frames that arrive in
+ * delayed bursts and reads that return only part of the available data.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_FAULT_INJECTION_TRANSPORT_H_INCLUDED
+#define DRIVER_SVH_SVH_FAULT_INJECTION_TRANSPORT_H_INCLUDED
+
+#include <schunk_svh_library/serial/SVHTransport.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+//! Faults applied to a frame, combined in the observer callback
+enum SVHFault
+{
+  FF_CORRUPTED  = 0x1, //!< at least one bit of the frame was flipped
+  FF_DROPPED    = 0x2, //!< at least one byte of the frame was removed
+  FF_DUPLICATED = 0x4, //!< the frame is delivered twice
+  FF_DELAYED    = 0x8  //!< the frame is held back as part of a burst
+};
+
+//! Probabilities of the faults, all faults are disabled by default
+struct SVHFaultSettings
+{
+  //! Probability of each byte to get a random bit flipped
+  double corrupt_probability = 0.0;
+  //! Probability of each byte to be removed from the stream
+  double drop_probability = 0.0;
+  //! Probability of each frame to be delivered a second time right after itself
+  double duplicate_probability = 0.0;
+  //! Probability of each frame to start a burst: it and all frames following within burst_delay
+  //! are held back and delivered at once
+  double burst_probability = 0.0;
+  //! Time frames are held back by a burst
+  std::chrono::microseconds burst_delay{5000};
+  //! Each read returns at most a random number of bytes between 1 and this, 0 disables the limit
+  size_t max_read_size = 0;
+  //! Seed of the random faults, the same stream is always damaged the same way
+  uint32_t seed = 1;
+};
+
+//! Counters of the injected faults
+struct SVHFaultStatistics
+{
+  //! Number of frames read from the wrapped transport
+  uint64_t frames = 0;
+  //! Number of frames that were corrupted or lost bytes
+  uint64_t damaged_frames = 0;
+  //! Number of bytes with a flipped bit
+  uint64_t corrupted_bytes = 0;
+  //! Number of bytes removed from the stream
+  uint64_t dropped_bytes = 0;
+  //! Number of frames delivered twice
+  uint64_t duplicated_frames = 0;
+  //! Number of bursts started
+  uint64_t bursts = 0;
+  //! Number of reads that returned less than requested although more data was available
+  uint64_t partial_reads = 0;
+};
+
+/*!
+ * \brief Function called once the last byte of a frame was read from the fault injection
+ * transport, so the frame is just about to be decoded
+ * \param frame number of the frame in the wrapped stream, counted from 0
+ * \param faults combination of SVHFault values
+ */
+using SVHFaultObserver = std::function<void(uint64_t frame, uint32_t faults)>;
+
+/*!
+ * \brief Transport that injects faults into the data read from another transport
+ *
+ * The wrapped transport has to deliver an intact stream, e.g. one end of an SVHPipeTransport
+ * pair. It is split into frames before the faults are applied, so that every fault can be
+ * attributed to a frame. Bytes in between frames are passed on unchanged. Writes are passed on
+ * unchanged as well.
+ *
+ * Held back and partially read data is not signalled through a descriptor, so fileDescriptor()
+ * returns -1 and the transport cannot be serviced by an SVHReactor.
+ */
+class SVHFaultInjectionTransport : public SVHTransport
+{
+public:
+  SVHFaultInjectionTransport(const std::shared_ptr<SVHTransport>& transport,
+                             const SVHFaultSettings& settings);
+
+  //! Called in the reading thread for every frame, set before reading
+  void setObserver(const SVHFaultObserver& observer) { m_observer = observer; }
+
+  //! Counters of the injected faults
+  SVHFaultStatistics statistics() const;
+
+  bool isOpen() const override { return m_transport->isOpen(); }
+
+  void close() override { m_transport->close(); }
+
+  ssize_t read(void* data,
+               ssize_t size,
+               unsigned long time       = 100,
+               bool return_on_less_data = true) override;
+
+  ssize_t writev(const struct iovec* buffers, int count) override
+  {
+    return m_transport->writev(buffers, count);
+  }
+
+  int waitWritable(unsigned long time) override { return m_transport->waitWritable(time); }
+
+  int waitReadable(unsigned long time) override;
+
+  int fileDescriptor() override { return -1; }
+
+  int status() const override { return m_status; }
+
+  std::string statusText() const override;
+
+  const char* deviceName() const override { return m_name.c_str(); }
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  //! Bytes that become readable at the same time
+  struct Segment
+  {
+    Clock::time_point release;
+    std::vector<uint8_t> bytes;
+    size_t offset;
+    //! Frame the bytes belong to, the observer is told about it once all of them were read
+    bool notify;
+    uint64_t frame;
+    uint32_t faults;
+  };
+
+  //! Reads everything available from the wrapped transport and schedules it
+  void pull();
+
+  //! Applies the faults to a complete frame and schedules it
+  void inject(const uint8_t* frame, size_t size);
+
+  //! Copies at most \a size released bytes
+  size_t deliver(uint8_t* data, size_t size);
+
+  //! Whether released bytes are waiting
+  bool hasReleasedData(const Clock::time_point& now) const;
+
+  //! Waits for the wrapped transport until \a end or the next release, whatever comes first
+  void waitForData(const Clock::time_point& now, const Clock::time_point& end);
+
+  std::shared_ptr<SVHTransport> m_transport;
+
+  SVHFaultSettings m_settings;
+
+  SVHFaultObserver m_observer;
+
+  //! Decides the faults of the frames
+  std::mt19937 m_frame_random;
+
+  //! Decides the size of partial reads, separate so that it does not depend on the read timing
+  std::mt19937 m_read_random;
+
+  std::uniform_real_distribution<double> m_probability;
+
+  //! Bytes read from the wrapped transport that do not form a complete frame yet
+  std::vector<uint8_t> m_incoming;
+
+  //! Scheduled bytes in the order they are delivered
+  std::deque<Segment> m_pending;
+
+  //! End of the current burst
+  Clock::time_point m_burst_end;
+
+  //! Status of the wrapped transport after it failed
+  int m_transport_status;
+
+  int m_status;
+
+  std::string m_name;
+
+  std::atomic<uint64_t> m_stat_frames;
+  std::atomic<uint64_t> m_stat_damaged_frames;
+  std::atomic<uint64_t> m_stat_corrupted_bytes;
+  std::atomic<uint64_t> m_stat_dropped_bytes;
+  std::atomic<uint64_t> m_stat_duplicated_frames;
+  std::atomic<uint64_t> m_stat_bursts;
+  std::atomic<uint64_t> m_stat_partial_reads;
+};
+
+} // namespace driver_svh
+
+#endif
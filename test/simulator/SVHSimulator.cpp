@@ -0,0 +1,554 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHSimulator, a protocol responder that behaves
+ * like the SCHUNK five finger hand on the other end of a pseudo terminal.
+ */
+//----------------------------------------------------------------------
+#include "SVHSimulator.h"
+
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/control/SVHControlCommand.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace driver_svh {
+
+namespace {
+
+//! Fallbacks for channels that did not receive any settings yet
+const double C_DEFAULT_SPEED         = 40.0e3;
+const double C_DEFAULT_CURRENT_LIMIT = 300.0;
+
+//! Fraction of the current limit drawn while a channel moves freely
+const double C_MOVING_CURRENT_FACTOR = 0.2;
+
+//! Penetration of an end stop in ticks at which a channel draws its full current limit
+const double C_CONTACT_TICKS = 1000.0;
+
+} // namespace
+
+SVHSimulator::SVHSimulator(const SVHSimulatorSettings& settings)
+  : m_settings(settings)
+  , m_master(-1)
+  , m_slave(-1)
+  , m_running(false)
+  , m_lower_stop(-settings.hard_stop)
+  , m_upper_stop(settings.hard_stop)
+  , m_last_update(std::chrono::steady_clock::now())
+  , m_frames_received(0)
+  , m_frames_sent(0)
+  , m_checksum_errors(0)
+  , m_frames_dropped(0)
+{
+  for (Channel& channel : m_channels)
+  {
+    channel.position = 0.0;
+    channel.target   = 0;
+    channel.current  = 0;
+  }
+}
+
+SVHSimulator::~SVHSimulator()
+{
+  stop();
+}
+
+bool SVHSimulator::start()
+{
+  stop();
+
+  m_master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHSimulator",
+                         "Could not create pseudo terminal: " << std::strerror(errno));
+    stop();
+    return false;
+  }
+  m_device_name = ptsname(m_master);
+
+  // Keep one handle of the slave side open ourselves. Otherwise the master reports a hangup
+  // whenever the library closes its connection.
+  m_slave = ::open(m_device_name.c_str(), O_RDWR | O_NOCTTY);
+  if (m_slave < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHSimulator",
+                         "Could not open " << m_device_name << ": " << std::strerror(errno));
+    stop();
+    return false;
+  }
+  termios io_set;
+  tcgetattr(m_slave, &io_set);
+  cfmakeraw(&io_set);
+  tcsetattr(m_slave, TCSANOW, &io_set);
+
+  m_last_update = std::chrono::steady_clock::now();
+  m_running     = true;
+  m_thread      = std::thread([this] {
+    pthread_setname_np(pthread_self(), "svh-simulator");
+    run();
+  });
+
+  SVH_LOG_DEBUG_STREAM("SVHSimulator", "Simulated hand is listening on " << m_device_name);
+  return true;
+}
+
+bool SVHSimulator::start(const std::shared_ptr<SVHTransport>& transport)
+{
+  stop();
+
+  if (!transport || !transport->isOpen())
+  {
+    SVH_LOG_ERROR_STREAM("SVHSimulator", "Cannot answer on a transport that is not open");
+    return false;
+  }
+  m_transport   = transport;
+  m_device_name = transport->deviceName();
+
+  m_last_update = std::chrono::steady_clock::now();
+  m_running     = true;
+  m_thread      = std::thread([this] {
+    pthread_setname_np(pthread_self(), "svh-simulator");
+    run();
+  });
+
+  SVH_LOG_DEBUG_STREAM("SVHSimulator", "Simulated hand is listening on " << m_device_name);
+  return true;
+}
+
+void SVHSimulator::stop()
+{
+  m_running = false;
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+  if (m_transport)
+  {
+    m_transport->close();
+    m_transport.reset();
+  }
+  if (m_slave >= 0)
+  {
+    ::close(m_slave);
+    m_slave = -1;
+  }
+  if (m_master >= 0)
+  {
+    ::close(m_master);
+    m_master = -1;
+  }
+}
+
+int32_t SVHSimulator::position(const SVHChannel& channel)
+{
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  updateChannels();
+  return static_cast<int32_t>(m_channels[channel].position);
+}
+
+int32_t SVHSimulator::target(const SVHChannel& channel)
+{
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  return m_channels[channel].target;
+}
+
+bool SVHSimulator::isEnabled(const SVHChannel& channel)
+{
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  return channelEnabled(channel);
+}
+
+SVHControllerState SVHSimulator::controllerState()
+{
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  return m_controller_state;
+}
+
+std::vector<uint8_t> SVHSimulator::receivedAddresses()
+{
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  return m_received_addresses;
+}
+
+void SVHSimulator::setHardStop(int32_t hard_stop, int32_t stop_compliance)
+{
+  setHardStops(-hard_stop, hard_stop, stop_compliance);
+}
+
+void SVHSimulator::setHardStops(int32_t lower_stop, int32_t upper_stop, int32_t stop_compliance)
+{
+  std::lock_guard<std::mutex> lock(m_state_mutex);
+  updateChannels();
+  m_lower_stop               = lower_stop;
+  m_upper_stop               = upper_stop;
+  m_settings.stop_compliance = stop_compliance;
+}
+
+void SVHSimulator::run()
+{
+  uint8_t chunk[1024];
+  while (m_running)
+  {
+    ssize_t bytes = 0;
+    if (m_transport)
+    {
+      int ready = m_transport->waitReadable(10000);
+      if (ready < 0)
+      {
+        // The library closed its end, do not spin until stop() is called
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      if (ready <= 0)
+      {
+        continue;
+      }
+      bytes = m_transport->read(chunk, sizeof(chunk), 0);
+    }
+    else
+    {
+      pollfd poll_fd = {m_master, POLLIN, 0};
+      if (poll(&poll_fd, 1, 10) <= 0 || !(poll_fd.revents & POLLIN))
+      {
+        continue;
+      }
+      bytes = ::read(m_master, chunk, sizeof(chunk));
+    }
+    if (bytes > 0)
+    {
+      m_read_time = std::chrono::steady_clock::now();
+      m_buffer.insert(m_buffer.end(), chunk, chunk + bytes);
+      processBuffer();
+    }
+  }
+}
+
+void SVHSimulator::processBuffer()
+{
+  size_t pos = 0;
+  while (m_buffer.size() - pos >= C_PACKET_APPENDIX_SIZE)
+  {
+    if (m_buffer[pos] != PACKET_HEADER1 || m_buffer[pos + 1] != PACKET_HEADER2)
+    {
+      pos++;
+      continue;
+    }
+
+    const size_t length = m_buffer[pos + 4] | (m_buffer[pos + 5] << 8);
+    if (m_buffer.size() - pos < length + C_PACKET_APPENDIX_SIZE)
+    {
+      break;
+    }
+
+    SVHSerialPacket request(length, m_buffer[pos + 3]);
+    request.index = m_buffer[pos + 2];
+    auto payload = m_buffer.begin() + pos + 6;
+    std::copy(payload, payload + length, request.data.begin());
+
+    uint8_t check_sum1;
+    uint8_t check_sum2;
+    calcCheckSum(check_sum1, check_sum2, request);
+    if (check_sum1 != m_buffer[pos + 6 + length] || check_sum2 != m_buffer[pos + 7 + length])
+    {
+      // Resynchronize on the next header
+      m_checksum_errors++;
+      pos++;
+      continue;
+    }
+
+    pos += length + C_PACKET_APPENDIX_SIZE;
+    m_frames_received++;
+
+    // Requests read at once arrived back to back
+    if (m_settings.minimum_gap.count() > 0)
+    {
+      bool too_close = m_last_request != std::chrono::steady_clock::time_point() &&
+                       m_read_time - m_last_request < m_settings.minimum_gap;
+      m_last_request = m_read_time;
+      if (too_close)
+      {
+        m_frames_dropped++;
+        continue;
+      }
+    }
+    handleRequest(request);
+  }
+  m_buffer.erase(m_buffer.begin(), m_buffer.begin() + pos);
+}
+
+void SVHSimulator::handleRequest(const SVHSerialPacket& request)
+{
+  const uint8_t type    = request.address & 0x0F;
+  const size_t channel  = static_cast<size_t>(request.address >> 4);
+  const bool is_channel = channel < SVH_DIMENSION;
+
+  ArrayBuilder payload(0);
+  payload.appendWithoutConversion(request.data);
+  ArrayBuilder response_payload(0);
+
+  {
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    m_received_addresses.push_back(request.address);
+    updateChannels();
+
+    switch (type)
+    {
+      case SVH_SET_CONTROL_COMMAND:
+      case SVH_GET_CONTROL_FEEDBACK: {
+        if (!is_channel)
+        {
+          return;
+        }
+        if (type == SVH_SET_CONTROL_COMMAND)
+        {
+          SVHControlCommand command;
+          payload >> command;
+          m_channels[channel].target = command.position;
+        }
+        response_payload << SVHControllerFeedback(m_channels[channel].position,
+                                                  m_channels[channel].current);
+        break;
+      }
+      case SVH_SET_CONTROL_COMMAND_ALL:
+      case SVH_GET_CONTROL_FEEDBACK_ALL: {
+        if (type == SVH_SET_CONTROL_COMMAND_ALL)
+        {
+          SVHControlCommandAllChannels command;
+          payload >> command;
+          for (size_t i = 0; i < SVH_DIMENSION && i < command.commands.size(); ++i)
+          {
+            m_channels[i].target = command.commands[i].position;
+          }
+        }
+        SVHControllerFeedbackAllChannels feedback_all;
+        for (size_t i = 0; i < SVH_DIMENSION; ++i)
+        {
+          feedback_all.feedbacks[i] =
+            SVHControllerFeedback(m_channels[i].position, m_channels[i].current);
+        }
+        response_payload << feedback_all;
+        break;
+      }
+      case SVH_SET_POSITION_SETTINGS:
+      case SVH_GET_POSITION_SETTINGS: {
+        if (!is_channel)
+        {
+          return;
+        }
+        if (type == SVH_SET_POSITION_SETTINGS)
+        {
+          payload >> m_channels[channel].position_settings;
+        }
+        response_payload << m_channels[channel].position_settings;
+        break;
+      }
+      case SVH_SET_CURRENT_SETTINGS:
+      case SVH_GET_CURRENT_SETTINGS: {
+        if (!is_channel)
+        {
+          return;
+        }
+        if (type == SVH_SET_CURRENT_SETTINGS)
+        {
+          payload >> m_channels[channel].current_settings;
+        }
+        response_payload << m_channels[channel].current_settings;
+        break;
+      }
+      case SVH_SET_CONTROLLER_STATE:
+      case SVH_GET_CONTROLLER_STATE: {
+        if (type == SVH_SET_CONTROLLER_STATE)
+        {
+          payload >> m_controller_state;
+        }
+        response_payload << m_controller_state;
+        break;
+      }
+      case SVH_SET_ENCODER_VALUES:
+      case SVH_GET_ENCODER_VALUES: {
+        if (type == SVH_SET_ENCODER_VALUES)
+        {
+          payload >> m_encoder_settings;
+        }
+        response_payload << m_encoder_settings;
+        break;
+      }
+      case SVH_GET_FIRMWARE_INFO: {
+        // Serialized by hand as the stream operator of SVHFirmwareInfo does not pad the strings
+        const std::string text = "SVH simulator";
+        std::vector<uint8_t> svh = {'S', 'V', 'H', ' '};
+        std::vector<uint8_t> text_bytes(48, 0);
+        std::copy(text.begin(), text.end(), text_bytes.begin());
+        response_payload << svh << static_cast<uint16_t>(1) << static_cast<uint16_t>(0)
+                         << text_bytes;
+        break;
+      }
+      default:
+        // The hardware does not answer to unknown requests either
+        return;
+    }
+  }
+
+  if (m_settings.response_delay.count() > 0)
+  {
+    std::this_thread::sleep_for(m_settings.response_delay);
+  }
+
+  SVHSerialPacket response(0, request.address);
+  response.index = request.index;
+  response.data  = response_payload.array;
+  sendResponse(response);
+}
+
+bool SVHSimulator::channelEnabled(size_t channel) const
+{
+  return (m_controller_state.pwm_active & (1 << channel)) && m_controller_state.pos_ctrl;
+}
+
+void SVHSimulator::updateChannels()
+{
+  auto now          = std::chrono::steady_clock::now();
+  const double time = std::chrono::duration<double>(now - m_last_update).count();
+  m_last_update     = now;
+
+  const double lower      = static_cast<double>(m_lower_stop);
+  const double upper      = static_cast<double>(m_upper_stop);
+  const double compliance = static_cast<double>(m_settings.stop_compliance);
+  for (size_t i = 0; i < SVH_DIMENSION; ++i)
+  {
+    Channel& channel = m_channels[i];
+    if (!channelEnabled(i))
+    {
+      channel.current = 0;
+      continue;
+    }
+
+    double speed = channel.position_settings.dwmx > 0 ? channel.position_settings.dwmx
+                                                      : C_DEFAULT_SPEED;
+    speed *= m_settings.speed_scale;
+
+    const double target    = static_cast<double>(channel.target);
+    const double distance  = target - channel.position;
+    const double direction = (distance > 0) ? 1.0 : -1.0;
+
+    // Pushing a channel into an end stop only progresses slowly
+    const bool pushing = (direction > 0) ? channel.position >= upper : channel.position <= lower;
+    if (pushing)
+    {
+      speed *= m_settings.compliance_speed_factor;
+    }
+    const double step = std::min(std::abs(distance), speed * time);
+    channel.position = std::max(lower - compliance,
+                                std::min(upper + compliance, channel.position + direction * step));
+
+    const double limit = (direction > 0)
+                           ? ((channel.current_settings.wmx > 0) ? channel.current_settings.wmx
+                                                                 : C_DEFAULT_CURRENT_LIMIT)
+                           : ((channel.current_settings.wmn < 0) ? -channel.current_settings.wmn
+                                                                 : C_DEFAULT_CURRENT_LIMIT);
+    const double penetration =
+      std::max(0.0, std::max(channel.position - upper, lower - channel.position));
+    const bool moving        = std::abs(target - channel.position) > 0.5;
+
+    if (penetration > 0 && (pushing || !moving))
+    {
+      // The stop pushes back, the current rises right after the contact
+      const double sign = (channel.position >= upper) ? 1.0 : -1.0;
+      channel.current   = static_cast<int16_t>(
+        sign * limit * std::min(1.0, C_MOVING_CURRENT_FACTOR + penetration / C_CONTACT_TICKS));
+    }
+    else if (moving)
+    {
+      channel.current = static_cast<int16_t>(direction * limit * C_MOVING_CURRENT_FACTOR);
+    }
+    else
+    {
+      channel.current = 0;
+    }
+  }
+}
+
+void SVHSimulator::sendResponse(SVHSerialPacket& response)
+{
+  response.data.resize(64, 0);
+
+  uint8_t check_sum1;
+  uint8_t check_sum2;
+  calcCheckSum(check_sum1, check_sum2, response);
+
+  ArrayBuilder frame(response.data.size() + C_PACKET_APPENDIX_SIZE);
+  frame << PACKET_HEADER1 << PACKET_HEADER2 << response << check_sum1 << check_sum2;
+
+  size_t written = 0;
+  while (written < frame.array.size() && m_running && m_transport)
+  {
+    struct iovec buffer;
+    buffer.iov_base = frame.array.data() + written;
+    buffer.iov_len  = frame.array.size() - written;
+    ssize_t bytes   = m_transport->writev(&buffer, 1);
+    if (bytes < 0)
+    {
+      if (m_transport->status() != -EAGAIN)
+      {
+        SVH_LOG_WARN_STREAM("SVHSimulator",
+                            "Could not send response: " << m_transport->statusText());
+        return;
+      }
+      m_transport->waitWritable(10000);
+      continue;
+    }
+    written += static_cast<size_t>(bytes);
+  }
+  while (written < frame.array.size() && m_running && !m_transport)
+  {
+    ssize_t bytes = ::write(m_master, frame.array.data() + written, frame.array.size() - written);
+    if (bytes < 0)
+    {
+      if (errno != EAGAIN && errno != EINTR)
+      {
+        SVH_LOG_WARN_STREAM("SVHSimulator", "Could not send response: " << std::strerror(errno));
+        return;
+      }
+      pollfd poll_fd = {m_master, POLLOUT, 0};
+      poll(&poll_fd, 1, 10);
+      continue;
+    }
+    written += static_cast<size_t>(bytes);
+  }
+  m_frames_sent++;
+}
+
+} // namespace driver_svh
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-18
+ *
+ * This file contains the SVHSimulator, a protocol responder that behaves
+ * like the SCHUNK five finger hand on the other end of a pseudo terminal.
+ * It answers every request the way the hardware does and models the
+ * channels with a simple kinematic: they move with the speed given in
+ * their position settings and stall at hard stops, which is enough to
+ * connect, home and command the hand through the unmodified library stack.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_SIMULATOR_H_INCLUDED
+#define DRIVER_SVH_SVH_SIMULATOR_H_INCLUDED
+
+#include <schunk_svh_library/control/SVHController.h>
+#include <schunk_svh_library/control/SVHControllerFeedback.h>
+#include <schunk_svh_library/control/SVHControllerState.h>
+#include <schunk_svh_library/control/SVHCurrentSettings.h>
+#include <schunk_svh_library/control/SVHEncoderSettings.h>
+#include <schunk_svh_library/control/SVHPositionSettings.h>
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+#include <schunk_svh_library/serial/SVHTransport.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace driver_svh {
+
+/*!
+ * \brief Settings of the simulated hand
+ */
+struct SVHSimulatorSettings
+{
+  //! Scales the speed of all channels, values > 1 make moves and homing faster than on the hand
+  double speed_scale = 1.0;
+  //! Position of the end stops in encoder ticks, they are placed symmetrically around zero
+  int32_t hard_stop = 200000;
+  //! Depth of the elastic zone behind the end stops in encoder ticks. Channels reach their current
+  //! limit right after hitting a stop but can be pushed further in slowly. The homing of the
+  //! library relies on this, as some idle positions lie behind the point the stop is detected at.
+  int32_t stop_compliance = 50000;
+  //! Speed factor of channels pushed into the elastic zone
+  double compliance_speed_factor = 0.05;
+  //! Time the simulated hand takes to answer a request
+  std::chrono::microseconds response_delay{0};
+  //! Requests that arrive closer than this after the previous one are dropped without an answer,
+  //! like the hardware does when it is flooded. A request arrives when its last byte is read.
+  std::chrono::microseconds minimum_gap{0};
+};
+
+/*!
+ * \brief Simulated SCHUNK five finger hand behind a pseudo terminal
+ *
+ * Connect the library to deviceName() after start() was called. Alternatively the simulator
+ * answers on one end of a transport pair, see start(const std::shared_ptr<SVHTransport>&).
+ */
+class SVHSimulator
+{
+public:
+  explicit SVHSimulator(const SVHSimulatorSettings& settings = SVHSimulatorSettings());
+
+  //! Stops the simulation
+  ~SVHSimulator();
+
+  /*!
+   * \brief start creates the pseudo terminal and starts answering requests
+   * \return false if the pseudo terminal could not be created
+   */
+  bool start();
+
+  /*!
+   * \brief start answering requests on an opened transport instead of a pseudo terminal, the
+   * library connects to the other end of it
+   * \param transport e.g. one end of an SVHPipeTransport pair, it is closed by stop()
+   * \return false if the transport is not open
+   */
+  bool start(const std::shared_ptr<SVHTransport>& transport);
+
+  //! stops answering requests and closes the pseudo terminal or transport
+  void stop();
+
+  //! Name of the device the library has to connect to, e.g. /dev/pts/3
+  const std::string& deviceName() const { return m_device_name; }
+
+  //! Number of valid frames received from the library
+  uint64_t receivedFrameCount() const { return m_frames_received; }
+
+  //! Number of frames sent to the library
+  uint64_t sentFrameCount() const { return m_frames_sent; }
+
+  //! Number of frames that were discarded due to a checksum error
+  uint64_t checksumErrorCount() const { return m_checksum_errors; }
+
+  //! Number of valid frames dropped because they followed the previous one too closely
+  uint64_t droppedFrameCount() const { return m_frames_dropped; }
+
+  //! Current position of a channel in encoder ticks
+  int32_t position(const SVHChannel& channel);
+
+  //! Target position last commanded for a channel in encoder ticks
+  int32_t target(const SVHChannel& channel);
+
+  //! Whether the controller of a channel is enabled
+  bool isEnabled(const SVHChannel& channel);
+
+  //! Controller state as last set by the library
+  SVHControllerState controllerState();
+
+  //! Moves the hard stops of all channels while running, like an object blocking the fingers
+  void setHardStop(int32_t hard_stop, int32_t stop_compliance);
+
+  //! Places the lower and upper hard stops independently, like an object blocking the fingers on
+  //! one side only. The lower stop may be positive.
+  void setHardStops(int32_t lower_stop, int32_t upper_stop, int32_t stop_compliance);
+
+  //! Addresses of the requests handled so far, in the order they arrived
+  std::vector<uint8_t> receivedAddresses();
+
+private:
+  //! State of a single simulated channel
+  struct Channel
+  {
+    double position;
+    int32_t target;
+    int16_t current;
+    SVHPositionSettings position_settings;
+    SVHCurrentSettings current_settings;
+  };
+
+  //! Reads from the pseudo terminal or transport and answers requests until stop() is called
+  void run();
+
+  //! Extracts and handles all complete frames of the receive buffer
+  void processBuffer();
+
+  //! Answers a single request
+  void handleRequest(const SVHSerialPacket& request);
+
+  //! Advances the channel kinematics to the current time
+  void updateChannels();
+
+  //! Whether the given channel is enabled, expects the state mutex to be held
+  bool channelEnabled(size_t channel) const;
+
+  //! Writes a response frame to the pseudo terminal or transport
+  void sendResponse(SVHSerialPacket& response);
+
+  SVHSimulatorSettings m_settings;
+
+  //! master side of the pseudo terminal
+  int m_master;
+
+  //! slave side, kept open so that the terminal persists between connections of the library
+  int m_slave;
+
+  //! used instead of the pseudo terminal if set
+  std::shared_ptr<SVHTransport> m_transport;
+
+  std::string m_device_name;
+
+  std::thread m_thread;
+
+  std::atomic<bool> m_running;
+
+  //! Bytes received but not yet processed
+  std::vector<uint8_t> m_buffer;
+
+  //! Time the bytes in m_buffer were last read
+  std::chrono::steady_clock::time_point m_read_time;
+
+  //! Arrival of the previous request, zero before the first one
+  std::chrono::steady_clock::time_point m_last_request;
+
+  //! protects the hand state below
+  std::mutex m_state_mutex;
+
+  std::array<Channel, SVH_DIMENSION> m_channels;
+
+  SVHControllerState m_controller_state;
+
+  SVHEncoderSettings m_encoder_settings;
+
+  //! End stops in encoder ticks, placed at -hard_stop and hard_stop of the settings at first
+  int32_t m_lower_stop;
+  int32_t m_upper_stop;
+
+  std::vector<uint8_t> m_received_addresses;
+
+  std::chrono::steady_clock::time_point m_last_update;
+
+  std::atomic<uint64_t> m_frames_received;
+  std::atomic<uint64_t> m_frames_sent;
+  std::atomic<uint64_t> m_checksum_errors;
+  std::atomic<uint64_t> m_frames_dropped;
+};
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,1003 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include "SVHCaptureAnalysis.h"
+
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHFirmwareInfo.h>
+#include <schunk_svh_library/control/SVHControllerState.h>
+#include <schunk_svh_library/control/SVHCurrentSettings.h>
+#include <schunk_svh_library/control/SVHPositionSettings.h>
+#include <schunk_svh_library/serial/SVHSerialPacket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace driver_svh {
+
+const size_t SVHCaptureSummary::C_RTT_BUCKETS;
+const uint64_t SVHCaptureAnalyzer::C_LOOKBACK_RECORDS;
+
+namespace {
+
+//! Header of a frame in front of the payload: two header bytes, index, address and length
+const size_t C_FRAME_HEADER_SIZE = 6;
+
+//! Checksum behind the payload
+const size_t C_FRAME_CHECKSUM_SIZE = 2;
+
+const char* const C_TYPE_NAMES[16] = {"get_control_feedback",
+                                      "set_control_command",
+                                      "get_control_feedback_all",
+                                      "set_control_command_all",
+                                      "get_position_settings",
+                                      "set_position_settings",
+                                      "get_current_settings",
+                                      "set_current_settings",
+                                      "get_controller_state",
+                                      "set_controller_state",
+                                      "get_encoder_values",
+                                      "set_encoder_values",
+                                      "get_firmware_info",
+                                      "unknown_13",
+                                      "unknown_14",
+                                      "unknown_15"};
+
+const char* directionName(SVHCaptureDirection direction)
+{
+  return direction == CD_TRANSMIT ? "tx" : "rx";
+}
+
+const char* statusName(SVHCaptureStatus status)
+{
+  switch (status)
+  {
+    case CS_OK:
+      return "ok";
+    case CS_CHECKSUM_ERROR:
+      return "checksum_error";
+    case CS_WRITE_FAILED:
+      return "write_failed";
+  }
+  return "unknown";
+}
+
+//! Bucket of the round trip time histogram
+size_t rttBucket(int64_t rtt_ns)
+{
+  const int64_t us = std::max<int64_t>(rtt_ns, 0) / 1000;
+  if (us < 1000)
+  {
+    return static_cast<size_t>(us);
+  }
+  if (us < 10000)
+  {
+    return static_cast<size_t>(1000 + (us - 1000) / 10);
+  }
+  if (us < 100000)
+  {
+    return static_cast<size_t>(1900 + (us - 10000) / 100);
+  }
+  if (us < 1000000)
+  {
+    return static_cast<size_t>(2800 + (us - 100000) / 1000);
+  }
+  return SVHCaptureSummary::C_RTT_BUCKETS - 1;
+}
+
+//! Shortest round trip time of a bucket in ns
+int64_t rttBucketStart(size_t bucket)
+{
+  int64_t us = 0;
+  if (bucket < 1000)
+  {
+    us = static_cast<int64_t>(bucket);
+  }
+  else if (bucket < 1900)
+  {
+    us = 1000 + static_cast<int64_t>(bucket - 1000) * 10;
+  }
+  else if (bucket < 2800)
+  {
+    us = 10000 + static_cast<int64_t>(bucket - 1900) * 100;
+  }
+  else
+  {
+    us = 100000 + static_cast<int64_t>(bucket - 2800) * 1000;
+  }
+  return us * 1000;
+}
+
+void appendNumber(std::string& out, double value)
+{
+  char buffer[32];
+  int length = std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+  out.append(buffer, static_cast<size_t>(std::max(length, 0)));
+}
+
+void appendNumber(std::string& out, uint64_t value)
+{
+  char buffer[32];
+  int length =
+    std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+  out.append(buffer, static_cast<size_t>(std::max(length, 0)));
+}
+
+void appendNumber(std::string& out, int64_t value)
+{
+  char buffer[32];
+  int length = std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+  out.append(buffer, static_cast<size_t>(std::max(length, 0)));
+}
+
+void appendFieldName(std::string& out, const SVHDecodedField& field)
+{
+  out += field.name;
+  if (field.channel >= 0)
+  {
+    out += '_';
+    appendNumber(out, static_cast<int64_t>(field.channel));
+  }
+}
+
+//! Append text as JSON string, or as CSV text with doubled quotes
+void appendEscaped(std::string& out, const std::string& text, SVHCaptureExportFormat format)
+{
+  for (std::string::const_iterator it = text.begin(); it != text.end(); ++it)
+  {
+    const unsigned char c = static_cast<unsigned char>(*it);
+    if (c == '"')
+    {
+      out += format == EF_JSON ? "\\\"" : "\"\"";
+    }
+    else if (c == '\\' && format == EF_JSON)
+    {
+      out += "\\\\";
+    }
+    else if (c < 0x20 || c >= 0x7F)
+    {
+      out += '?';
+    }
+    else
+    {
+      out += static_cast<char>(c);
+    }
+  }
+}
+
+//! Request that waits for its answer
+struct PendingRequest
+{
+  bool valid           = false;
+  uint8_t type         = 0;
+  int64_t timestamp_ns = 0;
+};
+
+} // namespace
+
+const char* SVHCaptureDecoder::typeName(uint8_t type)
+{
+  return C_TYPE_NAMES[type & 0x0F];
+}
+
+bool SVHCaptureDecoder::decode(const SVHCaptureFileHeader& header,
+                               const SVHCaptureRecord& record,
+                               SVHDecodedFrame& frame)
+{
+  frame.fields.clear();
+  frame.text.clear();
+
+  if (record.sequence == 0 || record.length > sizeof(record.frame) ||
+      record.length < C_FRAME_HEADER_SIZE + C_FRAME_CHECKSUM_SIZE)
+  {
+    return false;
+  }
+
+  frame.sequence  = record.sequence;
+  frame.time_ns   = header.realtime_ns + (record.timestamp_ns - header.steady_ns);
+  frame.direction = record.direction == CD_RECEIVE ? CD_RECEIVE : CD_TRANSMIT;
+  frame.status    = static_cast<SVHCaptureStatus>(record.status);
+  frame.index     = record.frame[2];
+  frame.type      = record.frame[3] & 0x0F;
+  frame.channel   = (record.frame[3] >> 4) & 0x0F;
+  frame.length    = static_cast<uint16_t>(record.frame[4] | (record.frame[5] << 8));
+
+  // A checksum error may have hit any byte, so its payload is not trusted
+  if (frame.status != CS_CHECKSUM_ERROR &&
+      C_FRAME_HEADER_SIZE + frame.length + C_FRAME_CHECKSUM_SIZE <= record.length)
+  {
+    decodePayload(record.frame + C_FRAME_HEADER_SIZE, frame);
+  }
+  return true;
+}
+
+void SVHCaptureDecoder::decodePayload(const uint8_t* payload, SVHDecodedFrame& frame)
+{
+  const bool received = frame.direction == CD_RECEIVE;
+
+  // Requests carry no payload, only their padding
+  if (!received && frame.type % 2 == 0)
+  {
+    return;
+  }
+
+  // The codecs read zeros behind the end of the payload, so short payloads are rejected up front
+  size_t required = 0;
+  switch (frame.type)
+  {
+    case SVH_GET_CONTROL_FEEDBACK:
+    case SVH_SET_CONTROL_COMMAND:
+      required = received ? 6 : 4;
+      break;
+    case SVH_GET_CONTROL_FEEDBACK_ALL:
+    case SVH_SET_CONTROL_COMMAND_ALL:
+      required = received ? 6 * C_CAPTURE_CHANNELS : 4 * C_CAPTURE_CHANNELS;
+      break;
+    case SVH_GET_POSITION_SETTINGS:
+    case SVH_SET_POSITION_SETTINGS:
+    case SVH_GET_CURRENT_SETTINGS:
+    case SVH_SET_CURRENT_SETTINGS:
+      required = 40;
+      break;
+    case SVH_GET_CONTROLLER_STATE:
+    case SVH_SET_CONTROLLER_STATE:
+      required = 12;
+      break;
+    case SVH_GET_ENCODER_VALUES:
+    case SVH_SET_ENCODER_VALUES:
+      required = 4 * C_CAPTURE_CHANNELS;
+      break;
+    case SVH_GET_FIRMWARE_INFO:
+      required = 56;
+      break;
+    default:
+      return;
+  }
+  if (frame.length < required)
+  {
+    return;
+  }
+
+  m_ab.array.assign(payload, payload + frame.length);
+  m_ab.write_pos = frame.length;
+  m_ab.read_pos  = 0;
+
+  std::vector<SVHDecodedField>& fields = frame.fields;
+  switch (frame.type)
+  {
+    case SVH_GET_CONTROL_FEEDBACK:
+    case SVH_SET_CONTROL_COMMAND:
+      if (received)
+      {
+        m_ab >> m_feedback;
+        fields.push_back({"position", -1, static_cast<double>(m_feedback.position)});
+        fields.push_back({"current", -1, static_cast<double>(m_feedback.current)});
+      }
+      else
+      {
+        m_ab >> m_command;
+        fields.push_back({"position", -1, static_cast<double>(m_command.position)});
+      }
+      break;
+    case SVH_GET_CONTROL_FEEDBACK_ALL:
+    case SVH_SET_CONTROL_COMMAND_ALL:
+      if (received)
+      {
+        m_feedback_all.feedbacks.resize(C_CAPTURE_CHANNELS);
+        m_ab >> m_feedback_all;
+        for (size_t i = 0; i < C_CAPTURE_CHANNELS; ++i)
+        {
+          const SVHControllerFeedback& feedback = m_feedback_all.feedbacks[i];
+          const int channel                     = static_cast<int>(i);
+          fields.push_back({"position", channel, static_cast<double>(feedback.position)});
+          fields.push_back({"current", channel, static_cast<double>(feedback.current)});
+        }
+      }
+      else
+      {
+        m_command_all.commands.resize(C_CAPTURE_CHANNELS);
+        m_ab >> m_command_all;
+        for (size_t i = 0; i < C_CAPTURE_CHANNELS; ++i)
+        {
+          const double position = static_cast<double>(m_command_all.commands[i].position);
+          fields.push_back({"position", static_cast<int>(i), position});
+        }
+      }
+      break;
+    case SVH_GET_POSITION_SETTINGS:
+    case SVH_SET_POSITION_SETTINGS:
+    {
+      SVHPositionSettings settings;
+      m_ab >> settings;
+      fields.push_back({"wmn", -1, settings.wmn});
+      fields.push_back({"wmx", -1, settings.wmx});
+      fields.push_back({"dwmx", -1, settings.dwmx});
+      fields.push_back({"ky", -1, settings.ky});
+      fields.push_back({"dt", -1, settings.dt});
+      fields.push_back({"imn", -1, settings.imn});
+      fields.push_back({"imx", -1, settings.imx});
+      fields.push_back({"kp", -1, settings.kp});
+      fields.push_back({"ki", -1, settings.ki});
+      fields.push_back({"kd", -1, settings.kd});
+      break;
+    }
+    case SVH_GET_CURRENT_SETTINGS:
+    case SVH_SET_CURRENT_SETTINGS:
+    {
+      SVHCurrentSettings settings;
+      m_ab >> settings;
+      fields.push_back({"wmn", -1, settings.wmn});
+      fields.push_back({"wmx", -1, settings.wmx});
+      fields.push_back({"ky", -1, settings.ky});
+      fields.push_back({"dt", -1, settings.dt});
+      fields.push_back({"imn", -1, settings.imn});
+      fields.push_back({"imx", -1, settings.imx});
+      fields.push_back({"kp", -1, settings.kp});
+      fields.push_back({"ki", -1, settings.ki});
+      fields.push_back({"umn", -1, settings.umn});
+      fields.push_back({"umx", -1, settings.umx});
+      break;
+    }
+    case SVH_GET_CONTROLLER_STATE:
+    case SVH_SET_CONTROLLER_STATE:
+    {
+      SVHControllerState state;
+      m_ab >> state;
+      fields.push_back({"pwm_fault", -1, static_cast<double>(state.pwm_fault)});
+      fields.push_back({"pwm_otw", -1, static_cast<double>(state.pwm_otw)});
+      fields.push_back({"pwm_reset", -1, static_cast<double>(state.pwm_reset)});
+      fields.push_back({"pwm_active", -1, static_cast<double>(state.pwm_active)});
+      fields.push_back({"pos_ctrl", -1, static_cast<double>(state.pos_ctrl)});
+      fields.push_back({"cur_ctrl", -1, static_cast<double>(state.cur_ctrl)});
+      break;
+    }
+    case SVH_GET_ENCODER_VALUES:
+    case SVH_SET_ENCODER_VALUES:
+      m_encoder_settings.scalings.resize(C_CAPTURE_CHANNELS);
+      m_ab >> m_encoder_settings;
+      for (size_t i = 0; i < C_CAPTURE_CHANNELS; ++i)
+      {
+        fields.push_back(
+          {"scaling", static_cast<int>(i), static_cast<double>(m_encoder_settings.scalings[i])});
+      }
+      break;
+    case SVH_GET_FIRMWARE_INFO:
+    {
+      SVHFirmwareInfo info;
+      m_ab >> info;
+      fields.push_back({"version_major", -1, static_cast<double>(info.version_major)});
+      fields.push_back({"version_minor", -1, static_cast<double>(info.version_minor)});
+      frame.text = info.svh.substr(0, info.svh.find('\0')) + " " +
+                   info.text.substr(0, info.text.find('\0'));
+      break;
+    }
+  }
+}
+
+void SVHCaptureChannelRange::add(int32_t position, int16_t current)
+{
+  if (samples == 0)
+  {
+    position_min = position_max = position;
+    current_min = current_max = current;
+  }
+  else
+  {
+    position_min = std::min(position_min, position);
+    position_max = std::max(position_max, position);
+    current_min  = std::min(current_min, current);
+    current_max  = std::max(current_max, current);
+  }
+  samples++;
+}
+
+void SVHCaptureChannelRange::merge(const SVHCaptureChannelRange& other)
+{
+  if (other.samples == 0)
+  {
+    return;
+  }
+  if (samples == 0)
+  {
+    *this = other;
+    return;
+  }
+  position_min = std::min(position_min, other.position_min);
+  position_max = std::max(position_max, other.position_max);
+  current_min  = std::min(current_min, other.current_min);
+  current_max  = std::max(current_max, other.current_max);
+  samples += other.samples;
+}
+
+SVHCaptureSummary::SVHCaptureSummary()
+  : rtt_histogram(C_RTT_BUCKETS, 0)
+{
+  std::fill(type_transmitted, type_transmitted + 16, 0);
+  std::fill(type_received, type_received + 16, 0);
+}
+
+void SVHCaptureSummary::merge(const SVHCaptureSummary& later)
+{
+  if (later.records > 0)
+  {
+    if (records == 0)
+    {
+      first_sequence = later.first_sequence;
+      first_ns       = later.first_ns;
+    }
+    last_sequence = later.last_sequence;
+    last_ns       = later.last_ns;
+  }
+  records += later.records;
+  transmitted += later.transmitted;
+  received += later.received;
+  checksum_errors += later.checksum_errors;
+  write_failures += later.write_failures;
+  missing_records += later.missing_records;
+  for (size_t i = 0; i < 16; ++i)
+  {
+    type_transmitted[i] += later.type_transmitted[i];
+    type_received[i] += later.type_received[i];
+  }
+
+  if (later.rtt_samples > 0)
+  {
+    rtt_min_ns = rtt_samples > 0 ? std::min(rtt_min_ns, later.rtt_min_ns) : later.rtt_min_ns;
+    rtt_max_ns = rtt_samples > 0 ? std::max(rtt_max_ns, later.rtt_max_ns) : later.rtt_max_ns;
+    for (size_t i = 0; i < C_RTT_BUCKETS; ++i)
+    {
+      rtt_histogram[i] += later.rtt_histogram[i];
+    }
+  }
+  rtt_samples += later.rtt_samples;
+  rtt_sum_ns += later.rtt_sum_ns;
+  unanswered += later.unanswered;
+  unmatched_responses += later.unmatched_responses;
+
+  gap_max_ns = std::max(gap_max_ns, later.gap_max_ns);
+  gaps += later.gaps;
+
+  for (size_t i = 0; i < C_CAPTURE_CHANNELS; ++i)
+  {
+    channels[i].merge(later.channels[i]);
+  }
+}
+
+double SVHCaptureSummary::durationSeconds() const
+{
+  return static_cast<double>(last_ns - first_ns) * 1e-9;
+}
+
+void SVHCaptureSummary::addRtt(int64_t rtt_ns)
+{
+  rtt_min_ns = rtt_samples > 0 ? std::min(rtt_min_ns, rtt_ns) : rtt_ns;
+  rtt_max_ns = rtt_samples > 0 ? std::max(rtt_max_ns, rtt_ns) : rtt_ns;
+  rtt_samples++;
+  rtt_sum_ns += static_cast<double>(rtt_ns);
+  rtt_histogram[rttBucket(rtt_ns)]++;
+}
+
+int64_t SVHCaptureSummary::rttPercentile(double fraction) const
+{
+  if (rtt_samples == 0)
+  {
+    return 0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(rtt_samples - 1));
+  uint64_t seen       = 0;
+  for (size_t i = 0; i < C_RTT_BUCKETS; ++i)
+  {
+    seen += rtt_histogram[i];
+    if (seen > rank)
+    {
+      return std::min(std::max(rttBucketStart(i), rtt_min_ns), rtt_max_ns);
+    }
+  }
+  return rtt_max_ns;
+}
+
+void SVHCaptureSummary::writeText(std::ostream& out) const
+{
+  const double duration = durationSeconds();
+  out << "Records:          " << records << " of " << recorded << " recorded, capacity "
+      << capacity << std::endl
+      << "Duration:         " << duration << " s" << std::endl
+      << "Transmitted:      " << transmitted << " (" << write_failures << " write failures)"
+      << std::endl
+      << "Received:         " << received << " (" << checksum_errors << " checksum errors)"
+      << std::endl
+      << "Missing records:  " << missing_records << std::endl
+      << "Gaps:             " << gaps << ", longest " << gap_max_ns * 1e-6 << " ms" << std::endl;
+
+  out << std::endl << std::left << std::setw(26) << "Message" << std::right << std::setw(10) << "tx"
+      << std::setw(12) << "tx/s" << std::setw(10) << "rx" << std::setw(12) << "rx/s" << std::endl;
+  for (uint8_t type = 0; type < 16; ++type)
+  {
+    if (type_transmitted[type] == 0 && type_received[type] == 0)
+    {
+      continue;
+    }
+    out << std::left << std::setw(26) << SVHCaptureDecoder::typeName(type) << std::right
+        << std::setw(10) << type_transmitted[type] << std::setw(12) << std::fixed
+        << std::setprecision(1) << (duration > 0 ? type_transmitted[type] / duration : 0.0)
+        << std::setw(10) << type_received[type] << std::setw(12)
+        << (duration > 0 ? type_received[type] / duration : 0.0) << std::endl
+        << std::defaultfloat << std::setprecision(6);
+  }
+
+  out << std::endl
+      << "Round trips:      " << rtt_samples << " answered, " << unanswered << " unanswered, "
+      << unmatched_responses << " unmatched responses" << std::endl;
+  if (rtt_samples > 0)
+  {
+    out << "Round trip [us]:  min " << rtt_min_ns / 1000 << ", p50 " << rttPercentile(0.5) / 1000
+        << ", p90 " << rttPercentile(0.9) / 1000 << ", p99 " << rttPercentile(0.99) / 1000
+        << ", max " << rtt_max_ns / 1000 << ", mean "
+        << static_cast<int64_t>(rtt_sum_ns / static_cast<double>(rtt_samples)) / 1000 << std::endl;
+  }
+
+  out << std::endl
+      << std::setw(8) << "Channel" << std::setw(10) << "samples" << std::setw(14) << "position min"
+      << std::setw(14) << "position max" << std::setw(13) << "current min" << std::setw(13)
+      << "current max" << std::endl;
+  for (size_t i = 0; i < C_CAPTURE_CHANNELS; ++i)
+  {
+    const SVHCaptureChannelRange& range = channels[i];
+    out << std::setw(8) << i << std::setw(10) << range.samples << std::setw(14)
+        << range.position_min << std::setw(14) << range.position_max << std::setw(13)
+        << range.current_min << std::setw(13) << range.current_max << std::endl;
+  }
+}
+
+void SVHCaptureSummary::writeJson(std::ostream& out) const
+{
+  const double duration = durationSeconds();
+  out << "{" << std::endl
+      << "  \"capacity\": " << capacity << "," << std::endl
+      << "  \"recorded\": " << recorded << "," << std::endl
+      << "  \"records\": " << records << "," << std::endl
+      << "  \"first_sequence\": " << first_sequence << "," << std::endl
+      << "  \"last_sequence\": " << last_sequence << "," << std::endl
+      << "  \"start_ns\": " << first_ns << "," << std::endl
+      << "  \"duration_s\": " << duration << "," << std::endl
+      << "  \"transmitted\": " << transmitted << "," << std::endl
+      << "  \"received\": " << received << "," << std::endl
+      << "  \"checksum_errors\": " << checksum_errors << "," << std::endl
+      << "  \"write_failures\": " << write_failures << "," << std::endl
+      << "  \"missing_records\": " << missing_records << "," << std::endl
+      << "  \"gaps\": {\"count\": " << gaps << ", \"max_ms\": " << gap_max_ns * 1e-6 << "},"
+      << std::endl;
+
+  out << "  \"messages\": [";
+  bool first = true;
+  for (uint8_t type = 0; type < 16; ++type)
+  {
+    if (type_transmitted[type] == 0 && type_received[type] == 0)
+    {
+      continue;
+    }
+    out << (first ? "" : ",") << std::endl
+        << "    {\"type\": \"" << SVHCaptureDecoder::typeName(type)
+        << "\", \"tx\": " << type_transmitted[type]
+        << ", \"tx_per_s\": " << (duration > 0 ? type_transmitted[type] / duration : 0.0)
+        << ", \"rx\": " << type_received[type]
+        << ", \"rx_per_s\": " << (duration > 0 ? type_received[type] / duration : 0.0) << "}";
+    first = false;
+  }
+  out << std::endl << "  ]," << std::endl;
+
+  out << "  \"round_trip_us\": {\"answered\": " << rtt_samples << ", \"unanswered\": " << unanswered
+      << ", \"unmatched_responses\": " << unmatched_responses;
+  if (rtt_samples > 0)
+  {
+    out << ", \"min\": " << rtt_min_ns * 1e-3 << ", \"p50\": " << rttPercentile(0.5) * 1e-3
+        << ", \"p90\": " << rttPercentile(0.9) * 1e-3 << ", \"p99\": " << rttPercentile(0.99) * 1e-3
+        << ", \"max\": " << rtt_max_ns * 1e-3
+        << ", \"mean\": " << rtt_sum_ns / static_cast<double>(rtt_samples) * 1e-3;
+  }
+  out << "}," << std::endl;
+
+  out << "  \"channels\": [";
+  for (size_t i = 0; i < C_CAPTURE_CHANNELS; ++i)
+  {
+    const SVHCaptureChannelRange& range = channels[i];
+    out << (i == 0 ? "" : ",") << std::endl
+        << "    {\"channel\": " << i << ", \"samples\": " << range.samples
+        << ", \"position_min\": " << range.position_min
+        << ", \"position_max\": " << range.position_max
+        << ", \"current_min\": " << range.current_min << ", \"current_max\": " << range.current_max
+        << "}";
+  }
+  out << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+SVHCaptureAnalyzer::SVHCaptureAnalyzer()
+  : m_first_slot(0)
+  , m_records(nullptr)
+  , m_mapping(nullptr)
+  , m_mapped_size(0)
+{
+  std::memset(&m_header, 0, sizeof(m_header));
+}
+
+SVHCaptureAnalyzer::~SVHCaptureAnalyzer()
+{
+  close();
+}
+
+bool SVHCaptureAnalyzer::open(const std::string& path)
+{
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureAnalyzer",
+                         "Could not open capture file " << path << ": " << strerror(errno));
+    return false;
+  }
+
+  struct stat file_status;
+  SVHCaptureFileHeader header;
+  if (fstat(fd, &file_status) != 0 ||
+      static_cast<size_t>(file_status.st_size) < sizeof(header) ||
+      pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+      !SVHPacketRecorder::isCaptureHeader(header))
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureAnalyzer", path << " is no capture file of a known version");
+    ::close(fd);
+    return false;
+  }
+
+  const size_t size = sizeof(header) + header.capacity * sizeof(SVHCaptureRecord);
+  if (header.capacity == 0 || static_cast<size_t>(file_status.st_size) < size)
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureAnalyzer", "Capture file " << path << " is truncated");
+    ::close(fd);
+    return false;
+  }
+
+  void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureAnalyzer",
+                         "Could not map capture file " << path << ": " << strerror(errno));
+    return false;
+  }
+  // Every thread reads its chunk front to back
+  madvise(mapping, size, MADV_SEQUENTIAL);
+
+  m_header      = header;
+  m_first_slot  = header.next < header.capacity ? 0 : header.next % header.capacity;
+  m_records     = reinterpret_cast<const SVHCaptureRecord*>(
+    static_cast<const uint8_t*>(mapping) + sizeof(SVHCaptureFileHeader));
+  m_mapping     = mapping;
+  m_mapped_size = size;
+  return true;
+}
+
+void SVHCaptureAnalyzer::close()
+{
+  if (m_mapping != nullptr)
+  {
+    munmap(m_mapping, m_mapped_size);
+  }
+  m_mapping     = nullptr;
+  m_mapped_size = 0;
+  m_records     = nullptr;
+  m_first_slot  = 0;
+  std::memset(&m_header, 0, sizeof(m_header));
+}
+
+bool SVHCaptureAnalyzer::analyze(const SVHCaptureAnalysisOptions& options,
+                                 SVHCaptureSummary& summary,
+                                 std::ostream* export_stream) const
+{
+  summary = SVHCaptureSummary();
+  if (m_mapping == nullptr)
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureAnalyzer", "No capture file is open");
+    return false;
+  }
+  summary.capacity = m_header.capacity;
+  summary.recorded = m_header.next;
+
+  const unsigned int threads =
+    options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  const uint64_t chunk = std::max<uint64_t>(1, options.chunk_records);
+
+  if (export_stream && options.export_format == EF_CSV)
+  {
+    writeCaptureCsvHeader(*export_stream);
+  }
+
+  // The chunks of a round are analyzed in parallel and merged in order, which bounds the memory
+  // used for the export and keeps it ordered
+  std::vector<SVHCaptureSummary> partial(threads);
+  std::vector<std::string> exported(threads);
+  std::vector<std::thread> workers;
+  for (uint64_t round = 0; round < m_header.capacity; round += chunk * threads)
+  {
+    unsigned int chunks = 0;
+    for (; chunks < threads && round + chunks * chunk < m_header.capacity; ++chunks)
+    {
+      const uint64_t begin = round + chunks * chunk;
+      const uint64_t end   = std::min(begin + chunk, m_header.capacity);
+      partial[chunks]      = SVHCaptureSummary();
+      exported[chunks].clear();
+      std::string* text = export_stream ? &exported[chunks] : nullptr;
+      if (chunks == 0)
+      {
+        continue;
+      }
+      workers.emplace_back([this, begin, end, &options, &partial, text, chunks]() {
+        analyzeChunk(begin, end, options, partial[chunks], text);
+      });
+    }
+    analyzeChunk(round,
+                 std::min(round + chunk, m_header.capacity),
+                 options,
+                 partial[0],
+                 export_stream ? &exported[0] : nullptr);
+    for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+      it->join();
+    }
+    workers.clear();
+
+    for (unsigned int i = 0; i < chunks; ++i)
+    {
+      summary.merge(partial[i]);
+      if (export_stream)
+      {
+        export_stream->write(exported[i].data(), static_cast<std::streamsize>(exported[i].size()));
+      }
+    }
+  }
+
+  // Records reserved at the end but never completed, e.g. because the process crashed
+  if (summary.records > 0 && summary.recorded > summary.last_sequence)
+  {
+    summary.missing_records += summary.recorded - summary.last_sequence;
+  }
+
+  if (export_stream && !*export_stream)
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureAnalyzer", "Could not write the export");
+    return false;
+  }
+  return true;
+}
+
+void SVHCaptureAnalyzer::analyzeChunk(uint64_t begin,
+                                      uint64_t end,
+                                      const SVHCaptureAnalysisOptions& options,
+                                      SVHCaptureSummary& summary,
+                                      std::string* export_text) const
+{
+  const int64_t gap_threshold_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(options.gap_threshold).count();
+
+  SVHCaptureDecoder decoder;
+  SVHDecodedFrame frame;
+  PendingRequest pending[256];
+  bool have_previous         = false;
+  uint64_t previous_sequence = 0;
+  int64_t previous_ns        = 0;
+
+  // The records in front of the chunk are only replayed to know the pending requests
+  const uint64_t lookback = begin > C_LOOKBACK_RECORDS ? begin - C_LOOKBACK_RECORDS : 0;
+  for (uint64_t position = lookback; position < end; ++position)
+  {
+    const SVHCaptureRecord& record = recordAt(position);
+    if (record.sequence == 0 || record.sequence > m_header.next ||
+        (have_previous && record.sequence <= previous_sequence) ||
+        !decoder.decode(m_header, record, frame))
+    {
+      // Empty slot, a record still in progress or one written after the file was opened
+      continue;
+    }
+    const bool counted = position >= begin;
+
+    if (counted)
+    {
+      if (summary.records == 0)
+      {
+        summary.first_sequence = frame.sequence;
+        summary.first_ns       = frame.time_ns;
+      }
+      summary.last_sequence = frame.sequence;
+      summary.last_ns       = frame.time_ns;
+      summary.records++;
+
+      if (have_previous)
+      {
+        summary.missing_records += frame.sequence - previous_sequence - 1;
+        const int64_t gap_ns = record.timestamp_ns - previous_ns;
+        summary.gap_max_ns   = std::max(summary.gap_max_ns, gap_ns);
+        if (gap_ns > gap_threshold_ns)
+        {
+          summary.gaps++;
+        }
+      }
+
+      if (frame.direction == CD_TRANSMIT)
+      {
+        summary.transmitted++;
+        summary.type_transmitted[frame.type]++;
+        summary.write_failures += frame.status == CS_WRITE_FAILED ? 1 : 0;
+      }
+      else
+      {
+        summary.received++;
+        summary.type_received[frame.type]++;
+        summary.checksum_errors += frame.status == CS_CHECKSUM_ERROR ? 1 : 0;
+      }
+
+      // Feedback is decoded into fields without channel for single channel messages
+      if (frame.direction == CD_RECEIVE && frame.type <= SVH_SET_CONTROL_COMMAND_ALL)
+      {
+        for (size_t i = 0; i + 1 < frame.fields.size(); i += 2)
+        {
+          const int channel =
+            frame.fields[i].channel >= 0 ? frame.fields[i].channel : frame.channel;
+          if (channel < static_cast<int>(C_CAPTURE_CHANNELS))
+          {
+            summary.channels[channel].add(static_cast<int32_t>(frame.fields[i].value),
+                                          static_cast<int16_t>(frame.fields[i + 1].value));
+          }
+        }
+      }
+
+      if (export_text)
+      {
+        appendDecodedFrame(frame, options.export_format, *export_text);
+      }
+    }
+
+    // The hand answers with the index and type of the request
+    if (frame.status == CS_OK)
+    {
+      PendingRequest& request = pending[frame.index];
+      if (frame.direction == CD_TRANSMIT)
+      {
+        if (request.valid && counted)
+        {
+          summary.unanswered++;
+        }
+        request.valid        = true;
+        request.type         = frame.type;
+        request.timestamp_ns = record.timestamp_ns;
+      }
+      else if (request.valid && request.type == frame.type)
+      {
+        if (counted)
+        {
+          summary.addRtt(record.timestamp_ns - request.timestamp_ns);
+        }
+        request.valid = false;
+      }
+      else if (counted)
+      {
+        summary.unmatched_responses++;
+      }
+    }
+
+    have_previous     = true;
+    previous_sequence = frame.sequence;
+    previous_ns       = record.timestamp_ns;
+  }
+}
+
+void writeCaptureCsvHeader(std::ostream& out)
+{
+  out << "sequence,time_ns,direction,status,index,type,channel,length,fields,text" << std::endl;
+}
+
+void appendDecodedFrame(const SVHDecodedFrame& frame,
+                        SVHCaptureExportFormat format,
+                        std::string& out)
+{
+  if (format == EF_CSV)
+  {
+    appendNumber(out, frame.sequence);
+    out += ',';
+    appendNumber(out, frame.time_ns);
+    out += ',';
+    out += directionName(frame.direction);
+    out += ',';
+    out += statusName(frame.status);
+    out += ',';
+    appendNumber(out, static_cast<uint64_t>(frame.index));
+    out += ',';
+    out += SVHCaptureDecoder::typeName(frame.type);
+    out += ',';
+    appendNumber(out, static_cast<uint64_t>(frame.channel));
+    out += ',';
+    appendNumber(out, static_cast<uint64_t>(frame.length));
+    out += ',';
+    for (size_t i = 0; i < frame.fields.size(); ++i)
+    {
+      out += i == 0 ? "" : ";";
+      appendFieldName(out, frame.fields[i]);
+      out += '=';
+      appendNumber(out, frame.fields[i].value);
+    }
+    out += ",\"";
+    appendEscaped(out, frame.text, format);
+    out += "\"\n";
+    return;
+  }
+
+  out += "{\"sequence\":";
+  appendNumber(out, frame.sequence);
+  out += ",\"time_ns\":";
+  appendNumber(out, frame.time_ns);
+  out += ",\"direction\":\"";
+  out += directionName(frame.direction);
+  out += "\",\"status\":\"";
+  out += statusName(frame.status);
+  out += "\",\"index\":";
+  appendNumber(out, static_cast<uint64_t>(frame.index));
+  out += ",\"type\":\"";
+  out += SVHCaptureDecoder::typeName(frame.type);
+  out += "\",\"channel\":";
+  appendNumber(out, static_cast<uint64_t>(frame.channel));
+  out += ",\"length\":";
+  appendNumber(out, static_cast<uint64_t>(frame.length));
+  out += ",\"fields\":{";
+  for (size_t i = 0; i < frame.fields.size(); ++i)
+  {
+    out += i == 0 ? "\"" : ",\"";
+    appendFieldName(out, frame.fields[i]);
+    out += "\":";
+    appendNumber(out, frame.fields[i].value);
+  }
+  out += '}';
+  if (!frame.text.empty())
+  {
+    out += ",\"text\":\"";
+    appendEscaped(out, frame.text, format);
+    out += '"';
+  }
+  out += "}\n";
+}
+
+} // namespace driver_svh
@@ -0,0 +1,324 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the offline analysis of capture files written by the
+ * SVHPacketRecorder. The recorded frames are decoded into the typed
+ * messages of the control layer and summarized: message rates, round trip
+ * times, checksum errors, gaps in the recording and the range of every
+ * channel. The file is mapped and split into chunks that are analyzed in
+ * parallel, so captures much larger than the memory can be processed.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_CAPTURE_ANALYSIS_H_INCLUDED
+#define DRIVER_SVH_SVH_CAPTURE_ANALYSIS_H_INCLUDED
+
+#include <schunk_svh_library/control/SVHControlCommand.h>
+#include <schunk_svh_library/control/SVHControllerFeedback.h>
+#include <schunk_svh_library/control/SVHEncoderSettings.h>
+#include <schunk_svh_library/serial/ByteOrderConversion.h>
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+//! Number of channels of the hand
+const size_t C_CAPTURE_CHANNELS = 9;
+
+//! Formats of the per frame export
+enum SVHCaptureExportFormat
+{
+  //! One line per frame, the decoded fields are joined into one column
+  EF_CSV,
+  //! One JSON object per line
+  EF_JSON
+};
+
+//! A decoded value of a frame
+struct SVHDecodedField
+{
+  //! Name of the value, e.g. "position"
+  const char* name;
+  //! Channel the value belongs to for messages of all channels, -1 otherwise
+  int channel;
+  //! The value
+  double value;
+};
+
+//! A recorded frame decoded into the message it carries
+struct SVHDecodedFrame
+{
+  uint64_t sequence = 0;
+  //! System clock in ns since the epoch
+  int64_t time_ns = 0;
+  SVHCaptureDirection direction = CD_TRANSMIT;
+  SVHCaptureStatus status       = CS_OK;
+  uint8_t index                 = 0;
+  //! Lower nibble of the address, one of the SVH_GET_* and SVH_SET_* constants
+  uint8_t type = 0;
+  //! Upper nibble of the address
+  uint8_t channel = 0;
+  //! Length of the payload
+  uint16_t length = 0;
+  //! Values of the message, empty for requests without payload and undecodable frames
+  std::vector<SVHDecodedField> fields;
+  //! Text of a firmware info
+  std::string text;
+};
+
+/*!
+ * \brief Decodes recorded frames with the codecs of the control layer
+ *
+ * The decoder keeps its buffers between calls, so decoding does not allocate once it is warm.
+ */
+class SVHCaptureDecoder
+{
+public:
+  /*!
+   * \brief decode a record
+   * \param header header of the capture file, used to convert the timestamp
+   * \param record the recorded frame
+   * \param frame receives the decoded message
+   * \return false if the record does not hold a complete frame. Frames with a checksum error and
+   * payloads too short for their message are returned without fields.
+   */
+  bool decode(const SVHCaptureFileHeader& header,
+              const SVHCaptureRecord& record,
+              SVHDecodedFrame& frame);
+
+  //! Name of a message type, e.g. "get_control_feedback"
+  static const char* typeName(uint8_t type);
+
+private:
+  //! Decode the payload into the fields of frame
+  void decodePayload(const uint8_t* payload, SVHDecodedFrame& frame);
+
+  ArrayBuilder m_ab;
+  SVHControllerFeedback m_feedback;
+  SVHControllerFeedbackAllChannels m_feedback_all;
+  SVHControlCommand m_command;
+  SVHControlCommandAllChannels m_command_all;
+  SVHEncoderSettings m_encoder_settings;
+};
+
+//! Range of the feedback of one channel
+struct SVHCaptureChannelRange
+{
+  uint64_t samples     = 0;
+  int32_t position_min = 0;
+  int32_t position_max = 0;
+  int16_t current_min  = 0;
+  int16_t current_max  = 0;
+
+  //! Extend the range by a feedback
+  void add(int32_t position, int16_t current);
+
+  //! Extend the range by another one
+  void merge(const SVHCaptureChannelRange& other);
+};
+
+//! Options of SVHCaptureAnalyzer::analyze
+struct SVHCaptureAnalysisOptions
+{
+  //! Number of threads, 0 to use one per CPU
+  unsigned int threads = 0;
+  //! Number of records a thread analyzes at once. The export buffers this many frames per thread.
+  size_t chunk_records = 16384;
+  //! Silences between two frames longer than this are counted as gaps
+  std::chrono::microseconds gap_threshold{100000};
+  //! Format of the per frame export
+  SVHCaptureExportFormat export_format = EF_CSV;
+};
+
+//! Result of SVHCaptureAnalyzer::analyze
+struct SVHCaptureSummary
+{
+  /*!
+   * Round trip times are counted in buckets of 1 us below 1 ms, 10 us below 10 ms, 100 us below
+   * 100 ms and 1 ms below 1 s. The last bucket holds everything longer.
+   */
+  static const size_t C_RTT_BUCKETS = 3701;
+
+  SVHCaptureSummary();
+
+  //! Capacity of the capture file
+  uint64_t capacity = 0;
+  //! Number of frames recorded into the file, including overwritten ones
+  uint64_t recorded = 0;
+
+  //! Complete records in the file
+  uint64_t records = 0;
+  uint64_t transmitted = 0;
+  uint64_t received    = 0;
+  //! Received frames dropped due to a checksum error
+  uint64_t checksum_errors = 0;
+  //! Frames that could not be written completely
+  uint64_t write_failures = 0;
+  //! Records between the first and the last one that are incomplete, e.g. after a crash
+  uint64_t missing_records = 0;
+
+  //! Sequence numbers of the first and the last complete record
+  uint64_t first_sequence = 0;
+  uint64_t last_sequence  = 0;
+  //! System clock of the first and the last complete record in ns since the epoch
+  int64_t first_ns = 0;
+  int64_t last_ns  = 0;
+
+  //! Frames per message type and direction
+  uint64_t type_transmitted[16];
+  uint64_t type_received[16];
+
+  //! Requests answered by a frame with the same index and type
+  uint64_t rtt_samples = 0;
+  int64_t rtt_min_ns   = 0;
+  int64_t rtt_max_ns   = 0;
+  double rtt_sum_ns    = 0;
+  std::vector<uint64_t> rtt_histogram;
+  //! Requests whose index was reused before an answer arrived
+  uint64_t unanswered = 0;
+  //! Received frames that answer no pending request
+  uint64_t unmatched_responses = 0;
+
+  //! Longest silence between two frames
+  int64_t gap_max_ns = 0;
+  //! Silences longer than the threshold
+  uint64_t gaps = 0;
+
+  //! Feedback ranges of the channels
+  SVHCaptureChannelRange channels[C_CAPTURE_CHANNELS];
+
+  //! Add the summary of the records following the ones of this summary
+  void merge(const SVHCaptureSummary& later);
+
+  //! Time between the first and the last record in seconds
+  double durationSeconds() const;
+
+  //! Round trip time that fraction of the answered requests do not exceed, in ns
+  int64_t rttPercentile(double fraction) const;
+
+  //! Count a round trip time
+  void addRtt(int64_t rtt_ns);
+
+  //! Print the summary in human readable form
+  void writeText(std::ostream& out) const;
+
+  //! Print the summary as JSON
+  void writeJson(std::ostream& out) const;
+};
+
+/*!
+ * \brief Analyzes a capture file
+ *
+ * The file is mapped read only, so it can be analyzed while it is still being recorded. Frames
+ * recorded during the analysis are not taken into account.
+ */
+class SVHCaptureAnalyzer
+{
+public:
+  SVHCaptureAnalyzer();
+
+  //! Unmaps the file
+  ~SVHCaptureAnalyzer();
+
+  /*!
+   * \brief map a capture file
+   * \param path file written by the SVHPacketRecorder
+   * \return false if the file cannot be mapped or is no capture file
+   */
+  bool open(const std::string& path);
+
+  //! Unmap the file
+  void close();
+
+  //! Header of the mapped file, as it was when the file was opened
+  const SVHCaptureFileHeader& header() const { return m_header; }
+
+  /*!
+   * \brief analyze the mapped file
+   * \param options number of threads and how to export the frames
+   * \param summary receives the statistics
+   * \param export_stream receives every decoded frame, oldest first, if set
+   * \return false if no file is open or the export could not be written
+   */
+  bool analyze(const SVHCaptureAnalysisOptions& options,
+               SVHCaptureSummary& summary,
+               std::ostream* export_stream = nullptr) const;
+
+  /*!
+   * Records analyzed in front of a chunk to find the requests answered in it. Requests are
+   * answered within a few frames and the index wraps after 255 requests, so pending requests are
+   * never older than this.
+   */
+  static const uint64_t C_LOOKBACK_RECORDS = 1024;
+
+private:
+  // Forbid copying
+  SVHCaptureAnalyzer(const SVHCaptureAnalyzer&);
+  SVHCaptureAnalyzer& operator=(const SVHCaptureAnalyzer&);
+
+  //! Record at a position of the recording, 0 being the oldest slot
+  const SVHCaptureRecord& recordAt(uint64_t position) const
+  {
+    return m_records[(m_first_slot + position) % m_header.capacity];
+  }
+
+  //! Analyze the records in [begin, end) and append their export to export_text if set
+  void analyzeChunk(uint64_t begin,
+                    uint64_t end,
+                    const SVHCaptureAnalysisOptions& options,
+                    SVHCaptureSummary& summary,
+                    std::string* export_text) const;
+
+  //! Copy of the file header
+  SVHCaptureFileHeader m_header;
+
+  //! Slot of the oldest record
+  uint64_t m_first_slot;
+
+  //! First record in the mapping
+  const SVHCaptureRecord* m_records;
+
+  //! The mapping
+  void* m_mapping;
+  size_t m_mapped_size;
+};
+
+//! Print the column names of the CSV export
+void writeCaptureCsvHeader(std::ostream& out);
+
+//! Append a decoded frame to an export
+void appendDecodedFrame(const SVHDecodedFrame& frame,
+                        SVHCaptureExportFormat format,
+                        std::string& out);
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * Command line tool that analyzes a capture file written by the
+ * SVHPacketRecorder. It prints a summary of the recorded communication and
+ * optionally exports every decoded frame as CSV or JSON.
+ */
+//----------------------------------------------------------------------
+#include "SVHCaptureAnalysis.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace driver_svh;
+
+namespace {
+
+struct AnalyzerOptions
+{
+  SVHCaptureAnalysisOptions analysis;
+  std::string capture;
+  std::string summary;
+  std::string export_file;
+};
+
+bool parseOptions(int argc, char* argv[], AnalyzerOptions& options)
+{
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    std::string arg = argv[i];
+    bool has_value  = (i + 1 < argc);
+
+    if (arg == "--threads" && has_value)
+    {
+      options.analysis.threads = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+    }
+    else if (arg == "--gap-threshold" && has_value)
+    {
+      options.analysis.gap_threshold =
+        std::chrono::microseconds(static_cast<int64_t>(std::atof(argv[++i]) * 1e3));
+    }
+    else if (arg == "--summary" && has_value)
+    {
+      options.summary = argv[++i];
+    }
+    else if (arg == "--export" && has_value)
+    {
+      options.export_file = argv[++i];
+    }
+    else if (arg == "--format" && has_value)
+    {
+      std::string format = argv[++i];
+      valid              = format == "csv" || format == "json";
+      options.analysis.export_format = format == "json" ? EF_JSON : EF_CSV;
+    }
+    else if (arg.compare(0, 2, "--") != 0 && options.capture.empty())
+    {
+      options.capture = arg;
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || options.capture.empty())
+  {
+    std::cerr << "Usage: " << argv[0] << " [options] CAPTURE" << std::endl
+              << "  --threads N          number of threads, default one per CPU" << std::endl
+              << "  --gap-threshold MS   count silences longer than MS ms as gaps (default 100)"
+              << std::endl
+              << "  --summary FILE       write the summary as JSON to FILE, '-' for stdout"
+              << std::endl
+              << "  --export FILE        write every decoded frame to FILE, '-' for stdout"
+              << std::endl
+              << "  --format csv|json    format of the export (default csv)" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//! Open FILE for writing, '-' selects stdout
+std::ostream* openOutput(const std::string& path, std::ofstream& file)
+{
+  if (path == "-")
+  {
+    return &std::cout;
+  }
+  file.open(path.c_str());
+  if (!file)
+  {
+    std::cerr << "Could not open " << path << " for writing" << std::endl;
+    return nullptr;
+  }
+  return &file;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  AnalyzerOptions options;
+  if (!parseOptions(argc, argv, options))
+  {
+    return 1;
+  }
+
+  SVHCaptureAnalyzer analyzer;
+  if (!analyzer.open(options.capture))
+  {
+    std::cerr << "Could not read capture file " << options.capture << std::endl;
+    return 1;
+  }
+
+  std::ofstream export_file;
+  std::ostream* export_stream = nullptr;
+  if (!options.export_file.empty())
+  {
+    export_stream = openOutput(options.export_file, export_file);
+    if (!export_stream)
+    {
+      return 1;
+    }
+  }
+
+  SVHCaptureSummary summary;
+  if (!analyzer.analyze(options.analysis, summary, export_stream))
+  {
+    return 1;
+  }
+
+  if (!options.summary.empty())
+  {
+    std::ofstream summary_file;
+    std::ostream* summary_stream = openOutput(options.summary, summary_file);
+    if (!summary_stream)
+    {
+      return 1;
+    }
+    summary.writeJson(*summary_stream);
+  }
+
+  // The human readable summary must not end up in the middle of machine readable output
+  if (options.summary != "-" && options.export_file != "-")
+  {
+    summary.writeText(std::cout);
+  }
+  return 0;
+}
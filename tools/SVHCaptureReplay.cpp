@@ -0,0 +1,410 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#include "SVHCaptureReplay.h"
+
+#include <schunk_svh_library/Logger.h>
+#include <schunk_svh_library/SVHFirmwareInfo.h>
+#include <schunk_svh_library/control/SVHController.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace driver_svh {
+
+namespace {
+
+//! Header of a frame in front of the payload
+const size_t C_FRAME_HEADER_SIZE = 6;
+
+//! Checksum behind the payload
+const size_t C_FRAME_CHECKSUM_SIZE = 2;
+
+//! Highest packet type the controller handles
+const uint8_t C_LAST_HANDLED_TYPE = SVH_GET_FIRMWARE_INFO;
+
+//! Pseudo terminal the controller connects to
+struct ReplayTerminal
+{
+  ~ReplayTerminal()
+  {
+    if (slave >= 0)
+    {
+      ::close(slave);
+    }
+    if (master >= 0)
+    {
+      ::close(master);
+    }
+  }
+
+  bool open()
+  {
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+      SVH_LOG_ERROR_STREAM("SVHCaptureReplay",
+                           "Could not create pseudo terminal: " << std::strerror(errno));
+      return false;
+    }
+    device_name = ptsname(master);
+
+    // Keep the slave open, the master would report a hangup whenever the controller closes it
+    slave = ::open(device_name.c_str(), O_RDWR | O_NOCTTY);
+    if (slave < 0)
+    {
+      SVH_LOG_ERROR_STREAM("SVHCaptureReplay",
+                           "Could not open " << device_name << ": " << std::strerror(errno));
+      return false;
+    }
+    termios io_set;
+    tcgetattr(slave, &io_set);
+    cfmakeraw(&io_set);
+    tcsetattr(slave, TCSANOW, &io_set);
+    return true;
+  }
+
+  //! Write a frame, waiting while the terminal is full
+  bool write(const uint8_t* data, size_t size)
+  {
+    while (size > 0)
+    {
+      ssize_t written = ::write(master, data, size);
+      if (written > 0)
+      {
+        data += written;
+        size -= static_cast<size_t>(written);
+        continue;
+      }
+      if (written < 0 && errno != EAGAIN && errno != EINTR)
+      {
+        return false;
+      }
+      struct pollfd descriptor = {master, POLLOUT, 0};
+      if (poll(&descriptor, 1, 1000) <= 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int master = -1;
+  int slave  = -1;
+  std::string device_name;
+};
+
+//! State of the controller implied by the recorded frames, decoded like the controller does
+class ExpectedState
+{
+public:
+  ExpectedState()
+    : m_feedback_seen(SVH_DIMENSION, false)
+    , m_feedback(SVH_DIMENSION)
+    , m_position_seen(SVH_DIMENSION, false)
+    , m_position(SVH_DIMENSION)
+    , m_current_seen(SVH_DIMENSION, false)
+    , m_current(SVH_DIMENSION)
+    , m_firmware_seen(false)
+  {
+  }
+
+  //! Apply a frame received with a valid checksum
+  void apply(const SVHCaptureRecord& record)
+  {
+    const uint8_t type    = record.frame[3] & 0x0F;
+    const uint8_t channel = (record.frame[3] >> 4) & 0x0F;
+    const size_t length   = static_cast<size_t>(record.frame[4] | (record.frame[5] << 8));
+    const uint8_t* payload = record.frame + C_FRAME_HEADER_SIZE;
+    m_ab.array.assign(payload, payload + length);
+    m_ab.write_pos = length;
+    m_ab.read_pos  = 0;
+
+    switch (type)
+    {
+      case SVH_GET_CONTROL_FEEDBACK:
+      case SVH_SET_CONTROL_COMMAND:
+        if (channel < SVH_DIMENSION)
+        {
+          m_ab >> m_feedback[channel];
+          m_feedback_seen[channel] = true;
+        }
+        break;
+      case SVH_GET_CONTROL_FEEDBACK_ALL:
+      case SVH_SET_CONTROL_COMMAND_ALL:
+      {
+        SVHControllerFeedbackAllChannels feedback_all;
+        m_ab >> feedback_all;
+        for (size_t i = 0; i < SVH_DIMENSION; ++i)
+        {
+          m_feedback[i]      = feedback_all.feedbacks[i];
+          m_feedback_seen[i] = true;
+        }
+        break;
+      }
+      case SVH_GET_POSITION_SETTINGS:
+      case SVH_SET_POSITION_SETTINGS:
+        if (channel < SVH_DIMENSION)
+        {
+          m_ab >> m_position[channel];
+          m_position_seen[channel] = true;
+        }
+        break;
+      case SVH_GET_CURRENT_SETTINGS:
+      case SVH_SET_CURRENT_SETTINGS:
+        if (channel < SVH_DIMENSION)
+        {
+          m_ab >> m_current[channel];
+          m_current_seen[channel] = true;
+        }
+        break;
+      case SVH_GET_FIRMWARE_INFO:
+        m_ab >> m_firmware;
+        m_firmware_seen = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  //! Describe every difference to the state of controller
+  void compare(SVHController& controller, std::vector<std::string>& mismatches) const
+  {
+    for (size_t i = 0; i < SVH_DIMENSION; ++i)
+    {
+      const SVHChannel channel = static_cast<SVHChannel>(i);
+      SVHControllerFeedback feedback;
+      if (m_feedback_seen[i] && (!controller.getControllerFeedback(channel, feedback) ||
+                                 !(feedback == m_feedback[i])))
+      {
+        std::ostringstream text;
+        text << "Feedback of channel " << i << " is " << feedback.position << "/"
+             << feedback.current << " instead of " << m_feedback[i].position << "/"
+             << m_feedback[i].current;
+        mismatches.push_back(text.str());
+      }
+
+      SVHPositionSettings position_settings;
+      if (m_position_seen[i] && (!controller.getPositionSettings(channel, position_settings) ||
+                                 !(position_settings == m_position[i])))
+      {
+        std::ostringstream text;
+        text << "Position settings of channel " << i << " differ from the recording";
+        mismatches.push_back(text.str());
+      }
+
+      SVHCurrentSettings current_settings;
+      if (m_current_seen[i] && (!controller.getCurrentSettings(channel, current_settings) ||
+                                !(current_settings == m_current[i])))
+      {
+        std::ostringstream text;
+        text << "Current settings of channel " << i << " differ from the recording";
+        mismatches.push_back(text.str());
+      }
+    }
+
+    if (m_firmware_seen)
+    {
+      SVHFirmwareInfo firmware = controller.getFirmwareInfo();
+      if (firmware.svh != m_firmware.svh || firmware.version_major != m_firmware.version_major ||
+          firmware.version_minor != m_firmware.version_minor || firmware.text != m_firmware.text)
+      {
+        std::ostringstream text;
+        text << "Firmware version is " << firmware.version_major << "." << firmware.version_minor
+             << " instead of " << m_firmware.version_major << "." << m_firmware.version_minor;
+        mismatches.push_back(text.str());
+      }
+    }
+  }
+
+private:
+  ArrayBuilder m_ab;
+  std::vector<bool> m_feedback_seen;
+  std::vector<SVHControllerFeedback> m_feedback;
+  std::vector<bool> m_position_seen;
+  std::vector<SVHPositionSettings> m_position;
+  std::vector<bool> m_current_seen;
+  std::vector<SVHCurrentSettings> m_current;
+  bool m_firmware_seen;
+  SVHFirmwareInfo m_firmware;
+};
+
+//! Whether a record holds a complete received frame
+bool isReplayed(const SVHCaptureRecord& record)
+{
+  if (record.direction != CD_RECEIVE || record.length > sizeof(record.frame) ||
+      record.length < C_FRAME_HEADER_SIZE + C_FRAME_CHECKSUM_SIZE)
+  {
+    return false;
+  }
+  const size_t length = static_cast<size_t>(record.frame[4] | (record.frame[5] << 8));
+  return C_FRAME_HEADER_SIZE + length + C_FRAME_CHECKSUM_SIZE <= record.length;
+}
+
+} // namespace
+
+bool SVHCaptureReplay::load(const std::string& path)
+{
+  SVHCaptureFileHeader header;
+  return SVHPacketRecorder::readCapture(path, header, m_records);
+}
+
+size_t SVHCaptureReplay::receivedFrames() const
+{
+  size_t frames = 0;
+  for (std::vector<SVHCaptureRecord>::const_iterator it = m_records.begin();
+       it != m_records.end();
+       ++it)
+  {
+    frames += isReplayed(*it) ? 1 : 0;
+  }
+  return frames;
+}
+
+bool SVHCaptureReplay::run(const SVHReplayOptions& options, SVHReplayResult& result) const
+{
+  result = SVHReplayResult();
+
+  ReplayTerminal terminal;
+  if (!terminal.open())
+  {
+    return false;
+  }
+
+  // Observers run after the handlers, so they tell when a frame has changed the controller state
+  std::atomic<uint64_t> dispatched(0);
+  SVHController controller;
+  controller.setTransportOptions(options.transport);
+  for (uint8_t type = 0; type <= C_LAST_HANDLED_TYPE; ++type)
+  {
+    controller.addPacketObserver(type, [&dispatched](const SVHSerialPacket&) { dispatched++; });
+  }
+
+  if (!controller.connect(terminal.device_name))
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureReplay", "Could not connect the controller to the replay");
+    return false;
+  }
+
+  ExpectedState expected;
+  uint64_t valid_frames   = 0;
+  uint64_t handled_frames = 0;
+  uint64_t dropped_frames = 0;
+  int64_t first_ns        = 0;
+  int64_t last_ns         = 0;
+  bool success            = true;
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (std::vector<SVHCaptureRecord>::const_iterator it = m_records.begin();
+       it != m_records.end() && success;
+       ++it)
+  {
+    const SVHCaptureRecord& record = *it;
+    if (!isReplayed(record))
+    {
+      continue;
+    }
+
+    if (result.frames == 0)
+    {
+      first_ns = record.timestamp_ns;
+    }
+    last_ns = record.timestamp_ns;
+    if (options.speed > 0)
+    {
+      const double offset_ns = static_cast<double>(record.timestamp_ns - first_ns) / options.speed;
+      std::this_thread::sleep_until(start +
+                                    std::chrono::nanoseconds(static_cast<int64_t>(offset_ns)));
+    }
+
+    success = terminal.write(record.frame, record.length);
+    result.frames++;
+    result.bytes += record.length;
+    if (record.status == CS_CHECKSUM_ERROR)
+    {
+      dropped_frames++;
+    }
+    else
+    {
+      valid_frames++;
+      handled_frames += (record.frame[3] & 0x0F) <= C_LAST_HANDLED_TYPE ? 1 : 0;
+      expected.apply(record);
+    }
+  }
+
+  if (!success)
+  {
+    SVH_LOG_ERROR_STREAM("SVHCaptureReplay",
+                         "Could not write frame " << result.frames << " to the controller");
+    controller.disconnect();
+    return false;
+  }
+
+  // Wait until the controller has processed everything
+  const std::chrono::steady_clock::time_point deadline =
+    std::chrono::steady_clock::now() + options.drain_timeout;
+  while (true)
+  {
+    result.receive  = controller.getReceiveStatistics();
+    result.complete = result.receive.packets >= valid_frames &&
+                      result.receive.checksum_errors >= dropped_frames &&
+                      dispatched >= handled_frames;
+    if (result.complete || std::chrono::steady_clock::now() > deadline)
+    {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  result.replay_seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.recorded_seconds = static_cast<double>(last_ns - first_ns) * 1e-9;
+
+  expected.compare(controller, result.mismatches);
+  if (!result.complete)
+  {
+    std::ostringstream text;
+    text << "The controller received " << result.receive.packets << " of " << valid_frames
+         << " frames and dropped " << result.receive.checksum_errors << " of " << dropped_frames;
+    result.mismatches.push_back(text.str());
+  }
+
+  controller.disconnect();
+  return true;
+}
+
+} // namespace driver_svh
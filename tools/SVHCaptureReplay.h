@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * This file contains the replay of capture files written by the
+ * SVHPacketRecorder. The received frames of a recording are fed through a
+ * pseudo terminal into an unmodified SVHController, either at the recorded
+ * pace or as fast as possible. Afterwards the state of the controller is
+ * compared with the state the recording implies. This reproduces problems
+ * seen in the field and measures the receive and dispatch path with real
+ * traffic.
+ */
+//----------------------------------------------------------------------
+#ifndef DRIVER_SVH_SVH_CAPTURE_REPLAY_H_INCLUDED
+#define DRIVER_SVH_SVH_CAPTURE_REPLAY_H_INCLUDED
+
+#include <schunk_svh_library/serial/SVHPacketRecorder.h>
+#include <schunk_svh_library/serial/SVHReceiveThread.h>
+#include <schunk_svh_library/serial/SVHTransportOptions.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace driver_svh {
+
+//! Options of SVHCaptureReplay::run
+struct SVHReplayOptions
+{
+  //! The replaying controller receives in blocking mode, so it keeps up with fast replays
+  SVHReplayOptions() { transport.receive_strategy = RS_BLOCKING; }
+
+  //! Multiple of the recorded pace, 0 replays as fast as possible
+  double speed = 1.0;
+  //! Transport options of the replaying controller
+  SVHTransportOptions transport;
+  //! How long to wait for the controller to process the last frame
+  std::chrono::milliseconds drain_timeout{2000};
+};
+
+//! Result of SVHCaptureReplay::run
+struct SVHReplayResult
+{
+  //! Received frames of the recording that were replayed
+  uint64_t frames = 0;
+  //! Bytes written to the controller
+  uint64_t bytes = 0;
+  //! Time between the first and the last replayed frame in the recording
+  double recorded_seconds = 0;
+  //! Time the replay took until the controller processed the last frame
+  double replay_seconds = 0;
+  //! What the receive thread of the controller saw
+  SVHReceiveStatistics receive;
+  //! Whether the controller processed all replayed frames
+  bool complete = false;
+  //! Differences between the state of the controller and the recording
+  std::vector<std::string> mismatches;
+
+  //! Whether the controller processed everything and ended up in the recorded state
+  bool verified() const { return complete && mismatches.empty(); }
+};
+
+/*!
+ * \brief Replays the received frames of a recording into an SVHController
+ *
+ * Only the frames received from the hand are replayed, the frames the application sent are
+ * skipped. Frames recorded with a checksum error are replayed unchanged, so the controller drops
+ * them again.
+ */
+class SVHCaptureReplay
+{
+public:
+  /*!
+   * \brief read the records of a capture file
+   * \param path file written by the SVHPacketRecorder
+   * \return false if the file cannot be read
+   */
+  bool load(const std::string& path);
+
+  //! Replay these records instead, oldest first
+  void setRecords(const std::vector<SVHCaptureRecord>& records) { m_records = records; }
+
+  //! Number of records that will be replayed
+  size_t receivedFrames() const;
+
+  /*!
+   * \brief replay the records into a new controller and verify its state
+   * \param options pace and transport of the replay
+   * \param result receives the measurements and differences
+   * \return false if the replay could not be set up or the frames could not be written
+   */
+  bool run(const SVHReplayOptions& options, SVHReplayResult& result) const;
+
+private:
+  //! The records, oldest first
+  std::vector<SVHCaptureRecord> m_records;
+};
+
+} // namespace driver_svh
+
+#endif
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// © Copyright 2022 SCHUNK Mobile Greifsysteme GmbH, Lauffen/Neckar Germany
+// © Copyright 2022 FZI Forschungszentrum Informatik, Karlsruhe, Germany
+//
+// This file is part of the Schunk SVH Library.
+//
+// The Schunk SVH Library is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// The Schunk SVH Library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// the Schunk SVH Library. If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ * Command line tool that replays the received frames of a capture file
+ * into an SVHController and checks that it ends up in the recorded state.
+ * It also reports how fast the receive and dispatch path processed the
+ * recorded traffic.
+ */
+//----------------------------------------------------------------------
+#include "SVHCaptureReplay.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace driver_svh;
+
+namespace {
+
+struct ReplayerOptions
+{
+  SVHReplayOptions replay;
+  std::string capture;
+};
+
+bool parseOptions(int argc, char* argv[], ReplayerOptions& options)
+{
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    std::string arg = argv[i];
+    bool has_value  = (i + 1 < argc);
+
+    if (arg == "--speed" && has_value)
+    {
+      options.replay.speed = std::max(0.0, std::atof(argv[++i]));
+    }
+    else if (arg == "--fast")
+    {
+      options.replay.speed = 0;
+    }
+    else if (arg == "--polling")
+    {
+      options.replay.transport.receive_strategy = RS_POLLING;
+    }
+    else if (arg.compare(0, 2, "--") != 0 && options.capture.empty())
+    {
+      options.capture = arg;
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  if (!valid || options.capture.empty())
+  {
+    std::cerr << "Usage: " << argv[0] << " [options] CAPTURE" << std::endl
+              << "  --speed FACTOR       multiple of the recorded pace (default 1)" << std::endl
+              << "  --fast               replay as fast as possible" << std::endl
+              << "  --polling            let the controller poll instead of blocking in read"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  ReplayerOptions options;
+  if (!parseOptions(argc, argv, options))
+  {
+    return 1;
+  }
+
+  SVHCaptureReplay replay;
+  if (!replay.load(options.capture))
+  {
+    std::cerr << "Could not read capture file " << options.capture << std::endl;
+    return 1;
+  }
+
+  SVHReplayResult result;
+  if (!replay.run(options.replay, result))
+  {
+    return 1;
+  }
+
+  std::cout << "Replayed " << result.frames << " frames (" << result.bytes << " bytes) in "
+            << result.replay_seconds << " s, recorded in " << result.recorded_seconds << " s"
+            << std::endl;
+  if (result.replay_seconds > 0)
+  {
+    std::cout << "Throughput: " << result.frames / result.replay_seconds << " frames/s, "
+              << result.recorded_seconds / result.replay_seconds << " x real time" << std::endl;
+  }
+  std::cout << "Receive thread: " << result.receive.packets << " packets, "
+            << result.receive.checksum_errors << " checksum errors, "
+            << result.receive.skipped_bytes << " skipped bytes, " << result.receive.wakeups
+            << " wakeups" << std::endl;
+
+  for (std::vector<std::string>::const_iterator it = result.mismatches.begin();
+       it != result.mismatches.end();
+       ++it)
+  {
+    std::cout << "Mismatch: " << *it << std::endl;
+  }
+  std::cout << (result.verified() ? "The controller state matches the recording"
+                                  : "The controller state does not match the recording")
+            << std::endl;
+  return result.verified() ? 0 : 2;
+}